@@ -81,6 +81,32 @@ BG_EXPORT extern int bg_tri_tri_isect_with_line(point_t V0,
 						point_t *isectpt1,
 						point_t *isectpt2);
 
+/**
+ * A block of triangles stored as separate coordinate arrays.  c[0], c[1]
+ * and c[2] hold the X, Y and Z coordinates of the first vertex of every
+ * triangle, c[3] - c[5] the second vertex and c[6] - c[8] the third.
+ * Each array holds n values.
+ */
+struct bg_tri_soa {
+    const fastf_t *c[9];
+    size_t n;
+};
+
+/**
+ * Test triangle V0, V1, V2 against every triangle in U.  mask[i] is set to
+ * 1 if U triangle i intersects the triangle and 0 otherwise, with the same
+ * results bg_tri_tri_isect would give.  Triangles lying entirely on one
+ * side of the other's plane are rejected for the whole block in a single
+ * vectorizable pass before the survivors get the full test.
+ *
+ * Returns the number of intersecting triangles.
+ */
+BG_EXPORT extern size_t bg_tri_tri_isect_batch(unsigned char *mask,
+					       const point_t V0,
+					       const point_t V1,
+					       const point_t V2,
+					       const struct bg_tri_soa *U);
+
 __END_DECLS
 
 #endif  /* BG_TRI_TRI_H */
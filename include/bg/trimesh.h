@@ -183,6 +183,28 @@ bg_trimesh_isect(
     int *faces_1, int num_faces_1, point_t *vertices_1, int num_vertices_1,
     int *faces_2, int num_faces_2, point_t *vertices_2, int num_vertices_2);
 
+/**
+ * @brief
+ * Find the intersecting triangle pairs between two meshes.
+ *
+ * A bounding volume hierarchy is built over each mesh and the two are
+ * walked against each other, so only triangles in overlapping leaves are
+ * tested.  pair_clbk is called with the face indices of each intersecting
+ * pair - if it returns non-zero the search stops.
+ *
+ * If faces_2 is NULL (or faces_2 and vertices_2 are the same arrays as
+ * faces_1 and vertices_1) the mesh is checked for self intersections.  In
+ * that mode each pair is reported once, with f1 < f2, and triangles that
+ * share a vertex are not reported.
+ *
+ * @return the number of intersecting pairs found
+ */
+BG_EXPORT extern size_t
+bg_trimesh_isect_pairs(
+    const int *faces_1, size_t num_faces_1, const point_t *vertices_1,
+    const int *faces_2, size_t num_faces_2, const point_t *vertices_2,
+    int (*pair_clbk)(size_t f1, size_t f2, void *data), void *data);
+
 /**
  * @brief
  * Compute vertex normals for a mesh based on the connected faces.
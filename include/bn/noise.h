@@ -136,6 +136,35 @@ BN_EXPORT extern double bn_noise_turb(point_t point,
 				      double lacunarity,
 				      double octaves);
 
+/**
+ * @brief
+ * Evaluate noise for a whole set of points at once.
+ *
+ * out[i] is set to the value bn_noise_perlin(), bn_noise_fbm() or
+ * bn_noise_turb() respectively would return for pts[i].  The points are
+ * processed in blocks with all octaves of a block evaluated together,
+ * which lets the compiler vectorize the lattice and interpolation math
+ * and does the per-call setup once for the whole set.  The arithmetic
+ * matches the single point routines operation for operation, so results
+ * are bit-identical to them - the single point routines remain the
+ * reference implementation.
+ */
+BN_EXPORT extern void bn_noise_perlin_n(double *out,
+					const point_t *pts,
+					size_t n);
+BN_EXPORT extern void bn_noise_fbm_n(double *out,
+				     const point_t *pts,
+				     size_t n,
+				     double h_val,
+				     double lacunarity,
+				     double octaves);
+BN_EXPORT extern void bn_noise_turb_n(double *out,
+				      const point_t *pts,
+				      size_t n,
+				      double h_val,
+				      double lacunarity,
+				      double octaves);
+
 /**
  * From "Texturing and Modeling, A Procedural Approach" 2nd ed
  */
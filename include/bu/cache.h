@@ -64,7 +64,12 @@ BU_EXPORT void bu_cache_erase(const char *cache_db);
 
 /**
  * Retrieve data (read-only) from the cache using the specified key.  User
- * should call bu_cache_get_done once their use of data is complete.
+ * should call bu_cache_get_done once their use of data is complete, whether
+ * or not the key was found.
+ *
+ * Any number of threads may read from the same cache at once.  The data
+ * remains valid until the matching bu_cache_get_done call, even if the key
+ * is overwritten or cleared in the meantime.
  *
  * Returns the size of the retrieved data.
  */
@@ -77,9 +82,22 @@ BU_EXPORT size_t bu_cache_get(void **data, const char *key, struct bu_cache *c);
 BU_EXPORT void bu_cache_get_done(const char *key, struct bu_cache *c);
 
 /**
- * Assign data to the cache using the specified key
+ * Assign dsize bytes of data to the cache using the specified key.  The data
+ * is copied, so the caller's buffer may be reused once this returns.
+ *
+ * Writes are committed to disk in batches - they are visible to later
+ * bu_cache_get calls, but are only guaranteed to be on disk once the cache is
+ * closed.  The one exception is a thread that is still holding data from an
+ * earlier bu_cache_get on the same part of the cache: its lookups keep
+ * seeing the cache as it was when that get began, so that the data it holds
+ * stays valid.  Once all of the thread's outstanding gets are matched by
+ * bu_cache_get_done calls, its next lookup sees everything written so far.
+ *
+ * Returns dsize on success, 0 on failure.  A batch that cannot be committed
+ * (most likely because the cache is full) is dropped, and the keys in it read
+ * as missing afterwards; the write whose call committed it returns 0.
  */
-BU_EXPORT size_t bu_cache_write(void **data, const char *key, struct bu_cache *c);
+BU_EXPORT size_t bu_cache_write(void *data, size_t dsize, const char *key, struct bu_cache *c);
 
 /**
  * Clear data associated with the specified key from the cache
@@ -144,12 +144,15 @@ BU_EXPORT extern size_t bu_malloc_len_roundup(size_t nbytes);
 
 /**
  * really fast heap-based memory allocation intended for "small"
- * allocation sizes (e.g., single structs).
+ * allocation sizes (e.g., single structs).  memory is returned
+ * zero-initialized.
  *
  * the implementation allocates chunks of memory ('pages') in order to
- * substantially reduce calls to system malloc.  it has a nice
- * property of having O(1) constant time complexity and profiles
- * significantly faster than system malloc().
+ * substantially reduce calls to system malloc, and keeps released
+ * memory in per-thread free lists by size class for reuse.  it has a
+ * nice property of having O(1) constant time complexity, needs no
+ * locking in the common case, and profiles significantly faster than
+ * system malloc().
  *
  * release memory with bu_heap_put() only.
  */
@@ -157,14 +160,24 @@ BU_EXPORT extern void *bu_heap_get(size_t sz);
 
 /**
  * counterpart to bu_heap_get() for releasing fast heap-based memory
- * allocations.
+ * allocations.  sz must be the size that was requested from
+ * bu_heap_get().  memory may be released by a different thread than
+ * the one that allocated it.
  *
- * the implementation may do nothing, relying on free-on-exit, or may
- * mark deallocations for reuse.  pass a NULL pointer and zero size to
- * force compaction of any unused memory.
+ * released memory is kept for reuse rather than returned to the
+ * system.  pass a NULL pointer and zero size to hand the calling
+ * thread's unused memory over to the other threads.
  */
 BU_EXPORT extern void bu_heap_put(void *ptr, size_t sz);
 
+/**
+ * hand all memory released by thread cpu (as numbered by
+ * bu_parallel_id()) and not yet reused over to the other threads, e.g.
+ * when that thread's work is done.  must not be called while thread
+ * cpu may be allocating or releasing heap memory.
+ */
+BU_EXPORT extern void bu_heap_flush(int cpu);
+
 /**
  * Convenience typedef for the printf()-style callback function used
  * during application exit to print summary statistics.
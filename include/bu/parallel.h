@@ -145,6 +145,10 @@ BU_EXPORT extern size_t bu_avail_cpus(void);
  * This function will not return control until all invocations of the
  * subroutine are finished.
  *
+ * Threads are kept in a pool between calls rather than created anew
+ * each time, so calling bu_parallel() repeatedly is cheap.  Pooled
+ * threads exit after sitting idle for half a minute.
+ *
  * In following is a working stand-alone example demonstrating how to
  * call the bu_parallel() interface.
  *
@@ -184,6 +188,73 @@ BU_EXPORT extern size_t bu_avail_cpus(void);
 BU_EXPORT extern void bu_parallel(void (*func)(int func_cpu_id, void *func_data), size_t ncpu, void *data);
 
 
+/**
+ * @brief
+ * task based parallelism
+ *
+ * Where bu_parallel() hands a function its own thread for every
+ * requested cpu, tasks are queued and run by a fixed set of threads
+ * kept by libbu, one less than the number of available cpus.  A
+ * thread waiting on a task runs queued tasks itself in the meantime,
+ * so tasks may submit and wait on further tasks (or call
+ * bu_parallel_for()) at any depth without running more threads than
+ * there are cpus.
+ *
+ * Tasks must not wait on each other by any other means than
+ * bu_task_wait(), since a task is not guaranteed to start until some
+ * thread is free to run it.  Shared data has to be protected as with
+ * bu_parallel().  Within a task, bu_parallel_id() returns an ID that
+ * is unique among the running threads, suitable for indexing per-cpu
+ * buffers, but different tasks see different IDs.
+ *
+ * @code
+ * struct sum { const double *v; size_t n; double total; };
+ *
+ * void sum_task(void *d) {
+ *   struct sum *s = (struct sum *)d;
+ *   size_t i;
+ *   for (i = 0; i < s->n; i++)
+ *     s->total += s->v[i];
+ * }
+ *
+ * double sum_halves(const double *v, size_t n) {
+ *   struct sum lo = {v, n/2, 0.0};
+ *   struct sum hi = {v + n/2, n - n/2, 0.0};
+ *   struct bu_task *t = bu_task_submit(sum_task, &lo);
+ *   sum_task(&hi);
+ *   bu_task_wait(t);
+ *   return lo.total + hi.total;
+ * }
+ * @endcode
+ */
+struct bu_task;
+
+/**
+ * Queue func(data) to be run by a task thread, returning a handle that
+ * has to be passed to bu_task_wait() exactly once.  Results are handed
+ * back through data.  Returns NULL if func is NULL.
+ */
+BU_EXPORT extern struct bu_task *bu_task_submit(void (*func)(void *data), void *data);
+
+/**
+ * Return once the task has finished, running other queued tasks while
+ * waiting.  The handle is released and may not be used again.  NULL
+ * is ignored.
+ */
+BU_EXPORT extern void bu_task_wait(struct bu_task *task);
+
+/**
+ * Call func(first, last, data) over chunks [first, last) of the range
+ * [begin, end), each at most grain long, in parallel using the task
+ * threads and the calling thread.  A grain of zero picks a size giving
+ * each thread a few chunks.  Returns once every chunk is done.
+ *
+ * Chunks are handed out in order as threads become free, so grain
+ * trades the cost of a call against how evenly uneven work is spread.
+ */
+BU_EXPORT extern void bu_parallel_for(size_t begin, size_t end, size_t grain, void (*func)(size_t first, size_t last, void *data), void *data);
+
+
 /**
  * @brief
  * semaphore implementation
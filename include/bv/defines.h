@@ -187,6 +187,7 @@ struct bview;
 #define BV_CHILD_OBJS 0x08
 
 struct bv_scene_obj_internal;
+struct bv_vlist_packed;
 
 struct bv_scene_obj  {
     struct bu_list l;
@@ -224,6 +225,7 @@ struct bv_scene_obj  {
     int s_dlist_mode;		/**< @brief  drawing mode in which display list was generated (if it doesn't match s_os.s_dmode, dlist is out of date.) */
     int s_dlist_stale;		/**< @brief  set by client codes when dlist is out of date - dm must update. */
     void (*s_dlist_free_callback)(struct bv_scene_obj *);  /**< @brief free any dlist specific data */
+    struct bv_vlist_packed *s_vpacked;	/**< @brief  packed copy of s_vlist for vertex array drawing - dropped by bv_obj_stale(), as s_dlist is marked stale */
 
     /* 3D geometry metadata */
     fastf_t s_size;		/**< @brief  Distance across solid, in model space */
@@ -114,6 +114,30 @@ bv_mesh_lod_clear_cache(struct bv_mesh_lod_context *c, unsigned long long key);
 BV_EXPORT unsigned long long
 bv_mesh_lod_cache(struct bv_mesh_lod_context *c, const point_t *v, size_t vcnt, const vect_t *vn, int *f, size_t fcnt, unsigned long long user_key, fastf_t fratio);
 
+/**
+ * Input and output for one mesh of a bv_mesh_lod_cache_batch() call.  The
+ * fields mirror the bv_mesh_lod_cache() arguments - key is set to the lookup
+ * key for the mesh (0 on failure) once the batch completes.
+ */
+struct bv_mesh_lod_cache_input {
+    const point_t *v;
+    size_t vcnt;
+    const vect_t *vn;
+    int *f;
+    size_t fcnt;
+    unsigned long long user_key;
+    fastf_t fratio;
+    unsigned long long key;
+};
+
+/**
+ * Run bv_mesh_lod_cache() for cnt meshes, generating the LoD data for up to
+ * ncpu meshes concurrently (ncpu == 0 uses all available processors).  The
+ * mesh data must remain valid and unmodified until the call returns.
+ */
+BV_EXPORT void
+bv_mesh_lod_cache_batch(struct bv_mesh_lod_context *c, struct bv_mesh_lod_cache_input *in, size_t cnt, size_t ncpu);
+
 
 /**
  * Given a name, see if the context has a key associated with that name.
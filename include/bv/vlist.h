@@ -182,6 +182,48 @@ BV_EXPORT extern size_t bv_vlist_cmd_cnt(struct bv_vlist *vlist);
 BV_EXPORT extern int bv_vlist_bbox(struct bu_list *vlistp, point_t *bmin, point_t *bmax, size_t *length, int *dispmode);
 
 
+/**
+ * Single precision, indexed copy of a vlist for drawing with vertex
+ * arrays.  Each distinct vertex (position and normal) is stored once
+ * and lines, surfaces and points refer to it by index, so wireframes
+ * that revisit their vertices take a fraction of the vlist's memory.
+ *
+ * Polygons are split into triangle fans.  A vlist that changes
+ * matrices, line widths or point sizes is not packed: its copy has no
+ * vertices, which tells callers to keep drawing the vlist itself.
+ */
+struct bv_vlist_packed {
+    size_t vlen;			/**< @brief vlist commands the copy was made from */
+    size_t nverts;			/**< @brief distinct vertices */
+    float *verts;			/**< @brief x, y, z of each vertex */
+    float *norms;			/**< @brief normal of each vertex, NULL without surfaces */
+    size_t nlines;			/**< @brief line segments */
+    unsigned int *lines;		/**< @brief vertex pairs of the segments */
+    size_t ntris;			/**< @brief surface triangles */
+    unsigned int *tris;			/**< @brief vertex triples of the triangles */
+    size_t npoints;			/**< @brief single points */
+    unsigned int *points;		/**< @brief vertex of each point */
+};
+
+/**
+ * Pack the vlist chain vhead.  Free the result with
+ * bv_vlist_packed_free().
+ *
+ * Nothing ties the copy to vhead afterwards; like a display list, it
+ * is up to the owner to drop it when the vlist changes (scene objects
+ * do so in bv_obj_stale()).
+ */
+BV_EXPORT extern struct bv_vlist_packed *bv_vlist_pack(const struct bu_list *vhead);
+
+BV_EXPORT extern void bv_vlist_packed_free(struct bv_vlist_packed *p);
+
+/**
+ * Bytes of memory held by p, for comparison with the sizeof(struct
+ * bv_vlist) of each chunk of the vlist it came from.
+ */
+BV_EXPORT extern size_t bv_vlist_packed_size(const struct bv_vlist_packed *p);
+
+
 
 /**
  * For plotting, a way of separating plots into separate color vlists:
@@ -410,6 +410,7 @@ class GED_EXPORT DbiState {
 
 	void populate_maps(struct directory *dp, unsigned long long phash, int reset);
 	unsigned long long update_dp(struct directory *dp, int reset);
+	void update_bboxes(std::unordered_set<struct directory *> &dps);
 	unsigned int color_int(struct bu_color *);
 	int int_color(struct bu_color *c, unsigned int);
 	struct resource *res = NULL;
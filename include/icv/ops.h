@@ -28,6 +28,7 @@
 
 #include "common.h"
 #include <stddef.h> /* for size_t */
+#include <stdio.h> /* for FILE */
 #include "vmath.h"
 #include "bu/vls.h"
 #include "icv/defines.h"
@@ -199,6 +200,51 @@ ICV_EXPORT extern int icv_rot(size_t argc, const char *argv[]);
  */
 ICV_EXPORT extern int icv_diff(int *matching, int *off_by_1, int *off_by_many, icv_image_t *img1, icv_image_t *img2);
 
+/**
+ * Pixel difference tallies reported by icv_diff_tiled and
+ * icv_diff_stream.  A pixel is off by 1 when exactly one of its
+ * channels differs and off by many otherwise.  Pixels present in only
+ * one of the inputs are counted as missing.  max_delta is the largest
+ * absolute channel difference seen, on the 0-255 scale.
+ */
+struct icv_diff_stats {
+    size_t matching;
+    size_t off_by_1;
+    size_t off_by_many;
+    size_t missing;
+    int max_delta;
+};
+
+/**
+ * Compare two equally sized RGB images in bands of scanlines spread
+ * across ncpu threads (0 uses all available cpus).  Unlike icv_diff,
+ * no 8-bit copies of the full images are made.
+ *
+ * If threshold is non-zero the comparison stops early once more than
+ * threshold pixels are off by many.
+ *
+ * Returns 0 if the images match, 1 if they differ, 2 if the threshold
+ * was exceeded and -1 on error.
+ */
+ICV_EXPORT extern int icv_diff_tiled(struct icv_diff_stats *stats, icv_image_t *img1, icv_image_t *img2, size_t threshold, size_t ncpu);
+
+/**
+ * Compare two PIX streams of the given width without reading either
+ * image into memory.  Input is consumed a band of scanlines at a time,
+ * so memory use is independent of image size, and each band is
+ * compared across ncpu threads (0 uses all available cpus).
+ *
+ * If threshold is non-zero the comparison stops early once more than
+ * threshold pixels are off by many.  If heatmap is non-NULL, a PIX
+ * image of the compared pixels is written to it: matching pixels are
+ * dimmed grayscale and differing pixels shade from yellow to red with
+ * increasing channel delta.
+ *
+ * Returns 0 if the streams match, 1 if they differ, 2 if the threshold
+ * was exceeded and -1 on error.
+ */
+ICV_EXPORT extern int icv_diff_stream(struct icv_diff_stats *stats, FILE *f1, FILE *f2, size_t width, size_t threshold, FILE *heatmap, size_t ncpu);
+
 /**
  * Generate a visual representation of the differences between two images.
  * (At least for now, images must be the same size.)
@@ -95,10 +95,13 @@
                                  */
 
 /**
- * storage allocation/deallocation support
+ * storage allocation/deallocation support.  NMG structures are small and
+ * are made and killed in large numbers, so they come from the bu_heap
+ * small-object allocator (zeroed, like bu_calloc).  Structures obtained
+ * with NMG_GETSTRUCT must be released with NMG_FREESTRUCT, never bu_free.
  */
-#define NMG_GETSTRUCT(p, str) p = (struct str *)bu_calloc(1, sizeof(struct str), "NMG_GETSTRUCT")
-#define NMG_FREESTRUCT(p, str) bu_free(p, "NMG_FREESTRUCT")
+#define NMG_GETSTRUCT(p, str) p = (struct str *)bu_heap_get(sizeof(struct str))
+#define NMG_FREESTRUCT(p, str) bu_heap_put(p, sizeof(struct str))
 #define NMG_ALLOC(_ptr, _type) _ptr = (_type *)bu_calloc(1, sizeof(_type), #_type " (NMG_ALLOC) " CPP_FILELINE)
 
 /**
@@ -41,12 +41,14 @@ __BEGIN_DECLS
 
 #define GET_EDGE(p, m)              {NMG_GETSTRUCT(p, edge); NMG_INCR_INDEX(p, m);}
 #define GET_EDGE_G_LSEG(p, m)       {NMG_GETSTRUCT(p, edge_g_lseg); NMG_INCR_INDEX(p, m);}
-#define GET_EDGE_G_CNURB(p, m)      {NMG_GETSTRUCT(p, edge_g_cnurb); NMG_INCR_INDEX(p, m);}
+/* cnurbs are also made by GET_CNURB and freed by nmg_nurb_free_cnurb, so
+ * they stay on bu_calloc rather than the NMG_GETSTRUCT heap */
+#define GET_EDGE_G_CNURB(p, m)      {BU_ALLOC(p, struct edge_g_cnurb); NMG_INCR_INDEX(p, m);}
 #define GET_EDGEUSE(p, m)           {NMG_GETSTRUCT(p, edgeuse); NMG_INCR_INDEX(p, m);}
 
 #define FREE_EDGE(p)              NMG_FREESTRUCT(p, edge)
 #define FREE_EDGE_G_LSEG(p)       NMG_FREESTRUCT(p, edge_g_lseg)
-#define FREE_EDGE_G_CNURB(p)      NMG_FREESTRUCT(p, edge_g_cnurb)
+#define FREE_EDGE_G_CNURB(p)      bu_free(p, "FREE_EDGE_G_CNURB")
 #define FREE_EDGEUSE(p)           NMG_FREESTRUCT(p, edgeuse)
 
 /**
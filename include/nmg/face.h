@@ -89,12 +89,14 @@ __BEGIN_DECLS
 
 #define GET_FACE(p, m)              {NMG_GETSTRUCT(p, face); NMG_INCR_INDEX(p, m);}
 #define GET_FACE_G_PLANE(p, m)      {NMG_GETSTRUCT(p, face_g_plane); NMG_INCR_INDEX(p, m);}
-#define GET_FACE_G_SNURB(p, m)      {NMG_GETSTRUCT(p, face_g_snurb); NMG_INCR_INDEX(p, m);}
+/* snurbs are also made by GET_SNURB and freed by nmg_nurb_free_snurb, so
+ * they stay on bu_calloc rather than the NMG_GETSTRUCT heap */
+#define GET_FACE_G_SNURB(p, m)      {BU_ALLOC(p, struct face_g_snurb); NMG_INCR_INDEX(p, m);}
 #define GET_FACEUSE(p, m)           {NMG_GETSTRUCT(p, faceuse); NMG_INCR_INDEX(p, m);}
 
 #define FREE_FACE(p)              NMG_FREESTRUCT(p, face)
 #define FREE_FACE_G_PLANE(p)      NMG_FREESTRUCT(p, face_g_plane)
-#define FREE_FACE_G_SNURB(p)      NMG_FREESTRUCT(p, face_g_snurb)
+#define FREE_FACE_G_SNURB(p)      bu_free(p, "FREE_FACE_G_SNURB")
 #define FREE_FACEUSE(p)           NMG_FREESTRUCT(p, faceuse)
 
 NMG_EXPORT extern void nmg_face_g(struct faceuse *fu,
@@ -47,6 +47,25 @@ __BEGIN_DECLS
 NMG_EXPORT extern void nmg_shell_a(struct shell *s,
                                    const struct bn_tol *tol);
 
+/* From file bvh.c */
+/**
+ * @brief Build (or reuse) the bounding volume hierarchy over the face
+ * bounding boxes of shell s, which ray intersection and point
+ * classification use to skip faces a ray can't reach.  Shells with
+ * only a few faces don't get one.
+ *
+ * The hierarchy is discarded whenever faces are added to, removed
+ * from or moved between shells, or their bounding boxes recomputed.
+ * Callers intersecting from several threads should build it before
+ * starting, since it is only ever rebuilt by a classifying ray.
+ */
+NMG_EXPORT extern void nmg_shell_bvh(struct shell *s);
+
+/**
+ * @brief Release the face hierarchy of shell s, if it has one.
+ */
+NMG_EXPORT extern void nmg_shell_bvh_free(struct shell *s);
+
 /* From file nmg_mk.c */
 /*      MAKE routines */
 NMG_EXPORT extern struct loopuse *nmg_ml(struct shell *s);
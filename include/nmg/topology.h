@@ -268,6 +268,7 @@ struct shell {
     struct bu_list eu_hd;       /**< @brief wire list (shell has wires) */
     struct vertexuse *vu_p;     /**< @brief internal ptr to single vertexuse */
     long index;                 /**< @brief struct # in this model */
+    struct nmg_shell_bvh *bvh;  /**< @brief cached faceuse hierarchy, see nmg_shell_bvh() */
 };
 
 /**
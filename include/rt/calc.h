@@ -207,6 +207,38 @@ RT_EXPORT extern int rt_poly_roots(bn_poly_t *eqn,
 				   bn_complex_t roots[],
 				   const char *name);
 
+/**
+ * Find only the real roots of a polynomial, which is what ray/surface
+ * intersection wants.  Quartics are solved in closed form without
+ * forming the complex roots, and each real root is verified (and
+ * Newton-polished if need be) against a residual scaled to the
+ * coefficients; anything that fails, or is of another degree, is
+ * handed to rt_poly_roots().  A root is taken as real if its
+ * imaginary part is within imag_tol of zero.
+ *
+ * Unlike rt_poly_roots(), the input polynomial is not modified.
+ *
+ * Returns the number of real roots stored in roots[] (which must hold
+ * BN_MAX_POLY_DEGREE values), or -1 if the general solver did not
+ * converge.
+ */
+RT_EXPORT extern int rt_poly_real_roots(const bn_poly_t *eqn,
+					fastf_t roots[],
+					fastf_t imag_tol,
+					const char *name);
+
+/**
+ * rt_poly_real_roots() over n polynomials, as used by the vectorized
+ * shot routines.  The roots of eqns[i] are stored starting at
+ * roots[i*BN_MAX_POLY_DEGREE] and their count in nroots[i].
+ */
+RT_EXPORT extern void rt_poly_real_roots_n(int nroots[],
+					   fastf_t roots[],
+					   const bn_poly_t eqns[],
+					   size_t n,
+					   fastf_t imag_tol,
+					   const char *name);
+
 /** @} */
 
 
@@ -49,32 +49,50 @@ struct rt_g {
  */
 RT_EXPORT extern struct rt_g RTG;
 
+/**
+ * Return the bv_vlist freelist the calling thread's plotting should
+ * use: &RTG.rtg_vlfree, unless the thread has set its own with
+ * rt_vlfree_set().
+ */
+RT_EXPORT extern struct bu_list *rt_vlfree(void);
+
+/**
+ * Have the calling thread use vlfree in place of &RTG.rtg_vlfree, or
+ * go back to &RTG.rtg_vlfree if vlfree is NULL.  Returns the previous
+ * setting, for restoring.  A list set this way must be initialized,
+ * and the vlists left on it are the caller's to move elsewhere or
+ * free once the thread is done.
+ */
+RT_EXPORT extern struct bu_list *rt_vlfree_set(struct bu_list *vlfree);
+
 /**
  * Applications that are going to use RT_ADD_VLIST and RT_GET_VLIST
  * are required to execute this macro once, first:
  *
  * BU_LIST_INIT(&RTG.rtg_vlfree);
  *
- * Note that RT_GET_VLIST and RT_FREE_VLIST are non-PARALLEL.
+ * Note that RT_GET_VLIST and RT_FREE_VLIST are non-PARALLEL - threads
+ * plotting at the same time each need their own freelist, see
+ * rt_vlfree_set().
  */
-#define RT_GET_VLIST(p) BV_GET_VLIST(&RTG.rtg_vlfree, p)
+#define RT_GET_VLIST(p) BV_GET_VLIST(rt_vlfree(), p)
 
 /** Place an entire chain of bv_vlist structs on the freelist */
-#define RT_FREE_VLIST(hd) BV_FREE_VLIST(&RTG.rtg_vlfree, hd)
+#define RT_FREE_VLIST(hd) BV_FREE_VLIST(rt_vlfree(), hd)
 
-#define RT_ADD_VLIST(hd, pnt, draw) BV_ADD_VLIST(&RTG.rtg_vlfree, hd, pnt, draw)
+#define RT_ADD_VLIST(hd, pnt, draw) BV_ADD_VLIST(rt_vlfree(), hd, pnt, draw)
 
 /** set the transformation matrix to display matrix */
-#define RT_VLIST_SET_DISP_MAT(_dest_hd, _ref_pt) BV_VLIST_SET_DISP_MAT(&RTG.rtg_vlfree, _dest_hd, _ref_pt)
+#define RT_VLIST_SET_DISP_MAT(_dest_hd, _ref_pt) BV_VLIST_SET_DISP_MAT(rt_vlfree(), _dest_hd, _ref_pt)
 
 /** set the transformation matrix to model matrix */
-#define RT_VLIST_SET_MODEL_MAT(_dest_hd) BV_VLIST_SET_MODEL_MAT(&RTG.rtg_vlfree, _dest_hd)
+#define RT_VLIST_SET_MODEL_MAT(_dest_hd) BV_VLIST_SET_MODEL_MAT(rt_vlfree(), _dest_hd)
 
 /** Set a point size to apply to the vlist elements that follow. */
-#define RT_VLIST_SET_POINT_SIZE(hd, size) BV_VLIST_SET_POINT_SIZE(&RTG.rtg_vlfree, hd, size)
+#define RT_VLIST_SET_POINT_SIZE(hd, size) BV_VLIST_SET_POINT_SIZE(rt_vlfree(), hd, size)
 
 /** Set a line width to apply to the vlist elements that follow. */
-#define RT_VLIST_SET_LINE_WIDTH(hd, width) BV_VLIST_SET_LINE_WIDTH(&RTG.rtg_vlfree, hd, width)
+#define RT_VLIST_SET_LINE_WIDTH(hd, width) BV_VLIST_SET_LINE_WIDTH(rt_vlfree(), hd, width)
 
 
 __END_DECLS
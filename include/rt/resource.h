@@ -119,6 +119,7 @@ RT_EXPORT extern struct resource rt_uniresource;        /**< @brief  default.  D
 RT_EXPORT extern int RT_SEM_WORKER;
 RT_EXPORT extern int RT_SEM_MODEL;
 RT_EXPORT extern int RT_SEM_RESULTS;
+/* No longer used by LIBRT, whose soltab lists now have striped locks */
 RT_EXPORT extern int RT_SEM_TREE0;
 RT_EXPORT extern int RT_SEM_TREE1;
 RT_EXPORT extern int RT_SEM_TREE2;
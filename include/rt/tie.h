@@ -56,6 +56,8 @@ __BEGIN_DECLS
 
 #define TIE_KDTREE_FAST		0x0
 #define TIE_KDTREE_OPTIMAL	0x1
+#define TIE_KDTREE_SAH		0x2	/* binned surface area heuristic */
+#define TIE_KDTREE_SAH_CLIP	0x3	/* SAH costing triangles clipped to each node */
 
 /* Type to use for floating precision */
 #if TIE_PRECISION == 0
@@ -118,8 +120,8 @@ struct tie_s {
     unsigned int tri_num;
     unsigned int tri_num_alloc;
     struct tie_tri_s *tri_list;
-    int stat;			/* used for testing various statistics */
-    unsigned int kdmethod;	/* Optimal or Fast */
+    int stat;			/* triangle references in the kd-tree leaves after prep */
+    unsigned int kdmethod;	/* TIE_KDTREE_* */
     point_t min, max;
     vect_t amin, amax, mid;
     fastf_t radius;
@@ -543,6 +543,12 @@ RT_EXPORT extern int db_tally_subtree_regions(union tree        *tp,
  * serial code only.  When called from within an existing thread, ncpu
  * must be 1.
  *
+ * If ncpu is not 1, the assemblies above the regions are also read in
+ * parallel, by libbu task threads (see bu_task_submit()), and regions
+ * are handed to the ncpu walking threads in batches.  reg_start_func
+ * is still only called by one thread at a time, but not in database
+ * order.
+ *
  * If ncpu > 1, the caller is responsible for making sure that
  * RTG.rtg_parallel is non-zero.
  *
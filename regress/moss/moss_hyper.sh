@@ -0,0 +1,166 @@
+#!/bin/sh
+#                   M O S S _ H Y P E R . S H
+# BRL-CAD
+#
+# Copyright (c) 2010-2024 United States Government as represented by
+# the U.S. Army Research Laboratory.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+# 1. Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above
+# copyright notice, this list of conditions and the following
+# disclaimer in the documentation and/or other materials provided
+# with the distribution.
+#
+# 3. The name of the author may not be used to endorse or promote
+# products derived from this software without specific prior written
+# permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+# GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+# WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+# NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+###
+
+# Ensure /bin/sh
+export PATH || (echo "This isn't sh."; sh $0 $*; kill $$)
+
+# source common library functionality, setting ARGS, NAME_OF_THIS,
+# PATH_TO_THIS, and THIS.
+. "$1/regress/library.sh"
+
+# Tests should use a local cache
+BU_DIR_CACHE="`pwd`/cache_hyper"
+rm -rf $BU_DIR_CACHE && mkdir $BU_DIR_CACHE
+export BU_DIR_CACHE
+LIBRT_CACHE="`pwd`/rtcache_hyper"
+rm -rf $LIBRT_CACHE && mkdir $LIBRT_CACHE
+export LIBRT_CACHE
+
+if test "x$LOGFILE" = "x" ; then
+    LOGFILE=`pwd`/moss_hyper.log
+    rm -f $LOGFILE
+fi
+log "=== TESTING adaptive against full hypersampling ==="
+
+RT="`ensearch rt`"
+if test ! -f "$RT" ; then
+    log "Unable to find rt, aborting"
+    exit 1
+fi
+A2G="`ensearch asc2g`"
+if test ! -f "$A2G" ; then
+    log "Unable to find asc2g, aborting"
+    exit 1
+fi
+PIXCMP="`ensearch pixcmp`"
+if test ! -f "$PIXCMP" ; then
+    log "Unable to find pixcmp, aborting"
+    exit 1
+fi
+
+SIZE=256
+# pixels the adaptive image may have off by many: 1%
+LIMIT=`expr $SIZE \* $SIZE / 100`
+
+rm -f moss_hyper.g
+run $A2G "$1/db/moss.asc" moss_hyper.g
+
+# render pixfile [rt options]
+#
+# renders moss from the view moss.sh uses, with 8 extra samples per
+# pixel, leaving rt's output in pixfile.log
+render ( ) {
+    out="$1"
+    shift
+    rm -f "$out" "$out.log"
+    $RT -P 1 -B -C0/0/50 -M -s $SIZE -H 8 "$@" -o "$out" moss_hyper.g all.g > "$out.log" 2>&1 << EOF
+viewsize 1.572026215e+02;
+eye_pt 6.379990387e+01 3.271768951e+01 3.366661453e+01;
+viewrot -5.735764503e-01 8.191520572e-01 0.000000000e+00
+0.000000000e+00 -3.461886346e-01 -2.424038798e-01 9.063078165e-01
+0.000000000e+00 7.424039245e-01 5.198368430e-01 4.226182699e-01
+0.000000000e+00 0.000000000e+00 0.000000000e+00 0.000000000e+00
+1.000000000e+00 ;
+start 0;
+end;
+EOF
+    cat "$out.log" >> "$LOGFILE"
+}
+
+log "... rendering moss with full hypersampling"
+render moss_hyper_full.pix
+log "... rendering moss with adaptive hypersampling"
+render moss_hyper_adapt.pix -c "set hyperAdapt=0.05"
+
+if [ ! -f moss_hyper_full.pix ] || [ ! -f moss_hyper_adapt.pix ] ; then
+    log "raytrace failed to create moss_hyper_full.pix and moss_hyper_adapt.pix"
+    NUMBER_WRONG=-1
+else
+    # rays shot and wallclock seconds of each render
+    FULL_RAYS=`awk '/rays.*wallclock/ {print $3}' moss_hyper_full.pix.log`
+    FULL_TIME=`awk '/rays.*wallclock/ {print $6}' moss_hyper_full.pix.log`
+    ADAPT_RAYS=`awk '/rays.*wallclock/ {print $3}' moss_hyper_adapt.pix.log`
+    ADAPT_TIME=`awk '/rays.*wallclock/ {print $6}' moss_hyper_adapt.pix.log`
+    log "full hypersampling:     $FULL_RAYS rays in $FULL_TIME sec"
+    log "adaptive hypersampling: $ADAPT_RAYS rays in $ADAPT_TIME sec"
+    log "`grep 'pixels hypersampled' moss_hyper_adapt.pix.log`"
+
+    log "... running $PIXCMP moss_hyper_full.pix moss_hyper_adapt.pix"
+    summary="`$PIXCMP moss_hyper_full.pix moss_hyper_adapt.pix 2>> "$LOGFILE" | tail -n1`"
+    log "$summary"
+    NUMBER_WRONG=`echo "$summary" | tr , '\012' | awk '/many/ {print $1}'`
+
+    if test "x$NUMBER_WRONG" = "x" ; then
+	log "pixcmp did not report a comparison"
+	NUMBER_WRONG=-1
+    elif test $NUMBER_WRONG -le $LIMIT ; then
+	NUMBER_WRONG=0
+    else
+	log "$NUMBER_WRONG pixels off by many, $LIMIT allowed"
+	NUMBER_WRONG=1
+    fi
+    if test "x$FULL_RAYS" = "x" || test "x$ADAPT_RAYS" = "x" ; then
+	log "rt did not report its ray counts"
+	NUMBER_WRONG=-1
+    elif test $ADAPT_RAYS -ge $FULL_RAYS ; then
+	log "adaptive hypersampling did not shoot fewer rays"
+	NUMBER_WRONG=-1
+    fi
+fi
+
+
+if [ X$NUMBER_WRONG = X0 ] ; then
+    log "-> moss_hyper.sh succeeded"
+else
+    log "-> moss_hyper.sh FAILED, see $LOGFILE"
+    cat "$LOGFILE"
+fi
+
+# Cleanup
+rm -rf "$BU_DIR_CACHE"
+rm -rf "$LIBRT_CACHE"
+
+exit $NUMBER_WRONG
+
+# Local Variables:
+# mode: sh
+# tab-width: 8
+# sh-indentation: 4
+# sh-basic-offset: 4
+# indent-tabs-mode: t
+# End:
+# ex: shiftwidth=4 tabstop=8
@@ -575,6 +575,30 @@ EOF
 run cmp nirt.ref nirt.out
 STATUS=$?
 
+# The batch command must report exactly what the same shots would
+# report one at a time, in the same order.  Use enough rays that
+# several processors get a share.
+log "*** Test 12 - batch shotlines vs. serial shots ***"
+rm -f nirt_batch.rays nirt_batch.out nirt_serial.out
+awk 'BEGIN {
+    print "# x y z dx dy dz"
+    for (i = 0; i < 64; i++) {
+	y = (i % 8) * 0.3 - 1.2
+	z = int(i / 8) * 0.3 - 1.2
+	if (i % 3 == 0) {
+	    printf "5 %g %g -1 0 0\n", y, z
+	} else if (i % 3 == 1) {
+	    printf "%g 5 %g 0 -1 0\n", y * 2, z
+	} else {
+	    printf "-5 %g %g 1 0.2 0.1\n", y, z
+	}
+    }
+}' > nirt_batch.rays
+SERIAL_CMDS="`grep -v '^#' nirt_batch.rays | awk '{printf "xyz %s %s %s;dir %s %s %s;s;", $1, $2, $3, $4, $5, $6}'`"
+$NIRT -H 0 -e "${SERIAL_CMDS}q" nirt.g left_cube.r center_cube.r right_cube.r > nirt_serial.out 2>&1
+$NIRT -H 0 -e "batch -P 4 nirt_batch.rays;q" nirt.g left_cube.r center_cube.r right_cube.r > nirt_batch.out 2>&1
+run cmp nirt_serial.out nirt_batch.out
+
 if [ X$STATUS = X0 ] ; then
     log "-> nirt.sh succeeded"
 else
@@ -55,6 +55,7 @@ struct isst_s {
     struct tie_s *tie;
     struct render_camera_s camera;
     struct camera_tile_s tile;
+    struct render_camera_progress_s progress;
     struct adrt_mesh_s *meshes;
     tienet_buffer_t buffer_image;
     int ogl, sflags, w, h, gs, ui;
@@ -229,11 +230,18 @@ paint_window(ClientData UNUSED(clientData), Tcl_Interp *interp, int objc, Tcl_Ob
 
     dt = isst->t2 - isst->t1;
 
+    /* a changed view starts over with a coarse pass, a still one is
+     * refined a pass per call until every pixel has its own ray */
     if (dt > 1e6*0.08 && isst->dirty) {
+	render_camera_progress_restart(&isst->progress);
+	isst->dirty = 0;
+    }
+
+    if (!RENDER_CAMERA_PROGRESS_DONE(&isst->progress)) {
 	isst->buffer_image.ind = 0;
 
 	render_camera_prep(&isst->camera);
-	render_camera_render(&isst->camera, isst->tie, &isst->tile, &isst->buffer_image);
+	render_camera_render_progressive(&isst->camera, isst->tie, &isst->tile, &isst->buffer_image, &isst->progress);
 
 	isst->t1 = bu_gettime();
 
@@ -254,8 +262,6 @@ paint_window(ClientData UNUSED(clientData), Tcl_Interp *interp, int objc, Tcl_Ob
 
 	glEnd();
 
-	isst->dirty = 0;
-
 	dm_draw_end(dmp);
     }
     return TCL_OK;
@@ -297,6 +303,7 @@ isst_init(ClientData UNUSED(clientData), Tcl_Interp *interp, int UNUSED(objc), T
     BU_ALLOC(isst->tie, struct tie_s);
     TIENET_BUFFER_INIT(isst->buffer_image);
     render_camera_init(&isst->camera, bu_avail_cpus());
+    render_camera_progress_init(&isst->progress);
 
     isst->camera.type = RENDER_CAMERA_PERSPECTIVE;
     isst->camera.fov = 25;
@@ -319,6 +326,11 @@ isst_zap(ClientData UNUSED(clientData), Tcl_Interp *interp, int objc, Tcl_Obj *c
 	return TCL_ERROR;
     }
 
+    if (isst->progress.frames)
+	bu_log("%u interactive frames, first pass %.1fms on average and %.1fms at worst\n",
+	       isst->progress.frames, isst->progress.latency_sum / (1.0e3 * isst->progress.frames),
+	       isst->progress.latency_max / 1.0e3);
+
     bu_free(isst, "isst free");
     isst = NULL;
 
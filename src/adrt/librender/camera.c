@@ -30,6 +30,7 @@
 #include "bu/parallel.h"
 #include "bu/log.h"
 #include "bu/str.h"
+#include "bu/time.h"
 
 #include "./camera.h"
 
@@ -391,25 +392,110 @@ render_camera_prep(render_camera_t *camera)
 }
 
 
-void
-render_camera_render_thread(int UNUSED(cpu), void *ptr)
+/* Shade the ray through pixel (x, y) of the camera's image */
+static void
+render_camera_shoot(render_camera_t *camera, struct tie_s *tie, int x, int y, vect_t pixel)
 {
-    render_camera_thread_data_t *td;
-    int d, n, res_ind, scanline, v_scanline;
-    vect_t pixel, accum;
-    vect_t v1 = VINIT_ZERO;
-    vect_t v2 = VINIT_ZERO;
     struct tie_ray_s ray;
-    fastf_t view_inv;
+    vect_t v1, v2, res;
 
-    VSETALL(v1, 0);
+    /* depth of view samples */
+    if (camera->view_num > 1) {
+	vect_t accum;
+	int d;
+
+	VSET(accum, 0, 0, 0);
+
+	for (d = 0; d < camera->view_num; d++) {
+	    VSCALE(ray.dir, camera->view_list[d].step_y, y);
+	    VADD2(ray.dir, ray.dir, camera->view_list[d].top_l);
+	    VSCALE(v1, camera->view_list[d].step_x, x);
+	    VADD2(ray.dir, ray.dir, v1);
+
+	    VSET(res, (TFLOAT)RENDER_CAMERA_BGR, (TFLOAT)RENDER_CAMERA_BGG, (TFLOAT)RENDER_CAMERA_BGB);
+
+	    VMOVE(ray.pos, camera->view_list[d].pos);
+	    ray.depth = 0;
+	    VUNITIZE(ray.dir);
+
+	    /* Compute pixel value using this ray */
+	    camera->render.work(&camera->render, tie, &ray, &res);
+
+	    VADD2(accum, accum, res);
+	}
+
+	/* Find Mean value of all views */
+	VSCALE(res, accum, 1.0 / camera->view_num);
+    } else if (camera->type == RENDER_CAMERA_PERSPECTIVE) {
+	VSCALE(v1, camera->view_list[0].step_y, y);
+	VADD2(v1, v1, camera->view_list[0].top_l);
+	VSCALE(v2, camera->view_list[0].step_x, x);
+	VADD2(ray.dir, v1, v2);
+
+	VSET(res, (TFLOAT)RENDER_CAMERA_BGR, (TFLOAT)RENDER_CAMERA_BGG, (TFLOAT)RENDER_CAMERA_BGB);
+
+	VMOVE(ray.pos, camera->view_list[0].pos);
+	ray.depth = 0;
+	VUNITIZE(ray.dir);
+
+	/* Compute pixel value using this ray */
+	camera->render.work(&camera->render, tie, &ray, &res);
+    } else {
+	VMOVE(ray.pos, camera->view_list[0].pos);
+	VMOVE(ray.dir, camera->view_list[0].top_l);
+
+	VSCALE(v1, camera->view_list[0].step_x, x);
+	VSCALE(v2, camera->view_list[0].step_y, y);
+	VADD2(ray.pos, ray.pos, v1);
+	VADD2(ray.pos, ray.pos, v2);
+
+	VSET(res, (TFLOAT)RENDER_CAMERA_BGR, (TFLOAT)RENDER_CAMERA_BGG, (TFLOAT)RENDER_CAMERA_BGB);
+	ray.depth = 0;
+
+	/* Compute pixel value using this ray */
+	camera->render.work(&camera->render, tie, &ray, &res);
+    }
+
+    VMOVE(pixel, res);
+}
+
+
+/* Store pixel at (x, y) of the tile's result buffer */
+static void
+render_camera_store(camera_tile_t *tile, void *res_buf, int x, int y, vect_t pixel)
+{
+    size_t res_ind = (size_t)y * tile->size_x + x;
+
+    if (tile->format == RENDER_CAMERA_BIT_DEPTH_24) {
+	unsigned char *res = &((unsigned char *)res_buf)[3 * res_ind];
+	vect_t c;
+
+	VMOVE(c, pixel);
+	V_MIN(c[0], 1);
+	V_MIN(c[1], 1);
+	V_MIN(c[2], 1);
+	res[0] = (unsigned char)(255 * c[0]);
+	res[1] = (unsigned char)(255 * c[1]);
+	res[2] = (unsigned char)(255 * c[2]);
+    } else if (tile->format == RENDER_CAMERA_BIT_DEPTH_128) {
+	TFLOAT *res = &((TFLOAT *)res_buf)[4 * res_ind];
+	res[0] = pixel[0];
+	res[1] = pixel[1];
+	res[2] = pixel[2];
+	res[3] = 1.0;
+    }
+}
 
-    td = (render_camera_thread_data_t *)ptr;
-    view_inv = 1.0 / td->camera->view_num;
 
-    td->camera->render.tie = td->tie;
+void
+render_camera_render_thread(int UNUSED(cpu), void *ptr)
+{
+    render_camera_thread_data_t *td;
+    unsigned int scanline;
+    int n;
+    vect_t pixel;
 
-    res_ind = 0;
+    td = (render_camera_thread_data_t *)ptr;
 
     while (1) {
 	/* Determine if this scanline should be computed by this thread */
@@ -423,108 +509,77 @@ render_camera_render_thread(int UNUSED(cpu), void *ptr)
 	}
 	bu_semaphore_release(td->sem_tie_worker);
 
-	v_scanline = scanline + td->tile->orig_y;
-	if (td->tile->format == RENDER_CAMERA_BIT_DEPTH_24) {
-	    res_ind = 3*scanline*td->tile->size_x;
-	} else if (td->tile->format == RENDER_CAMERA_BIT_DEPTH_128) {
-	    res_ind = 4*scanline*td->tile->size_x;
-	}
-
-
-	/* optimization if there is no depth of field being applied */
-	if (td->camera->view_num == 1) {
-	    VSCALE(v1, td->camera->view_list[0].step_y, v_scanline);
-	    VADD2(v1, v1, td->camera->view_list[0].top_l);
+	/* scanline, horizontal, each pixel */
+	for (n = 0; n < td->tile->size_x; n++) {
+	    render_camera_shoot(td->camera, td->tie, n + td->tile->orig_x, scanline + td->tile->orig_y, pixel);
+	    render_camera_store(td->tile, td->res_buf, n, scanline, pixel);
 	}
+    }
+}
 
 
-	/* scanline, horizontal, each pixel */
-	for (n = td->tile->orig_x; n < td->tile->orig_x + td->tile->size_x; n++) {
-	    /* depth of view samples */
-	    if (td->camera->view_num > 1) {
-		VSET(accum, 0, 0, 0);
-
-		for (d = 0; d < td->camera->view_num; d++) {
-		    VSCALE(ray.dir, td->camera->view_list[d].step_y, v_scanline);
-		    VADD2(ray.dir, ray.dir, td->camera->view_list[d].top_l);
-		    VSCALE(v1, td->camera->view_list[d].step_x, n);
-		    VADD2(ray.dir, ray.dir, v1);
-
-		    VSET(pixel, (TFLOAT)RENDER_CAMERA_BGR, (TFLOAT)RENDER_CAMERA_BGG, (TFLOAT)RENDER_CAMERA_BGB);
-
-		    VMOVE(ray.pos, td->camera->view_list[d].pos);
-		    ray.depth = 0;
-		    VUNITIZE(ray.dir);
-
-		    /* Compute pixel value using this ray */
-		    td->camera->render.work(&td->camera->render, td->tie, &ray, &pixel);
-
-		    VADD2(accum, accum, pixel);
-		}
-
-		/* Find Mean value of all views */
-		VSCALE(pixel, accum, view_inv);
-	    } else {
-		if (td->camera->type == RENDER_CAMERA_PERSPECTIVE) {
-		    VSCALE(v2, td->camera->view_list[0].step_x, n);
-		    VADD2(ray.dir, v1, v2);
-
-		    VSET(pixel, (TFLOAT)RENDER_CAMERA_BGR, (TFLOAT)RENDER_CAMERA_BGG, (TFLOAT)RENDER_CAMERA_BGB);
-
-		    VMOVE(ray.pos, td->camera->view_list[0].pos);
-		    ray.depth = 0;
-		    VUNITIZE(ray.dir);
-
-		    /* Compute pixel value using this ray */
-		    td->camera->render.work(&td->camera->render, td->tie, &ray, &pixel);
-		} else {
-		    VMOVE(ray.pos, td->camera->view_list[0].pos);
-		    VMOVE(ray.dir, td->camera->view_list[0].top_l);
-
-		    VSCALE(v1, td->camera->view_list[0].step_x, n);
-		    VSCALE(v2, td->camera->view_list[0].step_y, v_scanline);
-		    VADD2(ray.pos, ray.pos, v1);
-		    VADD2(ray.pos, ray.pos, v2);
-
-		    VSET(pixel, (TFLOAT)RENDER_CAMERA_BGR, (TFLOAT)RENDER_CAMERA_BGG, (TFLOAT)RENDER_CAMERA_BGB);
-		    ray.depth = 0;
-
-		    /* Compute pixel value using this ray */
-		    td->camera->render.work(&td->camera->render, td->tie, &ray, &pixel);
-		}
-	    }
-
+/* One pass of a progressive render: tiles are handed out the way
+ * scanlines are above, and a tile is abandoned as soon as the view
+ * changes under it.  Tiles never reached keep the previous frame. */
+static void
+render_camera_progress_thread(int UNUSED(cpu), void *ptr)
+{
+    render_camera_thread_data_t *td;
+    unsigned int tiles_x, tiles_y, t;
+    int x, y, bx, by, x0, y0, x1, y1;
+    int step, skip;
+    vect_t pixel;
 
-	    if (td->tile->format == RENDER_CAMERA_BIT_DEPTH_24) {
-		V_MIN(pixel[0], 1);
-		V_MIN(pixel[1], 1);
-		V_MIN(pixel[2], 1);
-		((char *)(td->res_buf))[res_ind+0] = (unsigned char)(255 * pixel[0]);
-		((char *)(td->res_buf))[res_ind+1] = (unsigned char)(255 * pixel[1]);
-		((char *)(td->res_buf))[res_ind+2] = (unsigned char)(255 * pixel[2]);
-		res_ind += 3;
-	    } else if (td->tile->format == RENDER_CAMERA_BIT_DEPTH_128) {
-		TFLOAT alpha;
+    td = (render_camera_thread_data_t *)ptr;
+    step = td->step;
+    skip = (step < RENDER_CAMERA_PROGRESS_STEP) ? 2 * step : 0;
 
-		alpha = 1.0;
+    tiles_x = (td->tile->size_x + RENDER_CAMERA_PROGRESS_TILE - 1) / RENDER_CAMERA_PROGRESS_TILE;
+    tiles_y = (td->tile->size_y + RENDER_CAMERA_PROGRESS_TILE - 1) / RENDER_CAMERA_PROGRESS_TILE;
 
-		((TFLOAT *)(td->res_buf))[res_ind + 0] = pixel[0];
-		((TFLOAT *)(td->res_buf))[res_ind + 1] = pixel[1];
-		((TFLOAT *)(td->res_buf))[res_ind + 2] = pixel[2];
-		((TFLOAT *)(td->res_buf))[res_ind + 3] = alpha;
+    while (1) {
+	bu_semaphore_acquire(td->sem_tie_worker);
+	if (*td->scanline == tiles_x * tiles_y || td->progress->view != td->view) {
+	    bu_semaphore_release(td->sem_tie_worker);
+	    return;
+	} else {
+	    t = *td->scanline;
+	    (*td->scanline)++;
+	}
+	bu_semaphore_release(td->sem_tie_worker);
 
-		res_ind += 4;
+	x0 = (t % tiles_x) * RENDER_CAMERA_PROGRESS_TILE;
+	y0 = (t / tiles_x) * RENDER_CAMERA_PROGRESS_TILE;
+	x1 = x0 + RENDER_CAMERA_PROGRESS_TILE;
+	y1 = y0 + RENDER_CAMERA_PROGRESS_TILE;
+	V_MIN(x1, td->tile->size_x);
+	V_MIN(y1, td->tile->size_y);
+
+	for (y = y0; y < y1; y += step) {
+	    /* stale, leave the rest of the tile alone */
+	    if (td->progress->view != td->view)
+		return;
+
+	    for (x = x0; x < x1; x += step) {
+		/* an earlier pass already shot this one */
+		if (skip && x % skip == 0 && y % skip == 0)
+		    continue;
+
+		render_camera_shoot(td->camera, td->tie, x + td->tile->orig_x, y + td->tile->orig_y, pixel);
+		for (by = y; by < y + step && by < y1; by++)
+		    for (bx = x; bx < x + step && bx < x1; bx++)
+			render_camera_store(td->tile, td->res_buf, bx, by, pixel);
 	    }
 	}
     }
 }
 
 
-void
-render_camera_render(render_camera_t *camera, struct tie_s *tie, camera_tile_t *tile, tienet_buffer_t *result)
+/* Grow result to hold the tile and copy the tile header in, returning
+ * where the pixels go and leaving the end of the tile in *end */
+static void *
+render_camera_result(camera_tile_t *tile, tienet_buffer_t *result, uint32_t *end)
 {
-    render_camera_thread_data_t td;
-    unsigned int scanline;
     uint32_t ind;
 
     ind = result->ind;
@@ -541,13 +596,28 @@ render_camera_render(render_camera_t *camera, struct tie_s *tie, camera_tile_t *
     TCOPY(camera_tile_t, tile, 0, result->data, result->ind);
     result->ind += sizeof(camera_tile_t);
 
+    *end = ind;
+    return &((char *)result->data)[result->ind];
+}
+
+
+void
+render_camera_render(render_camera_t *camera, struct tie_s *tie, camera_tile_t *tile, tienet_buffer_t *result)
+{
+    render_camera_thread_data_t td;
+    unsigned int scanline;
+    uint32_t ind;
+
     td.tie = tie;
     td.camera = camera;
     td.tile = tile;
-    td.res_buf = &((char *)result->data)[result->ind];
+    td.res_buf = render_camera_result(tile, result, &ind);
     scanline = 0;
     td.scanline = &scanline;
     td.sem_tie_worker = bu_semaphore_register("sem_tie_worker");
+    td.progress = NULL;
+
+    camera->render.tie = tie;
 
     bu_parallel(render_camera_render_thread, camera->thread_num, &td);
 
@@ -557,6 +627,78 @@ render_camera_render(render_camera_t *camera, struct tie_s *tie, camera_tile_t *
 }
 
 
+/* Nothing is pending until the first render_camera_progress_restart() */
+void
+render_camera_progress_init(render_camera_progress_t *progress)
+{
+    memset(progress, 0, sizeof(render_camera_progress_t));
+}
+
+
+/* Call whenever the view changes.  Safe from a thread other than the
+ * one rendering; a pass in flight stops at its next tile or row. */
+void
+render_camera_progress_restart(render_camera_progress_t *progress)
+{
+    progress->changed = bu_gettime();
+    progress->view++;
+}
+
+
+/* Render the next pass of a progressive render into result, which
+ * should still hold the last frame so that whatever this pass does not
+ * reach is reused.  Returns 1 while passes remain, 0 once the image is
+ * complete and -1 if the view changed before the pass finished. */
+int
+render_camera_render_progressive(render_camera_t *camera, struct tie_s *tie, camera_tile_t *tile, tienet_buffer_t *result, render_camera_progress_t *progress)
+{
+    render_camera_thread_data_t td;
+    unsigned int tilenum;
+    uint32_t ind;
+    int64_t now;
+
+    td.view = progress->view;
+    if (td.view != progress->rendered) {
+	progress->rendered = td.view;
+	progress->step = RENDER_CAMERA_PROGRESS_STEP;
+    }
+
+    td.tie = tie;
+    td.camera = camera;
+    td.tile = tile;
+    td.res_buf = render_camera_result(tile, result, &ind);
+    result->ind = ind;
+
+    if (progress->step == 0)
+	return 0;
+
+    tilenum = 0;
+    td.scanline = &tilenum;
+    td.sem_tie_worker = bu_semaphore_register("sem_tie_worker");
+    td.progress = progress;
+    td.step = progress->step;
+
+    camera->render.tie = tie;
+
+    bu_parallel(render_camera_progress_thread, camera->thread_num, &td);
+
+    if (progress->view != td.view)
+	return -1;
+
+    if (progress->step == RENDER_CAMERA_PROGRESS_STEP) {
+	now = bu_gettime();
+	progress->latency = now - progress->changed;
+	progress->latency_sum += progress->latency;
+	progress->frames++;
+	if (progress->latency > progress->latency_max)
+	    progress->latency_max = progress->latency;
+    }
+
+    progress->step /= 2;
+    return progress->step ? 1 : 0;
+}
+
+
 struct render_shader_s *
 render_shader_register(const char *name, int (*init)(render_t *, const char *))
 {
@@ -40,6 +40,9 @@
 #define RENDER_CAMERA_BIT_DEPTH_24	0
 #define RENDER_CAMERA_BIT_DEPTH_128	1
 
+#define RENDER_CAMERA_PROGRESS_STEP	8	/* pixels on a side of the first pass's blocks */
+#define RENDER_CAMERA_PROGRESS_TILE	32	/* pixels on a side of the tiles passes are split into */
+
 
 typedef struct render_camera_view_s
 {
@@ -81,6 +84,25 @@ typedef struct camera_tile_s
 } camera_tile_t;
 
 
+/* State of a progressively rendered view.  Each pass shoots one ray
+ * per step x step block that earlier passes left alone and fills the
+ * block with it, halving step until every pixel has its own ray. */
+typedef struct render_camera_progress_s
+{
+    volatile uint32_t view;	/* bumped by render_camera_progress_restart() */
+    uint32_t rendered;		/* view the passes so far belong to */
+    uint16_t step;		/* block size of the next pass, 0 once complete */
+    int64_t changed;		/* when the view last changed */
+    int64_t latency;		/* microseconds from the last change to its first pass */
+    int64_t latency_max;
+    int64_t latency_sum;
+    uint32_t frames;		/* first passes that made it to the screen */
+} render_camera_progress_t;
+
+/* true when the last pass rendered finished the current view */
+#define RENDER_CAMERA_PROGRESS_DONE(_p) ((_p)->view == (_p)->rendered && (_p)->step == 0)
+
+
 typedef struct render_camera_thread_data_s
 {
     render_camera_t *camera;
@@ -89,6 +111,9 @@ typedef struct render_camera_thread_data_s
     void *res_buf;
     unsigned int *scanline;
     int sem_tie_worker;
+    render_camera_progress_t *progress;
+    uint32_t view;
+    uint16_t step;
 } render_camera_thread_data_t;
 
 
@@ -97,6 +122,10 @@ RENDER_EXPORT extern void render_camera_free(render_camera_t *camera);
 RENDER_EXPORT extern void render_camera_prep(render_camera_t *camera);
 RENDER_EXPORT extern void render_camera_render(render_camera_t *camera, struct tie_s *tie, camera_tile_t *tile, tienet_buffer_t *result);
 
+RENDER_EXPORT extern void render_camera_progress_init(render_camera_progress_t *progress);
+RENDER_EXPORT extern void render_camera_progress_restart(render_camera_progress_t *progress);
+RENDER_EXPORT extern int render_camera_render_progressive(render_camera_t *camera, struct tie_s *tie, camera_tile_t *tile, tienet_buffer_t *result, render_camera_progress_t *progress);
+
 RENDER_EXPORT extern int render_shader_init(render_t *, const char *name, const char *buf);
 RENDER_EXPORT extern const char *render_shader_load_plugin(const char *filename);
 /* r is passed in so something ... sane(?) can be done if the shader being
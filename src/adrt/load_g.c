@@ -33,6 +33,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "bu/time.h"
 #include "gcv.h"
 
 /* interface headers */
@@ -243,6 +244,7 @@ load_g(struct tie_s *tie, const char *db, int argc, const char **argv, struct ad
     struct model *the_model;
     struct bg_tess_tol ttol;		/* tessellation tolerance in mm */
     struct db_tree_state tree_state;	/* includes tol & model */
+    int64_t start;
 
     cur_tie = tie;	/* blehhh, global... need locking. */
 
@@ -288,7 +290,7 @@ load_g(struct tie_s *tie, const char *db, int argc, const char **argv, struct ad
     BN_CK_TOL(tree_state.ts_tol);
     BG_CK_TESS_TOL(tree_state.ts_ttol);
 
-    TIE_VAL(tie_init)(cur_tie, BU_PAGE_SIZE, TIE_KDTREE_FAST);
+    TIE_VAL(tie_init)(cur_tie, BU_PAGE_SIZE, TIE_KDTREE_SAH);
 
     /* FIXME: where is this released? */
     BU_ALLOC(*meshes, struct adrt_mesh_s);
@@ -320,7 +322,9 @@ load_g(struct tie_s *tie, const char *db, int argc, const char **argv, struct ad
     bu_free(tribuf[2], "vert");
     bu_free(tribuf, "tri");
 
+    start = bu_gettime();
     TIE_VAL(tie_prep)(cur_tie);
+    bu_log("kd-tree over %u triangles built in %.2fs\n", cur_tie->tri_num, (double)(bu_gettime() - start) / 1.0e6);
 
     return 0;
 }
@@ -30,6 +30,7 @@
 
 #include "bu/malloc.h"
 #include "bu/file.h"
+#include "bu/time.h"
 #include "gcv.h"
 #include "nmg.h"
 #include "rt/geom.h"
@@ -240,6 +241,7 @@ GFile::load_g(const char *filename, int argc, const char *argv[])
     struct bg_tess_tol ttol;		/* tessellation tolerance in mm */
     struct db_tree_state tree_state;	/* includes tol & model */
     struct isst_nmg_data d;
+    int64_t start;
 
     tree_state = rt_initial_tree_state;	/* struct copy */
     tree_state.ts_tol = &tol;
@@ -287,7 +289,7 @@ GFile::load_g(const char *filename, int argc, const char *argv[])
     BN_CK_TOL(tree_state.ts_tol);
     BG_CK_TESS_TOL(tree_state.ts_ttol);
 
-    TIE_VAL(tie_init)(d.cur_tie, BU_PAGE_SIZE, TIE_KDTREE_FAST);
+    TIE_VAL(tie_init)(d.cur_tie, BU_PAGE_SIZE, TIE_KDTREE_SAH);
 
     /* FIXME: where is this released? */
     BU_ALLOC(this->meshes, struct adrt_mesh_s);
@@ -321,7 +323,9 @@ GFile::load_g(const char *filename, int argc, const char *argv[])
     bu_free(tribuf[2], "vert");
     bu_free(tribuf, "tri");
 
+    start = bu_gettime();
     TIE_VAL(tie_prep)(d.cur_tie);
+    bu_log("kd-tree over %u triangles built in %.2fs\n", d.cur_tie->tri_num, (double)(bu_gettime() - start) / 1.0e6);
 
     return 0;
 }
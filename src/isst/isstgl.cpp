@@ -45,6 +45,7 @@ TIERenderer::TIERenderer(isstGL *w)
     camera.fov = 25;
     render_camera_init(&camera, bu_avail_cpus());
     render_phong_init(&camera.render, NULL);
+    render_camera_progress_init(&progress);
 
     // Initialize texture buffer
     TIENET_BUFFER_INIT(buffer_image);
@@ -64,6 +65,11 @@ TIERenderer::TIERenderer(isstGL *w)
 
 TIERenderer::~TIERenderer()
 {
+    if (progress.frames)
+	bu_log("%u interactive frames, first pass %.1fms on average and %.1fms at worst\n",
+	       progress.frames, progress.latency_sum / (1.0e3 * progress.frames),
+	       progress.latency_max / 1.0e3);
+
     TIENET_BUFFER_FREE(buffer_image);
     free(texdata);
 }
@@ -116,6 +122,7 @@ void TIERenderer::res_incr()
     CLAMP(resolution, 1, 20);
     resolution_factor = (resolution == 20) ? 0 : lrint(floor(m_w->width() * .05 * resolution));
     scaled = true;
+    render_camera_progress_restart(&progress);
 }
 
 void TIERenderer::res_decr()
@@ -126,6 +133,7 @@ void TIERenderer::res_decr()
     CLAMP(resolution, 1, 20);
     resolution_factor = (resolution == 20) ? 0 : lrint(floor(m_w->height() * .05 * resolution));
     scaled = true;
+    render_camera_progress_restart(&progress);
 }
 
 void TIERenderer::render()
@@ -144,7 +152,8 @@ void TIERenderer::render()
 	scaled = false;
     }
 
-    if (!changed) {
+    // Nothing new and the last view fully refined
+    if (!changed && RENDER_CAMERA_PROGRESS_DONE(&progress)) {
 	// Avoid a hot spin
 	std::this_thread::sleep_for(std::chrono::milliseconds(10));
 	return;
@@ -184,9 +193,11 @@ void TIERenderer::render()
     // not display correctly in the buffer.
     buffer_image.ind = 0;
 
-    // Core TIE render
+    // Core TIE render.  Each call is one pass, starting coarse after
+    // the view changes and refining while it holds still.  Whatever a
+    // cancelled pass did not reach still shows the previous frame.
     render_camera_prep(&camera);
-    render_camera_render(&camera, tie, &tile, &buffer_image);
+    render_camera_render_progressive(&camera, tie, &tile, &buffer_image, &progress);
 
     glDisable(GL_LIGHTING);
 
@@ -285,6 +296,7 @@ void isstGL::onAboutToResize()
 void isstGL::onResized()
 {
     m_renderer->changed = true;
+    render_camera_progress_restart(&m_renderer->progress);
     m_renderer->unlockRenderer();
 }
 
@@ -311,6 +323,7 @@ isstGL::set_tie(struct tie_s *in_tie)
     // Record the initial settings for use in subsequent calculations
     VSETALL(m_renderer->camera_pos_init, m_renderer->tie->radius);
     VMOVE(m_renderer->camera_focus_init, m_renderer->tie->mid);
+    render_camera_progress_restart(&m_renderer->progress);
 
     // Having just loaded a new TIE scene,
     // we need a new image
@@ -75,6 +75,7 @@ class TIERenderer : public QObject, protected QOpenGLFunctions
     public:
 	struct tie_s *tie = NULL; // From parent app
 	struct render_camera_s camera;
+	struct render_camera_progress_s progress;
 	vect_t camera_pos_init;
 	vect_t camera_focus_init;
 	bool changed = true;
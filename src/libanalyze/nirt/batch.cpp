@@ -0,0 +1,542 @@
+/*                       B A T C H . C P P
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file batch.cpp
+ *
+ * Implementation of Natalie's Interactive Ray-Tracer (NIRT)
+ * functionality specific to the batch subcommand.
+ *
+ * A batch run reads shotlines from a file, one per line:
+ *
+ *   x y z dx dy dz
+ *
+ * with the origin in the current local units.  Blank lines and lines
+ * starting with '#' are skipped.  Rays are read a block at a time and
+ * shot across all available processors.  Each processor reports into
+ * a private copy of the NIRT state, so results are formatted in
+ * parallel with the current fmt settings, and are then written out in
+ * input order.
+ *
+ * With -b the text formatting is skipped entirely and a binary record
+ * is written for every ray instead (requires -o).  All values are in
+ * network order, distances in mm:
+ *
+ *   uint32 ray number (from 0), uint32 partition count, then for each
+ *   partition:
+ *     double in[3], out[3], los, obliq_in, obliq_out
+ *     int32  region id, surf_num_in, surf_num_out
+ */
+
+#include "common.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "bu/cmd.h"
+#include "bu/cv.h"
+#include "bu/opt.h"
+#include "bu/parallel.h"
+#include "bv/vlist.h"
+
+#include "./nirt.h"
+
+/* rays read and shot at a time */
+#define NIRT_BATCH_BLOCK 4096
+
+/* rays claimed by a processor at a time */
+#define NIRT_BATCH_CHUNK 16
+
+struct nirt_batch_ray {
+    point_t orig;
+    vect_t dir;
+    std::string out;
+    std::string err;
+};
+
+struct nirt_batch_worker {
+    struct nirt_state s;		/* private copy the report code works on */
+    struct application ap;
+    struct resource *res;
+    int own_res;
+    struct nirt_batch_ray *ray;		/* ray being reported */
+    size_t ray_num;
+};
+
+struct nirt_batch_state {
+    struct nirt_state *nss;
+    struct nirt_batch_worker *workers;
+    std::vector<struct nirt_batch_ray> rays;
+    size_t first_num;			/* ray number of rays[0] */
+    size_t next;			/* next ray to claim */
+    size_t next_slot;			/* next worker slot to claim */
+    int binary;
+};
+
+
+static int
+_nirt_batch_out(struct nirt_state *ns, void *u_data)
+{
+    struct nirt_batch_worker *w = (struct nirt_batch_worker *)u_data;
+    w->ray->out.append(bu_vls_cstr(ns->i->out));
+    return 0;
+}
+
+
+static int
+_nirt_batch_err(struct nirt_state *ns, void *u_data)
+{
+    struct nirt_batch_worker *w = (struct nirt_batch_worker *)u_data;
+    w->ray->err.append(bu_vls_cstr(ns->i->err));
+    return 0;
+}
+
+
+static void
+_nirt_batch_put_long(std::string &o, uint32_t v)
+{
+    unsigned char b[SIZEOF_NETWORK_LONG];
+    b[0] = (unsigned char)(v >> 24);
+    b[1] = (unsigned char)(v >> 16);
+    b[2] = (unsigned char)(v >> 8);
+    b[3] = (unsigned char)v;
+    o.append((const char *)b, SIZEOF_NETWORK_LONG);
+}
+
+
+static void
+_nirt_batch_put_dbl(std::string &o, double v)
+{
+    unsigned char b[SIZEOF_NETWORK_DOUBLE];
+    bu_cv_htond(b, (const unsigned char *)&v, 1);
+    o.append((const char *)b, SIZEOF_NETWORK_DOUBLE);
+}
+
+
+extern "C" int
+_nirt_batch_bin_hit(struct application *ap, struct partition *part_head, struct seg *UNUSED(finished_segs))
+{
+    struct nirt_batch_worker *w = (struct nirt_batch_worker *)((struct nirt_state *)ap->a_uptr)->i->u_data;
+    std::string &o = w->ray->out;
+    struct partition *part;
+    uint32_t cnt = 0;
+
+    for (part = part_head->pt_forw; part != part_head; part = part->pt_forw)
+	cnt++;
+
+    _nirt_batch_put_long(o, (uint32_t)w->ray_num);
+    _nirt_batch_put_long(o, cnt);
+
+    for (part = part_head->pt_forw; part != part_head; part = part->pt_forw) {
+	point_t in, out;
+	vect_t nm_in, nm_out;
+
+	VJOIN1(in, ap->a_ray.r_pt, part->pt_inhit->hit_dist, ap->a_ray.r_dir);
+	VJOIN1(out, ap->a_ray.r_pt, part->pt_outhit->hit_dist, ap->a_ray.r_dir);
+	RT_HIT_NORMAL(nm_in, part->pt_inhit, part->pt_inseg->seg_stp, &ap->a_ray, part->pt_inflip);
+	RT_HIT_NORMAL(nm_out, part->pt_outhit, part->pt_outseg->seg_stp, &ap->a_ray, part->pt_outflip);
+
+	_nirt_batch_put_dbl(o, in[X]);
+	_nirt_batch_put_dbl(o, in[Y]);
+	_nirt_batch_put_dbl(o, in[Z]);
+	_nirt_batch_put_dbl(o, out[X]);
+	_nirt_batch_put_dbl(o, out[Y]);
+	_nirt_batch_put_dbl(o, out[Z]);
+	_nirt_batch_put_dbl(o, part->pt_outhit->hit_dist - part->pt_inhit->hit_dist);
+	_nirt_batch_put_dbl(o, _nirt_get_obliq(ap->a_ray.r_dir, nm_in));
+	_nirt_batch_put_dbl(o, _nirt_get_obliq(ap->a_ray.r_dir, nm_out));
+	_nirt_batch_put_long(o, (uint32_t)part->pt_regionp->reg_regionid);
+	_nirt_batch_put_long(o, (uint32_t)part->pt_inhit->hit_surfno);
+	_nirt_batch_put_long(o, (uint32_t)part->pt_outhit->hit_surfno);
+    }
+
+    return HIT;
+}
+
+
+extern "C" int
+_nirt_batch_bin_miss(struct application *ap)
+{
+    struct nirt_batch_worker *w = (struct nirt_batch_worker *)((struct nirt_state *)ap->a_uptr)->i->u_data;
+
+    _nirt_batch_put_long(w->ray->out, (uint32_t)w->ray_num);
+    _nirt_batch_put_long(w->ray->out, 0);
+
+    return MISS;
+}
+
+
+/* Set up processor cpu's private copy of the NIRT state */
+static void
+_nirt_batch_worker_init(struct nirt_batch_state *bs, int cpu)
+{
+    struct nirt_state *nss = bs->nss;
+    struct nirt_batch_worker *w = &bs->workers[cpu];
+    struct nirt_state_impl *n = new nirt_state_impl(*nss->i);
+
+    /* read only, shared with the parent */
+    w->s.nirt_cmd = nss->nirt_cmd;
+    w->s.nirt_format_file = nss->nirt_format_file;
+    w->s.i = n;
+
+    BU_GET(n->out, struct bu_vls);
+    bu_vls_init(n->out);
+    BU_GET(n->msg, struct bu_vls);
+    bu_vls_init(n->msg);
+    BU_GET(n->err, struct bu_vls);
+    bu_vls_init(n->err);
+    BU_LIST_INIT(&(n->s_vlist));
+    n->segs = bv_vlblock_init(&(n->s_vlist), 32);
+    n->h_state = NULL;
+    n->h_out = _nirt_batch_out;
+    n->h_msg = NULL;
+    n->h_err = _nirt_batch_err;
+    n->h_segs = NULL;
+    n->h_objs = NULL;
+    n->h_frmts = NULL;
+    n->h_view = NULL;
+    n->diff_state = NULL;
+    n->u_data = (void *)w;
+
+    BU_GET(n->vals, struct nirt_output_record);
+    *n->vals = *nss->i->vals;
+    n->vals->seg = NULL;
+
+    /* the parent's resource serves the first processor */
+    if (cpu == 0) {
+	w->res = _nirt_get_resource(nss);
+	w->own_res = 0;
+    } else {
+	BU_GET(w->res, struct resource);
+	rt_init_resource(w->res, cpu, nss->i->ap->a_rt_i);
+	w->own_res = 1;
+    }
+
+    w->ap = *nss->i->ap;
+    w->ap.a_resource = w->res;
+    w->ap.a_uptr = (void *)&w->s;
+    if (bs->binary) {
+	w->ap.a_hit = _nirt_batch_bin_hit;
+	w->ap.a_miss = _nirt_batch_bin_miss;
+	w->ap.a_overlap = rt_defoverlap;
+    }
+    n->ap = &w->ap;
+}
+
+
+/* Drop the segment plot a worker built up over the last block.  The
+ * batch command never hands segments to h_segs, so without this they
+ * would pile up across the whole ray file. */
+static void
+_nirt_batch_worker_reset(struct nirt_batch_state *bs, int cpu)
+{
+    struct nirt_state_impl *n = bs->workers[cpu].s.i;
+    struct bv_vlblock *vbp = n->segs;
+
+    for (size_t i = 0; i < vbp->nused; i++) {
+	if (BU_LIST_IS_EMPTY(&(vbp->head[i])))
+	    continue;
+	BV_FREE_VLIST(vbp->free_vlist_hd, &(vbp->head[i]));
+    }
+    n->b_segs = false;
+}
+
+
+static void
+_nirt_batch_worker_free(struct nirt_batch_state *bs, int cpu)
+{
+    struct nirt_batch_worker *w = &bs->workers[cpu];
+    struct nirt_state_impl *n = w->s.i;
+    struct rt_i *rtip = w->ap.a_rt_i;
+
+    if (w->own_res) {
+	rt_clean_resource_basic(rtip, w->res);
+	BU_PTBL_SET(&rtip->rti_resources, cpu, NULL);
+	BU_PUT(w->res, struct resource);
+    }
+
+    if (n->vals->seg)
+	delete n->vals->seg;
+    BU_PUT(n->vals, struct nirt_output_record);
+    bv_vlist_cleanup(&(n->s_vlist));
+    bv_vlblock_free(n->segs);
+    bu_vls_free(n->out);
+    bu_vls_free(n->msg);
+    bu_vls_free(n->err);
+    BU_PUT(n->out, struct bu_vls);
+    BU_PUT(n->msg, struct bu_vls);
+    BU_PUT(n->err, struct bu_vls);
+    delete n;
+}
+
+
+/* Shoot one ray the way the "s" command does */
+static void
+_nirt_batch_shoot(struct nirt_batch_worker *w)
+{
+    struct nirt_state *ws = &w->s;
+    struct nirt_output_record *vals = ws->i->vals;
+    double bov;
+
+    VMOVE(vals->orig, w->ray->orig);
+    VMOVE(vals->dir, w->ray->dir);
+    _nirt_dir2ae(ws);
+    _nirt_targ2grid(ws);
+
+    bov = _nirt_backout(ws);
+    VJOIN1(vals->orig, vals->orig, -bov, vals->dir);
+    VMOVE(w->ap.a_ray.r_pt, vals->orig);
+    VMOVE(w->ap.a_ray.r_dir, vals->dir);
+
+    _nirt_init_ovlp(ws);
+    (void)rt_shootray(&w->ap);
+
+    VMOVE(vals->orig, w->ray->orig);
+}
+
+
+static void
+_nirt_batch_worker(int UNUSED(cpu), void *data)
+{
+    struct nirt_batch_state *bs = (struct nirt_batch_state *)data;
+    struct nirt_batch_worker *w;
+    size_t slot;
+
+    /* bu_parallel cpu ids are not guaranteed to be dense, so each
+     * worker claims its own slot */
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    slot = bs->next_slot++;
+    bu_semaphore_release(BU_SEM_GENERAL);
+    w = &bs->workers[slot];
+
+    while (1) {
+	size_t start, end;
+
+	bu_semaphore_acquire(BU_SEM_GENERAL);
+	start = bs->next;
+	bs->next += NIRT_BATCH_CHUNK;
+	bu_semaphore_release(BU_SEM_GENERAL);
+
+	if (start >= bs->rays.size())
+	    break;
+	end = start + NIRT_BATCH_CHUNK;
+	if (end > bs->rays.size())
+	    end = bs->rays.size();
+
+	for (size_t i = start; i < end; i++) {
+	    w->ray = &bs->rays[i];
+	    w->ray_num = bs->first_num + i;
+	    _nirt_batch_shoot(w);
+	}
+    }
+}
+
+
+/* Read up to NIRT_BATCH_BLOCK rays.  Returns -1 on a malformed line. */
+static int
+_nirt_batch_read(struct nirt_batch_state *bs, std::ifstream &fs, size_t *line_num)
+{
+    std::string line;
+
+    bs->rays.clear();
+    while (bs->rays.size() < NIRT_BATCH_BLOCK && std::getline(fs, line)) {
+	struct nirt_batch_ray r;
+	double v[6];
+	(*line_num)++;
+
+	_nirt_trim_whitespace(line);
+	if (line.empty() || line[0] == '#')
+	    continue;
+
+	std::istringstream ls(line);
+	for (int i = 0; i < 6; i++) {
+	    if (!(ls >> v[i])) {
+		nerr(bs->nss, "Error: line %zu: expected x y z dx dy dz: %s\n", *line_num, line.c_str());
+		return -1;
+	    }
+	}
+
+	VSET(r.orig, v[0], v[1], v[2]);
+	VSCALE(r.orig, r.orig, bs->nss->i->local2base);
+	VSET(r.dir, v[3], v[4], v[5]);
+	if (MAGSQ(r.dir) < SMALL_FASTF) {
+	    nerr(bs->nss, "Error: line %zu: zero length direction\n", *line_num);
+	    return -1;
+	}
+	VUNITIZE(r.dir);
+	bs->rays.push_back(r);
+    }
+
+    return 0;
+}
+
+
+extern "C" int
+_nirt_cmd_batch(void *ns, int argc, const char *argv[])
+{
+    struct nirt_state *nss = (struct nirt_state *)ns;
+    if (!ns || !nss->i->ap) return -1;
+
+    const char *usage = "Usage:  batch [-P ncpus] [-o file] [-b] rayfile\n";
+    int help = 0;
+    int binary = 0;
+    int ncpus = 0;
+    struct bu_vls ofile = BU_VLS_INIT_ZERO;
+    struct bu_opt_desc d[5];
+    BU_OPT(d[0], "h", "help",   "",       NULL,        &help,   "print help and exit");
+    BU_OPT(d[1], "P", "cpus",   "#",      &bu_opt_int, &ncpus,  "number of processors to use");
+    BU_OPT(d[2], "o", "output", "file",   &bu_opt_vls, &ofile,  "write results to file");
+    BU_OPT(d[3], "b", "binary", "",       NULL,        &binary, "write binary records (requires -o)");
+    BU_OPT_NULL(d[4]);
+
+    argv++; argc--;
+
+    struct bu_vls optparse_msg = BU_VLS_INIT_ZERO;
+    int ac = bu_opt_parse(&optparse_msg, argc, argv, d);
+    if (ac < 0) {
+	nerr(nss, "%s", bu_vls_cstr(&optparse_msg));
+	bu_vls_free(&optparse_msg);
+	bu_vls_free(&ofile);
+	return -1;
+    }
+    bu_vls_free(&optparse_msg);
+
+    if (help || ac != 1) {
+	char *option_help = bu_opt_describe(d, NULL);
+	if (help) {
+	    nout(nss, "%s%s", usage, option_help);
+	} else {
+	    nerr(nss, "%s%s", usage, option_help);
+	}
+	bu_free(option_help, "help str");
+	bu_vls_free(&ofile);
+	return (help) ? 0 : -1;
+    }
+
+    if (binary && !bu_vls_strlen(&ofile)) {
+	nerr(nss, "Error: binary output requires an output file (-o)\n");
+	bu_vls_free(&ofile);
+	return -1;
+    }
+
+    /* If we have no active rtip, we don't need to prep or shoot */
+    if (!_nirt_get_rtip(nss)) {
+	bu_vls_free(&ofile);
+	return 0;
+    }
+    if (nss->i->need_reprep) {
+	if (_nirt_raytrace_prep(nss)) {
+	    nerr(nss, "Error: raytrace prep failed!\n");
+	    bu_vls_free(&ofile);
+	    return -1;
+	}
+    } else {
+	nss->i->ap->a_rt_i = _nirt_get_rtip(nss);
+	nss->i->ap->a_resource = _nirt_get_resource(nss);
+    }
+
+    std::ifstream fs;
+    fs.open(argv[0]);
+    if (!fs.is_open()) {
+	nerr(nss, "Error: could not open ray file %s\n", argv[0]);
+	bu_vls_free(&ofile);
+	return -1;
+    }
+
+    FILE *ofp = NULL;
+    if (bu_vls_strlen(&ofile)) {
+	ofp = fopen(bu_vls_cstr(&ofile), (binary) ? "wb" : "w");
+	if (!ofp) {
+	    nerr(nss, "Error: could not open output file %s\n", bu_vls_cstr(&ofile));
+	    fs.close();
+	    bu_vls_free(&ofile);
+	    return -1;
+	}
+    }
+    bu_vls_free(&ofile);
+
+    size_t avail = bu_avail_cpus();
+    if (ncpus <= 0 || (size_t)ncpus > avail)
+	ncpus = (int)avail;
+    if (ncpus > MAX_PSW)
+	ncpus = MAX_PSW;
+
+    struct nirt_batch_state bs;
+    bs.nss = nss;
+    bs.binary = binary;
+    bs.first_num = 0;
+    bs.workers = (struct nirt_batch_worker *)bu_calloc(ncpus, sizeof(struct nirt_batch_worker), "nirt batch workers");
+    for (int i = 0; i < ncpus; i++)
+	_nirt_batch_worker_init(&bs, i);
+
+    int ret = 0;
+    size_t line_num = 0;
+    while (!ret) {
+	if (_nirt_batch_read(&bs, fs, &line_num)) {
+	    ret = -1;
+	    break;
+	}
+	if (bs.rays.empty())
+	    break;
+
+	bs.next = 0;
+	bs.next_slot = 0;
+	bu_parallel(_nirt_batch_worker, (size_t)ncpus, (void *)&bs);
+	for (int i = 0; i < ncpus; i++)
+	    _nirt_batch_worker_reset(&bs, i);
+
+	/* write out in input order */
+	for (size_t i = 0; i < bs.rays.size(); i++) {
+	    struct nirt_batch_ray *r = &bs.rays[i];
+	    if (!r->err.empty())
+		nerr(nss, "%s", r->err.c_str());
+	    if (r->out.empty())
+		continue;
+	    if (ofp) {
+		if (fwrite(r->out.data(), 1, r->out.size(), ofp) != r->out.size()) {
+		    nerr(nss, "Error: failed writing batch output\n");
+		    ret = -1;
+		    break;
+		}
+	    } else {
+		nout(nss, "%s", r->out.c_str());
+	    }
+	}
+	bs.first_num += bs.rays.size();
+    }
+
+    for (int i = 0; i < ncpus; i++)
+	_nirt_batch_worker_free(&bs, i);
+    bu_free(bs.workers, "nirt batch workers");
+
+    fs.close();
+    if (ofp)
+	fclose(ofp);
+
+    return ret;
+}
+
+
+// Local Variables:
+// tab-width: 8
+// mode: C++
+// c-basic-offset: 4
+// indent-tabs-mode: t
+// c-file-style: "stroustrup"
+// End:
+// ex: shiftwidth=4 tabstop=8
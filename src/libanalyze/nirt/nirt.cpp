@@ -341,7 +341,7 @@ static void _nirt_ae2dir(struct nirt_state *nss)
     VMOVE(nss->i->vals->dir, dir);
 }
 
-static double _nirt_backout(struct nirt_state *nss)
+double _nirt_backout(struct nirt_state *nss)
 {
     double bov;
     point_t ray_point;
@@ -376,7 +376,7 @@ static double _nirt_backout(struct nirt_state *nss)
     return bov;
 }
 
-static fastf_t
+fastf_t
 _nirt_get_obliq(fastf_t *ray, fastf_t *normal)
 {
     fastf_t cos_obl;
@@ -1357,6 +1357,7 @@ struct nirt_cmd_desc {
 
 static const struct nirt_cmd_desc nirt_descs[] = {
     { "attr",           "select attributes",                             NULL },
+    { "batch",          "shoot the rays listed in a file",               "[-P ncpus] [-o file] [-b] rayfile" },
     { "ae",             "set/query azimuth and elevation",               "azimuth elevation" },
     { "dir",            "set/query direction vector",                    "x-component y-component z-component" },
     { "diff",           "test a ray result against a supplied default",  "[-t tol] partition_info" },
@@ -2352,6 +2353,7 @@ _nirt_cmd_state(void *ns, int argc, const char *argv[])
 const struct bu_cmdtab _libanalyze_nirt_cmds[] = {
     { "attr",           _nirt_cmd_attr},
     { "ae",             _nirt_cmd_az_el},
+    { "batch",          _nirt_cmd_batch},
     { "diff",           _nirt_cmd_diff},
     { "dir",            _nirt_cmd_dir_vect},
     { "hv",             _nirt_cmd_grid_coor},
@@ -412,6 +412,9 @@ void _nirt_targ2grid(struct nirt_state *nss);
 
 void _nirt_dir2ae(struct nirt_state *nss);
 
+double _nirt_backout(struct nirt_state *nss);
+fastf_t _nirt_get_obliq(fastf_t *ray, fastf_t *normal);
+
 struct rt_i * _nirt_get_rtip(struct nirt_state *nss);
 struct resource * _nirt_get_resource(struct nirt_state *nss);
 void _nirt_init_ovlp(struct nirt_state *nss);
@@ -423,6 +426,8 @@ void _nirt_diff_destroy(struct nirt_state *nss);
 void _nirt_diff_add_seg(struct nirt_state *nss, nirt_seg *nseg);
 extern "C" int _nirt_cmd_diff(void *ns, int argc, const char *argv[]);
 
+extern "C" int _nirt_cmd_batch(void *ns, int argc, const char *argv[]);
+
 
 // Local Variables:
 // tab-width: 8
@@ -0,0 +1,189 @@
+/*                  T R I _ T R I _ P A I R S . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file tri_tri_pairs.c
+ *
+ * Check bg_tri_tri_isect_batch and bg_trimesh_isect_pairs against brute
+ * force bg_tri_tri_isect results on randomly generated triangle soups.
+ *
+ */
+
+#include "common.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bu.h"
+#include "bg.h"
+
+#define NTRI 400
+
+static unsigned long rseed = 1;
+
+static fastf_t
+rnd(void)
+{
+    /* simple LCG so the test is repeatable on every platform */
+    rseed = (rseed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+    return (fastf_t)rseed / (fastf_t)0x7fffffffUL;
+}
+
+/* Small triangles scattered in a unit cube, with every fourth triangle
+ * sharing a vertex with its predecessor */
+static void
+make_soup(int *f, point_t *v, size_t n)
+{
+    size_t i;
+    for (i = 0; i < n; i++) {
+	point_t c;
+	int k;
+	VSET(c, rnd(), rnd(), rnd());
+	for (k = 0; k < 3; k++) {
+	    VSET(v[3*i+k], c[X] + 0.1*rnd(), c[Y] + 0.1*rnd(), c[Z] + 0.1*rnd());
+	    f[3*i+k] = (int)(3*i+k);
+	}
+	if (i && i % 4 == 0)
+	    f[3*i] = f[3*(i-1)+1];
+    }
+}
+
+struct pair_tally {
+    size_t cnt;
+    unsigned char *seen;	/* NTRI x NTRI matrix */
+};
+
+static int
+tally_pair(size_t f1, size_t f2, void *data)
+{
+    struct pair_tally *t = (struct pair_tally *)data;
+    if (t->seen[f1*NTRI+f2])
+	bu_exit(1, "pair %zu %zu reported twice\n", f1, f2);
+    t->seen[f1*NTRI+f2] = 1;
+    t->cnt++;
+    return 0;
+}
+
+static int
+tri_isect(int *f1, point_t *v1, size_t i, int *f2, point_t *v2, size_t j)
+{
+    return bg_tri_tri_isect(v1[f1[3*i]], v1[f1[3*i+1]], v1[f1[3*i+2]],
+			    v2[f2[3*j]], v2[f2[3*j+1]], v2[f2[3*j+2]]);
+}
+
+static int
+shares_vert(int *f, size_t i, size_t j)
+{
+    int a, b;
+    for (a = 0; a < 3; a++)
+	for (b = 0; b < 3; b++)
+	    if (f[3*i+a] == f[3*j+b])
+		return 1;
+    return 0;
+}
+
+int
+main(int UNUSED(argc), const char **argv)
+{
+    int *f1, *f2;
+    point_t *v1, *v2;
+    fastf_t *soa;
+    unsigned char mask[NTRI];
+    struct bg_tri_soa blk;
+    struct pair_tally t;
+    size_t i, j, k, expected;
+
+    bu_setprogname(argv[0]);
+
+    f1 = (int *)bu_calloc(3*NTRI, sizeof(int), "f1");
+    f2 = (int *)bu_calloc(3*NTRI, sizeof(int), "f2");
+    v1 = (point_t *)bu_calloc(3*NTRI, sizeof(point_t), "v1");
+    v2 = (point_t *)bu_calloc(3*NTRI, sizeof(point_t), "v2");
+    soa = (fastf_t *)bu_calloc(9*NTRI, sizeof(fastf_t), "soa");
+    t.seen = (unsigned char *)bu_calloc(NTRI*NTRI, 1, "seen");
+
+    make_soup(f1, v1, NTRI);
+    make_soup(f2, v2, NTRI);
+
+    /* batch test of every mesh 1 triangle against all of mesh 2 */
+    for (k = 0; k < 9; k++) {
+	blk.c[k] = soa + k*NTRI;
+	for (j = 0; j < NTRI; j++)
+	    soa[k*NTRI+j] = v2[f2[3*j+k/3]][k%3];
+    }
+    blk.n = NTRI;
+    expected = 0;
+    for (i = 0; i < NTRI; i++) {
+	size_t cnt = bg_tri_tri_isect_batch(mask, v1[f1[3*i]], v1[f1[3*i+1]], v1[f1[3*i+2]], &blk);
+	size_t scnt = 0;
+	for (j = 0; j < NTRI; j++) {
+	    int r = tri_isect(f1, v1, i, f2, v2, j);
+	    if (r != mask[j])
+		bu_exit(1, "batch result for %zu/%zu is %d, expected %d\n", i, j, mask[j], r);
+	    scnt += r;
+	}
+	if (cnt != scnt)
+	    bu_exit(1, "batch count for %zu is %zu, expected %zu\n", i, cnt, scnt);
+	expected += scnt;
+    }
+    if (!expected)
+	bu_exit(1, "test meshes do not intersect\n");
+
+    /* mesh/mesh pairs */
+    t.cnt = 0;
+    if (bg_trimesh_isect_pairs(f1, NTRI, (const point_t *)v1, f2, NTRI, (const point_t *)v2, tally_pair, &t) != expected || t.cnt != expected)
+	bu_exit(1, "mesh pairs: found %zu, expected %zu\n", t.cnt, expected);
+    for (i = 0; i < NTRI; i++)
+	for (j = 0; j < NTRI; j++)
+	    if (t.seen[i*NTRI+j] != tri_isect(f1, v1, i, f2, v2, j))
+		bu_exit(1, "mesh pairs: wrong result for %zu/%zu\n", i, j);
+
+    /* self intersection */
+    expected = 0;
+    for (i = 0; i < NTRI; i++)
+	for (j = i + 1; j < NTRI; j++)
+	    if (!shares_vert(f1, i, j) && tri_isect(f1, v1, i, f1, v1, j))
+		expected++;
+    memset(t.seen, 0, NTRI*NTRI);
+    t.cnt = 0;
+    if (bg_trimesh_isect_pairs(f1, NTRI, (const point_t *)v1, NULL, 0, NULL, tally_pair, &t) != expected || t.cnt != expected)
+	bu_exit(1, "self pairs: found %zu, expected %zu\n", t.cnt, expected);
+    for (i = 0; i < NTRI; i++)
+	for (j = 0; j < NTRI; j++)
+	    if (t.seen[i*NTRI+j] && (j <= i || shares_vert(f1, i, j)))
+		bu_exit(1, "self pairs: unexpected pair %zu/%zu\n", i, j);
+
+    bu_free(f1, "f1");
+    bu_free(f2, "f2");
+    bu_free(v1, "v1");
+    bu_free(v2, "v2");
+    bu_free(soa, "soa");
+    bu_free(t.seen, "seen");
+
+    return 0;
+}
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
@@ -708,6 +708,86 @@ int bg_tri_tri_isect_with_line(point_t V0, point_t V1, point_t V2,
 }
 
 
+/* The batch plane rejection uses a slightly larger zero band than the
+ * scalar test, so that anything it rejects is also rejected by
+ * bg_tri_tri_isect regardless of rounding differences between the
+ * vectorized and scalar arithmetic. */
+#define BATCH_EPSILON (2*EPSILON)
+
+size_t
+bg_tri_tri_isect_batch(unsigned char *mask, const point_t V0, const point_t V1, const point_t V2, const struct bg_tri_soa *U)
+{
+    size_t i;
+    size_t cnt = 0;
+    point_t E1, E2, N1;
+    fastf_t d1;
+    const fastf_t *u0x, *u0y, *u0z, *u1x, *u1y, *u1z, *u2x, *u2y, *u2z;
+
+    if (!mask || !U)
+	return 0;
+
+    u0x = U->c[0]; u0y = U->c[1]; u0z = U->c[2];
+    u1x = U->c[3]; u1y = U->c[4]; u1z = U->c[5];
+    u2x = U->c[6]; u2y = U->c[7]; u2z = U->c[8];
+
+    VSUB2(E1, V1, V0);
+    VSUB2(E2, V2, V0);
+    VCROSS(N1, E1, E2);
+    d1 = -VDOT(N1, V0);
+
+    /* Pass 1 - reject every triangle that lies entirely on one side of
+     * the other's plane.  No data dependent branches, so the compiler
+     * can vectorize this loop. */
+    for (i = 0; i < U->n; i++) {
+	fastf_t du0, du1, du2, dv0, dv1, dv2;
+	fastf_t e1x, e1y, e1z, e2x, e2y, e2z, n2x, n2y, n2z, d2;
+	int rej1, rej2;
+
+	du0 = N1[X]*u0x[i] + N1[Y]*u0y[i] + N1[Z]*u0z[i] + d1;
+	du1 = N1[X]*u1x[i] + N1[Y]*u1y[i] + N1[Z]*u1z[i] + d1;
+	du2 = N1[X]*u2x[i] + N1[Y]*u2y[i] + N1[Z]*u2z[i] + d1;
+	du0 = (fabs(du0) < BATCH_EPSILON) ? 0.0 : du0;
+	du1 = (fabs(du1) < BATCH_EPSILON) ? 0.0 : du1;
+	du2 = (fabs(du2) < BATCH_EPSILON) ? 0.0 : du2;
+	rej1 = (du0*du1 > 0.0) & (du0*du2 > 0.0);
+
+	e1x = u1x[i] - u0x[i]; e1y = u1y[i] - u0y[i]; e1z = u1z[i] - u0z[i];
+	e2x = u2x[i] - u0x[i]; e2y = u2y[i] - u0y[i]; e2z = u2z[i] - u0z[i];
+	n2x = e1y*e2z - e1z*e2y;
+	n2y = e1z*e2x - e1x*e2z;
+	n2z = e1x*e2y - e1y*e2x;
+	d2 = -(n2x*u0x[i] + n2y*u0y[i] + n2z*u0z[i]);
+
+	dv0 = n2x*V0[X] + n2y*V0[Y] + n2z*V0[Z] + d2;
+	dv1 = n2x*V1[X] + n2y*V1[Y] + n2z*V1[Z] + d2;
+	dv2 = n2x*V2[X] + n2y*V2[Y] + n2z*V2[Z] + d2;
+	dv0 = (fabs(dv0) < BATCH_EPSILON) ? 0.0 : dv0;
+	dv1 = (fabs(dv1) < BATCH_EPSILON) ? 0.0 : dv1;
+	dv2 = (fabs(dv2) < BATCH_EPSILON) ? 0.0 : dv2;
+	rej2 = (dv0*dv1 > 0.0) & (dv0*dv2 > 0.0);
+
+	mask[i] = (unsigned char)!(rej1 | rej2);
+    }
+
+    /* Pass 2 - the survivors get the full interval test */
+    for (i = 0; i < U->n; i++) {
+	point_t A0, A1, A2, B0, B1, B2;
+	if (!mask[i])
+	    continue;
+	VMOVE(A0, V0);
+	VMOVE(A1, V1);
+	VMOVE(A2, V2);
+	VSET(B0, u0x[i], u0y[i], u0z[i]);
+	VSET(B1, u1x[i], u1y[i], u1z[i]);
+	VSET(B2, u2x[i], u2y[i], u2z[i]);
+	mask[i] = (unsigned char)bg_tri_tri_isect(A0, A1, A2, B0, B1, B2);
+	cnt += mask[i];
+    }
+
+    return cnt;
+}
+
+
 /*
  * Local Variables:
  * tab-width: 8
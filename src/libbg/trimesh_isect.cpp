@@ -71,6 +71,22 @@ plot_faces(const char *fname, std::set<int> *faces, int *f, point_t *v)
     fclose(plot_file);
 }
 
+struct isect_face_sets {
+    std::vector<int> *m1_working_faces;
+    std::vector<int> *m2_working_faces;
+    std::set<int> m1_intersecting_faces;
+    std::set<int> m2_intersecting_faces;
+};
+
+static int
+isect_face_pair(size_t f1, size_t f2, void *data)
+{
+    struct isect_face_sets *fs = (struct isect_face_sets *)data;
+    fs->m1_intersecting_faces.insert((*fs->m1_working_faces)[f1]);
+    fs->m2_intersecting_faces.insert((*fs->m2_working_faces)[f2]);
+    return 0;
+}
+
 /* For NURBS refinement, we do this once and keep the set of "inside" faces from
  * each mesh.  If any of the vertices from those faces are still inside after a
  * refinement and remeshing step, they are either genuinely inside the mesh (bad
@@ -183,33 +199,29 @@ bg_trimesh_isect(
     bu_log("m1_working_faces size: %zd\n", m1_working_faces.size());
     bu_log("m2_working_faces size: %zd\n", m2_working_faces.size());
 
-    /* For each "working" face in faces_1, check it against "working" faces in
-     * face_2 for intersections.  IFF it intersects, add it and the other face
-     * to their intersects set.
-     *
-     * TODO - this is the naive NxM implementation - it can undoubtedly be improved
-     * upon with one form or another of acceleration structure - but for now
-     * we're after simple and working.  Once this is established to be a
-     * performance bottleneck we can dig deeper into it. */
-    std::set<int> m1_intersecting_faces;
-    std::set<int> m2_intersecting_faces;
+    /* Check the "working" faces of each mesh against each other for
+     * intersections.  Faces that intersect are added to their mesh's
+     * intersects set. */
+    std::vector<int> m1_wf(3*m1_working_faces.size());
+    std::vector<int> m2_wf(3*m2_working_faces.size());
     for (size_t i = 0; i < m1_working_faces.size(); i++) {
-	for (size_t j = 0; j < m2_working_faces.size(); j++) {
-	    int v1_1 = faces_1[3*m1_working_faces[i]];
-	    int v1_2 = faces_1[3*m1_working_faces[i]+1];
-	    int v1_3 = faces_1[3*m1_working_faces[i]+2];
-	    int v2_1 = faces_2[3*m2_working_faces[j]];
-	    int v2_2 = faces_2[3*m2_working_faces[j]+1];
-	    int v2_3 = faces_2[3*m2_working_faces[j]+2];
-	    if (bg_tri_tri_isect(
-		    vertices_1[v1_1], vertices_1[v1_2], vertices_1[v1_3],
-		    vertices_2[v2_1], vertices_2[v2_2], vertices_2[v2_3]))
-	    {
-		m1_intersecting_faces.insert(m1_working_faces[i]);
-		m2_intersecting_faces.insert(m2_working_faces[j]);
-	    }
-	}
+	for (int k = 0; k < 3; k++)
+	    m1_wf[3*i+k] = faces_1[3*m1_working_faces[i]+k];
+    }
+    for (size_t i = 0; i < m2_working_faces.size(); i++) {
+	for (int k = 0; k < 3; k++)
+	    m2_wf[3*i+k] = faces_2[3*m2_working_faces[i]+k];
+    }
+    struct isect_face_sets fs;
+    fs.m1_working_faces = &m1_working_faces;
+    fs.m2_working_faces = &m2_working_faces;
+    if (m1_working_faces.size() && m2_working_faces.size()) {
+	bg_trimesh_isect_pairs(m1_wf.data(), m1_working_faces.size(), (const point_t *)vertices_1,
+		m2_wf.data(), m2_working_faces.size(), (const point_t *)vertices_2,
+		isect_face_pair, &fs);
     }
+    std::set<int> &m1_intersecting_faces = fs.m1_intersecting_faces;
+    std::set<int> &m2_intersecting_faces = fs.m2_intersecting_faces;
 
     bu_log("m1_intersecting_faces size: %zd\n", m1_intersecting_faces.size());
 
@@ -0,0 +1,271 @@
+/*                 T R I M E S H _ P A I R S . C P P
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file trimesh_pairs.cpp
+ *
+ * Find the intersecting triangle pairs between two meshes, or within a
+ * single mesh, by walking a bounding volume hierarchy built over each
+ * mesh against the other.  Leaf against leaf tests are handed to
+ * bg_tri_tri_isect_batch in blocks.
+ *
+ */
+
+#include "common.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "vmath.h"
+#include "bu/log.h"
+#include "bg/tri_tri.h"
+#include "bg/trimesh.h"
+
+/* Maximum number of triangles in a BVH leaf */
+#define TRI_BVH_LEAF_SIZE 8
+
+struct tri_bvh_node {
+    point_t min;
+    point_t max;
+    size_t start;	// first triangle (in BVH order) under this node
+    size_t cnt;		// number of triangles under this node
+    size_t left;	// child indices, only meaningful if cnt > TRI_BVH_LEAF_SIZE
+    size_t right;
+};
+
+class TriBVH {
+    public:
+	TriBVH(const int *faces, size_t num_faces, const point_t *vertices);
+
+	bool leaf(size_t n) const { return nodes[n].cnt <= TRI_BVH_LEAF_SIZE; }
+
+	// Set up a bg_tri_soa block for the triangles under leaf n
+	void block(struct bg_tri_soa *b, size_t n) const;
+
+	std::vector<struct tri_bvh_node> nodes;
+
+	// BVH order to original face index
+	std::vector<size_t> order;
+
+	// Triangle vertex coordinates in BVH order, one array per coordinate
+	std::vector<fastf_t> c[9];
+
+    private:
+	size_t build(size_t start, size_t cnt);
+	const int *f;
+	const point_t *v;
+	std::vector<fastf_t> centers;
+};
+
+TriBVH::TriBVH(const int *faces, size_t num_faces, const point_t *vertices)
+{
+    f = faces;
+    v = vertices;
+
+    order.resize(num_faces);
+    centers.resize(3*num_faces);
+    for (size_t i = 0; i < num_faces; i++) {
+	order[i] = i;
+	for (int k = 0; k < 3; k++)
+	    centers[3*i+k] = (v[f[3*i]][k] + v[f[3*i+1]][k] + v[f[3*i+2]][k]) / 3.0;
+    }
+
+    nodes.reserve(2 * (num_faces / TRI_BVH_LEAF_SIZE + 1));
+    build(0, num_faces);
+
+    for (int k = 0; k < 9; k++)
+	c[k].resize(num_faces);
+    for (size_t i = 0; i < num_faces; i++) {
+	for (int j = 0; j < 3; j++) {
+	    const fastf_t *p = v[f[3*order[i]+j]];
+	    c[3*j+0][i] = p[X];
+	    c[3*j+1][i] = p[Y];
+	    c[3*j+2][i] = p[Z];
+	}
+    }
+}
+
+size_t
+TriBVH::build(size_t start, size_t cnt)
+{
+    size_t n = nodes.size();
+    nodes.push_back(tri_bvh_node());
+    nodes[n].start = start;
+    nodes[n].cnt = cnt;
+    nodes[n].left = nodes[n].right = 0;
+    VSETALL(nodes[n].min, MAX_FASTF);
+    VSETALL(nodes[n].max, -MAX_FASTF);
+    for (size_t i = start; i < start + cnt; i++) {
+	for (int j = 0; j < 3; j++)
+	    VMINMAX(nodes[n].min, nodes[n].max, v[f[3*order[i]+j]]);
+    }
+
+    if (cnt <= TRI_BVH_LEAF_SIZE)
+	return n;
+
+    // Median split of the triangle centers along the longest axis
+    vect_t ext;
+    VSUB2(ext, nodes[n].max, nodes[n].min);
+    int axis = (ext[X] > ext[Y]) ? ((ext[X] > ext[Z]) ? X : Z) : ((ext[Y] > ext[Z]) ? Y : Z);
+    size_t half = cnt / 2;
+    const std::vector<fastf_t> &ctr = centers;
+    std::nth_element(order.begin() + start, order.begin() + start + half, order.begin() + start + cnt,
+	    [&ctr, axis](size_t a, size_t b) { return ctr[3*a+axis] < ctr[3*b+axis]; });
+
+    size_t l = build(start, half);
+    size_t r = build(start + half, cnt - half);
+    nodes[n].left = l;
+    nodes[n].right = r;
+    return n;
+}
+
+void
+TriBVH::block(struct bg_tri_soa *b, size_t n) const
+{
+    for (int k = 0; k < 9; k++)
+	b->c[k] = c[k].data() + nodes[n].start;
+    b->n = nodes[n].cnt;
+}
+
+static bool
+node_overlap(const struct tri_bvh_node *a, const struct tri_bvh_node *b)
+{
+    return (a->min[X] <= b->max[X] && a->max[X] >= b->min[X] &&
+	    a->min[Y] <= b->max[Y] && a->max[Y] >= b->min[Y] &&
+	    a->min[Z] <= b->max[Z] && a->max[Z] >= b->min[Z]);
+}
+
+static bool
+share_vert(const int *f, size_t a, size_t b)
+{
+    for (int i = 0; i < 3; i++) {
+	for (int j = 0; j < 3; j++) {
+	    if (f[3*a+i] == f[3*b+j])
+		return true;
+	}
+    }
+    return false;
+}
+
+extern "C" size_t
+bg_trimesh_isect_pairs(
+	const int *faces_1, size_t num_faces_1, const point_t *vertices_1,
+	const int *faces_2, size_t num_faces_2, const point_t *vertices_2,
+	int (*pair_clbk)(size_t, size_t, void *), void *data)
+{
+    if (!faces_1 || !num_faces_1 || !vertices_1)
+	return 0;
+
+    bool self = (!faces_2 || (faces_2 == faces_1 && vertices_2 == vertices_1));
+    if (self) {
+	faces_2 = faces_1;
+	num_faces_2 = num_faces_1;
+	vertices_2 = vertices_1;
+    }
+    if (!num_faces_2 || !vertices_2)
+	return 0;
+
+    TriBVH b1(faces_1, num_faces_1, vertices_1);
+    TriBVH *b2p = (self) ? &b1 : new TriBVH(faces_2, num_faces_2, vertices_2);
+    TriBVH &b2 = *b2p;
+
+    size_t found = 0;
+    bool halt = false;
+    std::vector<unsigned char> mask(TRI_BVH_LEAF_SIZE);
+    std::vector<std::pair<size_t, size_t>> stack;
+    stack.push_back(std::make_pair(0, 0));
+
+    while (!stack.empty() && !halt) {
+	std::pair<size_t, size_t> np = stack.back();
+	stack.pop_back();
+	const struct tri_bvh_node *n1 = &b1.nodes[np.first];
+	const struct tri_bvh_node *n2 = &b2.nodes[np.second];
+	if (!node_overlap(n1, n2))
+	    continue;
+
+	bool l1 = b1.leaf(np.first);
+	bool l2 = b2.leaf(np.second);
+
+	if (l1 && l2) {
+	    struct bg_tri_soa blk;
+	    b2.block(&blk, np.second);
+	    for (size_t i = n1->start; i < n1->start + n1->cnt && !halt; i++) {
+		point_t V0, V1, V2;
+		VSET(V0, b1.c[0][i], b1.c[1][i], b1.c[2][i]);
+		VSET(V1, b1.c[3][i], b1.c[4][i], b1.c[5][i]);
+		VSET(V2, b1.c[6][i], b1.c[7][i], b1.c[8][i]);
+		if (!bg_tri_tri_isect_batch(mask.data(), V0, V1, V2, &blk))
+		    continue;
+		for (size_t j = 0; j < blk.n; j++) {
+		    if (!mask[j])
+			continue;
+		    size_t f1 = b1.order[i];
+		    size_t f2 = b2.order[n2->start + j];
+		    if (self) {
+			// Distinct leaves are only visited once, but within a
+			// leaf we see every pair twice.  Triangles that are
+			// merely neighbors in the mesh aren't reported.
+			if (np.first == np.second && n2->start + j <= i)
+			    continue;
+			if (share_vert(faces_1, f1, f2))
+			    continue;
+			if (f1 > f2)
+			    std::swap(f1, f2);
+		    }
+		    found++;
+		    if (pair_clbk && (*pair_clbk)(f1, f2, data)) {
+			halt = true;
+			break;
+		    }
+		}
+	    }
+	    continue;
+	}
+
+	if (self && np.first == np.second) {
+	    // A node against itself - only the distinct child pairings are needed
+	    stack.push_back(std::make_pair(n1->left, n1->left));
+	    stack.push_back(std::make_pair(n1->left, n1->right));
+	    stack.push_back(std::make_pair(n1->right, n1->right));
+	    continue;
+	}
+
+	// Descend the larger node, or the one that isn't a leaf
+	if (l2 || (!l1 && n1->cnt >= n2->cnt)) {
+	    stack.push_back(std::make_pair(n1->left, np.second));
+	    stack.push_back(std::make_pair(n1->right, np.second));
+	} else {
+	    stack.push_back(std::make_pair(np.first, n2->left));
+	    stack.push_back(std::make_pair(np.first, n2->right));
+	}
+    }
+
+    if (!self)
+	delete b2p;
+
+    return found;
+}
+
+// Local Variables:
+// tab-width: 8
+// mode: C++
+// c-basic-offset: 4
+// indent-tabs-mode: t
+// c-file-style: "stroustrup"
+// End:
+// ex: shiftwidth=4 tabstop=8
@@ -403,6 +403,126 @@ bn_noise_vec(point_t point, point_t result)
 }
 
 
+/* number of sample points processed together by the _n routines */
+#define NOISE_LANES 64
+
+/* Points with coordinates no larger than this never need folding by
+ * filter_args.  Kept well below its limit so the fast path can't
+ * disagree with it. */
+#define NOISE_FOLD_MAX 1.0e15
+
+/**
+ * Evaluate bn_noise_perlin() for n <= NOISE_LANES points held in
+ * separate coordinate arrays.  The arithmetic is the same, done in the
+ * same order, as in bn_noise_perlin() so the results are identical -
+ * the work is just arranged so the lattice setup and the final
+ * interpolation run as straight loops over all the points.
+ */
+static void
+noise_perlin_lanes(double *out, const fastf_t *px, const fastf_t *py, const fastf_t *pz, size_t n)
+{
+    double x[NOISE_LANES], y[NOISE_LANES], z[NOISE_LANES];
+    double sx[NOISE_LANES], sy[NOISE_LANES], sz[NOISE_LANES];
+    double tx[NOISE_LANES], ty[NOISE_LANES], tz[NOISE_LANES];
+    int ix[NOISE_LANES], iy[NOISE_LANES], iz[NOISE_LANES];
+    short m[8][NOISE_LANES];
+    size_t i;
+
+    /* Fold each point into the noise domain.  Points already inside
+     * it (nearly all of them) need only the absolute value, and since
+     * those values are non-negative truncation gives the same lattice
+     * point as the floor() in filter_args. */
+    for (i = 0; i < n; i++) {
+	double fx, fy, fz;
+
+	x[i] = fabs(px[i]);
+	y[i] = fabs(py[i]);
+	z[i] = fabs(pz[i]);
+	if (!(x[i] <= NOISE_FOLD_MAX && y[i] <= NOISE_FOLD_MAX && z[i] <= NOISE_FOLD_MAX)) {
+	    point_t src, p, f;
+	    int ip[3];
+	    VSET(src, px[i], py[i], pz[i]);
+	    filter_args(src, p, f, ip);
+	    x[i] = p[X];
+	    y[i] = p[Y];
+	    z[i] = p[Z];
+	}
+	ix[i] = (int)x[i];
+	iy[i] = (int)y[i];
+	iz[i] = (int)z[i];
+
+	fx = x[i] - ix[i];
+	fy = y[i] - iy[i];
+	fz = z[i] - iz[i];
+
+	sx[i] = SMOOTHSTEP(fx);
+	sy[i] = SMOOTHSTEP(fy);
+	sz[i] = SMOOTHSTEP(fz);
+
+	tx[i] = 1.0 - sx[i];
+	ty[i] = 1.0 - sy[i];
+	tz[i] = 1.0 - sz[i];
+    }
+
+    /* lattice corner lookups */
+    for (i = 0; i < n; i++) {
+	int jx = ix[i] + 1;
+	int jy = iy[i] + 1;
+	int jz = iz[i] + 1;
+	m[0][i] = Hash3d(ix[i], iy[i], iz[i]) & 0xFF;
+	m[1][i] = Hash3d(jx, iy[i], iz[i]) & 0xFF;
+	m[2][i] = Hash3d(ix[i], jy, iz[i]) & 0xFF;
+	m[3][i] = Hash3d(jx, jy, iz[i]) & 0xFF;
+	m[4][i] = Hash3d(ix[i], iy[i], jz) & 0xFF;
+	m[5][i] = Hash3d(jx, iy[i], jz) & 0xFF;
+	m[6][i] = Hash3d(ix[i], jy, jz) & 0xFF;
+	m[7][i] = Hash3d(jx, jy, jz) & 0xFF;
+    }
+
+    /* interpolate! */
+    for (i = 0; i < n; i++) {
+	double sum;
+	int jx = ix[i] + 1;
+	int jy = iy[i] + 1;
+	int jz = iz[i] + 1;
+
+	sum = INCRSUM(m[0][i], (tx[i]*ty[i]*tz[i]), (x[i]-ix[i]), (y[i]-iy[i]), (z[i]-iz[i]));
+	sum += INCRSUM(m[1][i], (sx[i]*ty[i]*tz[i]), (x[i]-jx), (y[i]-iy[i]), (z[i]-iz[i]));
+	sum += INCRSUM(m[2][i], (tx[i]*sy[i]*tz[i]), (x[i]-ix[i]), (y[i]-jy), (z[i]-iz[i]));
+	sum += INCRSUM(m[3][i], (sx[i]*sy[i]*tz[i]), (x[i]-jx), (y[i]-jy), (z[i]-iz[i]));
+	sum += INCRSUM(m[4][i], (tx[i]*ty[i]*sz[i]), (x[i]-ix[i]), (y[i]-iy[i]), (z[i]-jz));
+	sum += INCRSUM(m[5][i], (sx[i]*ty[i]*sz[i]), (x[i]-jx), (y[i]-iy[i]), (z[i]-jz));
+	sum += INCRSUM(m[6][i], (tx[i]*sy[i]*sz[i]), (x[i]-ix[i]), (y[i]-jy), (z[i]-jz));
+	sum += INCRSUM(m[7][i], (sx[i]*sy[i]*sz[i]), (x[i]-jx), (y[i]-jy), (z[i]-jz));
+	out[i] = sum;
+    }
+}
+
+
+void
+bn_noise_perlin_n(double *out, const point_t *pts, size_t n)
+{
+    fastf_t px[NOISE_LANES], py[NOISE_LANES], pz[NOISE_LANES];
+    size_t b, i;
+
+    if (!out || !pts)
+	return;
+
+    if (!ht.hashTableValid)
+	bn_noise_init();
+
+    for (b = 0; b < n; b += NOISE_LANES) {
+	size_t cnt = (n - b < NOISE_LANES) ? n - b : NOISE_LANES;
+	for (i = 0; i < cnt; i++) {
+	    px[i] = pts[b+i][X];
+	    py[i] = pts[b+i][Y];
+	    pz[i] = pts[b+i][Z];
+	}
+	noise_perlin_lanes(out + b, px, py, pz, cnt);
+    }
+}
+
+
 /**
  * Spectral Noise functions
  *
@@ -629,6 +749,80 @@ bn_noise_turb(point_t point, double h_val, double lacunarity, double octaves)
 }
 
 
+/* Shared body of bn_noise_fbm_n and bn_noise_turb_n - all the octaves
+ * for a block of points are evaluated before moving to the next block */
+static void
+noise_spectral_n(double *out, const point_t *pts, size_t n, double h_val, double lacunarity, double octaves, int turb)
+{
+    struct fbm_spec *ep;
+    fastf_t px[NOISE_LANES], py[NOISE_LANES], pz[NOISE_LANES];
+    double nv[NOISE_LANES];
+    double noise_remainder, *spec_wgts;
+    size_t b, j;
+    int i, oct;
+
+    if (!out || !pts || !n)
+	return;
+
+    if (!ht.hashTableValid)
+	bn_noise_init();
+
+    /* one spectral weights lookup for the whole set of points */
+    ep = find_spec_wgt(h_val, lacunarity, octaves);
+    spec_wgts = ep->spec_wgts;
+    oct = (int)octaves;
+    noise_remainder = octaves - (int)octaves;
+
+    for (b = 0; b < n; b += NOISE_LANES) {
+	size_t cnt = (n - b < NOISE_LANES) ? n - b : NOISE_LANES;
+	double *value = out + b;
+
+	for (j = 0; j < cnt; j++) {
+	    px[j] = pts[b+j][X];
+	    py[j] = pts[b+j][Y];
+	    pz[j] = pts[b+j][Z];
+	    value[j] = 0.0;
+	}
+
+	for (i = 0; i < oct; i++) {
+	    noise_perlin_lanes(nv, px, py, pz, cnt);
+	    if (turb) {
+		for (j = 0; j < cnt; j++)
+		    value[j] += fabs(nv[j]) * spec_wgts[i];
+	    } else {
+		for (j = 0; j < cnt; j++)
+		    value[j] += nv[j] * spec_wgts[i];
+	    }
+	    for (j = 0; j < cnt; j++) {
+		px[j] *= lacunarity;
+		py[j] *= lacunarity;
+		pz[j] *= lacunarity;
+	    }
+	}
+
+	if (!ZERO(noise_remainder)) {
+	    noise_perlin_lanes(nv, px, py, pz, cnt);
+	    for (j = 0; j < cnt; j++)
+		value[j] += noise_remainder * nv[j] * spec_wgts[i];
+	}
+    }
+}
+
+
+void
+bn_noise_fbm_n(double *out, const point_t *pts, size_t n, double h_val, double lacunarity, double octaves)
+{
+    noise_spectral_n(out, pts, n, h_val, lacunarity, octaves, 0);
+}
+
+
+void
+bn_noise_turb_n(double *out, const point_t *pts, size_t n, double h_val, double lacunarity, double octaves)
+{
+    noise_spectral_n(out, pts, n, h_val, lacunarity, octaves, 1);
+}
+
+
 double
 bn_noise_ridged(point_t point, double h_val, double lacunarity, double octaves, double offset)
 {
@@ -0,0 +1,122 @@
+/*                         N O I S E . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bu.h"
+#include "bn.h"
+
+/* Check the multi-point noise routines give exactly the single point
+ * results, and report how long each takes.
+ *
+ * Usage: bn_test noise <npts> <octaves>
+ */
+int
+noise_main(int argc, char **argv)
+{
+    size_t npts, i;
+    double octaves;
+    double h_val = 1.0;
+    double lacunarity = 2.1753974;
+    point_t *pts;
+    double *ref, *val;
+    int64_t t0, t_ref, t_n;
+    int ret = 0;
+
+    if (argc < 3) {
+	fprintf(stderr, "Usage: bn_test noise <npts> <octaves>\n");
+	return 1;
+    }
+    npts = (size_t)atoi(argv[1]);
+    octaves = atof(argv[2]);
+    if (!npts)
+	return 1;
+
+    pts = (point_t *)bu_calloc(npts, sizeof(point_t), "pts");
+    ref = (double *)bu_calloc(npts, sizeof(double), "ref");
+    val = (double *)bu_calloc(npts, sizeof(double), "val");
+
+    /* a spread of points, including some negative and very large
+     * coordinates to exercise the domain folding */
+    for (i = 0; i < npts; i++) {
+	VSET(pts[i], (i % 97) * 0.37 - 15.0, (i % 89) * 1.13, (i % 83) * 0.071 + i * 0.001);
+	if (i % 101 == 0)
+	    pts[i][X] *= 1.0e12;
+    }
+
+    /* perlin */
+    for (i = 0; i < npts; i++)
+	ref[i] = bn_noise_perlin(pts[i]);
+    bn_noise_perlin_n(val, (const point_t *)pts, npts);
+    if (memcmp(ref, val, npts * sizeof(double))) {
+	printf("bn_noise_perlin_n does not match bn_noise_perlin\n");
+	ret = 1;
+    }
+
+    /* fbm */
+    t0 = bu_gettime();
+    for (i = 0; i < npts; i++)
+	ref[i] = bn_noise_fbm(pts[i], h_val, lacunarity, octaves);
+    t_ref = bu_gettime() - t0;
+    t0 = bu_gettime();
+    bn_noise_fbm_n(val, (const point_t *)pts, npts, h_val, lacunarity, octaves);
+    t_n = bu_gettime() - t0;
+    if (memcmp(ref, val, npts * sizeof(double))) {
+	printf("bn_noise_fbm_n does not match bn_noise_fbm\n");
+	ret = 1;
+    }
+    printf("fbm:  %zu points, %g octaves: single %.3fs, multi %.3fs\n",
+	   npts, octaves, t_ref / 1.0e6, t_n / 1.0e6);
+
+    /* turbulence */
+    t0 = bu_gettime();
+    for (i = 0; i < npts; i++)
+	ref[i] = bn_noise_turb(pts[i], h_val, lacunarity, octaves);
+    t_ref = bu_gettime() - t0;
+    t0 = bu_gettime();
+    bn_noise_turb_n(val, (const point_t *)pts, npts, h_val, lacunarity, octaves);
+    t_n = bu_gettime() - t0;
+    if (memcmp(ref, val, npts * sizeof(double))) {
+	printf("bn_noise_turb_n does not match bn_noise_turb\n");
+	ret = 1;
+    }
+    printf("turb: %zu points, %g octaves: single %.3fs, multi %.3fs\n",
+	   npts, octaves, t_ref / 1.0e6, t_n / 1.0e6);
+
+    bu_free(pts, "pts");
+    bu_free(ref, "ref");
+    bu_free(val, "val");
+
+    return ret;
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
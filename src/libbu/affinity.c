@@ -120,6 +120,57 @@ parallel_set_affinity(int cpu)
 }
 
 
+int
+parallel_clear_affinity(void)
+{
+#if defined(HAVE_PTHREAD_H) && defined(CPU_ZERO) && (defined(HAVE_SYS_CPUSET_H) || defined(HAVE_SCHED_H))
+
+#if defined(HAVE_SYS_CPUSET_H) || defined(HAVE_PTHREAD_NP_H)
+    cpuset_t set_of_cpus;
+#else
+    cpu_set_t set_of_cpus;
+#endif
+    int i;
+    int ncpus = bu_avail_cpus();
+
+    CPU_ZERO(&set_of_cpus);
+    for (i = 0; i < ncpus; i++)
+	CPU_SET(i, &set_of_cpus);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(set_of_cpus), &set_of_cpus);
+
+#elif defined(HAVE_MACH_THREAD_POLICY_H)
+
+    /* Mach affinity tags are only hints, put the thread back into the
+     * default group */
+    thread_affinity_policy_data_t apolicy;
+    kern_return_t ret;
+
+    apolicy.affinity_tag = THREAD_AFFINITY_TAG_NULL;
+    ret = thread_policy_set(mach_thread_self(), THREAD_AFFINITY_POLICY, (thread_policy_t) &apolicy, THREAD_AFFINITY_POLICY_COUNT);
+    if (ret != KERN_SUCCESS)
+	return -1;
+
+    return 0;
+
+#elif defined(HAVE_WINDOWS_H)
+    DWORD_PTR procmask, sysmask;
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &procmask, &sysmask))
+	return -1;
+    if (SetThreadAffinityMask(GetCurrentThread(), procmask) == 0)
+	return -1;
+
+    return 0;
+
+#else
+
+    /* don't know how to set thread affinity on this platform */
+    return 0;
+
+#endif
+}
+
+
 /*
  * Local Variables:
  * mode: C
@@ -21,13 +21,30 @@
  *
  * Routines for creating and manipulating a key/value cache database.
  *
+ * The keys are spread by hash across several LMDB environments (shards),
+ * each in its own subdirectory of the cache directory.  Every shard has its
+ * own map size limit and its own writer lock, so the total size of the cache
+ * is not bounded by a single map and writers to different shards don't wait
+ * on each other.
+ *
+ * Readers get a read-only transaction per thread and shard, which is reset
+ * rather than freed when bu_cache_get_done is called so it can be renewed
+ * cheaply by the next lookup.  Any number of threads can read concurrently.
+ *
+ * Writes and clears are held back per shard and committed in a single
+ * transaction once enough of them have accumulated, when a lookup asks for a
+ * key with a pending change, or when the cache is closed.
+ *
  */
 
 #include "common.h"
 
+#include <atomic>
 #include <cstring>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "lmdb.h"
@@ -36,24 +53,300 @@
 #include "bu/app.h"
 #include "bu/cache.h"
 #include "bu/file.h"
+#include "bu/hash.h"
+#include "bu/log.h"
 #include "bu/malloc.h"
 #include "bu/parallel.h"
 #include "bu/path.h"
 #include "bu/str.h"
 #include "bu/vls.h"
 
-// Maximum database size.
+// Maximum database size of each shard.
 #define CACHE_MAX_DB_SIZE 4294967296
 
+// Number of LMDB environments the keys are spread across.  Must be a power
+// of two.
+#define CACHE_SHARDS 8
+
+// Pending writes per shard that trigger a commit, by count and by size.
+#define CACHE_WRITE_BATCH 64
+#define CACHE_WRITE_BATCH_BYTES (16*1024*1024)
+
+// LMDB's default reader table size, which we don't want to go below
+#define CACHE_MIN_READERS 126
+
+struct cache_write {
+    bool clear;
+    std::string data;
+};
+
+struct cache_shard {
+    MDB_env *env = NULL;
+    MDB_dbi dbi = 0;
+
+    std::mutex wlock;	// guards pending and the write transaction
+    std::unordered_map<std::string, struct cache_write> pending;
+    std::atomic<size_t> npending{0};
+    size_t pending_bytes = 0;
+};
+
 struct bu_cache_impl {
-    MDB_env *env;
-    MDB_txn *txn; // TODO - do we need to support more than one of these for parallel reading...
-    MDB_dbi dbi;
-    MDB_txn *write_txn;  // Blocking, only need one
-    MDB_dbi write_dbi;
-    struct bu_vls *fname;
+    unsigned long id;	// distinguishes this cache in the per-thread reader tables
+    struct cache_shard shards[CACHE_SHARDS];
+    size_t maxkeysize = 0;
+
+    std::mutex rlock;	// guards readers
+    std::vector<MDB_txn *> readers;	// every read txn handed out, for close
+
+    struct bu_vls *fname = NULL;
+};
+
+struct cache_reader {
+    MDB_txn *txn;
+    int active;		// outstanding bu_cache_get calls
 };
 
+static std::atomic<unsigned long> cache_next_id{1};
+
+// Open caches by id, so an exiting thread can tell whether the caches it
+// read from are still open.  The lock is held while a cache is closed.
+static std::mutex cache_open_lock;
+static std::unordered_map<unsigned long, struct bu_cache_impl *> cache_open;
+
+// Each thread's read transactions, per open cache and shard.  They are
+// given back when the thread exits, so threads coming and going don't use
+// up the shards' reader tables.
+struct cache_thread_readers {
+    std::unordered_map<unsigned long, std::vector<struct cache_reader>> m;
+    ~cache_thread_readers();
+};
+
+static thread_local struct cache_thread_readers cache_readers;
+
+
+cache_thread_readers::~cache_thread_readers()
+{
+    std::lock_guard<std::mutex> oguard(cache_open_lock);
+    for (auto &rv : m) {
+	auto c_it = cache_open.find(rv.first);
+	if (c_it == cache_open.end())
+	    continue;	// closing the cache already freed them
+	struct bu_cache_impl *ci = c_it->second;
+	std::lock_guard<std::mutex> rguard(ci->rlock);
+	for (auto &r : rv.second) {
+	    if (!r.txn)
+		continue;
+	    for (size_t i = 0; i < ci->readers.size(); i++) {
+		if (ci->readers[i] == r.txn) {
+		    ci->readers[i] = ci->readers.back();
+		    ci->readers.pop_back();
+		    break;
+		}
+	    }
+	    mdb_txn_abort(r.txn);
+	    r.txn = NULL;
+	}
+    }
+}
+
+
+static int
+cache_shard_index(const char *key, size_t klen)
+{
+    return (int)(bu_data_hash(key, klen) & (CACHE_SHARDS - 1));
+}
+
+
+// Remove every pending key from the shard, for when the batch as a whole
+// could not be committed.  A write that can't be stored must not leave the
+// old value readable any more than a clear can.
+static void
+cache_shard_drop(struct cache_shard *s)
+{
+    MDB_txn *txn = NULL;
+    if (mdb_txn_begin(s->env, NULL, 0, &txn))
+	return;
+    for (auto &p : s->pending) {
+	MDB_val mdb_key;
+	mdb_key.mv_size = p.first.length();
+	mdb_key.mv_data = (void *)p.first.data();
+	// Not finding the key isn't a problem
+	(void)mdb_del(txn, s->dbi, &mdb_key, NULL);
+    }
+    if (mdb_txn_commit(txn))
+	bu_log("bu_cache: unable to remove keys whose update failed\n");
+}
+
+
+// Commit everything pending in the shard.  Caller holds s->wlock.  Returns
+// 0 on success and -1 if the batch could not be stored, in which case its
+// keys are dropped from the cache.
+static int
+cache_shard_flush(struct cache_shard *s)
+{
+    if (s->pending.empty())
+	return 0;
+
+    MDB_txn *txn = NULL;
+    int rc = mdb_txn_begin(s->env, NULL, 0, &txn);
+    if (!rc) {
+	for (auto &p : s->pending) {
+	    MDB_val mdb_key;
+	    mdb_key.mv_size = p.first.length();
+	    mdb_key.mv_data = (void *)p.first.data();
+	    if (p.second.clear) {
+		// Not finding the key isn't a problem
+		(void)mdb_del(txn, s->dbi, &mdb_key, NULL);
+		continue;
+	    }
+	    MDB_val mdb_data;
+	    mdb_data.mv_size = p.second.data.length();
+	    mdb_data.mv_data = (void *)p.second.data.data();
+	    rc = mdb_put(txn, s->dbi, &mdb_key, &mdb_data, 0);
+	    if (rc)
+		break;
+	}
+	if (rc) {
+	    mdb_txn_abort(txn);
+	} else {
+	    rc = mdb_txn_commit(txn);
+	}
+    }
+
+    // Most likely the shard is full - it's a cache, so we drop the batch
+    // rather than leave it pending forever, but the clears still have to
+    // happen
+    if (rc)
+	cache_shard_drop(s);
+
+    s->pending.clear();
+    s->pending_bytes = 0;
+    s->npending = 0;
+
+    return (rc) ? -1 : 0;
+}
+
+
+// Queue a write or clear, committing the shard if the batch is full.
+// Returns -1 if that commit failed.
+static int
+cache_shard_queue(struct cache_shard *s, const char *key, size_t klen, const void *data, size_t dsize, bool clear)
+{
+    std::lock_guard<std::mutex> guard(s->wlock);
+
+    struct cache_write &w = s->pending[std::string(key, klen)];
+    s->pending_bytes -= w.data.length();
+    w.clear = clear;
+    if (clear)
+	w.data.clear();
+    else
+	w.data.assign((const char *)data, dsize);
+    s->pending_bytes += w.data.length();
+    s->npending = s->pending.size();
+
+    if (s->pending.size() >= CACHE_WRITE_BATCH || s->pending_bytes >= CACHE_WRITE_BATCH_BYTES)
+	return cache_shard_flush(s);
+
+    return 0;
+}
+
+
+// Get this thread's read transaction on shard si, starting or renewing it if
+// it isn't already in use by an earlier lookup
+static struct cache_reader *
+cache_reader_acquire(struct bu_cache_impl *ci, int si)
+{
+    std::vector<struct cache_reader> &rv = cache_readers.m[ci->id];
+    if (rv.empty())
+	rv.resize(CACHE_SHARDS, {NULL, 0});
+
+    // An active reader can't be renewed without invalidating the data its
+    // earlier lookups returned, so it keeps its snapshot of the shard.
+    struct cache_reader *r = &rv[si];
+    if (r->active) {
+	r->active++;
+	return r;
+    }
+
+    if (!r->txn) {
+	if (mdb_txn_begin(ci->shards[si].env, NULL, MDB_RDONLY, &r->txn)) {
+	    r->txn = NULL;
+	    return NULL;
+	}
+	std::lock_guard<std::mutex> guard(ci->rlock);
+	ci->readers.push_back(r->txn);
+    } else if (mdb_txn_renew(r->txn)) {
+	return NULL;
+    }
+
+    r->active = 1;
+    return r;
+}
+
+
+static int
+cache_mkdirs(const char *cache_db)
+{
+    char cdb[MAXPATHLEN];
+
+    // Ensure the necessary top level dirs are present
+    bu_dir(cdb, MAXPATHLEN, BU_DIR_CACHE, NULL);
+    if (!bu_file_exists(cdb, NULL))
+	bu_mkdir(cdb);
+
+    // Break cache_db up into component directories with bu_path_component,
+    // making sure each one exists
+    std::vector<std::string> dirs;
+    struct bu_vls cdbd = BU_VLS_INIT_ZERO;
+    struct bu_vls ctmp = BU_VLS_INIT_ZERO;
+    bu_path_component(&cdbd, cache_db, BU_PATH_DIRNAME);
+    while (bu_vls_strlen(&cdbd)) {
+	bu_path_component(&ctmp, bu_vls_cstr(&cdbd), BU_PATH_BASENAME);
+	dirs.push_back(std::string(bu_vls_cstr(&cdbd)));
+	bu_vls_sprintf(&ctmp, "%s", bu_vls_cstr(&cdbd));
+	bu_path_component(&cdbd, bu_vls_cstr(&ctmp), BU_PATH_DIRNAME);
+    }
+    bu_dir(cdb, MAXPATHLEN, BU_DIR_CACHE, NULL);
+    bu_vls_sprintf(&ctmp, "%s", cdb);
+    for (long long i = dirs.size() - 1; i >= 0; i--) {
+	bu_vls_printf(&ctmp, "/%s", dirs[i].c_str());
+	if (!bu_file_exists(bu_vls_cstr(&ctmp), NULL))
+	    bu_mkdir((char *)bu_vls_cstr(&ctmp));
+    }
+    bu_vls_free(&cdbd);
+    bu_vls_free(&ctmp);
+
+    bu_dir(cdb, MAXPATHLEN, BU_DIR_CACHE, cache_db, NULL);
+    if (!bu_file_exists(cdb, NULL))
+	bu_mkdir(cdb);
+
+    return bu_file_exists(cdb, NULL);
+}
+
+
+static void
+cache_impl_free(struct bu_cache_impl *ci)
+{
+    {
+	std::lock_guard<std::mutex> oguard(cache_open_lock);
+	cache_open.erase(ci->id);
+	for (size_t i = 0; i < ci->readers.size(); i++)
+	    mdb_txn_abort(ci->readers[i]);
+	ci->readers.clear();
+    }
+    cache_readers.m.erase(ci->id);
+
+    for (int i = 0; i < CACHE_SHARDS; i++) {
+	if (ci->shards[i].env)
+	    mdb_env_close(ci->shards[i].env);
+    }
+
+    bu_vls_free(ci->fname);
+    BU_PUT(ci->fname, struct bu_vls);
+    delete ci;
+}
+
+
 struct bu_cache *
 bu_cache_open(const char *cache_db, int create)
 {
@@ -68,73 +361,86 @@ bu_cache_open(const char *cache_db, int create)
 	// in that situation, we need to bail
 	if (!create)
 	    return NULL;
-
-	// Ensure the necessary top level dirs are present
-	bu_dir(cdb, MAXPATHLEN, BU_DIR_CACHE, NULL);
-	if (!bu_file_exists(cdb, NULL))
-	    bu_mkdir(cdb);
-
-	// Break cache_db up into component directories with bu_path_component,
-	// making sure each one exists
-	std::vector<std::string> dirs;
-	struct bu_vls cdbd = BU_VLS_INIT_ZERO;
-	struct bu_vls ctmp = BU_VLS_INIT_ZERO;
-	bu_path_component(&cdbd, cache_db, BU_PATH_DIRNAME);
-	while (bu_vls_strlen(&cdbd)) {
-	    bu_path_component(&ctmp, bu_vls_cstr(&cdbd), BU_PATH_BASENAME);
-	    dirs.push_back(std::string(bu_vls_cstr(&cdbd)));
-	    bu_vls_sprintf(&ctmp, "%s", bu_vls_cstr(&cdbd));
-	    bu_path_component(&cdbd, bu_vls_cstr(&ctmp), BU_PATH_DIRNAME);
-	}
-	bu_dir(cdb, MAXPATHLEN, BU_DIR_CACHE, NULL);
-	bu_vls_sprintf(&ctmp, "%s", cdb);
-	for (long long i = dirs.size() - 1; i >= 0; i--) {
-	    bu_vls_printf(&ctmp, "/%s", dirs[i].c_str());
-	    if (!bu_file_exists(bu_vls_cstr(&ctmp), NULL))
-		bu_mkdir((char *)bu_vls_cstr(&ctmp));
-	}
-
-	bu_dir(cdb, MAXPATHLEN, BU_DIR_CACHE, cache_db, NULL);
+	if (!cache_mkdirs(cache_db))
+	    return NULL;
     }
 
-    struct bu_cache *c = NULL;
-    BU_GET(c, struct bu_cache);
-    BU_GET(c->i, struct bu_cache_impl);
-    BU_GET(c->i->fname, struct bu_vls);
-    bu_vls_init(c->i->fname);
-    bu_vls_sprintf(c->i->fname, "%s", cdb);
+    struct bu_cache_impl *ci = new bu_cache_impl;
+    ci->id = cache_next_id++;
+    BU_GET(ci->fname, struct bu_vls);
+    bu_vls_init(ci->fname);
+    bu_vls_sprintf(ci->fname, "%s", cdb);
 
-    // Base maximum readers on an estimate of how many threads
-    // we might want to fire off
+    // Every thread reading from the cache holds on to a reader slot in each
+    // shard until the cache is closed or the thread exits, so base the maximum readers on an
+    // estimate of how many threads we might want to fire off
     size_t mreaders = std::thread::hardware_concurrency();
     if (!mreaders)
 	mreaders = 1;
     int ncpus = bu_avail_cpus();
     if (ncpus > 0 && (size_t)ncpus > mreaders)
 	mreaders = (size_t)ncpus + 2;
+    if (mreaders < CACHE_MIN_READERS)
+	mreaders = CACHE_MIN_READERS;
+
+    // Set up LMDB environments, one per shard subdirectory
+    struct bu_vls sdir = BU_VLS_INIT_ZERO;
+    for (int i = 0; i < CACHE_SHARDS; i++) {
+	struct cache_shard *s = &ci->shards[i];
+	bu_vls_sprintf(&sdir, "%s/%d", cdb, i);
+	if (!bu_file_exists(bu_vls_cstr(&sdir), NULL))
+	    bu_mkdir(bu_vls_cstr(&sdir));
+
+	if (mdb_env_create(&s->env)) {
+	    s->env = NULL;
+	    goto bu_context_fail;
+	}
+	if (mdb_env_set_maxreaders(s->env, mreaders))
+	    goto bu_context_fail;
+	if (mdb_env_set_mapsize(s->env, CACHE_MAX_DB_SIZE))
+	    goto bu_context_fail;
+
+	// Read transactions are per thread, but are not tied to thread
+	// local storage so they can be reset, renewed and, at close,
+	// cleaned up from any thread.
+	//
+	// Need to call mdb_env_sync() at appropriate points.
+	if (mdb_env_open(s->env, bu_vls_cstr(&sdir), MDB_NOSYNC | MDB_NOTLS, 0664))
+	    goto bu_context_fail;
+
+	// Open the database handle once - it is valid for all later
+	// transactions in this environment
+	MDB_txn *txn = NULL;
+	if (mdb_txn_begin(s->env, NULL, 0, &txn))
+	    goto bu_context_fail;
+	if (mdb_dbi_open(txn, NULL, 0, &s->dbi)) {
+	    mdb_txn_abort(txn);
+	    goto bu_context_fail;
+	}
+	if (mdb_txn_commit(txn))
+	    goto bu_context_fail;
+    }
+    bu_vls_free(&sdir);
 
-    // Set up LMDB environments
-    if (mdb_env_create(&c->i->env))
-	goto bu_context_fail;
-    if (mdb_env_set_maxreaders(c->i->env, mreaders))
-	goto bu_context_close_fail;
-    if (mdb_env_set_mapsize(c->i->env, CACHE_MAX_DB_SIZE))
-	goto bu_context_close_fail;
+    {
+	int mkeysize = mdb_env_get_maxkeysize(ci->shards[0].env);
+	ci->maxkeysize = (mkeysize > 0) ? (size_t)mkeysize : 0;
+    }
 
-    // Need to call mdb_env_sync() at appropriate points.
-    if (mdb_env_open(c->i->env, cdb, MDB_NOSYNC, 0664))
-	goto bu_context_close_fail;
+    {
+	std::lock_guard<std::mutex> oguard(cache_open_lock);
+	cache_open[ci->id] = ci;
+    }
 
     // Success - return the context
+    struct bu_cache *c;
+    BU_GET(c, struct bu_cache);
+    c->i = ci;
     return c;
 
-bu_context_close_fail:
-    mdb_env_close(c->i->env);
 bu_context_fail:
-    bu_vls_free(c->i->fname);
-    BU_PUT(c->i->fname, struct bu_vls);
-    BU_PUT(c->i, struct bu_cache_impl);
-    BU_PUT(c, struct bu_cache);
+    bu_vls_free(&sdir);
+    cache_impl_free(ci);
     return NULL;
 }
 
@@ -144,10 +450,13 @@ bu_cache_close(struct bu_cache *c)
     if (!c)
 	return;
 
-    mdb_env_close(c->i->env);
-    bu_vls_free(c->i->fname);
-    BU_PUT(c->i->fname, struct bu_vls);
-    BU_PUT(c->i, struct bu_cache_impl);
+    for (int i = 0; i < CACHE_SHARDS; i++) {
+	struct cache_shard *s = &c->i->shards[i];
+	std::lock_guard<std::mutex> guard(s->wlock);
+	(void)cache_shard_flush(s);
+    }
+
+    cache_impl_free(c->i);
     BU_PUT(c, struct bu_cache);
 }
 
@@ -168,27 +477,37 @@ bu_cache_get(void **data, const char *key, struct bu_cache *c)
     if (!data || !c || !key)
 	return 0;
 
-    int mkeysize = mdb_env_get_maxkeysize(c->i->env);
-    if (mkeysize <= 0 || strlen(key) > (size_t)mkeysize)
+    (*data) = NULL;
+
+    size_t klen = strlen(key);
+    if (!klen || klen > c->i->maxkeysize)
 	return 0;
 
-    MDB_val mdb_key;
-    MDB_val mdb_data[2];
+    int si = cache_shard_index(key, klen);
+    struct cache_shard *s = &c->i->shards[si];
 
-    if (!c->i->txn) {
-	mdb_txn_begin(c->i->env, NULL, 0, &c->i->txn);
-	mdb_dbi_open(c->i->txn, NULL, 0, &c->i->dbi);
+    // If this key has a change waiting to be committed, commit the shard so
+    // the lookup sees it.  The count check keeps readers from touching the
+    // write lock when nothing is pending.
+    if (s->npending) {
+	std::lock_guard<std::mutex> guard(s->wlock);
+	if (s->pending.find(std::string(key, klen)) != s->pending.end())
+	    (void)cache_shard_flush(s);
     }
-    mdb_key.mv_size = strlen(key)*sizeof(char);
+
+    struct cache_reader *r = cache_reader_acquire(c->i, si);
+    if (!r)
+	return 0;
+
+    MDB_val mdb_key;
+    MDB_val mdb_data;
+    mdb_key.mv_size = klen*sizeof(char);
     mdb_key.mv_data = (void *)key;
-    int rc = mdb_get(c->i->txn, c->i->dbi, &mdb_key, &mdb_data[0]);
-    if (rc) {
-	(*data) = NULL;
+    if (mdb_get(r->txn, s->dbi, &mdb_key, &mdb_data))
 	return 0;
-    }
-    (*data) = mdb_data[0].mv_data;
 
-    return mdb_data[0].mv_size;
+    (*data) = mdb_data.mv_data;
+    return mdb_data.mv_size;
 }
 
 void
@@ -197,36 +516,38 @@ bu_cache_get_done(const char *key, struct bu_cache *c)
     if (!key || !c)
 	return;
 
-    mdb_txn_commit(c->i->txn);
-    c->i->txn = NULL;
+    size_t klen = strlen(key);
+    if (!klen || klen > c->i->maxkeysize)
+	return;
+
+    auto rv = cache_readers.m.find(c->i->id);
+    if (rv == cache_readers.m.end() || rv->second.empty())
+	return;
+
+    struct cache_reader *r = &rv->second[cache_shard_index(key, klen)];
+    if (!r->active)
+	return;
+
+    // Keep the transaction handle around for the next lookup
+    r->active--;
+    if (!r->active)
+	mdb_txn_reset(r->txn);
 }
 
 size_t
-bu_cache_write(void *data, size_t dsize, char *key, struct bu_cache *c)
+bu_cache_write(void *data, size_t dsize, const char *key, struct bu_cache *c)
 {
     if (!data || !key || !c)
 	return 0;
 
-    int mkeysize = mdb_env_get_maxkeysize(c->i->env);
-    if (mkeysize <= 0 || strlen(key) > (size_t)mkeysize)
+    size_t klen = strlen(key);
+    if (!klen || klen > c->i->maxkeysize)
 	return 0;
 
-    // Prepare inputs for writing
-    MDB_val mdb_key;
-    MDB_val mdb_data[2];
+    int si = cache_shard_index(key, klen);
+    if (cache_shard_queue(&c->i->shards[si], key, klen, data, dsize, false))
+	return 0;
 
-    // Write out key/value to LMDB database, where the key is the hash
-    // and the value is the serialized LoD data
-    mdb_txn_begin(c->i->env, NULL, 0, &c->i->write_txn);
-    mdb_dbi_open(c->i->write_txn, NULL, 0, &c->i->write_dbi);
-    mdb_key.mv_size = strlen(key)*sizeof(char);
-    mdb_key.mv_data = (void *)key;
-    mdb_data[0].mv_size = dsize;
-    mdb_data[0].mv_data = data;
-    mdb_data[1].mv_size = 0;
-    mdb_data[1].mv_data = NULL;
-    mdb_put(c->i->write_txn, c->i->write_dbi, &mdb_key, mdb_data, 0);
-    mdb_txn_commit(c->i->write_txn);
     return dsize;
 }
 
@@ -236,15 +557,12 @@ bu_cache_clear(const char *key, struct bu_cache *c)
     if (!key || !c)
 	return;
 
-    // Construct lookup key
-    MDB_val mdb_key;
+    size_t klen = strlen(key);
+    if (!klen || klen > c->i->maxkeysize)
+	return;
 
-    mdb_txn_begin(c->i->env, NULL, 0, &c->i->write_txn);
-    mdb_dbi_open(c->i->write_txn, NULL, 0, &c->i->write_dbi);
-    mdb_key.mv_size = strlen(key)*sizeof(char);
-    mdb_key.mv_data = (void *)key;
-    mdb_del(c->i->write_txn, c->i->write_dbi, &mdb_key, NULL);
-    mdb_txn_commit(c->i->write_txn);
+    int si = cache_shard_index(key, klen);
+    cache_shard_queue(&c->i->shards[si], key, klen, NULL, 0, true);
 }
 
 // Local Variables:
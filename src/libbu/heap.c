@@ -21,6 +21,7 @@
 #include "common.h"
 
 #include <stdlib.h> /* for getenv, atoi, and atexit */
+#include <string.h>
 
 #include "bu/debug.h"
 #include "bu/log.h"
@@ -29,36 +30,63 @@
 #include "bu/vls.h"
 
 /**
- * This number specifies the range of byte sizes to support for fast
- * memory allocations.  Any request outside this range will get passed
- * to bu_calloc().
- *
- * 1-to-HEAP_BINS byte size allocations are allocated in PAGESIZE chunks as
- * they are requested.  There's minimal penalty for making this
- * arbitrarily large except where there are very few allocations (each
- * size will allocate at least one page).  PAGESIZE should be some
- * multiple larger than HEAP_BINS.
- *
- * Embedded or memory-constrained environments probably want to set
- * this a lot smaller than the default.
+ * Requests are rounded up to a multiple of HEAP_GRANULE bytes, which
+ * also keeps every object handed out suitably aligned for any type.
+ * There is a size class (bin) per granule, so HEAP_BINS*HEAP_GRANULE
+ * is the largest allocation served from the heap.  Any request
+ * outside this range will get passed to bu_calloc().
  */
-#define HEAP_BINS 256
+#define HEAP_GRANULE 16
+#define HEAP_BINS 64
+#define HEAP_MAX (HEAP_BINS * HEAP_GRANULE)
 
 /**
- * This specifies how much memory we should preallocate for each
- * allocation size.  Note that this number should be some multiple of
- * HEAP_BINS and system page size in order to be useful.  Ideally sized to
- * keep the allocation size with the most requests down to
- * single-digit page counts.  Testing showed a 1M page size was very
- * effective at eliminating allocation overhead.
+ * This specifies how much memory we preallocate at a time for each
+ * thread.  All size classes are carved from the same page, so a
+ * thread that only uses a few sizes doesn't tie up a page per size.
+ * Note that this number should be some multiple of HEAP_MAX and the
+ * system page size in order to be useful.
  *
  * Embedded or memory-constrained environments probably want to set
  * this a lot smaller than the default.
  */
-#define HEAP_PAGESIZE (HEAP_BINS * 256)
+#define HEAP_PAGESIZE (HEAP_MAX * 256)
 
+/**
+ * Released objects are kept on a per-thread free list for their size
+ * class and reused by that thread without any locking.  Once a thread
+ * has more than HEAP_CACHE_MAX of one size on hand (e.g., because it
+ * is freeing what another thread allocated), HEAP_BATCH of them are
+ * moved to a shared list where any thread that runs out can pick them
+ * up in one go.
+ */
+#define HEAP_BATCH 64
+#define HEAP_CACHE_MAX (HEAP_BATCH * 4)
+
+
+/**
+ * a released object.  the first object in a batch on the shared
+ * lists also links to the next batch.
+ */
+struct heap_free {
+    struct heap_free *next;
+    struct heap_free *batch;
+};
 
 struct heap {
+    /** released objects of this size ready for reuse */
+    struct heap_free *free;
+    size_t nfree;
+
+    /** statistics */
+    size_t gets;
+    size_t puts;
+};
+
+struct cpus {
+    /** each allocation size class gets a bin */
+    struct heap heap[HEAP_BINS];
+
     /**
      * pages is an array of memory pages.  they are allocated one at a
      * time so we only have to keep track of the last page.
@@ -72,15 +100,10 @@ struct heap {
     size_t count;
 
     /**
-     * given tabulates how much memory the current page has been
-     * allocated to callers.  not a counter to avoid a multiply.
+     * given tabulates how much of the current page has been handed
+     * out to callers.
      */
     size_t given;
-};
-
-struct cpus {
-    /** each allocation size gets a bin for holding memory pages */
-    struct heap heap[HEAP_BINS];
 
     /** keep track of allocation sizes outside our supported range */
     size_t misses;
@@ -88,9 +111,21 @@ struct cpus {
 
 /**
  * store data in a cpu-specific structure so we can avoid the need for
- * mutex locking entirely.  relies on static zero-initialization.
+ * mutex locking on the common paths.  relies on static
+ * zero-initialization.  threads numbered MAX_PSW and up (only seen
+ * with deeply nested bu_parallel() calls) share the last one, under
+ * BU_SEM_HEAP.
  */
-static struct cpus per_cpu[MAX_PSW] = {{{{0, 0, 0}}, 0}};
+static struct cpus per_cpu[MAX_PSW+1];
+
+/**
+ * batches of released objects shared between threads, per size class.
+ * protected by BU_SEM_HEAP.
+ */
+static struct heap_free *shared[HEAP_BINS];
+static size_t shared_batches[HEAP_BINS];
+
+int BU_SEM_HEAP;
 
 /* Need a function signature that matches bu_heap_func_t, so wrap bu_log in
  * order to allow it to act as the default bu_heap_log function. */
@@ -127,11 +162,11 @@ heap_print(void)
     static int printed = 0;
 
     size_t h, i;
-    size_t allocs = 0;
+    size_t gets = 0;
+    size_t puts = 0;
     size_t misses = 0;
-    size_t got = 0;
     size_t total_pages = 0;
-    size_t ncpu = bu_avail_cpus();
+    size_t batches = 0;
 
     bu_heap_func_t log = bu_heap_log(NULL);
 
@@ -148,57 +183,132 @@ heap_print(void)
 	"Memory Heap Information\n"
 	"-----------------------\n", NULL);
 
-    for (h=0; h < ncpu; h++) {
-	for (i=0; i < HEAP_BINS; i++) {
-
-	    /* capacity across all pages */
-	    got = per_cpu[h].heap[i].count * (HEAP_PAGESIZE/(i+1));
+    for (i=0; i < HEAP_BINS; i++) {
+	size_t bgets = 0;
+	size_t bputs = 0;
+	size_t cached = 0;
 
-	    if (got > 0) {
-		/* last page is partial */
-		got -= (HEAP_PAGESIZE - per_cpu[h].heap[i].given)/(i+1);
-		bu_vls_sprintf(&str, "%04zu [%02zu] => %zu\n", i, per_cpu[h].heap[i].count, got);
-		log(bu_vls_addr(&str), NULL);
-		allocs += got;
-	    }
-	    total_pages += per_cpu[h].heap[i].count;
+	for (h=0; h < MAX_PSW; h++) {
+	    bgets += per_cpu[h].heap[i].gets;
+	    bputs += per_cpu[h].heap[i].puts;
+	    cached += per_cpu[h].heap[i].nfree;
 	}
+	if (bgets > 0 || bputs > 0) {
+	    bu_vls_sprintf(&str, "%04zu [%zu cached, %zu shared] => %zu gets, %zu puts\n",
+			   (i+1) * HEAP_GRANULE, cached, shared_batches[i] * HEAP_BATCH, bgets, bputs);
+	    log(bu_vls_addr(&str), NULL);
+	}
+	gets += bgets;
+	puts += bputs;
+	batches += shared_batches[i];
+    }
+    for (h=0; h < MAX_PSW; h++) {
+	total_pages += per_cpu[h].count;
 	misses += per_cpu[h].misses;
     }
     bu_vls_sprintf(&str, "-----------------------\n"
-		   "size [pages] => count\n"
+		   "size [cached, shared] => count\n"
 		   "Heap range: 1-%d bytes\n"
 		   "Page size: %d bytes\n"
 		   "Pages: %zu (%.2lfMB)\n"
-		   "%zu allocs, %zu misses\n"
+		   "Shared batches: %zu\n"
+		   "%zu allocs, %zu frees, %zu misses\n"
 		   "=======================\n",
-		   HEAP_BINS,
+		   HEAP_MAX,
 		   HEAP_PAGESIZE,
 		   total_pages,
 		   (double)(total_pages * HEAP_PAGESIZE) / (1024.0*1024.0),
-		   allocs,
+		   batches,
+		   gets,
+		   puts,
 		   misses);
     log(bu_vls_addr(&str), NULL);
     bu_vls_free(&str);
 }
 
 
+/* move up to HEAP_BATCH objects from a thread's bin to the shared list */
+static void
+heap_release(struct heap *heap, size_t bin)
+{
+    struct heap_free *first, *last;
+    size_t n = 1;
+
+    first = last = heap->free;
+    if (!first)
+	return;
+    while (n < HEAP_BATCH && last->next) {
+	last = last->next;
+	n++;
+    }
+    heap->free = last->next;
+    heap->nfree -= n;
+    last->next = NULL;
+
+    bu_semaphore_acquire(BU_SEM_HEAP);
+    first->batch = shared[bin];
+    shared[bin] = first;
+    shared_batches[bin]++;
+    bu_semaphore_release(BU_SEM_HEAP);
+}
+
+
+/* give a thread's empty bin a batch from the shared list, if any */
+static void
+heap_refill(struct heap *heap, size_t bin)
+{
+    struct heap_free *first, *f;
+
+    if (!shared[bin])
+	return;
+
+    bu_semaphore_acquire(BU_SEM_HEAP);
+    first = shared[bin];
+    if (first) {
+	shared[bin] = first->batch;
+	shared_batches[bin]--;
+    }
+    bu_semaphore_release(BU_SEM_HEAP);
+
+    heap->free = first;
+    for (f = first; f; f = f->next)
+	heap->nfree++;
+}
+
+
+/* look up the calling thread's heap, locking if it is shared */
+static struct cpus *
+heap_cpu(void)
+{
+    int id = bu_parallel_id();
+
+    if (LIKELY(id >= 0 && id < MAX_PSW))
+	return &per_cpu[id];
+
+    bu_semaphore_acquire(BU_SEM_HEAP);
+    return &per_cpu[MAX_PSW];
+}
+
+
+static void
+heap_cpu_done(struct cpus *cpu)
+{
+    if (UNLIKELY(cpu == &per_cpu[MAX_PSW]))
+	bu_semaphore_release(BU_SEM_HEAP);
+}
+
+
 void *
 bu_heap_get(size_t sz)
 {
     char *ret;
-    register size_t smo = sz-1;
     static int registered = 0;
-    int oncpu;
+    size_t bin, csz;
+    struct cpus *cpu;
     struct heap *heap;
 
-    /* what thread are we? */
-    oncpu = bu_parallel_id();
-
+    if (UNLIKELY(sz > HEAP_MAX || sz == 0)) {
 #ifdef DEBUG
-    if (sz > HEAP_BINS || sz == 0) {
-	per_cpu[oncpu].misses++;
-
 	if (bu_debug) {
 	    bu_log("DEBUG: heap size %zd out of range\n", sz);
 
@@ -206,40 +316,56 @@ bu_heap_get(size_t sz)
 		bu_bomb("Intentionally bombing due to BU_DEBUG_COREDUMP\n");
 	    }
 	}
+#endif
+	cpu = heap_cpu();
+	cpu->misses++;
+	heap_cpu_done(cpu);
 	return bu_calloc(1, sz, "heap calloc");
     }
-#endif
 
-    heap = &per_cpu[oncpu].heap[smo];
+    /* what thread are we? */
+    cpu = heap_cpu();
+
+    bin = (sz - 1) / HEAP_GRANULE;
+    heap = &cpu->heap[bin];
+    heap->gets++;
+
+    /* reuse */
+    if (!heap->free && cpu != &per_cpu[MAX_PSW])
+	heap_refill(heap, bin);
+    if (heap->free) {
+	ret = (char *)heap->free;
+	heap->free = heap->free->next;
+	heap->nfree--;
+	heap_cpu_done(cpu);
+	memset(ret, 0, sz);
+	return (void *)ret;
+    }
 
     /* init */
-    if (heap->count == 0) {
-
+    if (UNLIKELY(cpu->count == 0)) {
 	if (registered++ == 0) {
 	    ret = getenv("BU_HEAP_PRINT");
 	    if ((++registered == 2) && (ret && atoi(ret) > 0)) {
 		atexit(heap_print);
 	    }
 	}
-
-	heap->count++;
-	heap->pages = (char **)bu_malloc(1 * sizeof(char *), "heap malloc pages[]");
-	heap->pages[0] = (char *)bu_calloc(1, HEAP_PAGESIZE, "heap calloc pages[][0]");
-	heap->given = 0;
     }
 
     /* grow */
-    if (heap->given+sz > HEAP_PAGESIZE) {
-	heap->count++;
-	heap->pages = (char **)bu_realloc(heap->pages, heap->count * sizeof(char *), "heap realloc pages[]");
-	heap->pages[heap->count-1] = (char *)bu_calloc(1, HEAP_PAGESIZE, "heap calloc pages[][]");
-	heap->given = 0;
+    csz = (bin + 1) * HEAP_GRANULE;
+    if (cpu->count == 0 || cpu->given + csz > HEAP_PAGESIZE) {
+	cpu->count++;
+	cpu->pages = (char **)bu_realloc(cpu->pages, cpu->count * sizeof(char *), "heap realloc pages[]");
+	cpu->pages[cpu->count-1] = (char *)bu_calloc(1, HEAP_PAGESIZE, "heap calloc pages[][]");
+	cpu->given = 0;
     }
 
     /* give */
-    ret = &(heap->pages[heap->count-1][heap->given]);
-    heap->given += sz;
+    ret = &(cpu->pages[cpu->count-1][cpu->given]);
+    cpu->given += csz;
 
+    heap_cpu_done(cpu);
     return (void *)ret;
 }
 
@@ -247,19 +373,60 @@ bu_heap_get(size_t sz)
 void
 bu_heap_put(void *ptr, size_t sz)
 {
-    if (sz > HEAP_BINS || sz == 0) {
+    struct heap_free *f;
+    struct cpus *cpu;
+    struct heap *heap;
+    size_t bin;
+
+    if (!ptr) {
+	/* compaction request */
+	bu_heap_flush(bu_parallel_id());
+	return;
+    }
+
+    if (UNLIKELY(sz > HEAP_MAX || sz == 0)) {
 	bu_free(ptr, "heap free");
 	return;
     }
 
-    /* TODO: actually do something useful :) */
+    cpu = heap_cpu();
+
+    bin = (sz - 1) / HEAP_GRANULE;
+    heap = &cpu->heap[bin];
+    heap->puts++;
+
+    f = (struct heap_free *)ptr;
+    f->next = heap->free;
+    heap->free = f;
+    heap->nfree++;
 
-    return;
+    /* hand surplus to the other threads */
+    if (UNLIKELY(heap->nfree > HEAP_CACHE_MAX) && cpu != &per_cpu[MAX_PSW])
+	heap_release(heap, bin);
+
+    heap_cpu_done(cpu);
+}
+
+
+void
+bu_heap_flush(int cpu)
+{
+    size_t i;
+
+    /* the shared heap is already available to everyone */
+    if (cpu < 0 || cpu >= MAX_PSW)
+	return;
+
+    for (i = 0; i < HEAP_BINS; i++) {
+	struct heap *heap = &per_cpu[cpu].heap[i];
+	while (heap->free)
+	    heap_release(heap, i);
+    }
 }
 
 
 /* sanity */
-#if HEAP_PAGESIZE < HEAP_BINS
+#if HEAP_PAGESIZE < HEAP_MAX
 #  error "ERROR: heap page size cannot be smaller than bin range"
 #endif
 
@@ -491,10 +491,42 @@ parallel_interface_arg_stub(struct thread_data *user_thread_data)
 }
 #endif
 
+#  if defined(HAVE_PTHREAD_H)
+static void
+parallel_interface_job(void *utd)
+{
+    (void)parallel_interface_arg(utd);
+}
+#  endif
+
 #endif /* !HAVE_THREAD_LOCAL || !CPP11THREAD */
 #endif /* PARALLEL */
 
 
+int
+parallel_id_claim(void)
+{
+#if defined(PARALLEL) && (!defined(HAVE_THREAD_LOCAL) || !defined(CPP11THREAD))
+    return parallel_mapping(PARALLEL_GET, -1, 0)->id;
+#else
+    return 0;
+#endif
+}
+
+
+void
+parallel_id_release(int id)
+{
+#if defined(PARALLEL) && (!defined(HAVE_THREAD_LOCAL) || !defined(CPP11THREAD))
+    if (id > 0)
+	(void)parallel_mapping(PARALLEL_PUT, id, 0);
+#else
+    if (id)
+	return;
+#endif
+}
+
+
 void
 bu_parallel(void (*func)(int, void *), size_t ncpu, void *arg)
 {
@@ -526,9 +558,12 @@ bu_parallel(void (*func)(int, void *), size_t ncpu, void *arg)
 #else
 
     struct thread_data *thread_context;
+#  if !defined(HAVE_PTHREAD_H) || (defined(SUNOS) && SUNOS >= 52)
     rt_thread_t thread_tbl[MAX_PSW];
-    size_t x;
+    rt_thread_t thread;
     size_t i;
+#  endif
+    size_t x;
 
     /* number of threads created/ended */
     size_t nthreadc;
@@ -544,8 +579,6 @@ bu_parallel(void (*func)(int, void *), size_t ncpu, void *arg)
 
     struct parallel_info *parent;
 
-    rt_thread_t thread;
-
     if (!func)
 	return; /* nothing to do */
 
@@ -699,70 +732,31 @@ bu_parallel(void (*func)(int, void *), size_t ncpu, void *arg)
 
 #  if defined(HAVE_PTHREAD_H)
 
-    /* Create the posix threads.
-     *
-     * Start at 1 so we can treat the parent as thread 0.
+    /* Run each thread's share on a pool thread.  Pool threads persist
+     * between calls, so this avoids creating and joining ncpu threads
+     * every time.  The pool takes care of CPU affinity, preferring
+     * threads that are already locked onto the wanted CPU.
      */
-    nthreadc = 0;
-    for (x = 0; x < ncpu; x++) {
-	pthread_attr_t attrs;
-	pthread_attr_init(&attrs);
-	pthread_attr_setstacksize(&attrs, 10*1024*1024);
+    {
+	struct parallel_pool_group *group = parallel_pool_group_create();
 
-	parallel_wait_for_slot(throttle, parent, ncpu);
+	nthreadc = 0;
+	for (x = 0; x < ncpu; x++) {
+	    int cpu = (thread_context[x].affinity) ? thread_context[x].cpu_id : -1;
+	    thread_context[x].affinity = 0;
 
-	if (pthread_create(&thread, &attrs, parallel_interface_arg, &thread_context[x])) {
-	    bu_log("ERROR: bu_parallel: pthread_create(0x0, 0x0, 0x%lx, 0x0, 0, %p) failed for processor thread # %zu\n",
-		   (unsigned long int)parallel_interface_arg, (void *)&thread, x);
+	    parallel_wait_for_slot(throttle, parent, ncpu);
 
-	} else {
-	    if (UNLIKELY(bu_debug & BU_DEBUG_PARALLEL)) {
-		bu_log("bu_parallel(): created thread: (thread: %p) (loop: %zu) (nthreadc: %zu)\n",
-		       (void*)thread, x, nthreadc);
-	    }
-	    thread_tbl[nthreadc] = thread;
+	    parallel_pool_run(group, parallel_interface_job, &thread_context[x], cpu);
 	    nthreadc++;
 	}
 
-	/* done with the attributes after create */
-	pthread_attr_destroy(&attrs);
-    }
-
-    if (UNLIKELY(bu_debug & BU_DEBUG_PARALLEL)) {
-	for (i = 0; i < nthreadc; i++) {
-	    bu_log("bu_parallel(): thread_tbl[%zu] = %p\n", i, (void *)thread_tbl[i]);
-	}
-    }
-
-    /*
-     * Wait for completion of all threads.
-     * Wait for them in order.
-     */
-    nthreade = 0;
-    for (x = 0; x < nthreadc; x++) {
-	int ret;
-
-	if (UNLIKELY(bu_debug & BU_DEBUG_PARALLEL))
-	    bu_log("bu_parallel(): waiting for thread %p to complete:\t(loop:%zu) (nthreadc:%zu) (nthreade:%zu)\n",
-		   (void *)thread_tbl[x], x, nthreadc, nthreade);
-
-	if ((ret = pthread_join(thread_tbl[x], NULL)) != 0) {
-	    /* badness happened */
-	    bu_log("pthread_join(thread_tbl[%zu]=%p) ret=%d\n", x, (void *)thread_tbl[x], ret);
-	}
-
-	nthreade++;
-	thread = thread_tbl[x];
-	thread_tbl[x] = (rt_thread_t)-1;
-
-	if (UNLIKELY(bu_debug & BU_DEBUG_PARALLEL))
-	    bu_log("bu_parallel(): thread completed: (thread: %p)\t(loop:%zu) (nthreadc:%zu) (nthreade:%zu)\n",
-		   (void *)thread, x, nthreadc, nthreade);
-
+	parallel_pool_wait(group);
+	nthreade = nthreadc;
     }
 
     if (UNLIKELY(bu_debug & BU_DEBUG_PARALLEL))
-	bu_log("bu_parallel(): %zu threads created.  %zu threads exited.\n", nthreadc, nthreade);
+	bu_log("bu_parallel(): %zu threads run.  %zu threads finished.\n", nthreadc, nthreade);
 
 #  endif /* end if posix threads */
 
@@ -21,6 +21,10 @@
 #ifndef LIBBU_PARALLEL_H
 #define LIBBU_PARALLEL_H
 
+#include "common.h"
+
+__BEGIN_DECLS
+
 /**
  * Set affinity mask of current thread to the CPU set it is currently
  * running on. If it is not running on any CPUs in the set, it is
@@ -33,9 +37,43 @@
  */
 extern int parallel_set_affinity(int cpu);
 
+/**
+ * Let the current thread run on any CPU again after
+ * parallel_set_affinity().
+ *
+ * Return:
+ *  0 on Success
+ * -1 on Failure
+ */
+extern int parallel_clear_affinity(void);
+
 extern void thread_set_cpu(int cpu);
 extern int thread_get_cpu(void);
 
+/**
+ * Claim a free parallel ID for a thread not started by bu_parallel(),
+ * such as a task worker, and give it back again.
+ */
+extern int parallel_id_claim(void);
+extern void parallel_id_release(int id);
+
+/**
+ * Persistent threads for bu_parallel() and the task API.
+ *
+ * parallel_pool_run() starts func(arg) on a thread of its own right
+ * away, reusing an idle pool thread if there is one and creating a
+ * new one otherwise.  If cpu is not negative the thread is locked
+ * onto that CPU, idle threads already there being preferred.  Every
+ * function run in a group is finished once parallel_pool_wait()
+ * returns, which also releases the group.
+ */
+struct parallel_pool_group;
+extern struct parallel_pool_group *parallel_pool_group_create(void);
+extern void parallel_pool_run(struct parallel_pool_group *group, void (*func)(void *), void *arg, int cpu);
+extern void parallel_pool_wait(struct parallel_pool_group *group);
+
+__END_DECLS
+
 #endif /* LIBBU_PARALLEL_H */
 
 /*
@@ -24,11 +24,29 @@
 #include <vector>
 #include <stddef.h>
 
+#include "./parallel.h"
+
+
+struct cpp11thread_job {
+    void (*func)(int, void *);
+    int cpu;
+    void *arg;
+};
+
+
+static void
+cpp11thread_run(void *data)
+{
+    struct cpp11thread_job *job = (struct cpp11thread_job *)data;
+    job->func(job->cpu, job->arg);
+}
+
 
 extern "C" void
 parallel_cpp11thread(void (*func)(int, void *), size_t ncpu, void *arg)
 {
-    std::vector<std::thread> threads;
+    std::vector<struct cpp11thread_job> jobs;
+    struct parallel_pool_group *group;
 
     if (!ncpu) {
 	ncpu = std::thread::hardware_concurrency();
@@ -41,13 +59,18 @@ parallel_cpp11thread(void (*func)(int, void *), size_t ncpu, void *arg)
 	    return func((int)ncpu, arg);
     }
 
-    /* Create and run threads. */
-    for (size_t i = 0; i < ncpu; ++i)
-	threads.emplace_back(func, i, arg);
+    /* Run on pool threads, which persist between calls. */
+    jobs.resize(ncpu);
+    group = parallel_pool_group_create();
+    for (size_t i = 0; i < ncpu; ++i) {
+	jobs[i].func = func;
+	jobs[i].cpu = (int)i;
+	jobs[i].arg = arg;
+	parallel_pool_run(group, cpp11thread_run, &jobs[i], -1);
+    }
 
     /* Wait for the parallel task to complete. */
-    for (size_t i = 0; i < threads.size(); ++i)
-	threads[i].join();
+    parallel_pool_wait(group);
 }
 
 
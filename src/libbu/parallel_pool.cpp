@@ -0,0 +1,527 @@
+/*                P A R A L L E L _ P O O L . C P P
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file parallel_pool.cpp
+ *
+ * Persistent worker threads behind bu_parallel(), and the task API
+ * built on them.
+ *
+ * Applications such as animation renders call bu_parallel() thousands
+ * of times, and creating and joining every thread each time adds up.
+ * Pool threads instead go idle when their function returns and are
+ * handed the next one, retiring only after sitting idle for a while.
+ * bu_parallel() still gets one thread per requested cpu, since its
+ * callbacks are free to wait on each other.
+ *
+ * Tasks run on a fixed set of pool threads, one less than the number
+ * of cpus, with the thread waiting in bu_task_wait() running queued
+ * tasks itself.  Nested task submission and bu_parallel_for() calls
+ * therefore never need more threads than there are cpus.
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_PTHREAD_H
+#  include <pthread.h>
+#endif
+
+#include "bu/log.h"
+#include "bu/parallel.h"
+
+#include "./parallel.h"
+
+
+/* Seconds an idle pool thread waits for more work before exiting */
+#define POOL_IDLE_SEC 30
+
+/* Same stack as the threads bu_parallel() used to create itself */
+#define POOL_STACK_SIZE (10*1024*1024)
+
+
+struct pool_worker {
+    std::condition_variable cv;
+    void (*func)(void *);
+    void *arg;
+    struct parallel_pool_group *group;
+    int want_cpu;	/* CPU to run func on, -1 for any */
+    int cpu;		/* CPU this thread is locked onto, -1 for none */
+};
+
+struct parallel_pool_group {
+    std::mutex m;
+    std::condition_variable cv;
+    size_t pending;
+};
+
+struct pool {
+    std::mutex m;
+    std::vector<struct pool_worker *> idle;
+};
+
+
+/* Never destroyed, so idle threads stay valid until the process exits */
+static struct pool &
+pool_get(void)
+{
+    static struct pool *p = new struct pool;
+    return *p;
+}
+
+
+static void
+pool_done(struct parallel_pool_group *group)
+{
+    if (!group)
+	return;
+
+    /* the waiter frees the group as soon as it can lock it */
+    std::lock_guard<std::mutex> glock(group->m);
+    if (--group->pending == 0)
+	group->cv.notify_all();
+}
+
+
+static void
+pool_worker_main(struct pool_worker *w)
+{
+    struct pool &p = pool_get();
+    std::unique_lock<std::mutex> lock(p.m);
+
+    while (1) {
+	void (*func)(void *);
+	void *arg;
+	struct parallel_pool_group *group;
+	int want_cpu;
+
+	while (!w->func) {
+	    if (w->cv.wait_for(lock, std::chrono::seconds(POOL_IDLE_SEC)) == std::cv_status::timeout && !w->func) {
+		/* retire */
+		for (size_t i = 0; i < p.idle.size(); i++) {
+		    if (p.idle[i] == w) {
+			p.idle.erase(p.idle.begin() + i);
+			break;
+		    }
+		}
+		lock.unlock();
+		delete w;
+		return;
+	    }
+	}
+
+	func = w->func;
+	arg = w->arg;
+	group = w->group;
+	want_cpu = w->want_cpu;
+	w->func = NULL;
+	lock.unlock();
+
+	if (want_cpu != w->cpu) {
+	    int ret = (want_cpu >= 0) ? parallel_set_affinity(want_cpu) : parallel_clear_affinity();
+	    if (ret)
+		bu_log("WARNING: encountered unexpected problem setting CPU affinity\n");
+	    w->cpu = want_cpu;
+	}
+
+	func(arg);
+	pool_done(group);
+
+	lock.lock();
+	p.idle.push_back(w);
+    }
+}
+
+
+#ifdef HAVE_PTHREAD_H
+static void *
+pool_worker_start(void *w)
+{
+    pool_worker_main((struct pool_worker *)w);
+    return NULL;
+}
+#endif
+
+
+/* Start a thread for w, returning non-zero if that failed */
+static int
+pool_worker_create(struct pool_worker *w)
+{
+#ifdef HAVE_PTHREAD_H
+    pthread_t thread;
+    pthread_attr_t attrs;
+    int ret;
+
+    pthread_attr_init(&attrs);
+    pthread_attr_setstacksize(&attrs, POOL_STACK_SIZE);
+    pthread_attr_setdetachstate(&attrs, PTHREAD_CREATE_DETACHED);
+    ret = pthread_create(&thread, &attrs, pool_worker_start, w);
+    pthread_attr_destroy(&attrs);
+
+    return ret;
+#else
+    try {
+	std::thread(pool_worker_main, w).detach();
+    } catch (...) {
+	return -1;
+    }
+    return 0;
+#endif
+}
+
+
+extern "C" struct parallel_pool_group *
+parallel_pool_group_create(void)
+{
+    struct parallel_pool_group *group = new struct parallel_pool_group;
+    group->pending = 0;
+    return group;
+}
+
+
+extern "C" void
+parallel_pool_run(struct parallel_pool_group *group, void (*func)(void *), void *arg, int cpu)
+{
+    struct pool &p = pool_get();
+    struct pool_worker *w = NULL;
+
+    if (!func)
+	return;
+
+    if (group) {
+	std::lock_guard<std::mutex> glock(group->m);
+	group->pending++;
+    }
+
+    {
+	std::lock_guard<std::mutex> lock(p.m);
+
+	if (!p.idle.empty()) {
+	    /* most recently idle, or one already on the wanted CPU */
+	    size_t i = p.idle.size() - 1;
+	    if (cpu >= 0) {
+		for (size_t j = p.idle.size(); j > 0; j--) {
+		    if (p.idle[j-1]->cpu == cpu) {
+			i = j - 1;
+			break;
+		    }
+		}
+	    }
+	    w = p.idle[i];
+	    p.idle.erase(p.idle.begin() + i);
+
+	    w->func = func;
+	    w->arg = arg;
+	    w->group = group;
+	    w->want_cpu = cpu;
+	    w->cv.notify_one();
+	    return;
+	}
+    }
+
+    w = new struct pool_worker;
+    w->func = func;
+    w->arg = arg;
+    w->group = group;
+    w->want_cpu = cpu;
+    w->cpu = -1;
+
+    if (pool_worker_create(w)) {
+	bu_log("ERROR: unable to create a thread, running the work in the calling thread\n");
+	delete w;
+	func(arg);
+	pool_done(group);
+    }
+}
+
+
+extern "C" void
+parallel_pool_wait(struct parallel_pool_group *group)
+{
+    if (!group)
+	return;
+
+    {
+	std::unique_lock<std::mutex> glock(group->m);
+	while (group->pending)
+	    group->cv.wait(glock);
+    }
+    delete group;
+}
+
+
+/**********************************************************************/
+
+
+struct bu_task {
+    void (*func)(void *);
+    void *data;
+    int done;
+};
+
+struct task_queue {
+    std::mutex m;
+    std::condition_variable work;	/* tasks were queued */
+    std::condition_variable done;	/* a task finished */
+    std::deque<struct bu_task *> q;
+    size_t nworkers;
+    size_t nwaiting;
+};
+
+
+static struct task_queue &
+task_queue_get(void)
+{
+    static struct task_queue *tq = new struct task_queue;
+    return *tq;
+}
+
+
+static void
+task_worker(void *UNUSED(arg))
+{
+    struct task_queue &tq = task_queue_get();
+    std::unique_lock<std::mutex> lock(tq.m);
+    int id = 0;
+
+    while (1) {
+	struct bu_task *t;
+
+	if (tq.q.empty()) {
+	    if (id) {
+		/* only hold a parallel ID while there is work */
+		lock.unlock();
+		thread_set_cpu(0);
+		parallel_id_release(id);
+		id = 0;
+		lock.lock();
+		continue;
+	    }
+	    tq.work.wait(lock);
+	    continue;
+	}
+
+	t = tq.q.front();
+	tq.q.pop_front();
+	lock.unlock();
+
+	if (!id) {
+	    id = parallel_id_claim();
+	    thread_set_cpu(id);
+	}
+	t->func(t->data);
+
+	lock.lock();
+	t->done = 1;
+	tq.done.notify_all();
+    }
+}
+
+
+/* Start the task workers the first time they are needed */
+static void
+task_workers_start(struct task_queue &tq)
+{
+    const char *libbu_affinity;
+    int affinity = 0;
+    size_t i, n;
+
+    {
+	std::lock_guard<std::mutex> lock(tq.m);
+	if (tq.nworkers)
+	    return;
+	n = bu_avail_cpus();
+	n = (n > 2) ? n - 1 : 1;
+	if (n > MAX_PSW)
+	    n = MAX_PSW;
+	tq.nworkers = n;
+    }
+
+    libbu_affinity = getenv("LIBBU_AFFINITY");
+    if (libbu_affinity)
+	affinity = (int)strtol(libbu_affinity, NULL, 0x10);
+
+    /* the thread waiting on tasks is the last cpu */
+    for (i = 0; i < n; i++)
+	parallel_pool_run(NULL, task_worker, NULL, affinity ? (int)i : -1);
+}
+
+
+extern "C" struct bu_task *
+bu_task_submit(void (*func)(void *data), void *data)
+{
+    struct bu_task *t;
+
+    if (!func)
+	return NULL;
+
+    t = new struct bu_task;
+    t->func = func;
+    t->data = data;
+    t->done = 0;
+
+#ifdef PARALLEL
+    {
+	struct task_queue &tq = task_queue_get();
+	task_workers_start(tq);
+
+	std::lock_guard<std::mutex> lock(tq.m);
+	tq.q.push_back(t);
+	tq.work.notify_one();
+	if (tq.nwaiting)
+	    tq.done.notify_all();
+    }
+#else
+    func(data);
+    t->done = 1;
+#endif
+
+    return t;
+}
+
+
+extern "C" void
+bu_task_wait(struct bu_task *task)
+{
+    struct task_queue &tq = task_queue_get();
+
+    if (!task)
+	return;
+
+    {
+	std::unique_lock<std::mutex> lock(tq.m);
+	while (!task->done) {
+	    if (!tq.q.empty()) {
+		/* help out rather than block, newest first since that
+		 * is most likely what we are waiting on */
+		struct bu_task *t = tq.q.back();
+		tq.q.pop_back();
+		lock.unlock();
+		t->func(t->data);
+		lock.lock();
+		t->done = 1;
+		tq.done.notify_all();
+		continue;
+	    }
+	    tq.nwaiting++;
+	    tq.done.wait(lock);
+	    tq.nwaiting--;
+	}
+    }
+
+    delete task;
+}
+
+
+struct parallel_for_data {
+    size_t begin;
+    size_t end;
+    size_t grain;
+    size_t nchunks;
+    std::atomic<size_t> next;
+    void (*func)(size_t, size_t, void *);
+    void *data;
+};
+
+
+static void
+parallel_for_chunks(void *d)
+{
+    struct parallel_for_data *pf = (struct parallel_for_data *)d;
+
+    while (1) {
+	size_t c = pf->next++;
+	size_t first, last;
+
+	if (c >= pf->nchunks)
+	    return;
+
+	first = pf->begin + c * pf->grain;
+	last = (pf->end - first > pf->grain) ? first + pf->grain : pf->end;
+	pf->func(first, last, pf->data);
+    }
+}
+
+
+extern "C" void
+bu_parallel_for(size_t begin, size_t end, size_t grain, void (*func)(size_t first, size_t last, void *data), void *data)
+{
+    struct parallel_for_data pf;
+    size_t ntasks, nworkers = 1;
+    std::vector<struct bu_task *> tasks;
+
+    if (!func || end <= begin)
+	return;
+
+#ifdef PARALLEL
+    {
+	struct task_queue &tq = task_queue_get();
+	task_workers_start(tq);
+	nworkers = tq.nworkers;
+    }
+#endif
+
+    /* by default, a few chunks per thread to even out the load */
+    if (!grain) {
+	grain = (end - begin) / (4 * (nworkers + 1));
+	if (!grain)
+	    grain = 1;
+    }
+
+    pf.begin = begin;
+    pf.end = end;
+    pf.grain = grain;
+    pf.nchunks = (end - begin) / grain + (((end - begin) % grain) ? 1 : 0);
+    pf.next = 0;
+    pf.func = func;
+    pf.data = data;
+
+    ntasks = pf.nchunks - 1;
+    if (ntasks > nworkers)
+	ntasks = nworkers;
+#ifndef PARALLEL
+    ntasks = 0;
+#endif
+
+    for (size_t i = 0; i < ntasks; i++)
+	tasks.push_back(bu_task_submit(parallel_for_chunks, &pf));
+
+    /* the calling thread takes chunks too */
+    parallel_for_chunks(&pf);
+
+    for (size_t i = 0; i < tasks.size(); i++)
+	bu_task_wait(tasks[i]);
+}
+
+
+// Local Variables:
+// tab-width: 8
+// mode: C++
+// c-basic-offset: 4
+// indent-tabs-mode: t
+// c-file-style: "stroustrup"
+// End:
+// ex: shiftwidth=4 tabstop=8
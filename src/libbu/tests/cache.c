@@ -0,0 +1,243 @@
+/*                       C A C H E . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file cache.c
+ *
+ * Concurrent get/put testing and timing of the bu_cache key/value store.
+ *
+ */
+
+#include "common.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bu.h"
+#include "bu/cache.h"
+
+
+#define CACHE_TEST_DB "bu_cache_test"
+
+struct cache_test_data {
+    struct bu_cache *c;
+    size_t nkeys;
+    size_t ncpu;
+    size_t next_slot;
+    size_t bad[MAX_PSW];
+};
+
+
+/* bu_parallel cpu ids need not run from 0 to ncpu-1, so each thread
+ * claims its own dense slot */
+static size_t
+cache_test_slot(struct cache_test_data *td)
+{
+    size_t slot;
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    slot = td->next_slot++;
+    bu_semaphore_release(BU_SEM_GENERAL);
+    return slot;
+}
+
+
+static void
+cache_test_key(char *key, size_t len, size_t i)
+{
+    snprintf(key, len, "key_%zu", i);
+}
+
+
+/* The value stored for key i is a run of i % 251 + 1 bytes, each (i % 256) */
+static size_t
+cache_test_val(unsigned char *val, size_t i)
+{
+    size_t len = i % 251 + 1;
+    memset(val, (int)(i % 256), len);
+    return len;
+}
+
+
+static int
+cache_test_check(struct bu_cache *c, size_t i)
+{
+    char key[64];
+    unsigned char expect[256];
+    void *data = NULL;
+    size_t len, elen;
+    int ret = 0;
+
+    cache_test_key(key, sizeof(key), i);
+    elen = cache_test_val(expect, i);
+    len = bu_cache_get(&data, key, c);
+    if (len != elen || !data || memcmp(data, expect, elen))
+	ret = 1;
+    bu_cache_get_done(key, c);
+
+    return ret;
+}
+
+
+/* Each thread writes its share of the keys, reading back everything it
+ * has written every so often */
+static void
+cache_test_put(int UNUSED(cpu), void *d)
+{
+    struct cache_test_data *td = (struct cache_test_data *)d;
+    size_t slot = cache_test_slot(td);
+    unsigned char val[256];
+    char key[64];
+    size_t i, len;
+
+    for (i = slot; i < td->nkeys; i += td->ncpu) {
+	cache_test_key(key, sizeof(key), i);
+	len = cache_test_val(val, i);
+	if (bu_cache_write(val, len, key, td->c) != len)
+	    td->bad[slot]++;
+	if (i % 97 == slot)
+	    td->bad[slot] += cache_test_check(td->c, i);
+    }
+}
+
+
+/* Every thread reads every key */
+static void
+cache_test_get(int UNUSED(cpu), void *d)
+{
+    struct cache_test_data *td = (struct cache_test_data *)d;
+    size_t slot = cache_test_slot(td);
+    size_t i;
+
+    for (i = 0; i < td->nkeys; i++)
+	td->bad[slot] += cache_test_check(td->c, (i + slot * 7919) % td->nkeys);
+}
+
+
+static size_t
+cache_test_bad(struct cache_test_data *td)
+{
+    size_t i, bad = 0;
+    for (i = 0; i < MAX_PSW; i++)
+	bad += td->bad[i];
+    memset(td->bad, 0, sizeof(td->bad));
+    return bad;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    const char * const USAGE = "Usage: %s [-P ncpu] [-n nkeys]\n";
+
+    struct cache_test_data td;
+    char cdir[MAXPATHLEN];
+    int64_t start;
+    size_t i, bad;
+    void *data = NULL;
+    int c;
+
+    // Normally this file is part of bu_test, so only set this if it
+    // looks like the program name is still unset.
+    if (bu_getprogname()[0] == '\0')
+	bu_setprogname(argv[0]);
+
+    memset(&td, 0, sizeof(td));
+    td.nkeys = 20000;
+    td.ncpu = bu_avail_cpus();
+
+    while ((c = bu_getopt(argc, argv, "P:n:")) != -1) {
+	switch (c) {
+	    case 'P':
+		td.ncpu = (size_t)strtoul(bu_optarg, NULL, 0);
+		if (td.ncpu < 1 || td.ncpu >= MAX_PSW)
+		    td.ncpu = bu_avail_cpus();
+		break;
+	    case 'n':
+		td.nkeys = (size_t)strtoul(bu_optarg, NULL, 0);
+		break;
+	    default:
+		bu_exit(1, USAGE, argv[0]);
+	}
+    }
+
+    /* Keep the test out of the user's cache */
+    bu_dir(cdir, MAXPATHLEN, BU_DIR_CURR, "bu_cache_test.d", NULL);
+    if (!bu_file_exists(cdir, NULL))
+	bu_mkdir(cdir);
+    bu_setenv("BU_DIR_CACHE", cdir, 1);
+
+    bu_cache_erase(CACHE_TEST_DB);
+    td.c = bu_cache_open(CACHE_TEST_DB, 1);
+    if (!td.c)
+	bu_exit(1, "bu_cache_open failed\n");
+
+    start = bu_gettime();
+    td.next_slot = 0;
+    bu_parallel(cache_test_put, td.ncpu, &td);
+    bad = cache_test_bad(&td);
+    bu_log("put %zu keys on %zu cpus: %.3fs\n", td.nkeys, td.ncpu, (bu_gettime() - start) / 1.0e6);
+    if (bad) {
+	bu_log("bu_cache concurrent put [FAIL] (%zu bad)\n", bad);
+	return 1;
+    }
+    bu_log("bu_cache concurrent put [PASS]\n");
+
+    start = bu_gettime();
+    td.next_slot = 0;
+    bu_parallel(cache_test_get, td.ncpu, &td);
+    bad = cache_test_bad(&td);
+    bu_log("get %zu keys on %zu cpus: %.3fs\n", td.nkeys * td.ncpu, td.ncpu, (bu_gettime() - start) / 1.0e6);
+    if (bad) {
+	bu_log("bu_cache concurrent get [FAIL] (%zu bad)\n", bad);
+	return 1;
+    }
+    bu_log("bu_cache concurrent get [PASS]\n");
+
+    /* Cleared keys go away, and everything else survives a reopen */
+    bu_cache_clear("key_0", td.c);
+    bu_cache_close(td.c);
+    td.c = bu_cache_open(CACHE_TEST_DB, 0);
+    if (!td.c)
+	bu_exit(1, "bu_cache_open of existing cache failed\n");
+    if (bu_cache_get(&data, "key_0", td.c))
+	bad++;
+    bu_cache_get_done("key_0", td.c);
+    for (i = 1; i < td.nkeys; i++)
+	bad += cache_test_check(td.c, i);
+    bu_cache_close(td.c);
+    if (bad) {
+	bu_log("bu_cache clear and reopen [FAIL] (%zu bad)\n", bad);
+	return 1;
+    }
+    bu_log("bu_cache clear and reopen [PASS]\n");
+
+    bu_cache_erase(CACHE_TEST_DB);
+    bu_dirclear(cdir);
+
+    return 0;
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
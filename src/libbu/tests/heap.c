@@ -28,15 +28,291 @@
 #include "bu.h"
 
 
-/* this should match what is in heap.c */
-#define HEAP_BINS 512
+/* this should match HEAP_MAX in heap.c */
+#define HEAP_MAX 1024
 
 #define CNTCALLS
 
 
+struct heap_ops {
+    const char *name;
+    void *(*get)(size_t sz);
+    void (*put)(void *ptr, size_t sz);
+};
+
+static void *
+heap_sys_get(size_t sz)
+{
+    return bu_calloc(1, sz, "heap test");
+}
+
+static void
+heap_sys_put(void *ptr, size_t UNUSED(sz))
+{
+    bu_free(ptr, "heap test");
+}
+
+static const struct heap_ops heap_ops[2] = {
+    {"bu_heap", bu_heap_get, bu_heap_put},
+    {"bu_calloc", heap_sys_get, heap_sys_put}
+};
+
+
+/* stamp an object so overlapping allocations show up when it's released */
+static void
+heap_stamp(void *ptr, size_t sz, size_t tag)
+{
+    size_t i;
+    unsigned char *c = (unsigned char *)ptr;
+    for (i = 0; i < sz; i++)
+	c[i] = (unsigned char)(tag + i);
+}
+
+static int
+heap_stamped(const void *ptr, size_t sz, size_t tag)
+{
+    size_t i;
+    const unsigned char *c = (const unsigned char *)ptr;
+    for (i = 0; i < sz; i++) {
+	if (c[i] != (unsigned char)(tag + i))
+	    return 0;
+    }
+    return 1;
+}
+
+static int
+heap_zeroed(const void *ptr, size_t sz)
+{
+    size_t i;
+    const unsigned char *c = (const unsigned char *)ptr;
+    for (i = 0; i < sz; i++) {
+	if (c[i])
+	    return 0;
+    }
+    return 1;
+}
+
+
+/* Tree walk workload: per-thread binary trees of small nodes, each
+ * with a larger state record hanging off it (like union tree and
+ * db_tree_state in db_walk_tree), built and torn down over and over.
+ */
+
+struct heap_tree_node {
+    struct heap_tree_node *left;
+    struct heap_tree_node *right;
+    void *state;
+    size_t tag;
+};
+
+#define HEAP_TREE_STATE 184
+
+struct heap_work {
+    const struct heap_ops *ops;
+    size_t ncpu;
+    size_t iterations;
+    size_t next_row;	/* nmg workload: rows are claimed by the workers */
+    size_t bad[MAX_PSW];
+    void **slots;	/* nmg workload: ncpu rows of iterations objects */
+    size_t *sizes;
+};
+
+static struct heap_tree_node *
+heap_tree_build(const struct heap_ops *ops, size_t depth, size_t *tag, size_t *bad)
+{
+    struct heap_tree_node *n = (struct heap_tree_node *)ops->get(sizeof(struct heap_tree_node));
+    if (!heap_zeroed(n, sizeof(struct heap_tree_node)))
+	(*bad)++;
+    n->tag = (*tag)++;
+    n->state = ops->get(HEAP_TREE_STATE);
+    heap_stamp(n->state, HEAP_TREE_STATE, n->tag);
+    if (depth > 0) {
+	n->left = heap_tree_build(ops, depth - 1, tag, bad);
+	n->right = heap_tree_build(ops, depth - 1, tag, bad);
+    }
+    return n;
+}
+
+static void
+heap_tree_free(const struct heap_ops *ops, struct heap_tree_node *n, size_t *bad)
+{
+    if (!n)
+	return;
+    heap_tree_free(ops, n->left, bad);
+    heap_tree_free(ops, n->right, bad);
+    if (!heap_stamped(n->state, HEAP_TREE_STATE, n->tag))
+	(*bad)++;
+    ops->put(n->state, HEAP_TREE_STATE);
+    ops->put(n, sizeof(struct heap_tree_node));
+}
+
+static void
+heap_tree_work(int cpu, void *data)
+{
+    struct heap_work *w = (struct heap_work *)data;
+    size_t i, tag = 0;
+    size_t bad = 0;
+
+    for (i = 0; i < w->iterations; i++) {
+	struct heap_tree_node *root = heap_tree_build(w->ops, 12, &tag, &bad);
+	heap_tree_free(w->ops, root, &bad);
+    }
+
+    w->bad[cpu % MAX_PSW] += bad;
+}
+
+
+/* NMG boolean workload: lots of differently sized topology records
+ * with mixed lifetimes, many of which are released by a different
+ * thread than the one that made them.
+ */
+
+static const size_t heap_nmg_sizes[] = {32, 40, 64, 72, 88, 96, 120, 136, 152, 200};
+#define HEAP_NMG_NSIZES (sizeof(heap_nmg_sizes)/sizeof(heap_nmg_sizes[0]))
+
+static void
+heap_nmg_alloc(struct heap_work *w, size_t row, size_t i, size_t salt)
+{
+    size_t k = row * w->iterations + i;
+    size_t sz = heap_nmg_sizes[(k * 7 + salt) % HEAP_NMG_NSIZES];
+    w->sizes[k] = sz;
+    w->slots[k] = w->ops->get(sz);
+    heap_stamp(w->slots[k], sz, k + salt);
+}
+
+static void
+heap_nmg_release(struct heap_work *w, size_t row, size_t i, size_t salt, size_t *bad)
+{
+    size_t k = row * w->iterations + i;
+    if (!heap_stamped(w->slots[k], w->sizes[k], k + salt))
+	(*bad)++;
+    w->ops->put(w->slots[k], w->sizes[k]);
+    w->slots[k] = NULL;
+}
+
+/* each worker claims a row, since bu_parallel() cpu numbers aren't
+ * necessarily 0 to ncpu-1 */
+static size_t
+heap_nmg_row(struct heap_work *w)
+{
+    size_t row;
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    row = w->next_row++;
+    bu_semaphore_release(BU_SEM_GENERAL);
+    return row;
+}
+
+/* each worker fills its own row */
+static void
+heap_nmg_make(int UNUSED(cpu), void *data)
+{
+    struct heap_work *w = (struct heap_work *)data;
+    size_t row = heap_nmg_row(w);
+    size_t i;
+
+    for (i = 0; i < w->iterations; i++)
+	heap_nmg_alloc(w, row, i, 0);
+}
+
+/* each worker churns the even slots of its own row, then frees the odd
+ * slots of its neighbor's */
+static void
+heap_nmg_churn(int cpu, void *data)
+{
+    struct heap_work *w = (struct heap_work *)data;
+    size_t row = heap_nmg_row(w);
+    size_t other = (row + 1) % w->ncpu;
+    size_t i, bad = 0;
+
+    for (i = 0; i < w->iterations; i += 4) {
+	heap_nmg_release(w, row, i, 0, &bad);
+	heap_nmg_alloc(w, row, i, 1);
+	heap_nmg_release(w, row, i, 1, &bad);
+	heap_nmg_alloc(w, row, i, 0);
+    }
+    for (i = 1; i < w->iterations; i += 2)
+	heap_nmg_release(w, other, i, 0, &bad);
+
+    w->bad[cpu % MAX_PSW] += bad;
+}
+
+/* and then the even slots are freed by yet another worker */
+static void
+heap_nmg_kill(int cpu, void *data)
+{
+    struct heap_work *w = (struct heap_work *)data;
+    size_t victim = (heap_nmg_row(w) + 2) % w->ncpu;
+    size_t i, bad = 0;
+
+    for (i = 0; i < w->iterations; i += 2)
+	heap_nmg_release(w, victim, i, 0, &bad);
+
+    w->bad[cpu % MAX_PSW] += bad;
+}
+
+
+static size_t
+heap_bad(struct heap_work *w)
+{
+    size_t i, bad = 0;
+    for (i = 0; i < MAX_PSW; i++)
+	bad += w->bad[i];
+    memset(w->bad, 0, sizeof(w->bad));
+    return bad;
+}
+
+
+static int
+heap_bench(const char *workload, size_t ncpu)
+{
+    struct heap_work w;
+    size_t o, k, bad = 0;
+
+    for (o = 0; o < 2; o++) {
+	int64_t start = bu_gettime();
+
+	memset(&w, 0, sizeof(w));
+	w.ops = &heap_ops[o];
+	w.ncpu = ncpu;
+
+	if (BU_STR_EQUAL(workload, "tree")) {
+	    w.iterations = 40;
+	    bu_parallel(heap_tree_work, ncpu, &w);
+	} else {
+	    w.iterations = 200000;
+	    w.slots = (void **)bu_calloc(ncpu * w.iterations, sizeof(void *), "heap slots");
+	    w.sizes = (size_t *)bu_calloc(ncpu * w.iterations, sizeof(size_t), "heap sizes");
+	    bu_parallel(heap_nmg_make, ncpu, &w);
+	    w.next_row = 0;
+	    bu_parallel(heap_nmg_churn, ncpu, &w);
+	    w.next_row = 0;
+	    bu_parallel(heap_nmg_kill, ncpu, &w);
+	    for (k = 0; k < ncpu * w.iterations; k++) {
+		if (w.slots[k])
+		    bad++;
+	    }
+	    bu_free(w.slots, "heap slots");
+	    bu_free(w.sizes, "heap sizes");
+	}
+	bad += heap_bad(&w);
+
+	bu_log("%s workload on %zu cpus with %s: %.3fs\n", workload, ncpu, w.ops->name, (bu_gettime() - start) / 1.0e6);
+    }
+
+    if (bad) {
+	bu_log("%s workload: %zu objects damaged or lost [FAIL]\n", workload, bad);
+	return 1;
+    }
+    bu_log("%s workload [PASS]\n", workload);
+    return 0;
+}
+
+
 /*
- * FIXME: this routine should compare heap with malloc and make sure
- * it's always faster.
+ * Without arguments, churns random sizes through a single thread.
+ * With "tree" or "nmg", times the heap against bu_calloc() on
+ * allocation-heavy parallel workloads and checks that no objects are
+ * handed out twice.
  */
 int
 main(int ac, char *av[])
@@ -53,15 +329,25 @@ main(int ac, char *av[])
     if (bu_getprogname()[0] == '\0')
 	bu_setprogname(av[0]);
 
-    if (ac > 1) {
-	fprintf(stderr, "Usage: %s\n", av[0]);
+    if (ac > 3 || (ac > 1 && !BU_STR_EQUAL(av[1], "tree") && !BU_STR_EQUAL(av[1], "nmg"))) {
+	fprintf(stderr, "Usage: %s [tree|nmg [ncpu]]\n", av[0]);
 	return 1;
     }
 
+    if (ac > 1) {
+	size_t ncpu = bu_avail_cpus();
+	if (ac > 2) {
+	    ncpu = (size_t)strtoul(av[2], NULL, 0);
+	    if (ncpu < 1 || ncpu >= MAX_PSW)
+		ncpu = bu_avail_cpus();
+	}
+	return heap_bench(av[1], ncpu);
+    }
+
     srand(time(0));
 
     for (i=0; i<1024*1024*10; i++) {
-	size_t sz = ((rand() / (double)(RAND_MAX-1)) * (double)HEAP_BINS) + 1;
+	size_t sz = ((rand() / (double)(RAND_MAX-1)) * (double)HEAP_MAX) + 1;
 	/* bu_log("allocating %d: %zd\n", i, sz); */
 #ifdef USE_MALLOC
 	ptr = malloc(sz);
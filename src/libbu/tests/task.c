@@ -0,0 +1,211 @@
+/*                          T A S K . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file task.c
+ *
+ * Tests the task API and times the cost of starting parallel work,
+ * either by bu_parallel() or by tasks.
+ *
+ * Usage: bu_test task [calls]
+ *
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bu.h"
+
+
+/* ranges visited by nested parallel loops */
+#define TASK_OUTER 64
+#define TASK_INNER 1000
+
+struct task_count {
+    size_t n;
+};
+
+struct task_fib {
+    int n;
+    long result;
+};
+
+
+static void
+task_count_cb(int UNUSED(cpu), void *data)
+{
+    struct task_count *c = (struct task_count *)data;
+
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    c->n++;
+    bu_semaphore_release(BU_SEM_GENERAL);
+}
+
+
+static void
+task_count_task(void *data)
+{
+    task_count_cb(0, data);
+}
+
+
+/* Recursive tasks, every level waiting on the one below */
+static void
+task_fib_task(void *data)
+{
+    struct task_fib *f = (struct task_fib *)data;
+    struct task_fib a, b;
+    struct bu_task *t;
+
+    if (f->n < 2) {
+	f->result = f->n;
+	return;
+    }
+
+    a.n = f->n - 1;
+    b.n = f->n - 2;
+    t = bu_task_submit(task_fib_task, &a);
+    task_fib_task(&b);
+    bu_task_wait(t);
+    f->result = a.result + b.result;
+}
+
+
+static void
+task_inner_range(size_t first, size_t last, void *data)
+{
+    int *visits = (int *)data;
+    size_t i;
+
+    for (i = first; i < last; i++)
+	visits[i]++;
+}
+
+
+static void
+task_outer_range(size_t first, size_t last, void *data)
+{
+    int *visits = (int *)data;
+    size_t i;
+
+    for (i = first; i < last; i++)
+	bu_parallel_for(0, TASK_INNER, 7, task_inner_range, &visits[i * TASK_INNER]);
+}
+
+
+int
+main(int argc, char *argv[])
+{
+    size_t ncpu = bu_avail_cpus();
+    size_t ncalls = 1000;
+    size_t i;
+    struct task_count cnt;
+    struct bu_task **tasks;
+    struct task_fib fib;
+    int *visits;
+    int64_t start;
+    double elapsed;
+    int bad = 0;
+
+    // Normally this file is part of bu_test, so only set this if it
+    // looks like the program name is still unset.
+    if (bu_getprogname()[0] == '\0')
+	bu_setprogname(argv[0]);
+
+    if (argc > 1)
+	ncalls = (size_t)strtoul(argv[1], NULL, 0);
+    if (!ncalls)
+	bu_exit(1, "Usage: %s [calls]\n", argv[0]);
+
+    /* starting bu_parallel() over and over */
+    cnt.n = 0;
+    start = bu_gettime();
+    for (i = 0; i < ncalls; i++)
+	bu_parallel(task_count_cb, ncpu, &cnt);
+    elapsed = (double)(bu_gettime() - start);
+    bu_log("bu_parallel on %zu cpus: %.1f us per call\n", ncpu, elapsed / ncalls);
+    if (cnt.n != ncalls * ncpu) {
+	bu_log("bu_parallel ran %zu callbacks, expected %zu [FAIL]\n", cnt.n, ncalls * ncpu);
+	bad++;
+    }
+
+    /* starting tasks */
+    cnt.n = 0;
+    tasks = (struct bu_task **)bu_calloc(ncalls, sizeof(struct bu_task *), "tasks");
+    start = bu_gettime();
+    for (i = 0; i < ncalls; i++)
+	tasks[i] = bu_task_submit(task_count_task, &cnt);
+    for (i = 0; i < ncalls; i++)
+	bu_task_wait(tasks[i]);
+    elapsed = (double)(bu_gettime() - start);
+    bu_free(tasks, "tasks");
+    bu_log("bu_task_submit and bu_task_wait: %.1f us per task\n", elapsed / ncalls);
+    if (cnt.n != ncalls) {
+	bu_log("%zu tasks ran, expected %zu [FAIL]\n", cnt.n, ncalls);
+	bad++;
+    }
+
+    /* deeply nested waits must not deadlock */
+    fib.n = 20;
+    start = bu_gettime();
+    task_fib_task(&fib);
+    elapsed = (double)(bu_gettime() - start);
+    bu_log("recursive tasks: fib(%d) = %ld in %.3fs\n", fib.n, fib.result, elapsed / 1.0e6);
+    if (fib.result != 6765) {
+	bu_log("recursive tasks got fib(%d) = %ld, expected 6765 [FAIL]\n", fib.n, fib.result);
+	bad++;
+    }
+
+    /* nested loops cover every element exactly once */
+    visits = (int *)bu_calloc(TASK_OUTER * TASK_INNER, sizeof(int), "visits");
+    start = bu_gettime();
+    for (i = 0; i < ncalls / 100 + 1; i++)
+	bu_parallel_for(0, TASK_OUTER, 1, task_outer_range, visits);
+    elapsed = (double)(bu_gettime() - start);
+    bu_log("nested bu_parallel_for: %.1f us per outer loop\n", elapsed / (ncalls / 100 + 1));
+    for (i = 0; i < TASK_OUTER * TASK_INNER; i++) {
+	if (visits[i] != (int)(ncalls / 100 + 1)) {
+	    bu_log("element %zu visited %d times, expected %zu [FAIL]\n", i, visits[i], ncalls / 100 + 1);
+	    bad++;
+	    break;
+	}
+    }
+    bu_free(visits, "visits");
+
+    /* empty and NULL work is fine */
+    bu_parallel_for(5, 5, 0, task_inner_range, NULL);
+    bu_task_wait(bu_task_submit(NULL, NULL));
+
+    if (bad)
+	return 1;
+
+    bu_log("task API [PASS]\n");
+    return 0;
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
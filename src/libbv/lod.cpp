@@ -58,7 +58,9 @@
 #include <cstring>
 #include <stdlib.h>
 #include <map>
+#include <mutex>
 #include <set>
+#include <shared_mutex>
 #include <thread>
 #include <vector>
 #include <unordered_map>
@@ -103,9 +105,10 @@ extern "C" {
 // Factor by which to bump out bounds to avoid points on box edges
 #define MBUMP 1.01
 
-// Maximum database size.  For detailed views we fall back on just
+// Initial database size.  For detailed views we fall back on just
 // displaying the full data set, and we need to be able to memory map the
-// file, so go with a 4Gb per file limit.
+// file, so start with a 4Gb map.  This is not a hard ceiling - if a write
+// finds the map full, the map is doubled and the write retried.
 #define CACHE_MAX_DB_SIZE 4294967296
 
 // Define what format of the cache is current - if it doesn't match, we need
@@ -604,8 +607,30 @@ struct bv_mesh_lod_context_internal {
     MDB_dbi name_dbi;
 
     struct bu_vls *fname;
+
+    // LMDB only allows the map to be resized when no transactions are
+    // open, so anyone holding a lod_env transaction holds this lock shared
+    // and lod_cache_grow takes it exclusively.
+    std::shared_mutex *txn_lock;
+    size_t lod_mapsize;
 };
 
+static void
+lod_cache_grow(struct bv_mesh_lod_context_internal *i, size_t full_size)
+{
+    std::unique_lock<std::shared_mutex> lock(*i->txn_lock);
+
+    // Another thread may have already grown the map while we waited
+    if (i->lod_mapsize > full_size)
+	return;
+
+    if (mdb_env_set_mapsize(i->lod_env, 2*i->lod_mapsize)) {
+	bu_log("Unable to grow LoD cache beyond %zd bytes\n", i->lod_mapsize);
+	return;
+    }
+    i->lod_mapsize = 2*i->lod_mapsize;
+}
+
 struct bv_mesh_lod_context *
 bv_mesh_lod_context_create(const char *name)
 {
@@ -638,6 +663,8 @@ bv_mesh_lod_context_create(const char *name)
     BU_GET(i->fname, struct bu_vls);
     bu_vls_init(i->fname);
     bu_vls_sprintf(i->fname, "%s", bu_vls_cstr(&fname));
+    i->txn_lock = new std::shared_mutex;
+    i->lod_mapsize = CACHE_MAX_DB_SIZE;
 
     // Base maximum readers on an estimate of how many threads
     // we might want to fire off
@@ -699,8 +726,9 @@ bv_mesh_lod_context_create(const char *name)
     if (!bu_file_exists(dir, NULL))
 	bu_mkdir(dir);
 
-    // Need to call mdb_env_sync() at appropriate points.
-    if (mdb_env_open(i->lod_env, dir, MDB_NOSYNC, 0664))
+    // Need to call mdb_env_sync() at appropriate points.  MDB_NOTLS lets
+    // worker threads generating LoD data hold transactions independently.
+    if (mdb_env_open(i->lod_env, dir, MDB_NOSYNC | MDB_NOTLS, 0664))
 	goto lod_context_close_lod_fail;
 
     // Create the specific name/key LMDB mapping dir, if not already present
@@ -710,7 +738,7 @@ bv_mesh_lod_context_create(const char *name)
 	bu_mkdir(dir);
 
     // Need to call mdb_env_sync() at appropriate points.
-    if (mdb_env_open(i->name_env, dir, MDB_NOSYNC, 0664))
+    if (mdb_env_open(i->name_env, dir, MDB_NOSYNC | MDB_NOTLS, 0664))
 	goto lod_context_close_name_fail;
 
     // Success - return the context
@@ -724,6 +752,7 @@ lod_context_close_lod_fail:
     mdb_env_close(i->lod_env);
 lod_context_fail:
     bu_vls_free(&fname);
+    delete i->txn_lock;
     BU_PUT(c->i, struct bv_mesh_lod_context_internal);
     BU_PUT(c, struct bv_mesh_lod_context);
     return NULL;
@@ -736,6 +765,7 @@ bv_mesh_lod_context_destroy(struct bv_mesh_lod_context *c)
 	return;
     mdb_env_close(c->i->name_env);
     mdb_env_close(c->i->lod_env);
+    delete c->i->txn_lock;
     bu_vls_free(c->i->fname);
     BU_PUT(c->i->fname, struct bu_vls);
     BU_PUT(c->i, struct bv_mesh_lod_context_internal);
@@ -762,18 +792,22 @@ bv_mesh_lod_key_get(struct bv_mesh_lod_context *c, const char *name)
     unsigned long long hash = bu_data_hash(bu_vls_cstr(&keystr), bu_vls_strlen(&keystr)*sizeof(char));
     bu_vls_sprintf(&keystr, "%llu", hash);
 
-    mdb_txn_begin(c->i->name_env, NULL, 0, &c->i->name_txn);
-    mdb_dbi_open(c->i->name_txn, NULL, 0, &c->i->name_dbi);
+    // Use a local transaction so keys may be looked up from multiple threads
+    MDB_txn *txn;
+    MDB_dbi dbi;
+    mdb_txn_begin(c->i->name_env, NULL, MDB_RDONLY, &txn);
+    mdb_dbi_open(txn, NULL, 0, &dbi);
     mdb_key.mv_size = bu_vls_strlen(&keystr)*sizeof(char);
     mdb_key.mv_data = (void *)bu_vls_cstr(&keystr);
-    int rc = mdb_get(c->i->name_txn, c->i->name_dbi, &mdb_key, &mdb_data);
+    int rc = mdb_get(txn, dbi, &mdb_key, &mdb_data);
     if (rc) {
-	mdb_txn_commit(c->i->name_txn);
+	mdb_txn_abort(txn);
+	bu_vls_free(&keystr);
 	return 0;
     }
     unsigned long long *fkeyp = (unsigned long long *)mdb_data.mv_data;
     unsigned long long fkey = *fkeyp;
-    mdb_txn_commit(c->i->name_txn);
+    mdb_txn_abort(txn);
 
     bu_vls_free(&keystr);
     //bu_log("GOT %s: %llu\n", name, fkey);
@@ -800,16 +834,18 @@ bv_mesh_lod_key_put(struct bv_mesh_lod_context *c, const char *name, unsigned lo
 
     MDB_val mdb_key;
     MDB_val mdb_data[2];
-    mdb_txn_begin(c->i->name_env, NULL, 0, &c->i->name_txn);
-    mdb_dbi_open(c->i->name_txn, NULL, 0, &c->i->name_dbi);
+    MDB_txn *txn;
+    MDB_dbi dbi;
+    mdb_txn_begin(c->i->name_env, NULL, 0, &txn);
+    mdb_dbi_open(txn, NULL, 0, &dbi);
     mdb_key.mv_size = bu_vls_strlen(&keystr)*sizeof(char);
     mdb_key.mv_data = (void *)bu_vls_cstr(&keystr);
     mdb_data[0].mv_size = sizeof(key);
     mdb_data[0].mv_data = (void *)&key;
     mdb_data[1].mv_size = 0;
     mdb_data[1].mv_data = NULL;
-    int rc = mdb_put(c->i->name_txn, c->i->name_dbi, &mdb_key, mdb_data, 0);
-    mdb_txn_commit(c->i->name_txn);
+    int rc = mdb_put(txn, dbi, &mdb_key, mdb_data, 0);
+    mdb_txn_commit(txn);
 
     bu_vls_free(&keystr);
     //bu_log("PUT %s: %llu\n", name, key);
@@ -932,6 +968,11 @@ class POPState {
 	void cache_del(const char *component);
 	MDB_val mdb_key, mdb_data[2];
 
+	// Each POPState has its own transaction so several can be
+	// generated or loaded concurrently
+	MDB_txn *txn = NULL;
+	MDB_dbi dbi;
+
 	// Specific loading and unloading methods
 	void tri_pop_load(int start_level, int level);
 	void tri_pop_trim(int level);
@@ -1292,6 +1333,7 @@ POPState::tri_pop_load(int start_level, int level)
 	size_t bsize = cache_get((void **)&b, bu_vls_cstr(&kbuf));
 	if (bsize != level_vcnt[i]*sizeof(point_t)) {
 	    bu_log("Incorrect data size found loading level %d point data\n", i);
+	    cache_done();
 	    return;
 	}
 	lod_tri_pnts.insert(lod_tri_pnts.end(), &b[0], &b[level_vcnt[i]*3]);
@@ -1318,6 +1360,7 @@ POPState::tri_pop_load(int start_level, int level)
 	size_t bsize = cache_get((void **)&b, bu_vls_cstr(&kbuf));
 	if (bsize != level_tricnt[i]*3*sizeof(int)) {
 	    bu_log("Incorrect data size found loading level %d tri data\n", i);
+	    cache_done();
 	    return;
 	}
 	lod_tris.insert(lod_tris.end(), &b[0], &b[level_tricnt[i]*3]);
@@ -1333,6 +1376,7 @@ POPState::tri_pop_load(int start_level, int level)
 	size_t bsize = cache_get((void **)&b, bu_vls_cstr(&kbuf));
 	if (bsize > 0 && bsize != level_tricnt[i]*sizeof(vect_t)*3) {
 	    bu_log("Incorrect data size found loading level %d normal data\n", i);
+	    cache_done();
 	    return;
 	}
 	if (bsize) {
@@ -1544,16 +1588,38 @@ POPState::cache_write(const char *component, std::stringstream &s)
     char *keycstr = bu_strdup(keystr.c_str());
     void *bdata = bu_calloc(buffer.length()+1, sizeof(char), "bdata");
     memcpy(bdata, buffer.data(), buffer.length()*sizeof(char));
-    mdb_txn_begin(c->i->lod_env, NULL, 0, &c->i->lod_txn);
-    mdb_dbi_open(c->i->lod_txn, NULL, 0, &c->i->lod_dbi);
-    mdb_key.mv_size = keystr.length()*sizeof(char);
-    mdb_key.mv_data = (void *)keycstr;
-    mdb_data[0].mv_size = buffer.length()*sizeof(char);
-    mdb_data[0].mv_data = bdata;
-    mdb_data[1].mv_size = 0;
-    mdb_data[1].mv_data = NULL;
-    int rc = mdb_put(c->i->lod_txn, c->i->lod_dbi, &mdb_key, mdb_data, 0);
-    mdb_txn_commit(c->i->lod_txn);
+    int rc = 0;
+    while (1) {
+	// The write gets its own transaction, independent of any read
+	// this POPState has open
+	MDB_txn *wtxn;
+	MDB_dbi wdbi;
+	c->i->txn_lock->lock_shared();
+	size_t mapsize = c->i->lod_mapsize;
+	mdb_txn_begin(c->i->lod_env, NULL, 0, &wtxn);
+	mdb_dbi_open(wtxn, NULL, 0, &wdbi);
+	mdb_key.mv_size = keystr.length()*sizeof(char);
+	mdb_key.mv_data = (void *)keycstr;
+	mdb_data[0].mv_size = buffer.length()*sizeof(char);
+	mdb_data[0].mv_data = bdata;
+	mdb_data[1].mv_size = 0;
+	mdb_data[1].mv_data = NULL;
+	rc = mdb_put(wtxn, wdbi, &mdb_key, mdb_data, 0);
+	if (!rc) {
+	    rc = mdb_txn_commit(wtxn);
+	} else {
+	    mdb_txn_abort(wtxn);
+	}
+	c->i->txn_lock->unlock_shared();
+
+	// Out of room - grow the map and try again
+	if (rc == MDB_MAP_FULL) {
+	    lod_cache_grow(c->i, mapsize);
+	    if (c->i->lod_mapsize > mapsize)
+		continue;
+	}
+	break;
+    }
     bu_free(keycstr, "keycstr");
     bu_free(bdata, "buffer data");
 
@@ -1575,11 +1641,12 @@ POPState::cache_get(void **data, const char *component)
     //if (keystr.length()*sizeof(char) > mdb_env_get_maxkeysize(c->i->lod_env))
     //	return 0;
     char *keycstr = bu_strdup(keystr.c_str());
-    mdb_txn_begin(c->i->lod_env, NULL, 0, &c->i->lod_txn);
-    mdb_dbi_open(c->i->lod_txn, NULL, 0, &c->i->lod_dbi);
+    c->i->txn_lock->lock_shared();
+    mdb_txn_begin(c->i->lod_env, NULL, MDB_RDONLY, &txn);
+    mdb_dbi_open(txn, NULL, 0, &dbi);
     mdb_key.mv_size = keystr.length()*sizeof(char);
     mdb_key.mv_data = (void *)keycstr;
-    int rc = mdb_get(c->i->lod_txn, c->i->lod_dbi, &mdb_key, &mdb_data[0]);
+    int rc = mdb_get(txn, dbi, &mdb_key, &mdb_data[0]);
     if (rc) {
 	bu_free(keycstr, "keycstr");
 	(*data) = NULL;
@@ -1594,7 +1661,11 @@ POPState::cache_get(void **data, const char *component)
 void
 POPState::cache_done()
 {
-    mdb_txn_commit(c->i->lod_txn);
+    if (!txn)
+	return;
+    mdb_txn_abort(txn);
+    txn = NULL;
+    c->i->txn_lock->unlock_shared();
 }
 
 bool
@@ -1912,6 +1983,54 @@ bv_mesh_lod_cache(struct bv_mesh_lod_context *c, const point_t *v, size_t vcnt,
     return key;
 }
 
+struct lod_cache_batch_job {
+    struct bv_mesh_lod_context *c;
+    struct bv_mesh_lod_cache_input *in;
+    size_t cnt;
+    size_t next;
+};
+
+static void
+lod_cache_batch_worker(int UNUSED(cpu), void *data)
+{
+    struct lod_cache_batch_job *j = (struct lod_cache_batch_job *)data;
+    while (1) {
+	size_t ind;
+	bu_semaphore_acquire(BU_SEM_GENERAL);
+	ind = j->next++;
+	bu_semaphore_release(BU_SEM_GENERAL);
+	if (ind >= j->cnt)
+	    return;
+
+	struct bv_mesh_lod_cache_input *m = &j->in[ind];
+	m->key = bv_mesh_lod_cache(j->c, m->v, m->vcnt, m->vn, m->f, m->fcnt, m->user_key, m->fratio);
+    }
+}
+
+extern "C" void
+bv_mesh_lod_cache_batch(struct bv_mesh_lod_context *c, struct bv_mesh_lod_cache_input *in, size_t cnt, size_t ncpu)
+{
+    if (!c || !in || !cnt)
+	return;
+
+    struct lod_cache_batch_job j;
+    j.c = c;
+    j.in = in;
+    j.cnt = cnt;
+    j.next = 0;
+
+    if (!ncpu)
+	ncpu = bu_avail_cpus();
+    if (ncpu > cnt)
+	ncpu = cnt;
+
+    if (ncpu <= 1) {
+	lod_cache_batch_worker(0, &j);
+	return;
+    }
+    bu_parallel(lod_cache_batch_worker, ncpu, &j);
+}
+
 extern "C" struct bv_mesh_lod *
 bv_mesh_lod_create(struct bv_mesh_lod_context *c, unsigned long long key)
 {
@@ -2070,12 +2189,15 @@ cache_del(struct bv_mesh_lod_context *c, unsigned long long hash, const char *co
     MDB_val mdb_key;
     std::string keystr = std::to_string(hash) + std::string(":") + std::string(component);
 
-    mdb_txn_begin(c->i->lod_env, NULL, 0, &c->i->lod_txn);
-    mdb_dbi_open(c->i->lod_txn, NULL, 0, &c->i->lod_dbi);
+    std::shared_lock<std::shared_mutex> lock(*c->i->txn_lock);
+    MDB_txn *txn;
+    MDB_dbi dbi;
+    mdb_txn_begin(c->i->lod_env, NULL, 0, &txn);
+    mdb_dbi_open(txn, NULL, 0, &dbi);
     mdb_key.mv_size = keystr.length()*sizeof(char);
     mdb_key.mv_data = (void *)keystr.c_str();
-    mdb_del(c->i->lod_txn, c->i->lod_dbi, &mdb_key, NULL);
-    mdb_txn_commit(c->i->lod_txn);
+    mdb_del(txn, dbi, &mdb_key, NULL);
+    mdb_txn_commit(txn);
 }
 
 
@@ -2136,6 +2258,7 @@ bv_mesh_lod_clear_cache(struct bv_mesh_lod_context *c, unsigned long long key)
 	int rc;
 
 	// Clear the actual LoD data
+	std::unique_lock<std::shared_mutex> lock(*c->i->txn_lock);
 	mdb_txn_begin(c->i->lod_env, NULL, 0, &c->i->lod_txn);
 	mdb_dbi_open(c->i->lod_txn, NULL, 0, &c->i->lod_dbi);
 	rc = mdb_cursor_open(c->i->lod_txn, c->i->lod_dbi, &cursor);
@@ -0,0 +1,171 @@
+/*                   V L I S T _ P A C K E D . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+
+/* Pack the vlist of an n by n grid of triangles, drawn as a wireframe,
+ * as shaded triangles and as points, and check that bv_vlist_pack()
+ * shares the vertices the wireframe repeats, keeps every segment and
+ * triangle of the vlist, and ends up smaller than the vlist.  The
+ * <args> format is: grid_size
+ */
+
+#include "common.h"
+
+#include <string.h>
+#include "bu.h"
+#include "bv.h"
+
+
+static int
+vp_same(const float *f, const fastf_t *pt)
+{
+    return (ZERO(f[X] - pt[X]) && ZERO(f[Y] - pt[Y]) && ZERO(f[Z] - pt[Z]));
+}
+
+
+int
+vlist_packed_main(int argc, char *argv[])
+{
+    struct bu_list head;
+    struct bu_list vlfree;
+    struct bv_vlist_packed *p;
+    struct bv_vlist *vp;
+    vect_t up = {0.0, 0.0, 1.0};
+    size_t vlist_bytes = 0;
+    size_t seg = 0, tri = 0, tv = 0;
+    int n = 0;
+    int i, j, k;
+    int bad = 0;
+
+    if (argc < 2) {
+	bu_exit(1, "ERROR: input format is test_args [%s]\n", argv[0]);
+    }
+    sscanf(argv[1], "%d", &n);
+    if (n < 1) {
+	bu_exit(1, "ERROR: grid size must be positive\n");
+    }
+
+    BU_LIST_INIT(&head);
+    BU_LIST_INIT(&vlfree);
+
+    for (i = 0; i < n; i++) {
+	for (j = 0; j < n; j++) {
+	    point_t c[4];
+	    int t[2][3] = {{0, 1, 2}, {0, 2, 3}};
+	    VSET(c[0], i, j, 0);
+	    VSET(c[1], i + 1, j, 0);
+	    VSET(c[2], i + 1, j + 1, 0);
+	    VSET(c[3], i, j + 1, 0);
+	    for (k = 0; k < 2; k++) {
+		BV_ADD_VLIST(&vlfree, &head, c[t[k][0]], BV_VLIST_LINE_MOVE);
+		BV_ADD_VLIST(&vlfree, &head, c[t[k][1]], BV_VLIST_LINE_DRAW);
+		BV_ADD_VLIST(&vlfree, &head, c[t[k][2]], BV_VLIST_LINE_DRAW);
+		BV_ADD_VLIST(&vlfree, &head, c[t[k][0]], BV_VLIST_LINE_DRAW);
+		BV_ADD_VLIST(&vlfree, &head, up, BV_VLIST_TRI_START);
+		BV_ADD_VLIST(&vlfree, &head, c[t[k][0]], BV_VLIST_TRI_MOVE);
+		BV_ADD_VLIST(&vlfree, &head, c[t[k][1]], BV_VLIST_TRI_DRAW);
+		BV_ADD_VLIST(&vlfree, &head, c[t[k][2]], BV_VLIST_TRI_DRAW);
+		BV_ADD_VLIST(&vlfree, &head, c[t[k][0]], BV_VLIST_TRI_END);
+	    }
+	}
+    }
+    for (i = 0; i <= n; i++) {
+	for (j = 0; j <= n; j++) {
+	    point_t pt;
+	    VSET(pt, i, j, 0);
+	    BV_ADD_VLIST(&vlfree, &head, pt, BV_VLIST_POINT_DRAW);
+	}
+    }
+
+    for (BU_LIST_FOR(vp, bv_vlist, &head))
+	vlist_bytes += sizeof(struct bv_vlist);
+
+    p = bv_vlist_pack(&head);
+
+    /* wire and point vertices are shared, the shaded ones have a normal */
+    if (p->nverts != (size_t)(2 * (n + 1) * (n + 1))) {
+	bu_log("%zu vertices packed, expected %d\n", p->nverts, 2 * (n + 1) * (n + 1));
+	bad++;
+    }
+    if (p->nlines != (size_t)(6 * n * n) || p->ntris != (size_t)(2 * n * n) || p->npoints != (size_t)((n + 1) * (n + 1))) {
+	bu_log("%zu segments, %zu triangles, %zu points packed, expected %d, %d, %d\n",
+	       p->nlines, p->ntris, p->npoints, 6 * n * n, 2 * n * n, (n + 1) * (n + 1));
+	bad++;
+    }
+    if (p->vlen != (size_t)(18 * n * n + (n + 1) * (n + 1))) {
+	bu_log("packed copy made from %zu vlist commands, expected %d\n", p->vlen, 18 * n * n + (n + 1) * (n + 1));
+	bad++;
+    }
+
+    /* walk the vlist again and check each segment and triangle lands
+     * in the packed copy in order */
+    if (!bad) {
+	const fastf_t *prev = NULL;
+	for (BU_LIST_FOR(vp, bv_vlist, &head)) {
+	    size_t m;
+	    for (m = 0; m < vp->nused; m++) {
+		const fastf_t *pt = vp->pt[m];
+		switch (vp->cmd[m]) {
+		    case BV_VLIST_LINE_DRAW:
+			if (!vp_same(&p->verts[3*p->lines[2*seg]], prev) || !vp_same(&p->verts[3*p->lines[2*seg + 1]], pt)) {
+			    bu_log("segment %zu does not match the vlist\n", seg);
+			    bad++;
+			}
+			seg++;
+			break;
+		    case BV_VLIST_TRI_MOVE:
+		    case BV_VLIST_TRI_DRAW:
+			if (!vp_same(&p->verts[3*p->tris[3*tri + tv]], pt) || !vp_same(&p->norms[3*p->tris[3*tri + tv]], up)) {
+			    bu_log("triangle %zu does not match the vlist\n", tri);
+			    bad++;
+			}
+			if (++tv == 3) {
+			    tv = 0;
+			    tri++;
+			}
+			break;
+		}
+		prev = pt;
+	    }
+	}
+    }
+
+    bu_log("%d x %d grid: vlist %zu bytes, packed %zu bytes\n", n, n, vlist_bytes, bv_vlist_packed_size(p));
+    if (!bad && bv_vlist_packed_size(p) >= vlist_bytes) {
+	bu_log("packed copy is not smaller than the vlist\n");
+	bad++;
+    }
+
+    BV_FREE_VLIST(&vlfree, &head);
+    bv_vlist_packed_free(p);
+    bv_vlist_cleanup(&vlfree);
+
+    return bad;
+}
+
+
+/*
+ * Local Variables:
+ * mode: C
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
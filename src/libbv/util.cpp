@@ -337,6 +337,7 @@ bv_free(struct bview *gvp)
 	    (*sp->s_free_callback)(sp);
 	if (sp->s_dlist_free_callback)
 	    (*sp->s_dlist_free_callback)(sp);
+	bv_vlist_packed_free(sp->s_vpacked);
 	bu_ptbl_free(&sp->children);
 	BU_PUT(sp, struct bv_scene_obj);
 	sp = nsp;
@@ -1040,6 +1041,10 @@ bv_obj_stale(struct bv_scene_obj *s)
 {
     s->s_dlist_stale = 1;
 
+    // The packed vlist copy is cheap to rebuild, just drop it
+    bv_vlist_packed_free(s->s_vpacked);
+    s->s_vpacked = NULL;
+
     if (BU_PTBL_IS_INITIALIZED(&s->children)) {
 	for (size_t i = 0; i < BU_PTBL_LEN(&s->children); i++) {
 	    struct bv_scene_obj *s_c = (struct bv_scene_obj *)BU_PTBL_GET(&s->children, i);
@@ -1224,6 +1229,9 @@ bv_obj_reset(struct bv_scene_obj *s)
 	(*s->s_dlist_free_callback)(s);
     s->s_dlist_free_callback = NULL;
 
+    bv_vlist_packed_free(s->s_vpacked);
+    s->s_vpacked = NULL;
+
     // If we have a label, do the label freeing steps
     // TODO - this should be using the free callback rather
     // than special casing...
@@ -33,6 +33,7 @@
 #include "bv/defines.h"
 #include "bv/util.h"
 #include "bv/view_sets.h"
+#include "bv/vlist.h"
 #include "./bv_private.h"
 
 void
@@ -66,6 +67,7 @@ bv_set_free(struct bview_set *s)
 		(*sp->s_free_callback)(sp);
 	    if (sp->s_dlist_free_callback)
 		(*sp->s_dlist_free_callback)(sp);
+	    bv_vlist_packed_free(sp->s_vpacked);
 	    bu_ptbl_free(&sp->children);
 	    BU_PUT(sp, struct bv_scene_obj);
 	    sp = nsp;
@@ -20,6 +20,7 @@
 
 #include "common.h"
 
+#include <limits.h>
 #include <stdio.h>
 #include <math.h>
 #include <string.h>
@@ -135,6 +136,238 @@ bv_vlist_bbox(struct bu_list *vlistp, point_t *bmin, point_t *bmax, size_t *leng
     return cmd;
 }
 
+
+/* Vertex lookup for bv_vlist_pack(): open addressing over the
+ * position and normal, sized for every command being a new vertex */
+struct vlist_pack_state {
+    struct bv_vlist_packed *p;
+    float *norms;
+    unsigned int *table;
+    size_t mask;
+    size_t max_lines, max_tris, max_points;
+};
+
+
+static unsigned int
+vlist_pack_vert(struct vlist_pack_state *st, const point_t pt, const vect_t norm)
+{
+    struct bv_vlist_packed *p = st->p;
+    float v[6];
+    uint32_t bits;
+    size_t h = 2166136261U;
+    size_t i, slot;
+
+    VMOVE(v, pt);
+    VMOVE(&v[3], norm);
+    for (i = 0; i < 6; i++) {
+	/* -0 and 0 are the same vertex */
+	if (ZERO(v[i]))
+	    v[i] = 0.0f;
+	memcpy(&bits, &v[i], sizeof(bits));
+	h = (h ^ bits) * 16777619U;
+    }
+
+    for (slot = h & st->mask; st->table[slot] != UINT_MAX; slot = (slot + 1) & st->mask) {
+	unsigned int n = st->table[slot];
+	if (!memcmp(&p->verts[3*n], v, sizeof(float) * 3) && !memcmp(&st->norms[3*n], &v[3], sizeof(float) * 3))
+	    return n;
+    }
+
+    VMOVE(&p->verts[3*p->nverts], v);
+    VMOVE(&st->norms[3*p->nverts], &v[3]);
+    st->table[slot] = (unsigned int)p->nverts;
+    return (unsigned int)p->nverts++;
+}
+
+
+static unsigned int *
+vlist_pack_grow(unsigned int *a, size_t used, size_t *max, size_t n, const char *str)
+{
+    if (used + n <= *max)
+	return a;
+    *max = (*max) ? 2 * (*max) : 1024;
+    return (unsigned int *)bu_realloc(a, *max * sizeof(unsigned int), str);
+}
+
+
+struct bv_vlist_packed *
+bv_vlist_pack(const struct bu_list *vhead)
+{
+    struct bv_vlist_packed *p;
+    struct vlist_pack_state st;
+    const struct bv_vlist *vp;
+    vect_t norm = VINIT_ZERO;
+    vect_t zero = VINIT_ZERO;
+    unsigned int prev = UINT_MAX, poly_first = UINT_MAX, poly_prev = UINT_MAX;
+    size_t tsize = 16;
+
+    BU_ALLOC(p, struct bv_vlist_packed);
+    if (!vhead)
+	return p;
+    BU_CK_LIST_HEAD(vhead);
+
+    for (BU_LIST_FOR(vp, bv_vlist, vhead)) {
+	size_t i;
+	for (i = 0; i < vp->nused; i++) {
+	    switch (vp->cmd[i]) {
+		case BV_VLIST_DISPLAY_MAT:
+		case BV_VLIST_MODEL_MAT:
+		case BV_VLIST_LINE_WIDTH:
+		case BV_VLIST_POINT_SIZE:
+		    /* state changes have no place in the arrays */
+		    p->vlen = 0;
+		    goto done;
+	    }
+	}
+	p->vlen += vp->nused;
+    }
+    if (!p->vlen || p->vlen >= UINT_MAX)
+	goto done;
+
+    /* a vertex per command at most */
+    while (tsize < 2 * p->vlen)
+	tsize *= 2;
+    memset(&st, 0, sizeof(struct vlist_pack_state));
+    st.p = p;
+    st.mask = tsize - 1;
+    st.table = (unsigned int *)bu_malloc(tsize * sizeof(unsigned int), "vlist pack table");
+    memset(st.table, 0xff, tsize * sizeof(unsigned int));
+    st.norms = (float *)bu_malloc(3 * p->vlen * sizeof(float), "vlist pack norms");
+    p->verts = (float *)bu_malloc(3 * p->vlen * sizeof(float), "vlist pack verts");
+
+    for (BU_LIST_FOR(vp, bv_vlist, vhead)) {
+	size_t i;
+	for (i = 0; i < vp->nused; i++) {
+	    const fastf_t *pt = vp->pt[i];
+	    unsigned int n;
+
+	    switch (vp->cmd[i]) {
+		case BV_VLIST_LINE_MOVE:
+		    prev = vlist_pack_vert(&st, pt, zero);
+		    break;
+		case BV_VLIST_LINE_DRAW:
+		    n = vlist_pack_vert(&st, pt, zero);
+		    if (prev != UINT_MAX && prev != n) {
+			p->lines = vlist_pack_grow(p->lines, 2 * p->nlines, &st.max_lines, 2, "vlist pack lines");
+			p->lines[2*p->nlines] = prev;
+			p->lines[2*p->nlines + 1] = n;
+			p->nlines++;
+		    }
+		    prev = n;
+		    break;
+		case BV_VLIST_POLY_START:
+		case BV_VLIST_TRI_START:
+		    /* surface normal for the vertices that follow */
+		    VMOVE(norm, pt);
+		    poly_first = poly_prev = UINT_MAX;
+		    break;
+		case BV_VLIST_POLY_VERTNORM:
+		case BV_VLIST_TRI_VERTNORM:
+		    VMOVE(norm, pt);
+		    break;
+		case BV_VLIST_POLY_MOVE:
+		case BV_VLIST_POLY_DRAW:
+		case BV_VLIST_TRI_MOVE:
+		case BV_VLIST_TRI_DRAW:
+		    n = vlist_pack_vert(&st, pt, norm);
+		    if (poly_first == UINT_MAX) {
+			poly_first = n;
+		    } else if (poly_prev == UINT_MAX) {
+			poly_prev = n;
+		    } else {
+			/* polygons fan out from the first vertex, while
+			 * triangle vertices come in independent threes */
+			p->tris = vlist_pack_grow(p->tris, 3 * p->ntris, &st.max_tris, 3, "vlist pack tris");
+			p->tris[3*p->ntris] = poly_first;
+			p->tris[3*p->ntris + 1] = poly_prev;
+			p->tris[3*p->ntris + 2] = n;
+			p->ntris++;
+			if (vp->cmd[i] == BV_VLIST_TRI_MOVE || vp->cmd[i] == BV_VLIST_TRI_DRAW)
+			    poly_first = poly_prev = UINT_MAX;
+			else
+			    poly_prev = n;
+		    }
+		    break;
+		case BV_VLIST_POLY_END:
+		case BV_VLIST_TRI_END:
+		    poly_first = poly_prev = UINT_MAX;
+		    break;
+		case BV_VLIST_POINT_DRAW:
+		    n = vlist_pack_vert(&st, pt, zero);
+		    p->points = vlist_pack_grow(p->points, p->npoints, &st.max_points, 1, "vlist pack points");
+		    p->points[p->npoints++] = n;
+		    break;
+	    }
+	}
+    }
+
+    bu_free(st.table, "vlist pack table");
+
+    /* give back what the duplicates did not use */
+    if (p->nverts) {
+	p->verts = (float *)bu_realloc(p->verts, 3 * p->nverts * sizeof(float), "vlist pack verts");
+    } else {
+	bu_free(p->verts, "vlist pack verts");
+	p->verts = NULL;
+    }
+    if (p->ntris) {
+	p->norms = (float *)bu_realloc(st.norms, 3 * p->nverts * sizeof(float), "vlist pack norms");
+    } else {
+	bu_free(st.norms, "vlist pack norms");
+    }
+    if (p->lines)
+	p->lines = (unsigned int *)bu_realloc(p->lines, 2 * p->nlines * sizeof(unsigned int), "vlist pack lines");
+    if (p->tris)
+	p->tris = (unsigned int *)bu_realloc(p->tris, 3 * p->ntris * sizeof(unsigned int), "vlist pack tris");
+    if (p->points)
+	p->points = (unsigned int *)bu_realloc(p->points, p->npoints * sizeof(unsigned int), "vlist pack points");
+
+done:
+    if (!p->vlen) {
+	/* still record what the copy came from */
+	for (BU_LIST_FOR(vp, bv_vlist, vhead))
+	    p->vlen += vp->nused;
+    }
+    return p;
+}
+
+
+void
+bv_vlist_packed_free(struct bv_vlist_packed *p)
+{
+    if (!p)
+	return;
+    if (p->verts)
+	bu_free(p->verts, "vlist pack verts");
+    if (p->norms)
+	bu_free(p->norms, "vlist pack norms");
+    if (p->lines)
+	bu_free(p->lines, "vlist pack lines");
+    if (p->tris)
+	bu_free(p->tris, "vlist pack tris");
+    if (p->points)
+	bu_free(p->points, "vlist pack points");
+    bu_free(p, "vlist pack");
+}
+
+
+size_t
+bv_vlist_packed_size(const struct bv_vlist_packed *p)
+{
+    size_t size;
+
+    if (!p)
+	return 0;
+
+    size = sizeof(struct bv_vlist_packed);
+    size += 3 * p->nverts * sizeof(float);
+    if (p->norms)
+	size += 3 * p->nverts * sizeof(float);
+    size += (2 * p->nlines + 3 * p->ntris + p->npoints) * sizeof(unsigned int);
+
+    return size;
+}
+
 const char *
 bv_vlist_get_cmd_description(int cmd)
 {
@@ -665,6 +665,55 @@ int gl_drawVListHiddenLine(struct dm *dmp, register struct bv_vlist *vp)
 }
 
 
+/* Material for wireframe when lighting is on: lines are drawn in the
+ * emissive wire color and never blended. */
+static void
+gl_wire_material(struct gl_vars *mvars)
+{
+    static float black[4] = {0.0, 0.0, 0.0, 0.0};
+
+    glMaterialfv(GL_FRONT_AND_BACK, GL_EMISSION, mvars->i.wireColor);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, black);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, black);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, black);
+
+    if (mvars->transparency_on)
+	glDisable(GL_BLEND);
+}
+
+
+/* Material for shaded polygons when lighting is on */
+static void
+gl_surface_material(struct gl_vars *mvars)
+{
+    static float black[4] = {0.0, 0.0, 0.0, 0.0};
+
+    glMaterialfv(GL_FRONT_AND_BACK, GL_EMISSION, black);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, mvars->i.ambientColor);
+    glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, mvars->i.specularColor);
+    glMaterialfv(GL_FRONT, GL_DIFFUSE, mvars->i.diffuseColor);
+
+    switch (mvars->lighting_on) {
+	case 1:
+	    break;
+	case 2:
+	    glMaterialfv(GL_BACK, GL_DIFFUSE, mvars->i.diffuseColor);
+	    break;
+	case 3:
+	    glMaterialfv(GL_BACK, GL_DIFFUSE, mvars->i.backDiffuseColorDark);
+	    break;
+	default:
+	    glMaterialfv(GL_BACK, GL_DIFFUSE, mvars->i.backDiffuseColorLight);
+	    break;
+    }
+
+    if (mvars->transparency_on) {
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+}
+
+
 int gl_drawVList(struct dm *dmp, struct bv_vlist *vp)
 {
     struct gl_vars *mvars = (struct gl_vars *)dmp->i->m_vars;
@@ -672,7 +721,6 @@ int gl_drawVList(struct dm *dmp, struct bv_vlist *vp)
     register int first;
     register int mflag = 1;
     GLfloat pointSize = 0.0;
-    static float black[4] = {0.0, 0.0, 0.0, 0.0};
     GLfloat originalPointSize, originalLineWidth;
     GLdouble m[16];
     GLdouble mt[16];
@@ -712,13 +760,7 @@ int gl_drawVList(struct dm *dmp, struct bv_vlist *vp)
 
 		    if (mvars->lighting_on && mflag) {
 			mflag = 0;
-			glMaterialfv(GL_FRONT_AND_BACK, GL_EMISSION, mvars->i.wireColor);
-			glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, black);
-			glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, black);
-			glMaterialfv(GL_FRONT_AND_BACK, GL_DIFFUSE, black);
-
-			if (mvars->transparency_on)
-			    glDisable(GL_BLEND);
+			gl_wire_material(mvars);
 		    }
 
 		    glBegin(GL_LINE_STRIP);
@@ -754,29 +796,7 @@ int gl_drawVList(struct dm *dmp, struct bv_vlist *vp)
 
 		    if (mvars->lighting_on && mflag) {
 			mflag = 0;
-			glMaterialfv(GL_FRONT_AND_BACK, GL_EMISSION, black);
-			glMaterialfv(GL_FRONT_AND_BACK, GL_AMBIENT, mvars->i.ambientColor);
-			glMaterialfv(GL_FRONT_AND_BACK, GL_SPECULAR, mvars->i.specularColor);
-			glMaterialfv(GL_FRONT, GL_DIFFUSE, mvars->i.diffuseColor);
-
-			switch (mvars->lighting_on) {
-			    case 1:
-				break;
-			    case 2:
-				glMaterialfv(GL_BACK, GL_DIFFUSE, mvars->i.diffuseColor);
-				break;
-			    case 3:
-				glMaterialfv(GL_BACK, GL_DIFFUSE, mvars->i.backDiffuseColorDark);
-				break;
-			    default:
-				glMaterialfv(GL_BACK, GL_DIFFUSE, mvars->i.backDiffuseColorLight);
-				break;
-			}
-
-			if (mvars->transparency_on) {
-			    glEnable(GL_BLEND);
-			    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-			}
+			gl_surface_material(mvars);
 		    }
 
 		    if (*cmd == BV_VLIST_POLY_START) {
@@ -860,6 +880,54 @@ int gl_drawVList(struct dm *dmp, struct bv_vlist *vp)
     return BRLCAD_OK;
 }
 
+/* Draw a vlist packed by bv_vlist_pack().  The whole object goes to
+ * the driver in at most three glDrawElements() calls from the shared
+ * vertex array instead of one call per vertex. */
+int gl_draw_vlist_packed(struct dm *dmp, struct bv_vlist_packed *p)
+{
+    struct gl_vars *mvars = (struct gl_vars *)dmp->i->m_vars;
+
+    if (!p || !p->nverts)
+	return BRLCAD_OK;
+
+    gl_debug_print(dmp, "gl_draw_vlist_packed", dmp->i->dm_debugLevel);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(3, GL_FLOAT, 0, p->verts);
+
+    if (p->nlines || p->npoints) {
+	if (mvars->lighting_on)
+	    gl_wire_material(mvars);
+	if (p->nlines)
+	    glDrawElements(GL_LINES, (GLsizei)(2 * p->nlines), GL_UNSIGNED_INT, p->lines);
+	if (p->npoints) {
+#if ENABLE_POINT_SMOOTH
+	    glEnable(GL_POINT_SMOOTH);
+#endif
+	    glDrawElements(GL_POINTS, (GLsizei)p->npoints, GL_UNSIGNED_INT, p->points);
+	}
+    }
+
+    if (p->ntris) {
+	if (mvars->lighting_on)
+	    gl_surface_material(mvars);
+	glEnableClientState(GL_NORMAL_ARRAY);
+	glNormalPointer(GL_FLOAT, 0, p->norms);
+	glDrawElements(GL_TRIANGLES, (GLsizei)(3 * p->ntris), GL_UNSIGNED_INT, p->tris);
+	glDisableClientState(GL_NORMAL_ARRAY);
+    }
+
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    if (mvars->lighting_on && mvars->transparency_on)
+	glDisable(GL_BLEND);
+
+    if (dmp->i->dm_debugLevel > 3)
+	gl_debug_print(dmp, "gl_draw_vlist_packed", dmp->i->dm_debugLevel);
+
+    return BRLCAD_OK;
+}
+
 int gl_draw_data_axes(struct dm *dmp,
                   fastf_t sf,
                   struct bv_data_axes_state *bndasp)
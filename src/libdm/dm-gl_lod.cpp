@@ -35,6 +35,7 @@
 extern "C" {
 #include "bv/defines.h"
 #include "bv/lod.h"
+#include "bv/vlist.h"
 #include "dm.h"
 #include "./dm-gl.h"
 #include "./include/private.h"
@@ -372,6 +373,39 @@ gl_draw_tri(struct dm *dmp, struct bv_mesh_lod *lod)
     return BRLCAD_ERROR;
 }
 
+// Unlike most view vlist "free" operations this is intentionally a real
+// free instead of putting the vlists onto the vlfree list for reuse -
+// the callers are trying to conserve system memory, and using vlfree
+// wouldn't improve the situation...
+static void
+vlist_release(struct bv_scene_obj *s)
+{
+    struct bu_list *p;
+    while (BU_LIST_WHILE(p, bu_list, &s->s_vlist)) {
+	BU_LIST_DEQUEUE(p);
+	struct bv_vlist *pv = (struct bv_vlist *)p;
+	BU_FREE(pv, struct bv_vlist);
+    }
+}
+
+// Draw the packed copy of a CSG LoD object's vlist in place of a dlist
+static int
+gl_csg_lod_packed(struct dm *dmp, struct bv_scene_obj *s, GLfloat pointSize, GLfloat lineWidth)
+{
+    mat_t save_mat, draw_mat;
+
+    MAT_COPY(save_mat, s->s_v->gv_model2view);
+    bn_mat_mul(draw_mat, s->s_v->gv_model2view, s->s_mat);
+    dm_loadmatrix(dmp, draw_mat, 0);
+    gl_draw_vlist_packed(dmp, s->s_vpacked);
+    dm_loadmatrix(dmp, save_mat, 0);
+
+    glPointSize(pointSize);
+    glLineWidth(lineWidth);
+
+    return BRLCAD_OK;
+}
+
 static int
 gl_csg_lod(struct dm *dmp, struct bv_scene_obj *s)
 {
@@ -431,6 +465,11 @@ gl_csg_lod(struct dm *dmp, struct bv_scene_obj *s)
 	}
     }
 
+    // If we released the vlist after packing it (see below) the packed copy
+    // stands in for it until the LoD code loads new data
+    if (BU_LIST_IS_EMPTY(&s->s_vlist) && s->s_vpacked && s->s_vpacked->nverts)
+	return gl_csg_lod_packed(dmp, s, originalPointSize, originalLineWidth);
+
     // Figure out if we need a new dlist (and if so whether this vlist is a
     // candidate.)  OpenGL Display Lists are faster than immediate drawing when
     // we can use them, but they require more memory usage while they are being
@@ -447,6 +486,19 @@ gl_csg_lod(struct dm *dmp, struct bv_scene_obj *s)
 	s->s_dlist_free_callback = &dlist_free_callback;
 	glNewList(s->s_dlist, GL_COMPILE);
     } else {
+	// Without a dlist, try a packed copy of the vlist instead - it is
+	// much smaller than the vlist and goes to the driver in a few calls
+	// rather than one per vertex, so once we have it we can let the
+	// vlist go as we would after compiling a dlist.  The LoD code
+	// calls bv_obj_stale when it loads a new vlist, which drops any
+	// older copy, so a copy we still hold was made from this vlist.
+	if (!s->s_vpacked)
+	    s->s_vpacked = bv_vlist_pack(&s->s_vlist);
+	if (s->s_vpacked->nverts) {
+	    vlist_release(s);
+	    return gl_csg_lod_packed(dmp, s, originalPointSize, originalLineWidth);
+	}
+
 	bu_log("Not using dlist\n");
 	// Straight-up drawing - set up the matrix
 	MAT_COPY(save_mat, s->s_v->gv_model2view);
@@ -506,17 +558,7 @@ gl_csg_lod(struct dm *dmp, struct bv_scene_obj *s)
 	    // If the original data is sizable, clear it to save system memory.
 	    // The dlist has what it needs, and the LoD code will re-load info
 	    // as needed for updates.
-	    //
-	    // Note that unlike most view vlist "free" operations this is
-	    // intentionally a real free instead of putting the vlists onto the
-	    // vlfree list for reuse - since we're trying to conserve system
-	    // memory, using vlfree here wouldn't improve the situation...
-	    struct bu_list *p;
-	    while (BU_LIST_WHILE(p, bu_list, &s->s_vlist)) {
-		BU_LIST_DEQUEUE(p);
-		struct bv_vlist *pv = (struct bv_vlist *)p;
-		BU_FREE(pv, struct bv_vlist);
-	    }
+	    vlist_release(s);
 	}
 
 	MAT_COPY(save_mat, s->s_v->gv_model2view);
@@ -555,9 +597,10 @@ int gl_draw_obj(struct dm *dmp, struct bv_scene_obj *s)
     if (bu_list_len(&s->s_vlist)) {
 	if (s->s_os->s_dmode == 4) {
 	    dm_draw_vlist_hidden_line(dmp, (struct bv_vlist *)&s->s_vlist);
-	} else {
-	    dm_draw_vlist(dmp, (struct bv_vlist *)&s->s_vlist);
+	    return BRLCAD_OK;
 	}
+
+	dm_draw_vlist(dmp, (struct bv_vlist *)&s->s_vlist);
 	return BRLCAD_OK;
     }
 
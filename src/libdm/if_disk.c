@@ -26,6 +26,9 @@
 
 #include "common.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "bio.h"
 
 #include "bu/color.h"
@@ -45,14 +48,164 @@
 
 #define if_seekpos u5.l	/* stored seek position */
 
+/* Pixel writes to a file are gathered into a few large tiles, aligned
+ * on tile boundaries in the file, and written back a tile at a time.
+ * Rendering a huge image then costs one big write per tile instead of
+ * a seek and a write per scanline, and memory use does not depend on
+ * the image size.
+ */
+#define DISK_TILE_BYTES ((size_t)4*(size_t)1024*(size_t)1024)
+#define DISK_TILE_CNT 8
+
+struct dsk_tile {
+    size_t start;		/* file offset of the tile */
+    size_t lo;			/* buf[lo, hi) holds unwritten data */
+    size_t hi;
+    size_t used;		/* for picking a tile to reuse */
+    unsigned char *buf;
+};
+
+struct dsk_tiles {
+    size_t clock;
+    struct dsk_tile t[DISK_TILE_CNT];
+};
+#define DSK_TILES(ptr) ((struct dsk_tiles *)((ptr)->i->u6.p))
+
+
+/* Write out the unwritten part of a tile */
+static int
+dsk_tile_flush(struct fb *ifp, struct dsk_tile *tp)
+{
+    size_t dest, n;
+
+    if (tp->hi <= tp->lo)
+	return 0;
+
+    dest = tp->start + tp->lo;
+    n = tp->hi - tp->lo;
+    if (dest != ifp->i->if_seekpos) {
+	if (bu_lseek(ifp->i->if_fd, (b_off_t)dest, 0) == -1) {
+	    fb_log("disk_tile_flush : seek to %zu failed.\n", dest);
+	    return -1;
+	}
+	ifp->i->if_seekpos = dest;
+    }
+    if (write(ifp->i->if_fd, (char *)tp->buf + tp->lo, n) != (ssize_t)n) {
+	fb_log("disk_tile_flush : write failed\n");
+	return -1;
+    }
+    ifp->i->if_seekpos += n;
+    tp->lo = tp->hi = 0;
+    return 0;
+}
+
+
+static int
+dsk_tiles_flush(struct fb *ifp)
+{
+    struct dsk_tiles *tiles = DSK_TILES(ifp);
+    int i, ret = 0;
+
+    if (!tiles)
+	return 0;
+    for (i = 0; i < DISK_TILE_CNT; i++) {
+	if (dsk_tile_flush(ifp, &tiles->t[i]))
+	    ret = -1;
+    }
+    return ret;
+}
+
+
+static void
+dsk_tiles_free(struct fb *ifp)
+{
+    struct dsk_tiles *tiles = DSK_TILES(ifp);
+    int i;
+
+    if (!tiles)
+	return;
+    for (i = 0; i < DISK_TILE_CNT; i++) {
+	if (tiles->t[i].buf)
+	    free(tiles->t[i].buf);
+    }
+    free(tiles);
+    ifp->i->u6.p = NULL;
+}
+
+
+/* Read bytes [lo, hi) of a tile from the file, so that the unwritten
+ * range of the tile can grow over them.  Anything past the end of the
+ * file reads as zero.
+ */
+static int
+dsk_tile_fill(struct fb *ifp, struct dsk_tile *tp, size_t lo, size_t hi)
+{
+    size_t dest = tp->start + lo;
+    size_t done = 0;
+
+    if (bu_lseek(ifp->i->if_fd, (b_off_t)dest, 0) == -1)
+	return -1;
+    ifp->i->if_seekpos = dest;
+    while (done < hi - lo) {
+	ssize_t got = read(ifp->i->if_fd, (char *)tp->buf + lo + done, hi - lo - done);
+	if (got < 0)
+	    return -1;
+	if (got == 0)
+	    break;
+	done += got;
+	ifp->i->if_seekpos += got;
+    }
+    if (done < hi - lo)
+	memset(tp->buf + lo + done, 0, hi - lo - done);
+    return 0;
+}
+
+
+/* Find the tile starting at file offset start, taking over an unused
+ * or the least recently used tile if it is not held.
+ */
+static struct dsk_tile *
+dsk_tile_get(struct fb *ifp, size_t start)
+{
+    struct dsk_tiles *tiles = DSK_TILES(ifp);
+    struct dsk_tile *tp = &tiles->t[0];
+    int i;
+
+    for (i = 0; i < DISK_TILE_CNT; i++) {
+	struct dsk_tile *cp = &tiles->t[i];
+	if (cp->buf && cp->start == start) {
+	    cp->used = ++tiles->clock;
+	    return cp;
+	}
+	if (tp->buf && (!cp->buf || cp->used < tp->used))
+	    tp = cp;
+    }
+
+    if (!tp->buf) {
+	if ((tp->buf = (unsigned char *)malloc(DISK_TILE_BYTES)) == NULL) {
+	    fb_log("disk_tile_get : tile malloc failed\n");
+	    return NULL;
+	}
+    } else if (dsk_tile_flush(ifp, tp)) {
+	return NULL;
+    }
+    tp->start = start;
+    tp->lo = tp->hi = 0;
+    tp->used = ++tiles->clock;
+    return tp;
+}
+
 
 static int
 dsk_open(struct fb *ifp, const char *file, int width, int height)
 {
     static char zero = 0;
+    int writable = 0;
 
     FB_CK_FB(ifp->i);
 
+    ifp->i->u6.p = NULL;
+
     /* check for default size */
     if (width == 0)
 	width = ifp->i->if_width;
@@ -72,17 +225,19 @@ dsk_open(struct fb *ifp, const char *file, int width, int height)
 	return 0;
     }
 
-    if ((ifp->i->if_fd = open(file, O_RDWR | O_BINARY, 0)) == -1
-	&& (ifp->i->if_fd = open(file, O_RDONLY | O_BINARY, 0)) == -1) {
+    if ((ifp->i->if_fd = open(file, O_RDWR | O_BINARY, 0)) != -1) {
+	writable = 1;
+    } else if ((ifp->i->if_fd = open(file, O_RDONLY | O_BINARY, 0)) == -1) {
 	if ((ifp->i->if_fd = open(file, O_RDWR | O_CREAT | O_BINARY, 0664)) > 0) {
+	    writable = 1;
 	    /* New file, write byte at end */
 	    if (bu_lseek(ifp->i->if_fd, (height*width*sizeof(RGBpixel)-1), 0) == -1) {
 		fb_log("disk_device_open : can not seek to end of new file.\n");
-		return -1;
+		goto fail;
 	    }
 	    if (write(ifp->i->if_fd, &zero, 1) < 0) {
 		fb_log("disk_device_open : initial write failed.\n");
-		return -1;
+		goto fail;
 	    }
 	} else
 	    return -1;
@@ -94,10 +249,24 @@ dsk_open(struct fb *ifp, const char *file, int width, int height)
     ifp->i->if_height = height;
     if (bu_lseek(ifp->i->if_fd, 0, 0) == -1) {
 	fb_log("disk_device_open : can not seek to beginning.\n");
-	return -1;
+	goto fail;
     }
     ifp->i->if_seekpos = 0;
+
+    /* pixel writes go through tiles, except to stdout */
+    if (writable) {
+	if ((ifp->i->u6.p = (char *)calloc(1, sizeof(struct dsk_tiles))) == NULL) {
+	    fb_log("disk_device_open : tile table malloc failed.\n");
+	    goto fail;
+	}
+    }
     return 0;
+
+fail:
+    /* fb_open() does not close a device that failed to open */
+    close(ifp->i->if_fd);
+    ifp->i->if_fd = -1;
+    return -1;
 }
 
 static struct fb_platform_specific *
@@ -137,16 +306,29 @@ dsk_refresh(struct fb *UNUSED(ifp), int UNUSED(x), int UNUSED(y), int UNUSED(w),
         return 0;
 }
 
+static int
+dsk_flush(struct fb *ifp)
+{
+    return dsk_tiles_flush(ifp);
+}
+
+
 static int
 dsk_close(struct fb *ifp)
 {
-    return close(ifp->i->if_fd);
+    int ret = dsk_tiles_flush(ifp);
+
+    dsk_tiles_free(ifp);
+    if (close(ifp->i->if_fd) < 0)
+	ret = -1;
+    return ret;
 }
 
 
 static int
 dsk_free(struct fb *ifp)
 {
+    dsk_tiles_free(ifp);
     close(ifp->i->if_fd);
     if (bu_file_delete(ifp->i->if_name)) {
 	return 0;
@@ -174,6 +356,12 @@ disk_color_clear(struct fb *ifp, register unsigned char *bpp)
 	pix_to += sizeof(RGBpixel);
     }
 
+    /* Anything not yet written is about to be overwritten */
+    if (DSK_TILES(ifp)) {
+	for (i = 0; i < DISK_TILE_CNT; i++)
+	    DSK_TILES(ifp)->t[i].lo = DSK_TILES(ifp)->t[i].hi = 0;
+    }
+
     /* Set start of framebuffer */
     fd = ifp->i->if_fd;
     if (ifp->i->if_seekpos != 0 && bu_lseek(fd, 0, 0) == -1) {
@@ -220,6 +408,9 @@ dsk_read(struct fb *ifp, int x, int y, unsigned char *pixelp, size_t count)
     /* Reads on stdout make no sense.  Take reads from stdin. */
     if (fd == 1) fd = 0;
 
+    if (dsk_tiles_flush(ifp))
+	return -1;
+
     dest = ((y * ifp->i->if_width) + x) * sizeof(RGBpixel);
     if (ifp->i->if_seekpos != dest && bu_lseek(fd, dest, 0) == -1) {
 	fb_log("disk_buffer_read : seek to %zu failed.\n", dest);
@@ -255,6 +446,48 @@ dsk_read(struct fb *ifp, int x, int y, unsigned char *pixelp, size_t count)
 }
 
 
+/* Copy pixels into the tiles, writing out tiles as they are reused */
+static ssize_t
+dsk_write_tiled(struct fb *ifp, size_t dest, const unsigned char *pixelp, size_t count)
+{
+    size_t bytes = count * sizeof(RGBpixel);
+
+    while (bytes > 0) {
+	size_t start = dest - dest % DISK_TILE_BYTES;
+	size_t lo = dest - start;
+	size_t hi = (bytes > DISK_TILE_BYTES - lo) ? DISK_TILE_BYTES : lo + bytes;
+	struct dsk_tile *tp = dsk_tile_get(ifp, start);
+
+	if (!tp)
+	    return -1;
+
+	/* keep the unwritten range contiguous, reading in any gap */
+	if (tp->hi > tp->lo) {
+	    if ((lo > tp->hi && dsk_tile_fill(ifp, tp, tp->hi, lo))
+		|| (hi < tp->lo && dsk_tile_fill(ifp, tp, hi, tp->lo))) {
+		if (dsk_tile_flush(ifp, tp))
+		    return -1;
+	    }
+	}
+	memcpy(tp->buf + lo, pixelp, hi - lo);
+	if (tp->hi > tp->lo) {
+	    if (lo < tp->lo)
+		tp->lo = lo;
+	    if (hi > tp->hi)
+		tp->hi = hi;
+	} else {
+	    tp->lo = lo;
+	    tp->hi = hi;
+	}
+
+	pixelp += hi - lo;
+	bytes -= hi - lo;
+	dest += hi - lo;
+    }
+    return count;
+}
+
+
 static ssize_t
 dsk_write(struct fb *ifp, int x, int y, const unsigned char *pixelp, size_t count)
 {
@@ -263,6 +496,8 @@ dsk_write(struct fb *ifp, int x, int y, const unsigned char *pixelp, size_t coun
     size_t dest;
 
     dest = (y * ifp->i->if_width + x) * sizeof(RGBpixel);
+    if (DSK_TILES(ifp))
+	return dsk_write_tiled(ifp, dest, pixelp, count);
     if (dest != ifp->i->if_seekpos) {
 	if (bu_lseek(ifp->i->if_fd, (b_off_t)dest, 0) == -1) {
 	    fb_log("disk_buffer_write : seek to %zd failed.\n", dest);
@@ -379,7 +614,7 @@ struct fb_impl disk_interface_impl = {
     dsk_configure_window,
     dsk_refresh,
     fb_null,		/* poll */
-    fb_null,		/* flush */
+    dsk_flush,		/* flush */
     dsk_free,
     dsk_help,
     "Disk File Interface",
@@ -0,0 +1,232 @@
+/*                       F B _ D I S K . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file fb_disk.c
+ *
+ * Check the disk file framebuffer: scanlines written out of order
+ * come back from fb_read() and land in the file, and neither a
+ * normal open and close nor an open that fails after the file was
+ * opened leaves a file descriptor behind.
+ *
+ * Usage: fb_disk [file.pix]
+ *
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#ifdef HAVE_SYS_RESOURCE_H
+#  include <sys/resource.h>
+#endif
+#include <signal.h>
+
+#include "bio.h"
+
+#include "bu/app.h"
+#include "bu/file.h"
+#include "bu/log.h"
+#include "bu/malloc.h"
+#include "dm.h"
+
+#define FD_SIZE 256
+
+
+/* Lowest file descriptor not in use */
+static int
+fd_lowest(void)
+{
+    int fd = dup(fileno(stderr));
+    if (fd >= 0)
+	close(fd);
+    return fd;
+}
+
+
+static void
+fd_pixel(unsigned char *pp, int x, int y)
+{
+    pp[0] = (unsigned char)x;
+    pp[1] = (unsigned char)y;
+    pp[2] = (unsigned char)(x ^ y);
+}
+
+
+static int
+fd_roundtrip(const char *file)
+{
+    struct fb *fbp;
+    unsigned char *line = (unsigned char *)bu_malloc(FD_SIZE * sizeof(RGBpixel), "line");
+    unsigned char *img = (unsigned char *)bu_malloc(FD_SIZE * FD_SIZE * sizeof(RGBpixel), "img");
+    int x, y, bad = 0;
+    FILE *fp;
+
+    if ((fbp = fb_open(file, FD_SIZE, FD_SIZE)) == FB_NULL) {
+	bu_log("unable to open %s [FAIL]\n", file);
+	bu_free(line, "line");
+	bu_free(img, "img");
+	return 1;
+    }
+
+    /* top down, the way rt's parallel workers tend to finish */
+    for (y = FD_SIZE - 1; y >= 0; y--) {
+	for (x = 0; x < FD_SIZE; x++)
+	    fd_pixel(&line[x * sizeof(RGBpixel)], x, y);
+	if (fb_write(fbp, 0, y, line, FD_SIZE) != FD_SIZE) {
+	    bu_log("write of scanline %d failed [FAIL]\n", y);
+	    bad++;
+	}
+    }
+
+    memset(line, 0, FD_SIZE * sizeof(RGBpixel));
+    if (fb_read(fbp, 0, FD_SIZE / 2, line, FD_SIZE) != FD_SIZE) {
+	bu_log("read of scanline %d failed [FAIL]\n", FD_SIZE / 2);
+	bad++;
+    } else {
+	for (x = 0; x < FD_SIZE; x++) {
+	    unsigned char want[3];
+	    fd_pixel(want, x, FD_SIZE / 2);
+	    if (memcmp(&line[x * sizeof(RGBpixel)], want, sizeof(RGBpixel))) {
+		bu_log("pixel %d,%d read back wrong [FAIL]\n", x, FD_SIZE / 2);
+		bad++;
+		break;
+	    }
+	}
+    }
+
+    if (fb_close(fbp) < 0) {
+	bu_log("close of %s failed [FAIL]\n", file);
+	bad++;
+    }
+
+    if ((fp = fopen(file, "rb")) == NULL
+	|| fread(img, sizeof(RGBpixel), FD_SIZE * FD_SIZE, fp) != FD_SIZE * FD_SIZE) {
+	bu_log("unable to read back %s [FAIL]\n", file);
+	bad++;
+    } else {
+	for (y = 0; y < FD_SIZE && !bad; y++) {
+	    for (x = 0; x < FD_SIZE; x++) {
+		unsigned char want[3];
+		fd_pixel(want, x, y);
+		if (memcmp(&img[(y * FD_SIZE + x) * sizeof(RGBpixel)], want, sizeof(RGBpixel))) {
+		    bu_log("pixel %d,%d wrong in %s [FAIL]\n", x, y, file);
+		    bad++;
+		    break;
+		}
+	    }
+	}
+    }
+    if (fp)
+	fclose(fp);
+
+    bu_free(line, "line");
+    bu_free(img, "img");
+    return bad;
+}
+
+
+/* Make the initial write of a new file fail, after dsk_open() has
+ * opened it, by lowering the file size limit below the image size.
+ */
+static int
+fd_failed_open(const char *file)
+{
+#if defined(HAVE_SYS_RESOURCE_H) && defined(SIGXFSZ)
+    struct rlimit old, lim;
+    struct fb *fbp;
+    int before, after;
+
+    if (getrlimit(RLIMIT_FSIZE, &old))
+	return 0;
+    lim = old;
+    lim.rlim_cur = FD_SIZE * FD_SIZE;	/* a third of the image */
+    signal(SIGXFSZ, SIG_IGN);
+
+    bu_file_delete(file);
+    before = fd_lowest();
+    if (setrlimit(RLIMIT_FSIZE, &lim)) {
+	bu_log("unable to lower the file size limit, skipping the failed open check\n");
+	return 0;
+    }
+    fbp = fb_open(file, FD_SIZE, FD_SIZE);
+    (void)setrlimit(RLIMIT_FSIZE, &old);
+    after = fd_lowest();
+
+    if (fbp != FB_NULL) {
+	bu_log("open of %s succeeded past the file size limit [FAIL]\n", file);
+	fb_close(fbp);
+	return 1;
+    }
+    if (before != after) {
+	bu_log("failed open left a file descriptor open (%d free before, %d after) [FAIL]\n", before, after);
+	return 1;
+    }
+#else
+    (void)file;
+#endif
+    return 0;
+}
+
+
+int
+main(int argc, const char **argv)
+{
+    const char *file = "fb_disk.pix";
+    int before, i, bad = 0;
+
+    bu_setprogname(argv[0]);
+
+    if (argc > 1)
+	file = argv[1];
+
+    bu_file_delete(file);
+    before = fd_lowest();
+    bad += fd_roundtrip(file);
+
+    /* reopen the existing file a few times */
+    for (i = 0; i < 16; i++) {
+	struct fb *fbp = fb_open(file, FD_SIZE, FD_SIZE);
+	if (fbp == FB_NULL) {
+	    bu_log("reopen %d of %s failed [FAIL]\n", i, file);
+	    bad++;
+	    break;
+	}
+	fb_close(fbp);
+    }
+    if (fd_lowest() != before) {
+	bu_log("open and close left a file descriptor open [FAIL]\n");
+	bad++;
+    }
+
+    bad += fd_failed_open(file);
+    bu_file_delete(file);
+
+    return (bad) ? 1 : 0;
+}
+
+/*
+ * Local Variables:
+ * mode: C
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
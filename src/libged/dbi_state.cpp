@@ -1521,6 +1521,125 @@ DbiState::tops(bool show_cyclic)
     return ret;
 }
 
+struct dbi_bbox_job {
+    struct db_i *dbip = NULL;
+    std::vector<struct directory *> *dps = NULL;
+    std::vector<fastf_t> *bounds = NULL;
+    std::vector<int> *have = NULL;
+    struct resource *res = NULL;
+    size_t next_res = 0;
+    size_t next_dp = 0;
+};
+
+static void
+dbi_bbox_worker(int UNUSED(cpu), void *data)
+{
+    struct dbi_bbox_job *j = (struct dbi_bbox_job *)data;
+    struct bg_tess_tol ttol = BG_TESS_TOL_INIT_ZERO;
+    struct bn_tol tol = BN_TOL_INIT_TOL;
+
+    // bu_parallel cpu ids are not guaranteed to be dense, so each worker
+    // claims its own resource slot
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    struct resource *res = &j->res[j->next_res++];
+    bu_semaphore_release(BU_SEM_GENERAL);
+
+    while (1) {
+	bu_semaphore_acquire(BU_SEM_GENERAL);
+	size_t i = j->next_dp++;
+	bu_semaphore_release(BU_SEM_GENERAL);
+	if (i >= j->dps->size())
+	    break;
+
+	point_t bmin, bmax;
+	mat_t m;
+	MAT_IDN(m);
+	if (rt_bound_instance(&bmin, &bmax, (*j->dps)[i], j->dbip, &ttol, &tol, &m, res) == -1)
+	    continue;
+	VMOVE(&(*j->bounds)[i*6], bmin);
+	VMOVE(&(*j->bounds)[i*6+3], bmax);
+	(*j->have)[i] = 1;
+    }
+}
+
+void
+DbiState::update_bboxes(std::unordered_set<struct directory *> &dps)
+{
+    // Only solids have bounds of their own - comb boxes are assembled from
+    // their children on demand in get_bbox.  Anything already cached on
+    // disk is picked up serially, since the cache is not set up for
+    // concurrent transactions.
+    std::vector<struct directory *> todo;
+    std::unordered_set<struct directory *>::iterator d_it;
+    for (d_it = dps.begin(); d_it != dps.end(); d_it++) {
+	struct directory *dp = *d_it;
+	if ((dp->d_flags & RT_DIR_COMB) || (dp->d_flags & DB_LS_HIDDEN))
+	    continue;
+	unsigned long long hash = bu_data_hash(dp->d_namep, strlen(dp->d_namep)*sizeof(char));
+	if (bboxes.find(hash) != bboxes.end())
+	    continue;
+	const char *b = NULL;
+	size_t bsize = cache_get(dcache, (void **)&b, hash, CACHE_OBJ_BOUNDS);
+	if (bsize == 2*sizeof(point_t)) {
+	    point_t bmin, bmax;
+	    memcpy(&bmin, b, sizeof(bmin));
+	    memcpy(&bmax, b + sizeof(bmin), sizeof(bmax));
+	    bboxes[hash] = {bmin[X], bmin[Y], bmin[Z], bmax[X], bmax[Y], bmax[Z]};
+	    cache_done(dcache);
+	    continue;
+	}
+	cache_done(dcache);
+	todo.push_back(dp);
+    }
+    if (!todo.size())
+	return;
+
+    size_t ncpus = bu_avail_cpus();
+    if (ncpus > todo.size())
+	ncpus = todo.size();
+    if (ncpus > MAX_PSW)
+	ncpus = MAX_PSW;
+
+    // Results are staged and only published into bboxes once every box
+    // is ready, so readers never see a partially updated set
+    std::vector<fastf_t> bounds(todo.size() * 6, 0.0);
+    std::vector<int> have(todo.size(), 0);
+    struct dbi_bbox_job j;
+    j.dbip = dbip;
+    j.dps = &todo;
+    j.bounds = &bounds;
+    j.have = &have;
+    j.res = (struct resource *)bu_calloc(ncpus, sizeof(struct resource), "bbox resources");
+    for (size_t i = 0; i < ncpus; i++)
+	rt_init_resource(&j.res[i], (int)i, NULL);
+
+    if (ncpus > 1) {
+	bu_parallel(dbi_bbox_worker, ncpus, (void *)&j);
+    } else {
+	dbi_bbox_worker(0, (void *)&j);
+    }
+
+    for (size_t i = 0; i < ncpus; i++)
+	rt_clean_resource_basic(NULL, &j.res[i]);
+    bu_free(j.res, "bbox resources");
+
+    for (size_t i = 0; i < todo.size(); i++) {
+	if (!have[i])
+	    continue;
+	struct directory *dp = todo[i];
+	unsigned long long hash = bu_data_hash(dp->d_namep, strlen(dp->d_namep)*sizeof(char));
+	bboxes[hash] = std::vector<fastf_t>(bounds.begin() + i*6, bounds.begin() + i*6 + 6);
+
+	point_t bmin, bmax;
+	VMOVE(bmin, &bounds[i*6]);
+	VMOVE(bmax, &bounds[i*6+3]);
+	std::stringstream s;
+	s.write(reinterpret_cast<const char *>(&bmin), sizeof(bmin));
+	s.write(reinterpret_cast<const char *>(&bmax), sizeof(bmax));
+	cache_write(dcache, hash, CACHE_OBJ_BOUNDS, s);
+    }
+}
+
 unsigned long long
 DbiState::update()
 {
@@ -1551,22 +1670,30 @@ DbiState::update()
 	changed_hashes.insert(hash);
     }
 
-    // Update the primary data structures
-    for(s_it = removed.begin(); s_it != removed.end(); s_it++) {
-	bu_log("removed: %llu\n", *s_it);
-
-	// Combs with this key in their child set need to be updated to refer
-	// to it as an invalid entry.
+    // Combs with a removed key in their child set need to be updated to
+    // refer to it as an invalid entry.  One pass over the combs covers
+    // all removed objects, rather than one pass per removed object.
+    if (removed.size()) {
 	std::unordered_map<unsigned long long, std::vector<unsigned long long>>::iterator pv_it;
 	for (pv_it = p_v.begin(); pv_it != p_v.end(); pv_it++) {
 	    for (size_t i = 0; i < pv_it->second.size(); i++) {
-		if (i_map.find(pv_it->second[i]) != i_map.end()) {
-		    invalid_entry_map[i_map[pv_it->second[i]]] = i_str[i_map[pv_it->second[i]]];
+		unsigned long long chash = pv_it->second[i];
+		std::unordered_map<unsigned long long, unsigned long long>::iterator im_it = i_map.find(chash);
+		unsigned long long ohash = (im_it != i_map.end()) ? im_it->second : chash;
+		if (removed.find(ohash) == removed.end())
+		    continue;
+		if (im_it != i_map.end()) {
+		    invalid_entry_map[chash] = i_str[chash];
 		} else {
-		    invalid_entry_map[pv_it->second[i]] = old_names[*s_it];
+		    invalid_entry_map[chash] = old_names[ohash];
 		}
 	    }
 	}
+    }
+
+    // Update the primary data structures
+    for(s_it = removed.begin(); s_it != removed.end(); s_it++) {
+	bu_log("removed: %llu\n", *s_it);
 
 	d_map.erase(*s_it);
 	bboxes.erase(*s_it);
@@ -1604,6 +1731,12 @@ DbiState::update()
 	update_dp(dp, 1);
     }
 
+    // Solid bounding boxes for new and edited objects are computed in
+    // parallel rather than one at a time during the redraw below
+    std::unordered_set<struct directory *> bbox_dps = added;
+    bbox_dps.insert(changed.begin(), changed.end());
+    update_bboxes(bbox_dps);
+
     // Garbage collect i_map and i_str
     std::unordered_map<unsigned long long, std::vector<unsigned long long>>::iterator sk_it;
     std::unordered_set<unsigned long long> used;
@@ -1613,7 +1746,7 @@ DbiState::update()
     std::vector<unsigned long long> unused;
     std::unordered_map<unsigned long long, unsigned long long>::iterator im_it;
     for (im_it = i_map.begin(); im_it != i_map.end(); im_it++) {
-	if (used.find(im_it->first) != used.end())
+	if (used.find(im_it->first) == used.end())
 	    unused.push_back(im_it->first);
     }
     for (size_t i = 0; i < unused.size(); i++) {
@@ -2912,6 +3045,24 @@ BViewState::redraw(struct bv_obj_settings *vs, std::unordered_set<struct bview *
     // work for the "top level" object used for adaptive cases, since shared
     // views will be using a shared object pool for anything other than their
     // view specific geometry sub-objects.
+    //
+    // View independent geometry is the same for every view, so when none of
+    // the views are adaptive generate it up front on all the cpus.  Objects
+    // plotted that way are current, and the loop below passes them over.
+    bool adaptive = false;
+    for (v_it = views.begin(); v_it != views.end(); v_it++) {
+	if ((*v_it)->gv_s->adaptive_plot_csg || (*v_it)->gv_s->adaptive_plot_mesh)
+	    adaptive = true;
+    }
+    if (!adaptive && views.size() && objs.size() > 1) {
+	struct bu_ptbl pobjs = BU_PTBL_INIT_ZERO;
+	bu_ptbl_init(&pobjs, objs.size(), "parallel draw objs");
+	std::unordered_set<struct bv_scene_obj *>::iterator o_it;
+	for (o_it = objs.begin(); o_it != objs.end(); o_it++)
+	    bu_ptbl_ins(&pobjs, (long *)*o_it);
+	draw_scene_parallel(&pobjs, 0);
+	bu_ptbl_free(&pobjs);
+    }
     for (v_it = views.begin(); v_it != views.end(); v_it++) {
 	std::unordered_set<struct bv_scene_obj *>::iterator o_it;
 	for (o_it = objs.begin(); o_it != objs.end(); o_it++) {
@@ -29,6 +29,7 @@
 #include <string.h>
 
 #include "bu/hash.h"
+#include "bu/parallel.h"
 #include "bu/ptbl.h"
 #include "bu/str.h"
 #include "bu/color.h"
@@ -736,7 +737,8 @@ dl_add_path(int dashflag, struct bu_list *vhead, const struct db_full_path *path
 
 static fastf_t
 draw_solid_wireframe(struct bv_scene_obj *sp, struct bview *gvp, struct db_i *dbip,
-		     const struct bn_tol *tol, const struct bg_tess_tol *ttol)
+		     const struct bn_tol *tol, const struct bg_tess_tol *ttol,
+		     struct resource *resp)
 {
     int ret;
     struct bu_list vhead;
@@ -749,7 +751,7 @@ draw_solid_wireframe(struct bv_scene_obj *sp, struct bview *gvp, struct db_i *db
     struct ged_bv_data *bdata = (struct ged_bv_data *)sp->s_u_data;
 
     ret = rt_db_get_internal(ip, DB_FULL_PATH_CUR_DIR(&bdata->s_fullpath),
-			     dbip, sp->s_mat, &rt_uniresource);
+			     dbip, sp->s_mat, resp);
 
     if (ret < 0) {
 	return -1;
@@ -785,28 +787,132 @@ redraw_solid(struct bv_scene_obj *sp, struct db_i *dbip, struct db_tree_state *t
 	if (BU_LIST_NON_EMPTY(&sp->s_vlist)) {
 	    BV_FREE_VLIST(&RTG.rtg_vlfree, &sp->s_vlist);
 	}
-	return draw_solid_wireframe(sp, gvp, dbip, tsp->ts_tol, tsp->ts_ttol);
+	return draw_solid_wireframe(sp, gvp, dbip, tsp->ts_tol, tsp->ts_ttol, &rt_uniresource);
     }
     return 0;
 }
 
 
+struct dl_redraw_job {
+    struct bu_ptbl *objs;	/* solids to plot */
+    size_t next_obj;
+    struct resource *res;	/* one per worker */
+    struct bu_list *vlfree;	/* one vlist freelist per worker */
+    size_t next_slot;
+    struct db_i *dbip;
+    struct db_tree_state *tsp;
+    struct bview *gvp;
+    int ret;
+};
+
+
+static void
+dl_redraw_worker(int UNUSED(cpu), void *data)
+{
+    struct dl_redraw_job *j = (struct dl_redraw_job *)data;
+    struct bu_list *ovlfree;
+    size_t slot;
+    int ret = 0;
+
+    /* bu_parallel cpu ids are not guaranteed to be dense, so each
+     * worker claims its own resource and freelist slot */
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    slot = j->next_slot++;
+    bu_semaphore_release(BU_SEM_GENERAL);
+
+    /* the plot routines get their vlists from rt_vlfree(), which
+     * would otherwise be the shared RTG.rtg_vlfree */
+    ovlfree = rt_vlfree_set(&j->vlfree[slot]);
+
+    while (1) {
+	struct bv_scene_obj *sp;
+	size_t i;
+
+	bu_semaphore_acquire(BU_SEM_GENERAL);
+	i = j->next_obj++;
+	bu_semaphore_release(BU_SEM_GENERAL);
+	if (i >= BU_PTBL_LEN(j->objs))
+	    break;
+
+	/* each solid is plotted by exactly one worker, straight onto
+	 * its own s_vlist, so the result does not depend on which */
+	sp = (struct bv_scene_obj *)BU_PTBL_GET(j->objs, i);
+	ret += draw_solid_wireframe(sp, j->gvp, j->dbip, j->tsp->ts_tol, j->tsp->ts_ttol, &j->res[slot]);
+    }
+
+    (void)rt_vlfree_set(ovlfree);
+
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    j->ret += ret;
+    bu_semaphore_release(BU_SEM_GENERAL);
+}
+
+
 int
-dl_redraw(struct display_list *gdlp, struct ged *gedp, int skip_subtractions)
+dl_redraw(struct display_list *gdlp, struct ged *gedp, int skip_subtractions, size_t ncpu)
 {
     struct db_i *dbip = gedp->dbip;
     struct rt_wdb *wdbp = wdb_dbopen(gedp->dbip, RT_WDB_TYPE_DB_DEFAULT);
     struct db_tree_state *tsp = &wdbp->wdb_initial_tree_state;
     struct bview *gvp = gedp->ged_gvp;
-    int ret = 0;
+    struct bu_ptbl objs = BU_PTBL_INIT_ZERO;
+    struct dl_redraw_job j;
     struct bv_scene_obj *sp;
+    size_t i;
+
+    /* Only wireframes are replotted (see redraw_solid).  Their old
+     * vlists go back on the shared freelist before any threads start. */
+    bu_ptbl_init(&objs, 64, "redraw solids");
     for (BU_LIST_FOR(sp, bv_scene_obj, &gdlp->dl_head_scene_obj)) {
-	if (!skip_subtractions || (skip_subtractions && !sp->s_soldash)) {
-	    ret += redraw_solid(sp, dbip, tsp, gvp);
+	if (skip_subtractions && sp->s_soldash)
+	    continue;
+	if (sp->s_os->s_dmode != _GED_WIREFRAME)
+	    continue;
+	if (BU_LIST_NON_EMPTY(&sp->s_vlist)) {
+	    BV_FREE_VLIST(&RTG.rtg_vlfree, &sp->s_vlist);
 	}
+	bu_ptbl_ins(&objs, (long *)sp);
+    }
+
+    if (!ncpu)
+	ncpu = bu_avail_cpus();
+    if (ncpu > BU_PTBL_LEN(&objs))
+	ncpu = BU_PTBL_LEN(&objs);
+    if (ncpu > MAX_PSW)
+	ncpu = MAX_PSW;
+    if (ncpu < 1)
+	ncpu = 1;
+
+    memset(&j, 0, sizeof(struct dl_redraw_job));
+    j.objs = &objs;
+    j.dbip = dbip;
+    j.tsp = tsp;
+    j.gvp = gvp;
+    j.res = (struct resource *)bu_calloc(ncpu, sizeof(struct resource), "redraw resources");
+    j.vlfree = (struct bu_list *)bu_calloc(ncpu, sizeof(struct bu_list), "redraw vlfree");
+    for (i = 0; i < ncpu; i++) {
+	rt_init_resource(&j.res[i], (int)i, NULL);
+	BU_LIST_INIT(&j.vlfree[i]);
     }
+
+    if (ncpu > 1) {
+	bu_parallel(dl_redraw_worker, ncpu, (void *)&j);
+    } else {
+	dl_redraw_worker(0, (void *)&j);
+    }
+
+    /* Whatever the workers freed goes back on the shared list, in
+     * worker order */
+    for (i = 0; i < ncpu; i++) {
+	BU_LIST_APPEND_LIST(&RTG.rtg_vlfree, &j.vlfree[i]);
+	rt_clean_resource_basic(NULL, &j.res[i]);
+    }
+    bu_free(j.vlfree, "redraw vlfree");
+    bu_free(j.res, "redraw resources");
+    bu_ptbl_free(&objs);
+
     ged_create_vlist_display_list_cb(gedp, gdlp);
-    return ret;
+    return j.ret;
 }
 
 
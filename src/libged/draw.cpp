@@ -27,6 +27,7 @@
 
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include <stdlib.h>
 #include <ctype.h>
@@ -37,6 +38,7 @@
 #include "bu/cmd.h"
 #include "bu/hash.h"
 #include "bu/opt.h"
+#include "bu/parallel.h"
 #include "bu/sort.h"
 #include "bu/str.h"
 #include "bv/defines.h"
@@ -713,10 +715,13 @@ draw_scene(struct bv_scene_obj *s, struct bview *v)
 	switch (ip->idb_minor_type) {
 	    case DB5_MINORTYPE_BRLCAD_BOT:
 		(void)rt_bot_plot_poly(&s->s_vlist, ip, ttol, tol);
+		// The mesh is view independent - don't replot it per view
+		s->current = 1;
 		goto geom_done;
 		break;
 	    case DB5_MINORTYPE_BRLCAD_POLY:
 		(void)rt_pg_plot_poly(&s->s_vlist, ip, ttol, tol);
+		s->current = 1;
 		goto geom_done;
 		break;
 	    case DB5_MINORTYPE_BRLCAD_BREP:
@@ -788,6 +793,119 @@ geom_done:
     rt_db_free_internal(&dbintern);
 }
 
+/* Only the view independent wireframe and mode 1 mesh plots are generated
+ * in parallel - tessellation (modes 2 and 4) shares s->vlfree, and modes
+ * 3 and 5 raytrace or evaluate booleans on their own. */
+static void
+draw_scene_collect(std::vector<struct bv_scene_obj *> &plot, struct bv_scene_obj *s)
+{
+    if (s->current)
+	return;
+    struct draw_update_data_t *d = (struct draw_update_data_t *)s->s_i_data;
+    if (!d) {
+	for (size_t i = 0; i < BU_PTBL_LEN(&s->children); i++) {
+	    struct bv_scene_obj *c = (struct bv_scene_obj *)BU_PTBL_GET(&s->children, i);
+	    draw_scene_collect(plot, c);
+	}
+	return;
+    }
+    if (s->s_os->s_dmode != 0 && s->s_os->s_dmode != 1)
+	return;
+    struct db_full_path *fp = (struct db_full_path *)s->s_path;
+    if (fp && fp->fp_len <= 0)
+	return;
+    struct directory *dp = (fp) ? DB_FULL_PATH_CUR_DIR(fp) : (struct directory *)s->dp;
+    if (!dp)
+	return;
+    // BRep meshing is left to the serial pass
+    if (s->s_os->s_dmode == 1 && dp->d_minor_type == DB5_MINORTYPE_BRLCAD_BREP)
+	return;
+    plot.push_back(s);
+}
+
+struct draw_scene_job {
+    std::vector<struct bv_scene_obj *> *plot;
+    size_t next_obj;
+    struct resource *res;
+    struct bu_list *vlfree;
+    size_t next_slot;
+};
+
+static void
+draw_scene_worker(int UNUSED(cpu), void *data)
+{
+    struct draw_scene_job *j = (struct draw_scene_job *)data;
+
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    size_t slot = j->next_slot++;
+    bu_semaphore_release(BU_SEM_GENERAL);
+
+    // Plot routines pull vlist chunks from rt_vlfree() - give this thread
+    // its own list rather than the shared RTG.rtg_vlfree
+    struct bu_list *ovlfree = rt_vlfree_set(&j->vlfree[slot]);
+
+    while (1) {
+	bu_semaphore_acquire(BU_SEM_GENERAL);
+	size_t i = j->next_obj++;
+	bu_semaphore_release(BU_SEM_GENERAL);
+	if (i >= j->plot->size())
+	    break;
+
+	struct bv_scene_obj *s = (*j->plot)[i];
+	struct draw_update_data_t *d = (struct draw_update_data_t *)s->s_i_data;
+	struct resource *ores = d->res;
+	d->res = &j->res[slot];
+	draw_scene(s, NULL);
+	d->res = ores;
+    }
+
+    (void)rt_vlfree_set(ovlfree);
+}
+
+/* Generate the view independent geometry of objs on up to ncpu threads (0
+ * for all available).  Anything left un-current afterwards, such as
+ * adaptive or shaded objects, is for draw_scene to handle as usual. */
+extern "C" void
+draw_scene_parallel(struct bu_ptbl *objs, size_t ncpu)
+{
+    std::vector<struct bv_scene_obj *> plot;
+    for (size_t i = 0; i < BU_PTBL_LEN(objs); i++)
+	draw_scene_collect(plot, (struct bv_scene_obj *)BU_PTBL_GET(objs, i));
+    if (plot.size() < 2)
+	return;
+
+    if (!ncpu)
+	ncpu = bu_avail_cpus();
+    if (ncpu > plot.size())
+	ncpu = plot.size();
+    if (ncpu > MAX_PSW)
+	ncpu = MAX_PSW;
+    if (ncpu < 2)
+	return;
+
+    struct draw_scene_job j;
+    j.plot = &plot;
+    j.next_obj = 0;
+    j.next_slot = 0;
+    j.res = (struct resource *)bu_calloc(ncpu, sizeof(struct resource), "draw resources");
+    j.vlfree = (struct bu_list *)bu_calloc(ncpu, sizeof(struct bu_list), "draw vlfree");
+    for (size_t i = 0; i < ncpu; i++) {
+	rt_init_resource(&j.res[i], (int)i, NULL);
+	BU_LIST_INIT(&j.vlfree[i]);
+    }
+
+    bu_parallel(draw_scene_worker, ncpu, (void *)&j);
+
+    // Hand the threads' spare vlist chunks back to the shared list, in slot
+    // order so the result doesn't depend on thread scheduling
+    for (size_t i = 0; i < ncpu; i++) {
+	BU_LIST_APPEND_LIST(&RTG.rtg_vlfree, &j.vlfree[i]);
+	rt_clean_resource_basic(NULL, &j.res[i]);
+    }
+    bu_free(j.vlfree, "draw vlfree");
+    bu_free(j.res, "draw resources");
+}
+
 static void
 tree_color(struct directory *dp, struct draw_data_t *dd)
 {
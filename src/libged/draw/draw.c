@@ -564,6 +564,7 @@ _ged_drawtrees(struct ged *gedp, int argc, const char *argv[], int kind, struct
     int ret = 0;
     int c;
     int ncpu = 1;
+    size_t plot_ncpu = 0;	/* 0: plot on all available cpus */
     int nmg_use_tnurbs = 0;
     int enable_fastpath = 0;
     struct model *nmg_model;
@@ -656,6 +657,7 @@ _ged_drawtrees(struct ged *gedp, int argc, const char *argv[], int kind, struct
 		    break;
 		case 'P':
 		    ncpu = atoi(bu_optarg);
+		    plot_ncpu = (ncpu > 0) ? (size_t)ncpu : 0;
 		    break;
 		case 'q':
 		    dgcdp.do_not_draw_nmg_solids_during_debugging = 1;
@@ -923,7 +925,7 @@ _ged_drawtrees(struct ged *gedp, int argc, const char *argv[], int kind, struct
 			continue;
 		    }
 
-		    ret = dl_redraw(gdlp, gedp, dgcdp.vs.draw_non_subtract_only);
+		    ret = dl_redraw(gdlp, gedp, dgcdp.vs.draw_non_subtract_only, plot_ncpu);
 		    if (ret < 0) {
 			/* restore view bot threshold */
 			if (gedp && gedp->ged_gvp) gedp->ged_gvp->gv_s->bot_threshold = threshold_cached;
@@ -1276,7 +1278,7 @@ ged_redraw_core(struct ged *gedp, int argc, const char *argv[])
 	/* redraw everything */
 	for (BU_LIST_FOR(gdlp, display_list, gedp->ged_gdp->gd_headDisplay))
 	{
-	    ret = dl_redraw(gdlp, gedp, 0);
+	    ret = dl_redraw(gdlp, gedp, 0, 0);
 	    if (ret < 0) {
 		bu_vls_printf(gedp->ged_result_str, "%s: redraw failure\n", argv[0]);
 		return BRLCAD_ERROR;
@@ -1312,7 +1314,7 @@ ged_redraw_core(struct ged *gedp, int argc, const char *argv[])
 		    found_path = 1;
 		    db_free_full_path(&dl_path);
 
-		    ret = dl_redraw(gdlp, gedp, 0);
+		    ret = dl_redraw(gdlp, gedp, 0, 0);
 		    if (ret < 0) {
 			bu_vls_printf(gedp->ged_result_str,
 				"%s: %s redraw failure\n", argv[0], argv[i]);
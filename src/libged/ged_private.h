@@ -261,7 +261,11 @@ extern struct bu_ptbl *dl_get_solids(struct display_list *gdlp);
 
 GED_EXPORT extern void dl_add_path(int dashflag, struct bu_list *vhead, const struct db_full_path *pathp, struct db_tree_state *tsp, unsigned char *wireframe_color_override, struct _ged_client_data *dgcdp);
 
-GED_EXPORT extern int dl_redraw(struct display_list *gdlp, struct ged *gedp, int skip_subtractions);
+/* Defined in draw.cpp - view independent plotting of objs on ncpu threads */
+extern void draw_scene_parallel(struct bu_ptbl *objs, size_t ncpu);
+
+/* Replot the wireframes of gdlp on ncpu threads (0 for all available) */
+GED_EXPORT extern int dl_redraw(struct display_list *gdlp, struct ged *gedp, int skip_subtractions, size_t ncpu);
 GED_EXPORT extern union tree * append_solid_to_display_list(struct db_tree_state *tsp, const struct db_full_path *pathp, struct rt_db_internal *ip, void *client_data);
 GED_EXPORT int dl_set_illum(struct display_list *gdlp, const char *obj, int illum);
 GED_EXPORT void dl_set_flag(struct bu_list *hdlp, int flag);
@@ -28,6 +28,7 @@
 #include <stdlib.h>
 #include <ctype.h>
 #include <string.h>
+#include <vector>
 
 #include "bu/cmd.h"
 #include "bu/hash.h"
@@ -39,6 +40,11 @@
 #include "../ged_private.h"
 #include "./ged_view.h"
 
+/* Limits on how many BoTs (and how much BoT face data) "lod cache" will hold
+ * in memory while generating their LoD data in parallel */
+#define LOD_CACHE_BATCH_MAX 64
+#define LOD_CACHE_BATCH_FACES 50000000
+
 int
 _view_cmd_lod(void *bs, int argc, const char **argv)
 {
@@ -201,6 +207,29 @@ _view_cmd_lod(void *bs, int argc, const char **argv)
 		}
 	    }
 
+	    // BoTs already have their mesh data, so they are loaded in groups
+	    // and their LoD data generated concurrently.  Bound the size of a
+	    // group so we don't have to hold every BoT in memory at once.
+	    std::vector<struct rt_db_internal *> bot_ips;
+	    std::vector<struct directory *> bot_dps;
+	    std::vector<struct bv_mesh_lod_cache_input> bot_in;
+	    size_t bot_faces = 0;
+	    auto bot_flush = [&]() {
+		if (!bot_in.size())
+		    return;
+		bv_mesh_lod_cache_batch(gedp->ged_lod, bot_in.data(), bot_in.size(), 0);
+		for (size_t j = 0; j < bot_in.size(); j++) {
+		    if (bot_in[j].key)
+			bv_mesh_lod_key_put(gedp->ged_lod, bot_dps[j]->d_namep, bot_in[j].key);
+		    rt_db_free_internal(bot_ips[j]);
+		    BU_PUT(bot_ips[j], struct rt_db_internal);
+		}
+		bot_ips.clear();
+		bot_dps.clear();
+		bot_in.clear();
+		bot_faces = 0;
+	    };
+
 	    for (int i = 0; i < RT_DBNHASH; i++) {
 		struct directory *dp;
 		for (dp = gedp->dbip->dbi_Head[i]; dp != RT_DIR_NULL; dp = dp->d_forw) {
@@ -211,27 +240,31 @@ _view_cmd_lod(void *bs, int argc, const char **argv)
 
 		    // No need to open up the internal unless it's a BoT or a BRep
 		    if (dp->d_minor_type == DB5_MINORTYPE_BRLCAD_BOT) {
-			struct rt_db_internal dbintern;
-			RT_DB_INTERNAL_INIT(&dbintern);
-			struct rt_db_internal *ip = &dbintern;
+			struct rt_db_internal *ip;
+			BU_GET(ip, struct rt_db_internal);
+			RT_DB_INTERNAL_INIT(ip);
 			int ret = rt_db_get_internal(ip, dp, gedp->dbip, NULL, &rt_uniresource);
-			if (ret < 0)
+			if (ret < 0) {
+			    BU_PUT(ip, struct rt_db_internal);
 			    continue;
+			}
 
 			if (ip->idb_minor_type != DB5_MINORTYPE_BRLCAD_BOT) {
-			    rt_db_free_internal(&dbintern);
+			    rt_db_free_internal(ip);
+			    BU_PUT(ip, struct rt_db_internal);
 			    continue;
 			}
 			done++;
-			struct bu_vls pname = BU_VLS_INIT_ZERO;
 			bu_log("Caching BoT %s (%d of %d)\n", dp->d_namep, done, total);
-			bu_vls_free(&pname);
 			struct rt_bot_internal *bot = (struct rt_bot_internal *)ip->idb_ptr;
 			RT_BOT_CK_MAGIC(bot);
-			key = bv_mesh_lod_cache(gedp->ged_lod, (const point_t *)bot->vertices, bot->num_vertices, NULL, bot->faces, bot->num_faces, 0, 0.66);
-			if (key)
-			    bv_mesh_lod_key_put(gedp->ged_lod, dp->d_namep, key);
-			rt_db_free_internal(&dbintern);
+			struct bv_mesh_lod_cache_input in = {(const point_t *)bot->vertices, bot->num_vertices, NULL, bot->faces, bot->num_faces, 0, 0.66, 0};
+			bot_ips.push_back(ip);
+			bot_dps.push_back(dp);
+			bot_in.push_back(in);
+			bot_faces += bot->num_faces;
+			if (bot_in.size() >= LOD_CACHE_BATCH_MAX || bot_faces >= LOD_CACHE_BATCH_FACES)
+			    bot_flush();
 		    }
 
 		    if (dp->d_minor_type == DB5_MINORTYPE_BRLCAD_BREP) {
@@ -294,6 +327,7 @@ _view_cmd_lod(void *bs, int argc, const char **argv)
 		    }
 		}
 	    }
+	    bot_flush();
 
 	    elapsedtime = bu_gettime() - elapsedtime;
 	    {
@@ -0,0 +1,369 @@
+/*                          D I F F . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file libicv/diff.c
+ *
+ * Tiled, multithreaded image comparison.
+ *
+ * Both the in-memory and the streaming comparisons work on bands of
+ * scanlines.  Each band is split into row chunks that are claimed by
+ * bu_parallel() workers, every worker tallies into its own
+ * icv_diff_stats and the tallies are merged once per band.  The
+ * per-pixel kernel is written without data dependent branches so the
+ * compiler can vectorize it.
+ */
+
+#include "common.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bu/log.h"
+#include "bu/malloc.h"
+#include "bu/parallel.h"
+#include "icv_private.h"
+
+/* number of scanlines read per band when streaming */
+#define ICV_DIFF_BAND_ROWS 256
+
+/* number of scanlines a worker claims at a time */
+#define ICV_DIFF_CHUNK_ROWS 8
+
+
+struct diff_band {
+    /* inputs - exactly one of the uchar or double pairs is set */
+    const unsigned char *c1;
+    const unsigned char *c2;
+    const double *d1;
+    const double *d2;
+    unsigned char *heat;	/* optional heatmap output, 3 bytes/pixel */
+    size_t width;
+    size_t rows;
+
+    /* work distribution */
+    size_t next_row;
+    struct icv_diff_stats stats;
+};
+
+
+static void
+diff_stats_merge(struct icv_diff_stats *dst, const struct icv_diff_stats *src)
+{
+    dst->matching += src->matching;
+    dst->off_by_1 += src->off_by_1;
+    dst->off_by_many += src->off_by_many;
+    dst->missing += src->missing;
+    if (src->max_delta > dst->max_delta)
+	dst->max_delta = src->max_delta;
+}
+
+
+static inline unsigned char
+diff_d2c(double v)
+{
+    /* matches icv_data2uchar() for images without gamma correction */
+    long lv = lrint(v * 255.0);
+    return (unsigned char)((lv > 255) ? 255 : ((lv < 0) ? 0 : lv));
+}
+
+
+/**
+ * Compare npix RGB pixels.  Kept free of branches on pixel data so
+ * the loop vectorizes.
+ */
+static void
+diff_span(struct icv_diff_stats *s, const unsigned char *a, const unsigned char *b, size_t npix, unsigned char *heat)
+{
+    size_t i;
+    size_t same = 0, one = 0, many = 0;
+    int maxd = s->max_delta;
+
+    for (i = 0; i < npix; i++) {
+	int dr = abs((int)a[3*i+0] - (int)b[3*i+0]);
+	int dg = abs((int)a[3*i+1] - (int)b[3*i+1]);
+	int db = abs((int)a[3*i+2] - (int)b[3*i+2]);
+	int ne = (dr != 0) + (dg != 0) + (db != 0);
+	int pd = (dr > dg) ? dr : dg;
+	pd = (pd > db) ? pd : db;
+
+	same += (ne == 0);
+	one += (ne == 1);
+	many += (ne > 1);
+	maxd = (pd > maxd) ? pd : maxd;
+
+	if (heat) {
+	    /* matching pixels are dimmed grayscale, differences run
+	     * from yellow (small delta) to red (large delta) */
+	    int lum = ((22937 * a[3*i+0] + 36044 * a[3*i+1] + 6553 * a[3*i+2]) >> 17) / 2;
+	    heat[3*i+0] = (unsigned char)(ne ? 255 : lum);
+	    heat[3*i+1] = (unsigned char)(ne ? 255 - pd : lum);
+	    heat[3*i+2] = (unsigned char)(ne ? 0 : lum);
+	}
+    }
+
+    s->matching += same;
+    s->off_by_1 += one;
+    s->off_by_many += many;
+    s->max_delta = maxd;
+}
+
+
+static void
+diff_band_worker(int UNUSED(cpu), void *data)
+{
+    struct diff_band *band = (struct diff_band *)data;
+    struct icv_diff_stats local;
+    unsigned char *r1 = NULL, *r2 = NULL;
+    size_t rowbytes = band->width * 3;
+
+    memset(&local, 0, sizeof(local));
+
+    if (band->d1) {
+	r1 = (unsigned char *)bu_malloc(rowbytes, "diff row 1");
+	r2 = (unsigned char *)bu_malloc(rowbytes, "diff row 2");
+    }
+
+    while (1) {
+	size_t row, end;
+
+	bu_semaphore_acquire(BU_SEM_GENERAL);
+	row = band->next_row;
+	band->next_row += ICV_DIFF_CHUNK_ROWS;
+	bu_semaphore_release(BU_SEM_GENERAL);
+
+	if (row >= band->rows)
+	    break;
+	end = (row + ICV_DIFF_CHUNK_ROWS < band->rows) ? row + ICV_DIFF_CHUNK_ROWS : band->rows;
+
+	for (; row < end; row++) {
+	    const unsigned char *a, *b;
+	    unsigned char *h = (band->heat) ? band->heat + row * rowbytes : NULL;
+
+	    if (band->d1) {
+		size_t i;
+		const double *s1 = band->d1 + row * rowbytes;
+		const double *s2 = band->d2 + row * rowbytes;
+		for (i = 0; i < rowbytes; i++) {
+		    r1[i] = diff_d2c(s1[i]);
+		    r2[i] = diff_d2c(s2[i]);
+		}
+		a = r1;
+		b = r2;
+	    } else {
+		a = band->c1 + row * rowbytes;
+		b = band->c2 + row * rowbytes;
+	    }
+	    diff_span(&local, a, b, band->width, h);
+	}
+    }
+
+    if (r1) {
+	bu_free(r1, "diff row 1");
+	bu_free(r2, "diff row 2");
+    }
+
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    diff_stats_merge(&band->stats, &local);
+    bu_semaphore_release(BU_SEM_GENERAL);
+}
+
+
+static void
+diff_band_run(struct diff_band *band, size_t ncpu)
+{
+    size_t chunks = (band->rows + ICV_DIFF_CHUNK_ROWS - 1) / ICV_DIFF_CHUNK_ROWS;
+
+    if (!ncpu)
+	ncpu = bu_avail_cpus();
+    if (ncpu > chunks)
+	ncpu = chunks;
+
+    band->next_row = 0;
+    memset(&band->stats, 0, sizeof(band->stats));
+
+    if (ncpu <= 1) {
+	diff_band_worker(0, band);
+    } else {
+	bu_parallel(diff_band_worker, ncpu, band);
+    }
+}
+
+
+int
+icv_diff_tiled(struct icv_diff_stats *stats, icv_image_t *img1, icv_image_t *img2, size_t threshold, size_t ncpu)
+{
+    struct diff_band band;
+    struct icv_diff_stats total;
+    size_t y;
+
+    if (stats)
+	memset(stats, 0, sizeof(struct icv_diff_stats));
+
+    if (!img1 || !img2)
+	return -1;
+
+    ICV_IMAGE_VAL_INT(img1);
+    ICV_IMAGE_VAL_INT(img2);
+
+    if (img1->width != img2->width || img1->height != img2->height
+	|| img1->channels != 3 || img2->channels != 3)
+    {
+	bu_log("icv_diff_tiled : Image Parameters not Equal");
+	return -1;
+    }
+
+    memset(&total, 0, sizeof(total));
+    memset(&band, 0, sizeof(band));
+    band.width = img1->width;
+
+    for (y = 0; y < img1->height; y += ICV_DIFF_BAND_ROWS) {
+	size_t offset = y * img1->width * 3;
+
+	band.d1 = img1->data + offset;
+	band.d2 = img2->data + offset;
+	band.rows = (y + ICV_DIFF_BAND_ROWS < img1->height) ? ICV_DIFF_BAND_ROWS : img1->height - y;
+
+	diff_band_run(&band, ncpu);
+	diff_stats_merge(&total, &band.stats);
+
+	if (threshold && total.off_by_many > threshold)
+	    break;
+    }
+
+    if (stats)
+	*stats = total;
+
+    if (threshold && total.off_by_many > threshold)
+	return 2;
+    return (total.off_by_1 || total.off_by_many) ? 1 : 0;
+}
+
+
+/* read up to len bytes, returning how many were actually read */
+static size_t
+diff_fill(unsigned char *buf, size_t len, FILE *fp)
+{
+    size_t got = 0;
+    while (got < len) {
+	size_t r = fread(buf + got, 1, len - got, fp);
+	if (!r)
+	    break;
+	got += r;
+    }
+    return got;
+}
+
+
+int
+icv_diff_stream(struct icv_diff_stats *stats, FILE *f1, FILE *f2, size_t width, size_t threshold, FILE *heatmap, size_t ncpu)
+{
+    struct diff_band band;
+    struct icv_diff_stats total;
+    unsigned char *b1, *b2, *heat = NULL;
+    size_t bandbytes;
+    int ret = 0;
+
+    if (stats)
+	memset(stats, 0, sizeof(struct icv_diff_stats));
+
+    if (!f1 || !f2 || !width)
+	return -1;
+
+    bandbytes = width * 3 * ICV_DIFF_BAND_ROWS;
+    b1 = (unsigned char *)bu_malloc(bandbytes, "icv_diff_stream band 1");
+    b2 = (unsigned char *)bu_malloc(bandbytes, "icv_diff_stream band 2");
+    if (heatmap)
+	heat = (unsigned char *)bu_malloc(bandbytes, "icv_diff_stream heatmap");
+
+    memset(&total, 0, sizeof(total));
+    memset(&band, 0, sizeof(band));
+    band.c1 = b1;
+    band.c2 = b2;
+    band.heat = heat;
+    band.width = width;
+
+    while (1) {
+	size_t n1 = diff_fill(b1, bandbytes, f1);
+	size_t n2 = diff_fill(b2, bandbytes, f2);
+	size_t nmin = (n1 < n2) ? n1 : n2;
+	size_t nmax = (n1 > n2) ? n1 : n2;
+	size_t npix = nmin / 3;
+
+	if (!nmax)
+	    break;
+
+	/* full rows go through the parallel band, a trailing partial
+	 * row is compared directly */
+	band.rows = npix / width;
+	if (band.rows) {
+	    diff_band_run(&band, ncpu);
+	    diff_stats_merge(&total, &band.stats);
+	}
+	if (npix % width) {
+	    size_t off = band.rows * width * 3;
+	    diff_span(&total, b1 + off, b2 + off, npix % width, (heat) ? heat + off : NULL);
+	}
+
+	if (heat && npix && fwrite(heat, 3, npix, heatmap) != npix) {
+	    bu_log("icv_diff_stream : Short Write");
+	    ret = -1;
+	    break;
+	}
+
+	/* one stream ran out - everything left in the other is missing */
+	if (nmin != nmax) {
+	    FILE *longer = (n1 > n2) ? f1 : f2;
+	    size_t extra = nmax - npix * 3;
+	    size_t n;
+	    while ((n = diff_fill(b1, bandbytes, longer)) > 0)
+		extra += n;
+	    total.missing += (extra + 2) / 3;
+	    break;
+	}
+
+	if (threshold && total.off_by_many > threshold) {
+	    ret = 2;
+	    break;
+	}
+    }
+
+    bu_free(b1, "icv_diff_stream band 1");
+    bu_free(b2, "icv_diff_stream band 2");
+    if (heat)
+	bu_free(heat, "icv_diff_stream heatmap");
+
+    if (stats)
+	*stats = total;
+
+    if (ret)
+	return ret;
+    return (total.off_by_1 || total.off_by_many || total.missing) ? 1 : 0;
+}
+
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
@@ -0,0 +1,155 @@
+/*                        I C V _ D I F F . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file icv_diff.c
+ *
+ * Checks that the tiled and streaming image comparisons agree with
+ * each other on a synthetic image pair with known differences.
+ *
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bu/app.h"
+#include "bu/log.h"
+#include "bu/malloc.h"
+#include "icv.h"
+
+#define TW 613
+#define TH 517
+
+
+/* fill a pair of images, returning the expected counts */
+static void
+make_pair(unsigned char *a, unsigned char *b, size_t *one, size_t *many)
+{
+    size_t i;
+
+    *one = *many = 0;
+    for (i = 0; i < TW*TH; i++) {
+	a[3*i+0] = (unsigned char)(i % 251);
+	a[3*i+1] = (unsigned char)((i / TW) % 256);
+	a[3*i+2] = (unsigned char)((i * 7) % 256);
+	memcpy(&b[3*i], &a[3*i], 3);
+	if (i % 97 == 0) {
+	    b[3*i+1] ^= 0x1;
+	    (*one)++;
+	} else if (i % 131 == 0) {
+	    b[3*i+0] ^= 0x80;
+	    b[3*i+2] ^= 0x40;
+	    (*many)++;
+	}
+    }
+}
+
+
+static icv_image_t *
+make_image(unsigned char *data)
+{
+    icv_image_t *img = icv_create(TW, TH, ICV_COLOR_SPACE_RGB);
+    double *d = icv_uchar2double(data, TW*TH*3);
+    memcpy(img->data, d, TW*TH*3*sizeof(double));
+    bu_free(d, "double data");
+    return img;
+}
+
+
+int
+main(int UNUSED(argc), const char **argv)
+{
+    unsigned char *a, *b;
+    size_t one, many;
+    struct icv_diff_stats ts, ss;
+    int m = 0, o1 = 0, om = 0;
+    int ret;
+    FILE *f1, *f2;
+
+    bu_setprogname(argv[0]);
+
+    a = (unsigned char *)bu_malloc(TW*TH*3, "image a");
+    b = (unsigned char *)bu_malloc(TW*TH*3, "image b");
+    make_pair(a, b, &one, &many);
+
+    icv_image_t *ia = make_image(a);
+    icv_image_t *ib = make_image(b);
+
+    /* in-memory tiled comparison */
+    ret = icv_diff_tiled(&ts, ia, ib, 0, 0);
+    if (ret != 1 || ts.off_by_1 != one || ts.off_by_many != many
+	|| ts.matching != TW*TH - one - many || ts.max_delta != 0x80)
+    {
+	bu_exit(1, "icv_diff_tiled: got %zu/%zu/%zu max %d, expected %zu/%zu\n",
+		ts.matching, ts.off_by_1, ts.off_by_many, ts.max_delta, one, many);
+    }
+
+    /* icv_diff must report the same thing */
+    icv_diff(&m, &o1, &om, ia, ib);
+    if ((size_t)m != ts.matching || (size_t)o1 != ts.off_by_1 || (size_t)om != ts.off_by_many)
+	bu_exit(1, "icv_diff: got %d/%d/%d\n", m, o1, om);
+
+    /* an identical pair is clean */
+    if (icv_diff_tiled(NULL, ia, ia, 0, 0) != 0)
+	bu_exit(1, "icv_diff_tiled: identical images differ\n");
+
+    /* early out */
+    if (icv_diff_tiled(&ts, ia, ib, 10, 0) != 2 || ts.off_by_many >= many)
+	bu_exit(1, "icv_diff_tiled: threshold did not stop early\n");
+
+    /* streaming comparison, with the second file a few pixels short */
+    f1 = bu_temp_file(NULL, 0);
+    f2 = bu_temp_file(NULL, 0);
+    if (!f1 || !f2)
+	bu_exit(1, "unable to open temporary files\n");
+    fwrite(a, 3, TW*TH, f1);
+    fwrite(b, 3, TW*TH - 5, f2);
+    rewind(f1);
+    rewind(f2);
+
+    ret = icv_diff_stream(&ss, f1, f2, TW, 0, NULL, 0);
+    if (ret != 1 || ss.missing != 5
+	|| ss.matching + ss.off_by_1 + ss.off_by_many + ss.missing != TW*TH
+	|| ss.off_by_many != many)
+    {
+	bu_exit(1, "icv_diff_stream: got %zu/%zu/%zu/%zu\n",
+		ss.matching, ss.off_by_1, ss.off_by_many, ss.missing);
+    }
+
+    fclose(f1);
+    fclose(f2);
+    icv_destroy(ia);
+    icv_destroy(ib);
+    bu_free(a, "image a");
+    bu_free(b, "image b");
+
+    bu_log("icv_diff: OK\n");
+    return 0;
+}
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
@@ -650,6 +650,7 @@ static struct shell * nmg_bool(struct shell *sA, struct shell *sB, const int ope
 		    fu->s_p = sA;
 		}
 		BU_LIST_APPEND_LIST(&(sA->fu_hd), &(sB->fu_hd));
+		nmg_shell_bvh_free(sA);
 
 		/* assign new bounding box to sA */
 		VMOVE(sA->sa_p->min_pt, s_min_pt);
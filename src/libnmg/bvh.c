@@ -0,0 +1,317 @@
+/*                           B V H . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @addtogroup nmg_shell */
+/** @{ */
+/** @file libnmg/bvh.c
+ *
+ * Bounding volume hierarchy over the faceuses of a shell.
+ *
+ * Ray intersection with a shell used to look at every faceuse, which
+ * makes raytracing and boolean classification of large shells
+ * quadratic.  The hierarchy is built over the face bounding boxes and
+ * cached on the shell, and lets the intersector visit only the faces
+ * whose boxes the ray passes through.
+ *
+ * Since the intersector is careful about the order it meets faces in
+ * (the first face to reach a shared edge or vertex claims it), the
+ * faceuses found are handed back in shell list order.
+ *
+ */
+/** @} */
+
+#include "common.h"
+
+#include <stdlib.h>
+
+#include "vmath.h"
+#include "bu/malloc.h"
+#include "nmg.h"
+#include "./nmg_private.h"
+
+/* Shells with fewer faceuses than this are cheaper to just walk */
+#define NMG_SHELL_BVH_MIN_FU 32
+
+/* Maximum number of faceuses in a leaf */
+#define NMG_SHELL_BVH_LEAF_SIZE 8
+
+struct nmg_shell_bvh_node {
+    point_t min;
+    point_t max;
+    size_t first;	/* first item under this node */
+    size_t cnt;		/* number of items under this node */
+    size_t skip;	/* next node if this one is missed */
+};
+
+struct nmg_shell_bvh {
+    long maxindex;	/* model maxindex when built */
+    point_t s_min;	/* shell extent when built */
+    point_t s_max;
+    size_t nfu;
+    struct faceuse **fu;	/* faceuses in shell list order */
+    size_t *item;		/* hierarchy order to list position */
+    size_t nnodes;
+    struct nmg_shell_bvh_node *nodes;
+};
+
+struct nmg_shell_bvh_sort {
+    fastf_t key;
+    size_t item;
+};
+
+
+static int
+shell_bvh_sort_cmp(const void *a, const void *b)
+{
+    const struct nmg_shell_bvh_sort *sa = (const struct nmg_shell_bvh_sort *)a;
+    const struct nmg_shell_bvh_sort *sb = (const struct nmg_shell_bvh_sort *)b;
+
+    if (sa->key < sb->key)
+	return -1;
+    if (sa->key > sb->key)
+	return 1;
+    return (sa->item < sb->item) ? -1 : (sa->item > sb->item);
+}
+
+
+static int
+shell_bvh_size_cmp(const void *a, const void *b)
+{
+    size_t sa = *(const size_t *)a;
+    size_t sb = *(const size_t *)b;
+
+    return (sa < sb) ? -1 : (sa > sb);
+}
+
+
+/* Build the node for items [first, first+cnt) and its children in
+ * depth first order, splitting at the median face center along the
+ * longest axis of the node.
+ */
+static void
+shell_bvh_build(struct nmg_shell_bvh *bvh, struct nmg_shell_bvh_sort *srt, size_t first, size_t cnt)
+{
+    struct nmg_shell_bvh_node *n = &bvh->nodes[bvh->nnodes++];
+    size_t i, half;
+    vect_t ext;
+    int axis;
+
+    n->first = first;
+    n->cnt = cnt;
+    VSETALL(n->min, MAX_FASTF);
+    VSETALL(n->max, -MAX_FASTF);
+    for (i = first; i < first + cnt; i++) {
+	const struct face *f = bvh->fu[bvh->item[i]]->f_p;
+	VMIN(n->min, f->min_pt);
+	VMAX(n->max, f->max_pt);
+    }
+
+    if (cnt > NMG_SHELL_BVH_LEAF_SIZE) {
+	VSUB2(ext, n->max, n->min);
+	axis = (ext[X] > ext[Y]) ? ((ext[X] > ext[Z]) ? X : Z) : ((ext[Y] > ext[Z]) ? Y : Z);
+	for (i = 0; i < cnt; i++) {
+	    const struct face *f = bvh->fu[bvh->item[first + i]]->f_p;
+	    srt[i].key = f->min_pt[axis] + f->max_pt[axis];
+	    srt[i].item = bvh->item[first + i];
+	}
+	qsort(srt, cnt, sizeof(struct nmg_shell_bvh_sort), shell_bvh_sort_cmp);
+	for (i = 0; i < cnt; i++)
+	    bvh->item[first + i] = srt[i].item;
+
+	half = cnt / 2;
+	shell_bvh_build(bvh, srt, first, half);
+	shell_bvh_build(bvh, srt, first + half, cnt - half);
+    }
+
+    /* nodes are numbered depth first, so everything under this one
+     * was just added */
+    n->skip = bvh->nnodes;
+}
+
+
+/* Is the hierarchy still describing shell s? */
+static int
+shell_bvh_current(const struct shell *s)
+{
+    const struct nmg_shell_bvh *bvh = s->bvh;
+
+    if (!bvh || !s->sa_p)
+	return 0;
+    if (bvh->maxindex != nmg_find_model(&s->l.magic)->maxindex)
+	return 0;
+    return VEQUAL(bvh->s_min, s->sa_p->min_pt) && VEQUAL(bvh->s_max, s->sa_p->max_pt);
+}
+
+
+void
+nmg_shell_bvh(struct shell *s)
+{
+    struct nmg_shell_bvh *bvh;
+    struct nmg_shell_bvh_sort *srt;
+    struct faceuse *fu;
+    size_t i, nfu;
+
+    NMG_CK_SHELL(s);
+
+    if (shell_bvh_current(s))
+	return;
+    nmg_shell_bvh_free(s);
+
+    if (!s->sa_p)
+	return;
+    nfu = (size_t)bu_list_len(&s->fu_hd);
+    if (nfu < NMG_SHELL_BVH_MIN_FU)
+	return;
+
+    BU_ALLOC(bvh, struct nmg_shell_bvh);
+    bvh->maxindex = nmg_find_model(&s->l.magic)->maxindex;
+    VMOVE(bvh->s_min, s->sa_p->min_pt);
+    VMOVE(bvh->s_max, s->sa_p->max_pt);
+    bvh->nfu = nfu;
+    bvh->fu = (struct faceuse **)bu_calloc(nfu, sizeof(struct faceuse *), "nmg_shell_bvh fu");
+    bvh->item = (size_t *)bu_calloc(nfu, sizeof(size_t), "nmg_shell_bvh item");
+    i = 0;
+    for (BU_LIST_FOR(fu, faceuse, &s->fu_hd)) {
+	NMG_CK_FACEUSE(fu);
+	NMG_CK_FACE(fu->f_p);
+	bvh->fu[i] = fu;
+	bvh->item[i] = i;
+	i++;
+    }
+
+    /* a binary tree with leaves of at least one item */
+    bvh->nodes = (struct nmg_shell_bvh_node *)bu_calloc(2 * nfu, sizeof(struct nmg_shell_bvh_node), "nmg_shell_bvh nodes");
+    bvh->nnodes = 0;
+    srt = (struct nmg_shell_bvh_sort *)bu_calloc(nfu, sizeof(struct nmg_shell_bvh_sort), "nmg_shell_bvh sort");
+    shell_bvh_build(bvh, srt, 0, nfu);
+    bu_free(srt, "nmg_shell_bvh sort");
+
+    s->bvh = bvh;
+}
+
+
+void
+nmg_shell_bvh_free(struct shell *s)
+{
+    if (!s || !s->bvh)
+	return;
+
+    bu_free(s->bvh->fu, "nmg_shell_bvh fu");
+    bu_free(s->bvh->item, "nmg_shell_bvh item");
+    bu_free(s->bvh->nodes, "nmg_shell_bvh nodes");
+    bu_free(s->bvh, "nmg_shell_bvh");
+    s->bvh = NULL;
+}
+
+
+/* Does the line through pt along dir pass within tol of the box? */
+static int
+shell_bvh_line_box(const point_t pt, const vect_t dir, const vect_t invdir, const point_t min, const point_t max, fastf_t tol)
+{
+    fastf_t tmin = -INFINITY, tmax = INFINITY;
+    int i;
+
+    for (i = X; i <= Z; i++) {
+	fastf_t lo = min[i] - tol;
+	fastf_t hi = max[i] + tol;
+
+	if (ZERO(dir[i])) {
+	    if (pt[i] < lo || pt[i] > hi)
+		return 0;
+	    continue;
+	}
+
+	lo = (lo - pt[i]) * invdir[i];
+	hi = (hi - pt[i]) * invdir[i];
+	if (lo > hi) {
+	    fastf_t t = lo;
+	    lo = hi;
+	    hi = t;
+	}
+	if (lo > tmin)
+	    tmin = lo;
+	if (hi < tmax)
+	    tmax = hi;
+	if (tmin > tmax)
+	    return 0;
+    }
+    return 1;
+}
+
+
+long
+nmg_shell_bvh_isect(struct faceuse ***fus, const struct shell *s, const struct nmg_ray *rp, fastf_t tol_dist)
+{
+    const struct nmg_shell_bvh *bvh;
+    size_t *hits;
+    size_t i, j, n = 0;
+    vect_t invdir;
+
+    if (!shell_bvh_current(s))
+	return -1;
+    bvh = s->bvh;
+
+    for (i = X; i <= Z; i++)
+	invdir[i] = ZERO(rp->r_dir[i]) ? 0.0 : 1.0 / rp->r_dir[i];
+
+    hits = (size_t *)bu_calloc(bvh->nfu, sizeof(size_t), "nmg_shell_bvh_isect hits");
+    i = 0;
+    while (i < bvh->nnodes) {
+	const struct nmg_shell_bvh_node *nd = &bvh->nodes[i];
+
+	if (!shell_bvh_line_box(rp->r_pt, rp->r_dir, invdir, nd->min, nd->max, tol_dist)) {
+	    i = nd->skip;
+	    continue;
+	}
+	if (nd->cnt > NMG_SHELL_BVH_LEAF_SIZE) {
+	    i++;
+	    continue;
+	}
+	for (j = nd->first; j < nd->first + nd->cnt; j++) {
+	    const struct face *f = bvh->fu[bvh->item[j]]->f_p;
+	    if (shell_bvh_line_box(rp->r_pt, rp->r_dir, invdir, f->min_pt, f->max_pt, tol_dist))
+		hits[n++] = bvh->item[j];
+	}
+	i = nd->skip;
+    }
+
+    if (!n) {
+	bu_free(hits, "nmg_shell_bvh_isect hits");
+	return 0;
+    }
+
+    qsort(hits, n, sizeof(size_t), shell_bvh_size_cmp);
+    *fus = (struct faceuse **)bu_calloc(n, sizeof(struct faceuse *), "nmg_shell_bvh_isect fus");
+    for (j = 0; j < n; j++)
+	(*fus)[j] = bvh->fu[hits[j]];
+    bu_free(hits, "nmg_shell_bvh_isect hits");
+
+    return (long)n;
+}
+
+
+/*
+ * Local Variables:
+ * mode: C
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
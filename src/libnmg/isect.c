@@ -38,6 +38,7 @@
 #include "bn/mat.h"
 #include "bv/plot3.h"
 #include "nmg.h"
+#include "./nmg_private.h"
 
 
 /* Plot a faceuse and a line between pt and plane_pt */
@@ -2317,8 +2318,10 @@ static void
 nmg_isect_ray_shell(struct nmg_ray_data *rd, const struct shell *s_p, struct bu_list *vlfree)
 {
     struct faceuse *fu_p;
+    struct faceuse **fus = NULL;
     struct loopuse *lu_p;
     struct edgeuse *eu_p;
+    long i, nfus;
 
     if (nmg_debug & NMG_DEBUG_RT_ISECT)
 	bu_log("nmg_isect_ray_shell(%p, %p)\n", (void *)rd, (void *)s_p);
@@ -2339,8 +2342,21 @@ nmg_isect_ray_shell(struct nmg_ray_data *rd, const struct shell *s_p, struct bu_
 
     /* ray intersects shell, check sub-objects */
 
-    for (BU_LIST_FOR(fu_p, faceuse, &(s_p->fu_hd)))
-	isect_ray_faceuse(rd, fu_p, vlfree);
+    /* Faces the ray can't reach would only be recorded as misses, so
+     * use the shell's face hierarchy if it has one.  Classification is
+     * single threaded and may build it; raytracing gets it from prep.
+     */
+    if (rd->classifying_ray)
+	nmg_shell_bvh((struct shell *)s_p);
+    nfus = nmg_shell_bvh_isect(&fus, s_p, rd->rp, rd->tol->dist);
+    if (nfus < 0) {
+	for (BU_LIST_FOR(fu_p, faceuse, &(s_p->fu_hd)))
+	    isect_ray_faceuse(rd, fu_p, vlfree);
+    } else if (nfus > 0) {
+	for (i = 0; i < nfus; i++)
+	    isect_ray_faceuse(rd, fus[i], vlfree);
+	bu_free(fus, "nmg_shell_bvh_isect fus");
+    }
 
     for (BU_LIST_FOR(lu_p, loopuse, &(s_p->lu_hd)))
 	isect_ray_loopuse(rd, lu_p, vlfree);
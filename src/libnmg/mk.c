@@ -549,6 +549,7 @@ nmg_mf(struct loopuse *lu1)
     /* connect the faces to the parent shell:  head, fu1, fu2... */
     BU_LIST_APPEND(&s->fu_hd, &fu1->l);
     BU_LIST_APPEND(&fu1->l, &fu2->l);
+    nmg_shell_bvh_free(s);
 
     if (nmg_debug & NMG_DEBUG_BASIC) {
 	bu_log("nmg_mf(lu1=%p) returns fu=%p\n", (void *)lu1, (void *)fu1);
@@ -1156,6 +1157,7 @@ nmg_kfu(struct faceuse *fu1)
 	bu_bomb("nmg_kfu() faceuse mates do not share face!\n");
     s = fu1->s_p;
     NMG_CK_SHELL(s);
+    nmg_shell_bvh_free(s);
 
     struct loopuse *lu;
     while (BU_LIST_WHILE(lu, loopuse, &fu1->lu_hd)) {
@@ -1495,6 +1497,7 @@ nmg_ks(struct shell *s)
     if (s->sa_p) {
 	FREE_SHELL_A(s->sa_p);
     }
+    nmg_shell_bvh_free(s);
 
     if (nmg_debug & NMG_DEBUG_BASIC) {
 	bu_log("nmg_ks(s=%p)\n", (void *)s);
@@ -2316,6 +2319,9 @@ nmg_face_bb(struct face *f, const struct bn_tol *tol)
     fu = f->fu_p;
     NMG_CK_FACEUSE(fu);
 
+    /* the shell's face hierarchy is built on these boxes */
+    nmg_shell_bvh_free(fu->s_p);
+
     f->max_pt[X] = f->max_pt[Y] = f->max_pt[Z] = -MAX_FASTF;
     f->min_pt[X] = f->min_pt[Y] = f->min_pt[Z] = MAX_FASTF;
 
@@ -2369,6 +2375,8 @@ nmg_shell_a(struct shell *s, const struct bn_tol *tol)
     NMG_CK_SHELL(s);
     BN_CK_TOL(tol);
 
+    nmg_shell_bvh_free(s);
+
     if (s->sa_p) {
 	NMG_CK_SHELL_A(s->sa_p);
     } else {
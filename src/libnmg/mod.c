@@ -1733,6 +1733,9 @@ nmg_mv_fu_between_shells(struct shell *dest, register struct shell *src, registe
 	bu_bomb("fumate->s_p isn't source shell\n");
     }
 
+    nmg_shell_bvh_free(src);
+    nmg_shell_bvh_free(dest);
+
     /* Remove fu from src shell */
     BU_LIST_DEQUEUE(&fu->l);
     if (BU_LIST_IS_EMPTY(&src->fu_hd)) {
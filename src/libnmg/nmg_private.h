@@ -50,6 +50,24 @@
 NMG_EXPORT extern int nmg_keg(struct edgeuse *eu);
 
 
+/**
+ * @brief Find the faceuses of shell s whose face bounding boxes, grown
+ * by tol_dist on every side, the (infinite) line of ray rp passes
+ * through, using the shell's face hierarchy.  The faceuses are
+ * returned in a bu_calloc'ed array, in the order they appear on the
+ * shell's faceuse list, which the caller must free if the count is
+ * nonzero.
+ *
+ * @retval -1 If the shell has no current hierarchy.  Caller must
+ * consider every faceuse.
+ * @retval n The number of faceuses placed in *fus.
+ */
+NMG_EXPORT extern long nmg_shell_bvh_isect(struct faceuse ***fus,
+					   const struct shell *s,
+					   const struct nmg_ray *rp,
+					   fastf_t tol_dist);
+
+
 /* Currently commented out */
 NMG_EXPORT extern double nmg_vu_angle_measure(struct vertexuse   *vu,
                                               vect_t x_dir,
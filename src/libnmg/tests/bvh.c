@@ -0,0 +1,195 @@
+/*                           B V H . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+
+#include "common.h"
+
+#include <string.h>
+
+#include "bu/app.h"
+#include "bu/malloc.h"
+#include "nmg.h"
+
+/* quads along each edge of the test box */
+#define BVH_BOX_N 6
+#define BVH_BOX_STEP 10.0
+
+#define BVH_IDX(_x, _y, _z) ((((_x) * (BVH_BOX_N + 1)) + (_y)) * (BVH_BOX_N + 1) + (_z))
+
+
+/* Make a box shell whose sides are each a grid of quads, so there are
+ * enough faces for the shell to get a hierarchy */
+static struct shell *
+bvh_box(struct model *m, struct bu_list *vlfree, const struct bn_tol *tol)
+{
+    struct nmgregion *r;
+    struct shell *s;
+    struct faceuse *fu;
+    struct vertex **verts;
+    int a, sgn, i, j, k;
+
+    r = nmg_mrsv(m);
+    s = BU_LIST_FIRST(shell, &r->s_hd);
+
+    verts = (struct vertex **)bu_calloc((BVH_BOX_N + 1) * (BVH_BOX_N + 1) * (BVH_BOX_N + 1), sizeof(struct vertex *), "verts");
+
+    for (a = 0; a < 3; a++) {
+	int u = (a + 1) % 3;
+	int v = (a + 2) % 3;
+	for (sgn = 0; sgn < 2; sgn++) {
+	    for (i = 0; i < BVH_BOX_N; i++) {
+		for (j = 0; j < BVH_BOX_N; j++) {
+		    struct vertex **vp[4];
+		    int c[4][3];
+		    for (k = 0; k < 4; k++) {
+			c[k][a] = sgn * BVH_BOX_N;
+			c[k][u] = i + (k == 1 || k == 2);
+			c[k][v] = j + (k >= 2);
+		    }
+		    /* counter-clockwise seen from outside */
+		    for (k = 0; k < 4; k++) {
+			int kk = (sgn) ? k : 3 - k;
+			vp[k] = &verts[BVH_IDX(c[kk][X], c[kk][Y], c[kk][Z])];
+		    }
+		    if (!nmg_cmface(s, vp, 4))
+			bu_exit(1, "nmg_cmface failed\n");
+		}
+	    }
+	}
+    }
+
+    for (i = 0; i <= BVH_BOX_N; i++) {
+	for (j = 0; j <= BVH_BOX_N; j++) {
+	    for (k = 0; k <= BVH_BOX_N; k++) {
+		point_t pt;
+		if (!verts[BVH_IDX(i, j, k)])
+		    continue;
+		VSET(pt, i * BVH_BOX_STEP, j * BVH_BOX_STEP, k * BVH_BOX_STEP);
+		nmg_vertex_gv(verts[BVH_IDX(i, j, k)], pt);
+	    }
+	}
+    }
+    bu_free(verts, "verts");
+
+    for (BU_LIST_FOR(fu, faceuse, &s->fu_hd)) {
+	if (fu->orientation != OT_SAME)
+	    continue;
+	if (nmg_fu_planeeqn(fu, tol))
+	    bu_exit(1, "nmg_fu_planeeqn failed\n");
+    }
+    (void)nmg_mark_edges_real(&s->l.magic, vlfree);
+    nmg_region_a(r, tol);
+
+    return s;
+}
+
+
+/* Classify points inside and outside the box, returning the number of
+ * wrong answers */
+static int
+bvh_classify(struct shell *s, struct bu_list *vlfree, const struct bn_tol *tol)
+{
+    const fastf_t len = BVH_BOX_N * BVH_BOX_STEP;
+    int i, bad = 0;
+
+    for (i = 0; i < 50; i++) {
+	point_t pt;
+	int c;
+
+	/* inside, clear of the sides */
+	VSET(pt, 1.3 + (i % 11) * (len - 3.0) / 11.0,
+	     1.7 + (i % 13) * (len - 4.0) / 13.0,
+	     2.1 + (i % 17) * (len - 5.0) / 17.0);
+	c = nmg_class_pnt_s(pt, s, 0, vlfree, tol);
+	if (c != NMG_CLASS_AinB) {
+	    bu_log("(%g %g %g) classified %s, expected inside\n", V3ARGS(pt), nmg_class_name(c));
+	    bad++;
+	}
+
+	/* outside, beyond one or more sides */
+	VSET(pt, (i % 3 == 0) ? len + 1.0 + i : pt[X],
+	     (i % 3 == 1) ? -1.0 - i : pt[Y],
+	     (i % 3 == 2) ? len * 2.0 : pt[Z]);
+	c = nmg_class_pnt_s(pt, s, 0, vlfree, tol);
+	if (c != NMG_CLASS_AoutB) {
+	    bu_log("(%g %g %g) classified %s, expected outside\n", V3ARGS(pt), nmg_class_name(c));
+	    bad++;
+	}
+    }
+
+    return bad;
+}
+
+
+int
+main(int argc, char **argv)
+{
+    struct bn_tol tol = BN_TOL_INIT_TOL;
+    struct bu_list vlfree;
+    struct model *m;
+    struct shell *s;
+    int bad;
+
+    // Normally this file is part of nmg_test, so only set this if it looks like
+    // the program name is still unset.
+    if (bu_getprogname()[0] == '\0')
+	bu_setprogname(argv[0]);
+
+    if (argc > 1)
+	bu_exit(1, "Usage: %s\n", argv[0]);
+
+    BU_LIST_INIT(&vlfree);
+    m = nmg_mm();
+    s = bvh_box(m, &vlfree, &tol);
+
+    if (s->bvh)
+	bu_exit(1, "shell has a face hierarchy before any classification\n");
+
+    bad = bvh_classify(s, &vlfree, &tol);
+    if (!s->bvh)
+	bu_exit(1, "classification did not build a face hierarchy\n");
+
+    /* recomputing the bounds discards it, the next ray rebuilds it */
+    nmg_shell_a(s, &tol);
+    if (s->bvh)
+	bu_exit(1, "nmg_shell_a did not discard the face hierarchy\n");
+    bad += bvh_classify(s, &vlfree, &tol);
+
+    /* so does removing a face */
+    (void)nmg_kfu(BU_LIST_FIRST(faceuse, &s->fu_hd));
+    if (s->bvh)
+	bu_exit(1, "nmg_kfu did not discard the face hierarchy\n");
+
+    nmg_km(m);
+
+    if (bad)
+	bu_exit(1, "%d points misclassified\n", bad);
+
+    return 0;
+}
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
@@ -39,6 +39,9 @@
 #define FLOOR(x)	((int)(x) - ((x) < 0 && (x) != (int)(x)))
 #define CEIL(x)		((int)(x) + ((x) > 0 && (x) != (int)(x)))
 
+/* number of samples along the ray evaluated per bn_noise_turb_n() call */
+#define SCLOUD_NOISE_BLOCK 64
+
 struct scloud_specific {
     double lacunarity;
     double h_val;
@@ -300,6 +303,32 @@ scloud_render(struct application *ap, const struct partition *pp, struct shadewo
 
     delta_dpmm = scloud_sp->max_d_p_mm - scloud_sp->min_d_p_mm;
 
+    if (swp->sw_xmitonly) {
+	/* Only the transmission is wanted (e.g. for shadow rays), so the
+	 * turbulence along the whole path can be evaluated in blocks.
+	 */
+	point_t bpts[SCLOUD_NOISE_BLOCK];
+	double bvals[SCLOUD_NOISE_BLOCK];
+	size_t b, j;
+
+	for (b = 0; b < steps; b += SCLOUD_NOISE_BLOCK) {
+	    size_t cnt = (steps - b < SCLOUD_NOISE_BLOCK) ? steps - b : SCLOUD_NOISE_BLOCK;
+	    for (j = 0; j < cnt; j++)
+		VJOIN1(bpts[j], in_pt, (b+j)*step_delta, v_cloud);
+
+	    bn_noise_turb_n(bvals, (const point_t *)bpts, cnt, scloud_sp->h_val,
+			    scloud_sp->lacunarity, scloud_sp->octaves);
+
+	    for (j = 0; j < cnt; j++) {
+		density = scloud_sp->min_d_p_mm + bvals[j] * delta_dpmm;
+		val = exp(- density * step_delta);
+		trans *= val;
+	    }
+	}
+	swp->sw_transmit = trans;
+	return 1;
+    }
+
     sub_sw = *swp; /* struct copy */
     sub_sw.sw_inputs = MFI_HIT;
 
@@ -28,8 +28,11 @@
 
 #include "common.h"
 
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <math.h>
 #include <string.h>
@@ -1869,7 +1872,8 @@ struct db_walk_parallel_state {
     uint32_t magic;
     union tree **reg_trees;
     int reg_count;
-    int reg_current;		/* semaphored when parallel */
+    std::atomic<int> reg_current;	/* next region to claim */
+    int reg_batch;		/* regions claimed at a time */
     union tree * (*reg_end_func)(struct db_tree_state *, const struct db_full_path *, union tree *, void *);
     union tree * (*reg_leaf_func)(struct db_tree_state *, const struct db_full_path *, struct rt_db_internal *, void *);
     struct rt_i *rtip;
@@ -1982,14 +1986,14 @@ _db_walk_subtree(
  * will be at least one, and possibly more, instances of this routine
  * running simultaneously.
  *
- * Uses the self-dispatcher pattern: Pick off the next region's tree,
- * and walk it.
+ * Uses the self-dispatcher pattern: Pick off the next batch of
+ * region trees, and walk them.
  */
 static void
 _db_walk_dispatcher(int cpu, void *arg)
 {
     struct combined_tree_state *region_start_statep;
-    int mine;
+    int first, last, mine;
     union tree *curtree;
     struct db_walk_parallel_state *wps = (struct db_walk_parallel_state *)arg;
     struct resource *resp;
@@ -2010,60 +2014,296 @@ _db_walk_dispatcher(int cpu, void *arg)
     struct db_i *dbip = (wps->rtip) ? wps->rtip->rti_dbip : NULL;
 
     while (1) {
-	bu_semaphore_acquire(RT_SEM_WORKER);
-	mine = wps->reg_current++;
-	bu_semaphore_release(RT_SEM_WORKER);
-
-	if (mine >= wps->reg_count)
+	/* Claim a batch of regions at a time */
+	first = wps->reg_current.fetch_add(wps->reg_batch);
+	if (first >= wps->reg_count)
 	    break;
+	last = first + wps->reg_batch;
+	if (last > wps->reg_count)
+	    last = wps->reg_count;
 
-	if (RT_G_DEBUG&RT_DEBUG_TREEWALK)
-	    bu_log("\n\n***** _db_walk_dispatcher() on item %d\n\n", mine);
+	for (mine = first; mine < last; mine++) {
+	    if (RT_G_DEBUG&RT_DEBUG_TREEWALK)
+		bu_log("\n\n***** _db_walk_dispatcher() on item %d\n\n", mine);
 
-	if ((curtree = wps->reg_trees[mine]) == TREE_NULL)
-	    continue;
-	RT_CK_TREE(curtree);
+	    if ((curtree = wps->reg_trees[mine]) == TREE_NULL)
+		continue;
+	    RT_CK_TREE(curtree);
 
-	/* Walk the full subtree now */
-	region_start_statep = (struct combined_tree_state *)0;
+	    /* Walk the full subtree now */
+	    region_start_statep = (struct combined_tree_state *)0;
 
-	if (UNLIKELY(dbip && dbip->dbi_use_comb_instance_ids)) {
-	    std::unordered_map<std::string, int> c_inst_map;
-	    _db_walk_subtree(curtree, &region_start_statep, wps->reg_leaf_func, wps->client_data, resp, (void *)&c_inst_map);
-	} else {
-	    _db_walk_subtree(curtree, &region_start_statep, wps->reg_leaf_func, wps->client_data, resp, NULL);
-	}
+	    if (UNLIKELY(dbip && dbip->dbi_use_comb_instance_ids)) {
+		std::unordered_map<std::string, int> c_inst_map;
+		_db_walk_subtree(curtree, &region_start_statep, wps->reg_leaf_func, wps->client_data, resp, (void *)&c_inst_map);
+	    } else {
+		_db_walk_subtree(curtree, &region_start_statep, wps->reg_leaf_func, wps->client_data, resp, NULL);
+	    }
 
-	/* curtree->tr_op may be OP_NOP here.
-	 * It is up to db_reg_end_func() to deal with this,
-	 * either by discarding it, or making a null region.
-	 */
-	RT_CK_TREE(curtree);
-	if (!region_start_statep) {
-	    bu_log("ERROR: _db_walk_dispatcher() region %d started with no state\n", mine);
+	    /* curtree->tr_op may be OP_NOP here.
+	     * It is up to db_reg_end_func() to deal with this,
+	     * either by discarding it, or making a null region.
+	     */
+	    RT_CK_TREE(curtree);
+	    if (!region_start_statep) {
+		bu_log("ERROR: _db_walk_dispatcher() region %d started with no state\n", mine);
+		if (RT_G_DEBUG&RT_DEBUG_TREEWALK)
+		    rt_pr_tree(curtree, 0);
+		continue;
+	    }
+	    RT_CK_CTS(region_start_statep);
+
+	    /* This is a new region */
 	    if (RT_G_DEBUG&RT_DEBUG_TREEWALK)
-		rt_pr_tree(curtree, 0);
-	    continue;
+		db_pr_combined_tree_state(region_start_statep);
+
+	    /*
+	     * reg_end_func() returns a pointer to any unused
+	     * subtree for freeing.
+	     */
+	    if (wps->reg_end_func) {
+		wps->reg_trees[mine] = (*(wps->reg_end_func))(
+		    &(region_start_statep->cts_s),
+		    &(region_start_statep->cts_p),
+		    curtree, wps->client_data);
+	    }
+
+	    db_free_combined_tree_state(region_start_statep);
 	}
-	RT_CK_CTS(region_start_statep);
+    }
+}
 
-	/* This is a new region */
-	if (RT_G_DEBUG&RT_DEBUG_TREEWALK)
-	    db_pr_combined_tree_state(region_start_statep);
 
-	/*
-	 * reg_end_func() returns a pointer to any unused
-	 * subtree for freeing.
-	 */
-	if (wps->reg_end_func) {
-	    wps->reg_trees[mine] = (*(wps->reg_end_func))(
-		&(region_start_statep->cts_s),
-		&(region_start_statep->cts_p),
-		curtree, wps->client_data);
+/* Shared by the threads finding the regions of a walk */
+struct db_discover_state {
+    int (*reg_start_func)(struct db_tree_state *, const struct db_full_path *, const struct rt_comb_internal *, void *);
+    void *client_data;
+    std::mutex start_lock;	/* reg_start_func is called serially */
+};
+
+
+/* A member subtree of a combination, found by a task */
+struct db_discover_job {
+    union tree *tp;		/* member leaf, replaced by its subtree */
+    struct db_tree_state ts;
+    struct db_full_path path;
+    struct db_discover_state *dsp;
+};
+
+
+static union tree *_db_discover(struct db_tree_state *tsp, struct db_full_path *pathp, struct db_discover_state *dsp);
+
+
+static int
+_db_discover_region_start(struct db_tree_state *tsp, const struct db_full_path *pathp, const struct rt_comb_internal *combp, void *client_data)
+{
+    struct db_discover_state *dsp = (struct db_discover_state *)client_data;
+    std::lock_guard<std::mutex> guard(dsp->start_lock);
+
+    return dsp->reg_start_func(tsp, pathp, combp, dsp->client_data);
+}
+
+
+/* Graft subtree on in place of the member leaf tp, or NOP tp out if
+ * there is no subtree.
+ */
+static void
+_db_discover_graft(union tree *tp, union tree *subtree, struct resource *resp)
+{
+    if (subtree != TREE_NULL) {
+	union tree *tmp;
+
+	/* exchange what subtree and tp point at */
+	BU_GET(tmp, union tree);
+	RT_TREE_INIT(tmp);
+	RT_CK_TREE(subtree);
+	*tmp = *tp;	/* struct copy */
+	*tp = *subtree;	/* struct copy */
+	BU_PUT(subtree, union tree);
+
+	db_free_tree(tmp, resp);
+	RT_CK_TREE(tp);
+	return;
+    }
+
+    if (tp->tr_l.tl_mat) {
+	bu_free((char *)tp->tr_l.tl_mat, "tl_mat");
+	tp->tr_l.tl_mat = NULL;
+    }
+    bu_free(tp->tr_l.tl_name, "tl_name");
+    tp->tr_l.tl_name = NULL;
+    tp->tr_op = OP_NOP;
+}
+
+
+static void
+_db_discover_task(void *data)
+{
+    struct db_discover_job *job = (struct db_discover_job *)data;
+    union tree *subtree;
+
+    subtree = _db_discover(&job->ts, &job->path, job->dsp);
+    _db_discover_graft(job->tp, subtree, job->ts.ts_resp);
+
+    db_free_full_path(&job->path);
+    db_free_db_tree_state(&job->ts);
+    BU_PUT(job, struct db_discover_job);
+}
+
+
+/**
+ * Helper routine for _db_discover(), like _db_recurse_subtree_old()
+ * except that members which are assemblies (combinations other than
+ * regions) are handed to tasks, adding them to pending.
+ */
+static void
+_db_discover_subtree(union tree *tp, struct db_tree_state *msp, struct db_full_path *pathp, struct db_discover_state *dsp, std::vector<struct bu_task *> *pending)
+{
+    struct db_tree_state memb_state;
+    struct directory *dp;
+
+    RT_CK_TREE(tp);
+    RT_CK_DBTS(msp);
+    db_dup_db_tree_state(&memb_state, msp);
+
+    switch (tp->tr_op) {
+
+	case OP_DB_LEAF:
+	    if (db_apply_state_from_memb(&memb_state, pathp, tp) < 0) {
+		/* Lookup of this leaf failed, NOP it out. */
+		_db_discover_graft(tp, TREE_NULL, msp->ts_resp);
+		break;
+	    }
+
+	    /* protect against cyclic geometry */
+	    if (cyclic_path(pathp, tp->tr_l.tl_name, pathp->fp_len - 2)) {
+		int depth = pathp->fp_len;
+
+		bu_log("Detected cyclic reference of %s\nPath stack is:\n", tp->tr_l.tl_name);
+		while (--depth >=0) {
+		    bu_log("\tPath depth %d is %s\n", depth, pathp->fp_names[depth]->d_namep);
+		}
+		bu_log("WARNING: skipping the cyclic reference lookup\n");
+
+		_db_discover_graft(tp, TREE_NULL, msp->ts_resp);
+		DB_FULL_PATH_POP(pathp);
+		break;
+	    }
+
+	    dp = DB_FULL_PATH_CUR_DIR(pathp);
+	    if ((dp->d_flags & RT_DIR_COMB) && !(dp->d_flags & RT_DIR_REGION)) {
+		struct db_discover_job *job;
+
+		BU_GET(job, struct db_discover_job);
+		job->tp = tp;
+		db_dup_db_tree_state(&job->ts, &memb_state);
+		db_full_path_init(&job->path);
+		db_dup_full_path(&job->path, pathp);
+		job->dsp = dsp;
+		pending->push_back(bu_task_submit(_db_discover_task, job));
+	    } else {
+		_db_discover_graft(tp, _db_discover(&memb_state, pathp, dsp), msp->ts_resp);
+	    }
+	    DB_FULL_PATH_POP(pathp);
+	    break;
+
+	case OP_UNION:
+	case OP_INTERSECT:
+	case OP_SUBTRACT:
+	case OP_XOR:
+	    _db_discover_subtree(tp->tr_b.tb_left, &memb_state, pathp, dsp, pending);
+	    if (tp->tr_op == OP_SUBTRACT)
+		memb_state.ts_sofar |= TS_SOFAR_MINUS;
+	    else if (tp->tr_op == OP_INTERSECT)
+		memb_state.ts_sofar |= TS_SOFAR_INTER;
+	    _db_discover_subtree(tp->tr_b.tb_right, &memb_state, pathp, dsp, pending);
+	    break;
+
+	default:
+	    bu_log("_db_discover_subtree: bad op %d\n", tp->tr_op);
+	    bu_bomb("_db_discover_subtree\n");
+    }
+
+    db_free_db_tree_state(&memb_state);
+}
+
+
+/**
+ * The parallel form of the first pass of db_walk_tree(), which
+ * db_recurse()s from a tree top down to the regions.  Assemblies are
+ * read here, with their members that are themselves assemblies found
+ * by tasks that any idle task thread can take.  Everything from a
+ * region or solid down is left to db_recurse(), so this builds the
+ * same tree db_recurse() would.
+ */
+static union tree *
+_db_discover(struct db_tree_state *tsp, struct db_full_path *pathp, struct db_discover_state *dsp)
+{
+    struct directory *dp;
+    struct rt_db_internal intern;
+    struct rt_comb_internal *comb;
+    struct db_tree_state nts;
+    union tree *curtree;
+
+    RT_CK_DBTS(tsp);
+    RT_CK_FULL_PATH(pathp);
+
+    if (pathp->fp_len <= 0)
+	return TREE_NULL;
+    dp = DB_FULL_PATH_CUR_DIR(pathp);
+    if (!dp)
+	return TREE_NULL;
+
+    if ((dp->d_flags & RT_DIR_COMB) && !(dp->d_flags & RT_DIR_REGION) && dp->d_addr != RT_DIR_PHONY_ADDR) {
+	RT_DB_INTERNAL_INIT(&intern);
+	if (rt_db_get_internal(&intern, dp, tsp->ts_dbip, NULL, tsp->ts_resp) < 0) {
+	    bu_log("db_recurse() rt_db_get_internal(%s) FAIL\n", dp->d_namep);
+	    return TREE_NULL;
+	}
+
+	db_dup_db_tree_state(&nts, tsp);
+	comb = (struct rt_comb_internal *)intern.idb_ptr;
+	RT_CK_COMB(comb);
+	db5_sync_attr_to_comb(comb, &intern.idb_avs, dp);
+
+	/* Failures and regions are left to db_recurse() below */
+	if (db_apply_state_from_comb(&nts, pathp, comb) == 0) {
+	    std::vector<struct bu_task *> pending;
+
+	    if (comb->tree) {
+		/* Steal tree from combination, so it won't be freed */
+		curtree = comb->tree;
+		comb->tree = TREE_NULL;
+		rt_db_free_internal(&intern);
+
+		_db_discover_subtree(curtree, &nts, pathp, dsp, &pending);
+		for (size_t i = 0; i < pending.size(); i++)
+		    bu_task_wait(pending[i]);
+		RT_CK_TREE(curtree);
+	    } else {
+		/* No subtrees in this combination, invent a NOP */
+		rt_db_free_internal(&intern);
+		BU_GET(curtree, union tree);
+		RT_TREE_INIT(curtree);
+		curtree->tr_op = OP_NOP;
+	    }
+	    db_free_db_tree_state(&nts);
+	    return curtree;
 	}
+	db_free_db_tree_state(&nts);
+	rt_db_free_internal(&intern);
+    }
+
+    /* Regions and solids, handled as usual */
+    {
+	struct combined_tree_state *region_start_statep = (struct combined_tree_state *)0;
 
-	db_free_combined_tree_state(region_start_statep);
+	curtree = db_recurse(tsp, pathp, &region_start_statep, (void *)dsp);
+	if (region_start_statep)
+	    db_free_combined_tree_state(region_start_statep);
     }
+
+    return curtree;
 }
 
 
@@ -2084,6 +2324,7 @@ db_walk_tree(struct db_i *dbip,
     int something_not_found = 0;
     union tree **reg_trees;	/* (*reg_trees)[] */
     struct db_walk_parallel_state wps;
+    struct db_discover_state *dsp = NULL;
     struct resource *resp;
 
     RT_CK_DBTS(init_state);
@@ -2104,6 +2345,13 @@ db_walk_tree(struct db_i *dbip,
     }
     RT_CK_RESOURCE(resp);
 
+    /* With more than one cpu, assemblies are read in parallel too */
+    if (ncpu != 1 && bu_avail_cpus() > 1 && !dbip->dbi_use_comb_instance_ids) {
+	dsp = new struct db_discover_state;
+	dsp->reg_start_func = reg_start_func;
+	dsp->client_data = client_data;
+    }
+
     /* Walk each of the given path strings */
     for (i = 0; i < argc; i++) {
 	union tree *curtree;
@@ -2140,7 +2388,11 @@ db_walk_tree(struct db_i *dbip,
 	ts.ts_leaf_func = _db_gettree_leaf;
 
 	region_start_statep = (struct combined_tree_state *)0;
-	if (UNLIKELY(dbip->dbi_use_comb_instance_ids)) {
+	if (dsp) {
+	    if (reg_start_func)
+		ts.ts_region_start_func = _db_discover_region_start;
+	    curtree = _db_discover(&ts, &path, dsp);
+	} else if (UNLIKELY(dbip->dbi_use_comb_instance_ids)) {
 	    std::unordered_map<std::string, int> c_inst_map;
 	    curtree = db_recurse2(&ts, &path, &region_start_statep, client_data, (void *)&c_inst_map);
 	} else {
@@ -2172,6 +2424,8 @@ db_walk_tree(struct db_i *dbip,
 	}
     }
 
+    delete dsp;
+
     if (whole_tree == TREE_NULL)
 	return -1;	/* ERROR, nothing worked */
 
@@ -2238,7 +2492,13 @@ db_walk_tree(struct db_i *dbip,
     wps.magic = DB_WALK_PARALLEL_STATE_MAGIC;
     wps.reg_trees = reg_trees;
     wps.reg_count = new_reg_count;
-    wps.reg_current = 0;			/* Semaphored */
+    wps.reg_current = 0;
+    /* Claim regions in batches, small enough to balance the load */
+    wps.reg_batch = new_reg_count / (((ncpu > 0) ? ncpu : (int)bu_avail_cpus()) * 16);
+    if (wps.reg_batch < 1)
+	wps.reg_batch = 1;
+    if (wps.reg_batch > 64)
+	wps.reg_batch = 64;
     wps.reg_end_func = reg_end_func;
     wps.reg_leaf_func = leaf_func;
     wps.client_data = client_data;
@@ -0,0 +1,465 @@
+/*                      I N S T A N C E . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file librt/instance.c
+ *
+ * Object-space instancing of primitives placed by a rigid matrix.
+ *
+ * Normally each placement of a primitive under a different matrix is
+ * prepped in model space, so a BoT referenced a hundred times holds a
+ * hundred transformed copies of its triangles, each with its own
+ * hierarchy.  For the primitives whose prep is dominated by such
+ * data, every rigid placement instead shares one "prototype" soltab
+ * prepped from the unplaced object.  The placed soltab only carries
+ * the matrix and its model space bounding box, so the space
+ * partitioning built over the soltabs forms the top level of a two
+ * level structure whose lower level is the prototype's own
+ * object-space hierarchy.
+ *
+ * Rays are taken into object space on entry to ft_shot, and the hits
+ * handed back are in model space again.  Since the placement is
+ * rigid, hit distances are the same in both spaces.
+ */
+
+#include "common.h"
+
+#include <math.h>
+
+#include "bu/malloc.h"
+#include "bu/parallel.h"
+#include "bu/snooze.h"
+#include "vmath.h"
+#include "bn/mat.h"
+#include "raytrace.h"
+
+#include "./cache.h"
+#include "./librt_private.h"
+
+
+/* Largest error accepted in the rotation part of a placement */
+#define INSTANCE_RIGID_TOL 1.0e-9
+
+
+struct instance_proto {
+    struct soltab *stp;		/* prepped in object space */
+    struct rt_functab meth;	/* methods of the placed soltabs */
+    int state;			/* 0 prepping, 1 ready, -1 failed */
+    long uses;			/* placed soltabs sharing this */
+};
+
+struct instance_specific {
+    struct instance_proto *proto;
+    mat_t model2obj;
+    mat_t obj2model;
+};
+
+
+static int instance_shot(struct soltab *stp, struct xray *rp, struct application *ap, struct seg *seghead);
+
+
+static int
+instance_is(const struct soltab *stp)
+{
+    return (stp->st_meth && stp->st_meth->ft_shot == instance_shot);
+}
+
+
+static void
+instance_ray_to_obj(struct xray *orp, const struct xray *rp, const struct instance_specific *isp)
+{
+    *orp = *rp;		/* struct copy */
+    MAT4X3PNT(orp->r_pt, isp->model2obj, rp->r_pt);
+    MAT4X3VEC(orp->r_dir, isp->model2obj, rp->r_dir);
+}
+
+
+static void
+instance_hit_xform(struct hit *hitp, const mat_t m)
+{
+    point_t pt;
+    vect_t n;
+
+    MAT4X3PNT(pt, m, hitp->hit_point);
+    MAT4X3VEC(n, m, hitp->hit_normal);
+    VMOVE(hitp->hit_point, pt);
+    VMOVE(hitp->hit_normal, n);
+}
+
+
+static void
+instance_proto_release(struct instance_proto *proto)
+{
+    long uses;
+
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    uses = --proto->uses;
+    bu_semaphore_release(BU_SEM_GENERAL);
+    if (uses > 0)
+	return;
+
+    if (proto->stp) {
+	if (proto->state == 1 && proto->stp->st_meth->ft_free)
+	    proto->stp->st_meth->ft_free(proto->stp);
+	bu_free(proto->stp, "instance proto soltab");
+    }
+    bu_free(proto, "struct instance_proto");
+}
+
+
+static int
+instance_shot(struct soltab *stp, struct xray *rp, struct application *ap, struct seg *seghead)
+{
+    struct instance_specific *isp = (struct instance_specific *)stp->st_specific;
+    struct soltab *pstp = isp->proto->stp;
+    struct xray oray;
+    struct seg segs;
+    struct seg *segp;
+    int ret;
+
+    instance_ray_to_obj(&oray, rp, isp);
+
+    BU_LIST_INIT(&segs.l);
+    ret = pstp->st_meth->ft_shot(pstp, &oray, ap, &segs);
+    if (ret <= 0)
+	return ret;
+
+    for (BU_LIST_FOR(segp, seg, &segs.l)) {
+	segp->seg_stp = stp;
+	instance_hit_xform(&segp->seg_in, isp->obj2model);
+	instance_hit_xform(&segp->seg_out, isp->obj2model);
+    }
+    BU_LIST_APPEND_LIST(&seghead->l, &segs.l);
+
+    return ret;
+}
+
+
+static void
+instance_norm(struct hit *hitp, struct soltab *stp, struct xray *rp)
+{
+    struct instance_specific *isp = (struct instance_specific *)stp->st_specific;
+    struct soltab *pstp = isp->proto->stp;
+    struct xray *save_rayp = hitp->hit_rayp;
+    struct xray oray;
+
+    if (!pstp->st_meth->ft_norm)
+	return;
+
+    instance_hit_xform(hitp, isp->model2obj);
+    if (rp) {
+	instance_ray_to_obj(&oray, rp, isp);
+	hitp->hit_rayp = &oray;
+	pstp->st_meth->ft_norm(hitp, pstp, &oray);
+    } else {
+	pstp->st_meth->ft_norm(hitp, pstp, rp);
+    }
+    hitp->hit_rayp = save_rayp;
+    instance_hit_xform(hitp, isp->obj2model);
+}
+
+
+static void
+instance_curve(struct curvature *cvp, struct hit *hitp, struct soltab *stp)
+{
+    struct instance_specific *isp = (struct instance_specific *)stp->st_specific;
+    struct soltab *pstp = isp->proto->stp;
+    struct xray *save_rayp = hitp->hit_rayp;
+    struct xray oray;
+    vect_t pdir;
+
+    if (!pstp->st_meth->ft_curve)
+	return;
+
+    instance_hit_xform(hitp, isp->model2obj);
+    if (save_rayp) {
+	instance_ray_to_obj(&oray, save_rayp, isp);
+	hitp->hit_rayp = &oray;
+    }
+    pstp->st_meth->ft_curve(cvp, hitp, pstp);
+    hitp->hit_rayp = save_rayp;
+    instance_hit_xform(hitp, isp->obj2model);
+
+    MAT4X3VEC(pdir, isp->obj2model, cvp->crv_pdir);
+    VMOVE(cvp->crv_pdir, pdir);
+}
+
+
+static void
+instance_uv(struct application *ap, struct soltab *stp, struct hit *hitp, struct uvcoord *uvp)
+{
+    struct instance_specific *isp = (struct instance_specific *)stp->st_specific;
+    struct soltab *pstp = isp->proto->stp;
+    struct xray *save_rayp = hitp->hit_rayp;
+    struct xray oray;
+
+    if (!pstp->st_meth->ft_uv)
+	return;
+
+    instance_hit_xform(hitp, isp->model2obj);
+    if (save_rayp) {
+	instance_ray_to_obj(&oray, save_rayp, isp);
+	hitp->hit_rayp = &oray;
+    }
+    pstp->st_meth->ft_uv(ap, pstp, hitp, uvp);
+    hitp->hit_rayp = save_rayp;
+    instance_hit_xform(hitp, isp->obj2model);
+}
+
+
+static void
+instance_print(const struct soltab *stp)
+{
+    const struct instance_specific *isp = (const struct instance_specific *)stp->st_specific;
+
+    bu_log("object-space instance, %ld placements share the prep\n", isp->proto->uses);
+    bn_mat_print("obj2model", isp->obj2model);
+    if (isp->proto->state == 1 && isp->proto->stp->st_meth->ft_print)
+	isp->proto->stp->st_meth->ft_print(isp->proto->stp);
+}
+
+
+static void
+instance_free(struct soltab *stp)
+{
+    _rt_instance_detach(stp);
+}
+
+
+int
+_rt_instance_ok(const struct rt_i *rtip, int type, const matp_t mat)
+{
+    int i, j;
+
+    RT_CK_RTI(rtip);
+
+#ifdef USE_OPENCL
+    /* the OpenCL packers read st_specific by primitive type */
+    return 0;
+#endif
+
+    if (!mat || rtip->rti_dont_instance)
+	return 0;
+
+    /* only worth it where prep copies the geometry */
+    if (type != ID_BOT && type != ID_BREP)
+	return 0;
+
+    /* rigid, without mirroring: rows of the rotation are orthonormal,
+     * the determinant is +1, and there is no perspective or scale
+     */
+    for (i = 0; i < 3; i++) {
+	for (j = 0; j < 3; j++) {
+	    fastf_t d = VDOT(&mat[i*4], &mat[j*4]) - ((i == j) ? 1.0 : 0.0);
+	    if (!NEAR_ZERO(d, INSTANCE_RIGID_TOL))
+		return 0;
+	}
+    }
+    if (bn_mat_det3(mat) < 0.0)
+	return 0;
+    if (!ZERO(mat[12]) || !ZERO(mat[13]) || !ZERO(mat[14]) || !EQUAL(mat[15], 1.0))
+	return 0;
+
+    return 1;
+}
+
+
+int
+_rt_instance_attach(struct soltab *stp)
+{
+    struct instance_specific *isp;
+    struct instance_proto *proto = NULL;
+    struct directory *dp = (struct directory *)stp->st_dp;
+    struct bu_list *mid;
+    int creator = 0;
+
+    RT_CK_SOLTAB(stp);
+    RT_CK_DIR(dp);
+
+    /* Another placement of this object may already have a prototype */
+    for (BU_LIST_FOR(mid, bu_list, &dp->d_use_hd)) {
+	struct soltab *ostp = BU_LIST_MAIN_PTR(soltab, mid, l2);
+	if (ostp == stp || ostp->st_rtip != stp->st_rtip || !instance_is(ostp))
+	    continue;
+	proto = ((struct instance_specific *)ostp->st_specific)->proto;
+	break;
+    }
+
+    if (!proto) {
+	BU_ALLOC(proto, struct instance_proto);
+	proto->meth = OBJ[stp->st_id];	/* struct copy */
+	proto->meth.ft_shot = instance_shot;
+	proto->meth.ft_norm = instance_norm;
+	proto->meth.ft_curve = instance_curve;
+	proto->meth.ft_uv = instance_uv;
+	proto->meth.ft_print = instance_print;
+	proto->meth.ft_free = instance_free;
+	/* these would see the placed soltab as a model space one */
+	proto->meth.ft_prep = NULL;
+	proto->meth.ft_classify = NULL;
+	proto->meth.ft_piece_shot = NULL;
+	proto->meth.ft_piece_hitsegs = NULL;
+	proto->meth.ft_vshot = NULL;
+	proto->meth.ft_prep_serialize = NULL;
+	creator = 1;
+    }
+
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    proto->uses++;
+    bu_semaphore_release(BU_SEM_GENERAL);
+
+    BU_ALLOC(isp, struct instance_specific);
+    isp->proto = proto;
+    MAT_COPY(isp->obj2model, stp->st_matp);
+    bn_mat_inverse(isp->model2obj, isp->obj2model);
+
+    stp->st_specific = (void *)isp;
+    stp->st_meth = &proto->meth;
+
+    return creator;
+}
+
+
+void
+_rt_instance_detach(struct soltab *stp)
+{
+    struct instance_specific *isp;
+
+    RT_CK_SOLTAB(stp);
+    if (!instance_is(stp))
+	return;
+
+    isp = (struct instance_specific *)stp->st_specific;
+    stp->st_specific = NULL;
+    stp->st_meth = &OBJ[stp->st_id];
+
+    instance_proto_release(isp->proto);
+    bu_free(isp, "struct instance_specific");
+}
+
+
+/* Prep the prototype from the unplaced object */
+static int
+instance_proto_prep(struct instance_proto *proto, const struct soltab *stp, struct rt_cache *cache, struct resource *resp)
+{
+    struct rt_i *rtip = stp->st_rtip;
+    struct directory *dp = (struct directory *)stp->st_dp;
+    struct rt_db_internal intern;
+    struct soltab *pstp;
+    int ret;
+
+    if (rt_db_get_internal(&intern, dp, rtip->rti_dbip, NULL, resp) < 0) {
+	bu_log("_rt_instance_prep(%s):  import failure\n", dp->d_namep);
+	return -1;
+    }
+
+    BU_ALLOC(pstp, struct soltab);
+    pstp->l.magic = RT_SOLTAB_MAGIC;
+    pstp->l2.magic = RT_SOLTAB2_MAGIC;
+    pstp->st_rtip = rtip;
+    pstp->st_dp = dp;
+    pstp->st_uses = 1;
+    pstp->st_id = intern.idb_type;
+    pstp->st_meth = &OBJ[intern.idb_type];
+    pstp->st_bit = stp->st_bit;
+    pstp->st_matp = (matp_t)0;
+    VSETALL(pstp->st_max, -INFINITY);
+    VSETALL(pstp->st_min,  INFINITY);
+    proto->stp = pstp;
+
+    if (rtip->rti_dbip->dbi_version > 4) {
+	ret = rt_cache_prep(cache, pstp, &intern);
+    } else {
+	ret = rt_obj_prep(pstp, &intern, rtip);
+    }
+    rt_db_free_internal(&intern);
+
+    if (ret == 0 && (pstp->st_id != stp->st_id || !pstp->st_meth->ft_shot))
+	ret = -1;
+
+    return ret;
+}
+
+
+int
+_rt_instance_prep(struct soltab *stp, int creator, struct rt_cache *cache, struct resource *resp)
+{
+    struct instance_specific *isp;
+    struct instance_proto *proto;
+    struct soltab *pstp;
+    int state;
+    int i;
+
+    RT_CK_SOLTAB(stp);
+    if (!instance_is(stp))
+	return -1;
+    isp = (struct instance_specific *)stp->st_specific;
+    proto = isp->proto;
+
+    if (creator) {
+	state = instance_proto_prep(proto, stp, cache, resp) ? -1 : 1;
+	bu_semaphore_acquire(BU_SEM_GENERAL);
+	proto->state = state;
+	bu_semaphore_release(BU_SEM_GENERAL);
+    } else {
+	/* some other thread is prepping the prototype */
+	for (;;) {
+	    bu_semaphore_acquire(BU_SEM_GENERAL);
+	    state = proto->state;
+	    bu_semaphore_release(BU_SEM_GENERAL);
+	    if (state)
+		break;
+	    bu_snooze(BU_SEC2USEC(0.001));
+	}
+    }
+    if (state < 0)
+	return -1;
+
+    /* Place the prototype's bounds */
+    pstp = proto->stp;
+    VSETALL(stp->st_max, -INFINITY);
+    VSETALL(stp->st_min,  INFINITY);
+    for (i = 0; i < 8; i++) {
+	point_t corner, pt;
+	VSET(corner,
+	     (i & 1) ? pstp->st_max[X] : pstp->st_min[X],
+	     (i & 2) ? pstp->st_max[Y] : pstp->st_min[Y],
+	     (i & 4) ? pstp->st_max[Z] : pstp->st_min[Z]);
+	MAT4X3PNT(pt, isp->obj2model, corner);
+	VMINMAX(stp->st_min, stp->st_max, pt);
+    }
+    MAT4X3PNT(stp->st_center, isp->obj2model, pstp->st_center);
+    stp->st_aradius = pstp->st_aradius;
+    stp->st_bradius = pstp->st_bradius;
+
+    if (RT_G_DEBUG & RT_DEBUG_SOLIDS)
+	bu_log("%s placed as an object-space instance\n", stp->st_dp->d_namep);
+
+    return 0;
+}
+
+
+/*
+ * Local Variables:
+ * mode: C
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
@@ -176,6 +176,40 @@ extern RT_EXPORT long db5_size(struct db_i *dbip, struct directory *dp, int flag
 extern int rt_binunif_import5_minor_type(struct rt_db_internal *, const struct bu_external *, const mat_t, const struct db_i *, struct resource *, int);
 
 
+/* instance.c */
+
+struct rt_cache;
+
+/**
+ * Returns non-zero if a leaf of the given primitive type placed by mat
+ * should share an object-space prep with its other placements rather
+ * than being prepped in model space.  mat is NULL for identity.
+ */
+extern int _rt_instance_ok(const struct rt_i *rtip, int type, const matp_t mat);
+
+/**
+ * Turn a new soltab into an object-space instance, sharing the
+ * prototype of any other placement of the same object.  Must be
+ * called holding _rt_solid_dir_lock() for stp->st_dp, after st_id is
+ * set.  Returns 1 if the caller created the prototype and has to
+ * prep it.
+ */
+extern int _rt_instance_attach(struct soltab *stp);
+
+/**
+ * Prep an attached instance, prepping its prototype if creator is set
+ * or waiting for another thread to do so otherwise.  Returns 0 on
+ * success, non-zero if the soltab is no good.
+ */
+extern int _rt_instance_prep(struct soltab *stp, int creator, struct rt_cache *cache, struct resource *resp);
+
+/**
+ * Undo _rt_instance_attach(), dropping the soltab's reference to its
+ * prototype.  Does nothing to soltabs that are not instances.
+ */
+extern void _rt_instance_detach(struct soltab *stp);
+
+
 /* primitive_util.c */
 
 extern void primitive_hitsort(struct hit h[], int nh);
@@ -226,6 +260,44 @@ extern void plot_ellipse(
 extern int _rt_tcl_list_to_int_array(const char *list, int **array, int *array_len);
 extern int _rt_tcl_list_to_fastf_array(const char *list, fastf_t **array, int *array_len);
 
+
+/* solid_lookup.cpp */
+
+struct rt_solid_lookup;
+
+/**
+ * Lock protecting the rti_solidheads[hash] lists and the d_use_hd
+ * lists and d_uses of directories with db_dirhash() value hash.
+ */
+extern void _rt_solid_dir_lock(int hash);
+extern void _rt_solid_dir_unlock(int hash);
+
+/**
+ * Create the table tree walkers use to find existing soltabs of rtip,
+ * loaded with the soltabs it already has.
+ */
+extern struct rt_solid_lookup *_rt_solid_lookup_create(struct rt_i *rtip);
+
+/**
+ * Destroy the table once no walker uses it, adding the uses found
+ * through it to the soltabs' st_uses.
+ */
+extern void _rt_solid_lookup_destroy(struct rt_solid_lookup *tbl);
+
+/**
+ * Find the soltab of dp placed by mat (NULL for identity) without
+ * locking, counting a use of it unless it is dead.  Returns
+ * RT_SOLTAB_NULL if there is none.
+ */
+extern struct soltab *_rt_solid_lookup_find(struct rt_solid_lookup *tbl, const matp_t mat, struct directory *dp);
+
+/**
+ * Add a new soltab keyed by its st_dp and st_matp.  If another thread
+ * added the same placement first, a use of that soltab is counted and
+ * it is returned instead of stp, which the caller has to discard.
+ */
+extern struct soltab *_rt_solid_lookup_add(struct rt_solid_lookup *tbl, struct soltab *stp);
+
 /* view.c */
 extern fastf_t solid_point_spacing(const struct bview *gvp, fastf_t solid_width);
 extern fastf_t view_avg_sample_spacing(const struct bview *gvp);
@@ -54,8 +54,8 @@ rt_pr_soltab(register const struct soltab *stp)
     VPRINT("Bound RPP min", stp->st_min);
     VPRINT("Bound RPP max", stp->st_max);
     bu_pr_ptbl("st_regions", &stp->st_regions, 1);
-    if (OBJ[id].ft_print)
-	OBJ[id].ft_print(stp);
+    if (stp->st_meth->ft_print)
+	stp->st_meth->ft_print(stp);
 }
 
 
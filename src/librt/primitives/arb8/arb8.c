@@ -1254,7 +1254,7 @@ rt_arb_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct bg_te
 {
     point_t *pts;
     struct rt_arb_internal *aip;
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
@@ -1646,13 +1646,13 @@ rt_arb_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
     }
 
     /* Mark edges as real */
-    (void)nmg_mark_edges_real(&s->l.magic, &RTG.rtg_vlfree);
+    (void)nmg_mark_edges_real(&s->l.magic, rt_vlfree());
 
     /* Compute "geometry" for region and shell */
     nmg_region_a(*r, tol);
 
     /* Some arbs may not be within tolerance, so triangulate faces where needed */
-    nmg_make_faces_within_tol(s, &RTG.rtg_vlfree, tol);
+    nmg_make_faces_within_tol(s, rt_vlfree(), tol);
 
     return 0;
 }
@@ -1827,7 +1827,7 @@ rt_arb_tnurb(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, c
 
 
     /* Mark edges as real */
-    (void)nmg_mark_edges_real(&s->l.magic, &RTG.rtg_vlfree);
+    (void)nmg_mark_edges_real(&s->l.magic, rt_vlfree());
 
     /* Compute "geometry" for region and shell */
     nmg_region_a(*r, tol);
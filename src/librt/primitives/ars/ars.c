@@ -555,7 +555,7 @@ rt_ars_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
 		ASSOC_GEOM(0, 0, 0);
 		ASSOC_GEOM(1, 0, 1);
 		ASSOC_GEOM(2, 1, 1);
-		if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+		if (nmg_calc_face_g(fu,rt_vlfree())) {
 		    bu_log("Degenerate face created, will kill it later\n");
 		    bu_ptbl_ins(&kill_fus, (long *)fu);
 		}
@@ -586,7 +586,7 @@ rt_ars_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
 		ASSOC_GEOM(0, 1, 0);
 		ASSOC_GEOM(1, 0, 0);
 		ASSOC_GEOM(2, 1, 1);
-		if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+		if (nmg_calc_face_g(fu,rt_vlfree())) {
 		    bu_log("Degenerate face created, will kill it later\n");
 		    bu_ptbl_ins(&kill_fus, (long *)fu);
 		}
@@ -606,16 +606,16 @@ rt_ars_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
     /* ARS solids are often built with incorrect face normals.  Don't
      * depend on them to be correct.
      */
-    nmg_fix_normals(s, &RTG.rtg_vlfree, tol);
+    nmg_fix_normals(s, rt_vlfree(), tol);
 
     /* set edge's is_real flag */
-    nmg_mark_edges_real(&s->l.magic, &RTG.rtg_vlfree);
+    nmg_mark_edges_real(&s->l.magic, rt_vlfree());
 
     /* Compute "geometry" for region and shell */
     nmg_region_a(*r, tol);
 
-    nmg_shell_coplanar_face_merge(s, tol, 0, &RTG.rtg_vlfree);
-    nmg_simplify_shell(s,&RTG.rtg_vlfree);
+    nmg_shell_coplanar_face_merge(s, tol, 0, rt_vlfree());
+    nmg_simplify_shell(s,rt_vlfree());
 
     return 0;
 }
@@ -689,7 +689,7 @@ rt_ars_prep(struct soltab *stp, struct rt_db_internal *ip, struct rt_i *rtip)
     }
 
     s = BU_LIST_FIRST(shell, &r->s_hd);
-    bot = nmg_bot(s, &RTG.rtg_vlfree, &rtip->rti_tol);
+    bot = nmg_bot(s, rt_vlfree(), &rtip->rti_tol);
 
     if (!bot) {
 	bu_log("Failed to convert ARS to BOT (%s)\n", stp->st_dp->d_namep);
@@ -722,7 +722,7 @@ rt_ars_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct bg_te
     register size_t i;
     register size_t j;
     struct rt_ars_internal *arip;
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
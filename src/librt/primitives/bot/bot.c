@@ -1657,7 +1657,7 @@ rt_bot_adaptive_plot(struct bu_list *vhead, struct rt_db_internal *ip, const str
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
 
     bot = (struct rt_bot_internal *)ip->idb_ptr;
     RT_BOT_CK_MAGIC(bot);
@@ -1724,7 +1724,7 @@ rt_bot_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct bg_te
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     bot_ip = (struct rt_bot_internal *)ip->idb_ptr;
     RT_BOT_CK_MAGIC(bot_ip);
 
@@ -1760,7 +1760,7 @@ rt_bot_plot_poly(struct bu_list *vhead, struct rt_db_internal *ip, const struct
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     bot_ip = (struct rt_bot_internal *)ip->idb_ptr;
     RT_BOT_CK_MAGIC(bot_ip);
 
@@ -1942,7 +1942,7 @@ rt_bot_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
 	if (!(*corners[2])->vg_p)
 	    nmg_vertex_gv(*(corners[2]), pt[2]);
 
-	if (nmg_calc_face_g(fu,&RTG.rtg_vlfree))
+	if (nmg_calc_face_g(fu,rt_vlfree()))
 	    nmg_kfu(fu);
 	else if (bot_ip->mode == RT_BOT_SURFACE) {
 	    struct vertex **tmp;
@@ -1953,18 +1953,18 @@ rt_bot_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
 	    if ((fu=nmg_cmface(s, corners, 3)) == (struct faceuse *)NULL)
 		bu_log("rt_bot_tess() nmg_cmface() failed for face #%zu\n", i);
 	    else
-		nmg_calc_face_g(fu,&RTG.rtg_vlfree);
+		nmg_calc_face_g(fu,rt_vlfree());
 	}
     }
 
     bu_free(verts, "rt_bot_tess *verts[]");
 
-    nmg_mark_edges_real(&s->l.magic, &RTG.rtg_vlfree);
+    nmg_mark_edges_real(&s->l.magic, rt_vlfree());
 
     nmg_region_a(*r, tol);
 
     if (bot_ip->mode == RT_BOT_SOLID && bot_ip->orientation == RT_BOT_UNORIENTED)
-	nmg_fix_normals(s, &RTG.rtg_vlfree, tol);
+	nmg_fix_normals(s, rt_vlfree(), tol);
 
     return 0;
 }
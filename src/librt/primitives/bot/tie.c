@@ -130,7 +130,9 @@ TIE_VAL(tri_prep)(struct tie_s *tie)
  * @param tie pointer to a struct tie_t
  * @param tri_num initial number of triangles to allocate for.
  *                tie_push may expand the buffer, if needed.
- * @param kdmethod Either TIE_KDTREE_FAST or TIE_KDTREE_OPTIMAL
+ * @param kdmethod TIE_KDTREE_FAST, TIE_KDTREE_OPTIMAL, TIE_KDTREE_SAH or
+ *                 TIE_KDTREE_SAH_CLIP.  The SAH methods build slower
+ *                 than FAST but give trees that are faster to shoot.
  * @return void
  */
 void
@@ -169,7 +171,8 @@ TIE_VAL(tie_free)(struct tie_s *tie)
 /**
  * Get ready to shoot rays at triangles
  *
- * Build the KDTREE tree for the triangles we have
+ * Build the KDTREE tree for the triangles we have.  Subtrees with
+ * enough triangles in them are built in parallel by libbu tasks.
  *
  * @param tie pointer to a struct struct tie_s which now has all the
  * triangles in it.
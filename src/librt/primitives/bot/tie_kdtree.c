@@ -24,6 +24,7 @@
 
 #include "rt/tie.h"
 
+#include <float.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -45,6 +46,18 @@
 #define	TIE_KDTREE_NODE_MAX	4	/* Maximum number of triangles that can reside in a given node until it should be split */
 #define	TIE_KDTREE_DEPTH_K1	1.4	/* K1 Depth Constant Coefficient */
 #define	TIE_KDTREE_DEPTH_K2	1	/* K2 Constant */
+#define	TIE_KDTREE_DEPTH_SAH	7	/* Extra depth for SAH trees, which spend levels cutting off empty space */
+#define	TIE_KDTREE_DEPTH_MAX	36	/* Deepest tree the tie_work() traversal stack can take */
+
+#define	TIE_KDTREE_NO_SPLIT	3	/* Returned by a split finder when the node should stay a leaf */
+#define	TIE_KDTREE_TASK_MIN	4096	/* Nodes with at least this many triangles build their first child as a task */
+#define	TIE_KDTREE_PAR_MIN	65536	/* Nodes with at least this many triangles sort them with bu_parallel_for() */
+#define	TIE_KDTREE_GRAIN	4096	/* Triangles per bu_parallel_for() chunk */
+
+#define	TIE_SAH_BINS		32	/* Bins per axis, candidate planes are the bin boundaries */
+#define	TIE_SAH_TRAVERSE	1.0	/* Cost of stepping into a node */
+#define	TIE_SAH_INTERSECT	1.5	/* Cost of testing a triangle */
+#define	TIE_SAH_EMPTY_BONUS	0.8	/* Cost scale for splits that cut off empty space */
 
 #define _MIN(a, b) (a)<(b)?(a):(b)
 #define _MAX(a, b) (a)>(b)?(a):(b)
@@ -109,6 +122,28 @@
  **************** PRIVATE FUNCTIONS **************************
  *************************************************************/
 
+/* A subtree built by a task */
+struct tie_kdtree_job_s {
+    struct tie_s *tie;
+    struct tie_kdtree_s *node;
+    unsigned int depth;
+    point_t min, max;
+    size_t refs;
+};
+
+/* Per-triangle work shared by the bu_parallel_for() callbacks */
+struct tie_kdtree_range_s {
+    struct tie_tri_s **tri_list;
+    TIE_3 cmin[2], cmax[2], center[2], half_size[2];
+    uint8_t *sides;	/* bit n set if the triangle goes in child n */
+    TFLOAT *bounds;	/* per triangle min xyz then max xyz, inside the node */
+    int clip;		/* bounds are of the triangles clipped to the node */
+    unsigned int split;	/* splitting axis */
+    TFLOAT axis;	/* splitting plane */
+};
+
+static size_t tie_kdtree_build(struct tie_s *tie, struct tie_kdtree_s *node, unsigned int depth, point_t min, point_t max);
+
 
 static void
 tie_kdtree_free_node(struct tie_kdtree_s *node)
@@ -324,22 +359,26 @@ find_split_optimal(struct tie_s *tie, struct tie_kdtree_s *node, TIE_3 *cmin, TI
 	 * doing any computations for.
 	 */
 	for (i = 0; i < node_gd->tri_num; i++) {
+	    /* Triangles are shared by nodes built concurrently, so
+	     * keep this out of tri->v. */
+	    TFLOAT t_lo, t_hi;
+
 	    tri = node_gd->tri_list[i];
 	    /* Set min anx max */
-	    MATH_MIN3(tri->v[0], tri->data[0].v[d], tri->data[1].v[d], tri->data[2].v[d]);
-	    MATH_MAX3(tri->v[1], tri->data[0].v[d], tri->data[1].v[d], tri->data[2].v[d]);
+	    MATH_MIN3(t_lo, tri->data[0].v[d], tri->data[1].v[d], tri->data[2].v[d]);
+	    MATH_MAX3(t_hi, tri->data[0].v[d], tri->data[1].v[d], tri->data[2].v[d]);
 
 	    /* Clamp to node AABB */
-	    if (tri->v[0] < min.v[d])
-		tri->v[0] = min.v[d];
-	    if (tri->v[1] > max.v[d])
-		tri->v[1] = max.v[d];
+	    if (t_lo < min.v[d])
+		t_lo = min.v[d];
+	    if (t_hi > max.v[d])
+		t_hi = max.v[d];
 
-	    if (i == 0 || tri->v[0] < d_min)
-		d_min = tri->v[0];
+	    if (i == 0 || t_lo < d_min)
+		d_min = t_lo;
 
-	    if (i == 0 || tri->v[1] > d_max)
-		d_max = tri->v[1];
+	    if (i == 0 || t_hi > d_max)
+		d_max = t_hi;
 	}
 
 	for (k = 0; k < slice_num; k++) {
@@ -546,10 +585,8 @@ find_split_optimal(struct tie_s *tie, struct tie_kdtree_s *node, TIE_3 *cmin, TI
      * doing.  In other words, if one of the children have the same number of triangles
      * as the parent does then stop.
      */
-    if (side[split][split_slice][0] == node_gd->tri_num || side[split][split_slice][1] == node_gd->tri_num) {
-	tie->stat += node_gd->tri_num;
+    if (side[split][split_slice][0] == node_gd->tri_num || side[split][split_slice][1] == node_gd->tri_num)
 	return split;
-    }
 
     /* Based on the winner, construct the two child nodes */
     VMOVE(cmin[0].v, min.v);
@@ -564,16 +601,266 @@ find_split_optimal(struct tie_s *tie, struct tie_kdtree_s *node, TIE_3 *cmin, TI
     return split;
 }
 
+/* Bounds of the part of tri inside the box, 0 if none of it is */
+static int
+tie_kdtree_clip_bounds(struct tie_tri_s *tri, TIE_3 *bmin, TIE_3 *bmax, TFLOAT *lo, TFLOAT *hi)
+{
+    /* each of the six planes adds at most one vertex */
+    TIE_3 poly[2][9];
+    unsigned int i, d, side, n = 3, m, cur = 0;
+
+    for (i = 0; i < 3; i++)
+	poly[0][i] = tri->data[i];
+
+    for (d = 0; d < 3 && n; d++) {
+	for (side = 0; side < 2 && n; side++) {
+	    TFLOAT plane = side ? bmax->v[d] : bmin->v[d];
+
+	    m = 0;
+	    for (i = 0; i < n; i++) {
+		TIE_3 *a = &poly[cur][i];
+		TIE_3 *b = &poly[cur][(i + 1) % n];
+		int a_in = side ? a->v[d] <= plane : a->v[d] >= plane;
+		int b_in = side ? b->v[d] <= plane : b->v[d] >= plane;
+
+		if (a_in)
+		    poly[!cur][m++] = *a;
+		if (a_in != b_in) {
+		    TFLOAT t = (plane - a->v[d]) / (b->v[d] - a->v[d]);
+		    TIE_3 *c = &poly[!cur][m++];
+
+		    VSUB2(c->v, b->v, a->v);
+		    VJOIN1(c->v, a->v, t, c->v);
+		    c->v[d] = plane;
+		}
+	    }
+	    n = m;
+	    cur = !cur;
+	}
+    }
+
+    if (!n)
+	return 0;
+
+    VMOVE(lo, poly[cur][0].v);
+    VMOVE(hi, poly[cur][0].v);
+    for (i = 1; i < n; i++) {
+	VMIN(lo, poly[cur][i].v);
+	VMAX(hi, poly[cur][i].v);
+    }
+    return 1;
+}
+
+static void
+tie_kdtree_bounds(size_t first, size_t last, void *data)
+{
+    struct tie_kdtree_range_s *r = (struct tie_kdtree_range_s *)data;
+    size_t i;
+    unsigned int d;
+
+    for (i = first; i < last; i++) {
+	struct tie_tri_s *tri = r->tri_list[i];
+	TFLOAT *lo = &r->bounds[6*i];
+	TFLOAT *hi = &r->bounds[6*i + 3];
+
+	if (r->clip && tie_kdtree_clip_bounds(tri, &r->cmin[0], &r->cmax[0], lo, hi))
+	    continue;
+
+	/* Triangle bounds clamped to the node */
+	for (d = 0; d < 3; d++) {
+	    MATH_MIN3(lo[d], tri->data[0].v[d], tri->data[1].v[d], tri->data[2].v[d]);
+	    MATH_MAX3(hi[d], tri->data[0].v[d], tri->data[1].v[d], tri->data[2].v[d]);
+	    lo[d] = _MAX(lo[d], r->cmin[0].v[d]);
+	    lo[d] = _MIN(lo[d], r->cmax[0].v[d]);
+	    hi[d] = _MAX(hi[d], r->cmin[0].v[d]);
+	    hi[d] = _MIN(hi[d], r->cmax[0].v[d]);
+	}
+    }
+}
+
+static unsigned int
+find_split_sah(struct tie_kdtree_s *node, TFLOAT *bounds, TIE_3 *cmin, TIE_3 *cmax)
+{
+    /*********************************
+     * BINNED SURFACE AREA HEURISTIC *
+     *********************************/
+    struct tie_geom_s *node_gd = (struct tie_geom_s *)(node->data);
+    unsigned int lo_cnt[TIE_SAH_BINS], hi_cnt[TIE_SAH_BINS];
+    unsigned int i, d, k, n_l, n_r, split = TIE_KDTREE_NO_SPLIT;
+    TFLOAT ext[3], area, best, split_pos = 0.0;
+
+    VSUB2(ext, cmax[0].v, cmin[0].v);
+    area = ext[0]*ext[1] + ext[1]*ext[2] + ext[2]*ext[0];
+    if (area <= 0.0)
+	return TIE_KDTREE_NO_SPLIT;
+
+    /* Splitting has to beat testing every triangle in this node */
+    best = TIE_SAH_INTERSECT * node_gd->tri_num;
+
+    for (d = 0; d < 3; d++) {
+	TFLOAT g_min, g_max, g_ext, inv, other_area, other_perim;
+	TFLOAT plane[TIE_SAH_BINS + 1];
+	unsigned int left[TIE_SAH_BINS + 1], right[TIE_SAH_BINS + 1];
+
+	if (ext[d] <= 0.0)
+	    continue;
+
+	/* Bin over the extent of the geometry, not the node, so empty
+	 * space is cut off in one step instead of a bin at a time */
+	g_min = cmax[0].v[d];
+	g_max = cmin[0].v[d];
+	for (i = 0; i < node_gd->tri_num; i++) {
+	    g_min = _MIN(g_min, bounds[6*i + d]);
+	    g_max = _MAX(g_max, bounds[6*i + 3 + d]);
+	}
+	g_ext = g_max - g_min;
+
+	/* Count where triangles start and end along this axis */
+	memset(lo_cnt, 0, sizeof(lo_cnt));
+	memset(hi_cnt, 0, sizeof(hi_cnt));
+	inv = (g_ext > 0.0) ? TIE_SAH_BINS / g_ext : 0.0;
+	for (i = 0; i < node_gd->tri_num; i++) {
+	    int b0 = (int)((bounds[6*i + d] - g_min) * inv);
+	    int b1 = (int)((bounds[6*i + 3 + d] - g_min) * inv);
+	    lo_cnt[b0 < 0 ? 0 : (b0 >= TIE_SAH_BINS ? TIE_SAH_BINS - 1 : b0)]++;
+	    hi_cnt[b1 < 0 ? 0 : (b1 >= TIE_SAH_BINS ? TIE_SAH_BINS - 1 : b1)]++;
+	}
+
+	/*
+	 * Candidate planes are the ends of the geometry and the bin
+	 * boundaries between them.  A triangle is on the left of a
+	 * plane if it starts below it and on the right if it ends
+	 * above it.
+	 */
+	plane[0] = g_min;
+	left[0] = 0;
+	right[0] = node_gd->tri_num;
+	for (k = 1; k < TIE_SAH_BINS; k++) {
+	    plane[k] = g_min + g_ext * k / TIE_SAH_BINS;
+	    left[k] = left[k-1] + lo_cnt[k-1];
+	    right[k] = right[k-1] - hi_cnt[k-1];
+	}
+	plane[TIE_SAH_BINS] = g_max;
+	left[TIE_SAH_BINS] = node_gd->tri_num;
+	right[TIE_SAH_BINS] = 0;
+
+	/* Areas of the faces that do not depend on the plane */
+	other_area = ext[(d+1)%3] * ext[(d+2)%3];
+	other_perim = ext[(d+1)%3] + ext[(d+2)%3];
+
+	for (k = 0; k <= TIE_SAH_BINS; k++) {
+	    /* The plane is stored as a float, so cost the one we will
+	     * get.  Round the ends of the geometry outwards so the
+	     * triangles there do not poke through to the empty side. */
+	    float fpos = (float)plane[k];
+	    TFLOAT pos, len_l;
+	    TFLOAT len_r, cost;
+
+	    if (k == 0 && fpos > plane[k])
+		fpos = nextafterf(fpos, -FLT_MAX);
+	    else if (k == TIE_SAH_BINS && fpos < plane[k])
+		fpos = nextafterf(fpos, FLT_MAX);
+	    pos = fpos;
+	    len_l = pos - cmin[0].v[d];
+	    len_r = cmax[0].v[d] - pos;
+
+	    if (len_l <= 0.0 || len_r <= 0.0)
+		continue;
+
+	    n_l = left[k];
+	    n_r = right[k];
+	    cost = TIE_SAH_TRAVERSE + TIE_SAH_INTERSECT *
+		((other_area + len_l * other_perim) * n_l + (other_area + len_r * other_perim) * n_r) / area;
+	    if (n_l == 0 || n_r == 0)
+		cost *= TIE_SAH_EMPTY_BONUS;
+
+	    if (cost < best) {
+		best = cost;
+		split = d;
+		split_pos = pos;
+	    }
+	}
+    }
+
+    if (split == TIE_KDTREE_NO_SPLIT)
+	return split;
+
+    cmax[0].v[split] = split_pos;
+    cmin[1].v[split] = split_pos;
+    node->axis = split_pos;
+    return split;
+}
+
 static void
+tie_kdtree_classify(size_t first, size_t last, void *data)
+{
+    struct tie_kdtree_range_s *r = (struct tie_kdtree_range_s *)data;
+    size_t i;
+    unsigned int j, n;
+
+    for (i = first; i < last; i++) {
+	struct tie_tri_s *tri = r->tri_list[i];
+
+	r->sides[i] = 0;
+
+	/*
+	 * Perfect splits go by the clipped bounds the plane was chosen
+	 * with, a triangle lying in the plane going to both sides.
+	 */
+	if (r->clip) {
+	    if (r->bounds[6*i + r->split] < r->axis)
+		r->sides[i] |= 1;
+	    if (r->bounds[6*i + 3 + r->split] > r->axis)
+		r->sides[i] |= 2;
+	    if (!r->sides[i])
+		r->sides[i] = 3;
+	    continue;
+	}
+
+	for (n = 0; n < 2; n++) {
+	    /*
+	     * Check to see if any triangle points are inside of the node before
+	     * spending a lot of cycles on the full blown triangle box overlap
+	     */
+	    for (j = 0; j < 3; j++)
+		if (tri->data[j].v[0] > r->cmin[n].v[0] &&
+			tri->data[j].v[0] < r->cmax[n].v[0] &&
+			tri->data[j].v[1] > r->cmin[n].v[1] &&
+			tri->data[j].v[1] < r->cmax[n].v[1] &&
+			tri->data[j].v[2] > r->cmin[n].v[2] &&
+			tri->data[j].v[2] < r->cmax[n].v[2])
+		    break;
+
+	    if (j < 3 || tie_kdtree_tri_box_overlap(&r->center[n], &r->half_size[n], tri->data))
+		r->sides[i] |= (uint8_t)(1 << n);
+	}
+    }
+}
+
+static void
+tie_kdtree_build_task(void *data)
+{
+    struct tie_kdtree_job_s *job = (struct tie_kdtree_job_s *)data;
+
+    job->refs = tie_kdtree_build(job->tie, job->node, job->depth, job->min, job->max);
+}
+
+/* Returns the number of triangle references in the leaves below node */
+static size_t
 tie_kdtree_build(struct tie_s *tie, struct tie_kdtree_s *node, unsigned int depth, point_t min, point_t max)
 {
     struct tie_geom_s *child[2], *node_gd = (struct tie_geom_s *)(node->data);
-    TIE_3 cmin[2], cmax[2], center[2], half_size[2];
-    unsigned int i, j, n, split = 0, cnt[2];
+    struct tie_kdtree_s *kids;
+    struct tie_kdtree_range_s r;
+    struct tie_kdtree_job_s job;
+    struct bu_task *task;
+    TIE_3 cmin[2], cmax[2];
+    unsigned int i, n, split = 0;
+    size_t refs;
 
     if (node_gd == NULL) {
 	bu_log("null geom, aborting\n");
-	return;
+	return 0;
     }
 
     /* initialize cmax to make the compiler happy */
@@ -582,86 +869,89 @@ tie_kdtree_build(struct tie_s *tie, struct tie_kdtree_s *node, unsigned int dept
     VMOVE(cmax[1].v, max);
     VMOVE(cmin[1].v, min);
 
-    /* Terminating criteria for KDTREE subdivision */
-    if (node_gd->tri_num <= TIE_KDTREE_NODE_MAX || depth > tie->max_depth) {
-	tie->stat += node_gd->tri_num;
-	return;
-    }
+    /* Terminating criteria for KDTREE subdivision, SAH deciding for
+     * itself when a few triangles are not worth splitting further */
+    if (node_gd->tri_num == 0 || depth > tie->max_depth)
+	return node_gd->tri_num;
+    if (node_gd->tri_num <= TIE_KDTREE_NODE_MAX && tie->kdmethod != TIE_KDTREE_SAH && tie->kdmethod != TIE_KDTREE_SAH_CLIP)
+	return node_gd->tri_num;
+
+    r.tri_list = node_gd->tri_list;
+    r.bounds = NULL;
+    r.clip = 0;
 
-    if (tie->kdmethod == TIE_KDTREE_FAST)
+    if (tie->kdmethod == TIE_KDTREE_FAST) {
 	split = find_split_fast(node, &cmin[0], &cmax[0]);
-    else if (tie->kdmethod == TIE_KDTREE_OPTIMAL)
+    } else if (tie->kdmethod == TIE_KDTREE_OPTIMAL) {
 	split = find_split_optimal(tie, node, &cmin[0], &cmax[0]);
-    else
+    } else if (tie->kdmethod == TIE_KDTREE_SAH || tie->kdmethod == TIE_KDTREE_SAH_CLIP) {
+	/* Bounds of the triangles within this node */
+	r.cmin[0] = cmin[0];
+	r.cmax[0] = cmax[0];
+	r.clip = (tie->kdmethod == TIE_KDTREE_SAH_CLIP);
+	r.bounds = (TFLOAT *)bu_malloc(6 * sizeof(TFLOAT) * node_gd->tri_num, "tri bounds");
+	if (node_gd->tri_num >= TIE_KDTREE_PAR_MIN)
+	    bu_parallel_for(0, node_gd->tri_num, TIE_KDTREE_GRAIN, tie_kdtree_bounds, &r);
+	else
+	    tie_kdtree_bounds(0, node_gd->tri_num, &r);
+
+	split = find_split_sah(node, r.bounds, &cmin[0], &cmax[0]);
+    } else {
 	bu_bomb("Illegal tie kdtree method\n");
+    }
 
-    /* Allocate 2 children nodes for the parent node */
-    node->data = bu_calloc(2, sizeof(struct tie_kdtree_s), "tie_kdtree_build()");
-    node->b = 0;
-
-    BU_ALLOC(((struct tie_kdtree_s *)(node->data))[0].data, struct tie_geom_s);
-    BU_ALLOC(((struct tie_kdtree_s *)(node->data))[1].data, struct tie_geom_s);
-
-    /* Initialize Triangle List */
-    child[0] = ((struct tie_geom_s *)(((struct tie_kdtree_s *)(node->data))[0].data));
-    child[1] = ((struct tie_geom_s *)(((struct tie_kdtree_s *)(node->data))[1].data));
-
-    child[0]->tri_list = (struct tie_tri_s **)bu_calloc(node_gd->tri_num, sizeof(struct tie_tri_s *), "child[0]->tri_list");
-    child[0]->tri_num = 0;
-
-    child[1]->tri_list = (struct tie_tri_s **)bu_calloc(node_gd->tri_num, sizeof(struct tie_tri_s *), "child[1]->tri_list");
-    child[1]->tri_num = 0;
-
+    if (split == TIE_KDTREE_NO_SPLIT) {
+	if (r.bounds)
+	    bu_free(r.bounds, "tri bounds");
+	return node_gd->tri_num;
+    }
 
     /*
      * Determine if the triangles touch either of the two children nodes,
-     * if it does insert it into them respectively.
+     * large nodes checking their triangles in parallel.
      */
+    r.split = split;
+    r.axis = cmax[0].v[split];
     for (n = 0; n < 2; n++) {
-	cnt[n] = 0;
-
-	VADD2(center[n].v,  cmax[n].v,  cmin[n].v);
-	VSCALE(center[n].v,  center[n].v,  0.5);
-	VSUB2(half_size[n].v,  cmax[n].v,  cmin[n].v);
-	VSCALE(half_size[n].v,  half_size[n].v,  0.5);
-
-	for (i = 0; i < node_gd->tri_num; i++) {
-	    /*
-	     * Check to see if any triangle points are inside of the node before
-	     * spending a lot of cycles on the full blown triangle box overlap
-	     */
-	    for (j = 0; j < 3; j++)
-		if (node_gd->tri_list[i]->data[j].v[0] > cmin[n].v[0] &&
-			node_gd->tri_list[i]->data[j].v[0] < cmax[n].v[0] &&
-			node_gd->tri_list[i]->data[j].v[1] > cmin[n].v[1] &&
-			node_gd->tri_list[i]->data[j].v[1] < cmax[n].v[1] &&
-			node_gd->tri_list[i]->data[j].v[2] > cmin[n].v[2] &&
-			node_gd->tri_list[i]->data[j].v[2] < cmax[n].v[2]) {
-		    j = 4;
-		}
+	r.cmin[n] = cmin[n];
+	r.cmax[n] = cmax[n];
+	VADD2(r.center[n].v,  cmax[n].v,  cmin[n].v);
+	VSCALE(r.center[n].v,  r.center[n].v,  0.5);
+	VSUB2(r.half_size[n].v,  cmax[n].v,  cmin[n].v);
+	VSCALE(r.half_size[n].v,  r.half_size[n].v,  0.5);
+    }
+    r.sides = (uint8_t *)bu_malloc(node_gd->tri_num, "tri sides");
+    if (node_gd->tri_num >= TIE_KDTREE_PAR_MIN)
+	bu_parallel_for(0, node_gd->tri_num, TIE_KDTREE_GRAIN, tie_kdtree_classify, &r);
+    else
+	tie_kdtree_classify(0, node_gd->tri_num, &r);
 
-	    if (j == 5) {
-		child[n]->tri_list[child[n]->tri_num++] = node_gd->tri_list[i];
-		cnt[n]++;
-	    } else
-		if (tie_kdtree_tri_box_overlap(&center[n], &half_size[n], node_gd->tri_list[i]->data)) {
-		    child[n]->tri_list[child[n]->tri_num++] = node_gd->tri_list[i];
-		    cnt[n]++;
-		}
-	}
+    /* Allocate 2 children nodes for the parent node */
+    kids = (struct tie_kdtree_s *)bu_calloc(2, sizeof(struct tie_kdtree_s), "tie_kdtree_build()");
+    node->data = kids;
+    node->b = 0;
 
-	/* Resize Tri List to actual amount of memory used */
-	/* TODO: examine if this is correct. A 0 re-alloc is probably a very bad
-	 * thing. */
-	if ( child[n]->tri_num == 0 ) {
-	    if ( child[n]->tri_list ) {
-		bu_free( child[n]->tri_list, "tri_list");
-		child[n]->tri_list = NULL;
-	    }
-	} else {
-	    child[n]->tri_list = (struct tie_tri_s **)bu_realloc(child[n]->tri_list, sizeof(struct tie_tri_s *)*child[n]->tri_num, "tie_kdtree_build()");
+    for (n = 0; n < 2; n++) {
+	BU_ALLOC(kids[n].data, struct tie_geom_s);
+	child[n] = (struct tie_geom_s *)kids[n].data;
+	child[n]->tri_num = 0;
+	for (i = 0; i < node_gd->tri_num; i++)
+	    if (r.sides[i] & (1 << n))
+		child[n]->tri_num++;
+
+	/* A 0 length allocation is a bad thing, leave empty lists NULL */
+	child[n]->tri_list = NULL;
+	if (child[n]->tri_num) {
+	    unsigned int cnt = 0;
+	    child[n]->tri_list = (struct tie_tri_s **)bu_malloc(sizeof(struct tie_tri_s *) * child[n]->tri_num, "child tri_list");
+	    for (i = 0; i < node_gd->tri_num; i++)
+		if (r.sides[i] & (1 << n))
+		    child[n]->tri_list[cnt++] = node_gd->tri_list[i];
 	}
     }
+    bu_free(r.sides, "tri sides");
+    if (r.bounds)
+	bu_free(r.bounds, "tri bounds");
 
     /*
      * Now that the triangles have been propagated to the appropriate child nodes,
@@ -671,20 +961,35 @@ tie_kdtree_build(struct tie_s *tie, struct tie_kdtree_s *node, unsigned int dept
     bu_free(node_gd->tri_list, "tri_list");
     bu_free(node_gd, "node");
 
-    /* Push each child through the same process. */
+    /*
+     * Push each child through the same process, handing the first to
+     * another thread if there is enough below it to be worth it.
+     */
+    job.tie = tie;
+    job.node = &kids[0];
+    job.depth = depth + 1;
+    VMOVE(job.min, cmin[0].v);
+    VMOVE(job.max, cmax[0].v);
+    job.refs = 0;
+    task = NULL;
+    if (child[0]->tri_num >= TIE_KDTREE_TASK_MIN && child[1]->tri_num >= TIE_KDTREE_TASK_MIN)
+	task = bu_task_submit(tie_kdtree_build_task, &job);
+    else
+	tie_kdtree_build_task(&job);
+
     {
-	    point_t lmin[2], lmax[2];
-	    VMOVE(lmin[0], cmin[0].v);
-	    VMOVE(lmin[1], cmin[1].v);
-	    VMOVE(lmax[0], cmax[0].v);
-	    VMOVE(lmax[1], cmax[1].v);
-    tie_kdtree_build(tie, &((struct tie_kdtree_s *)(node->data))[0], depth+1, lmin[0], lmax[0]);
-    tie_kdtree_build(tie, &((struct tie_kdtree_s *)(node->data))[1], depth+1, lmin[1], lmax[1]);
+	point_t lmin, lmax;
+	VMOVE(lmin, cmin[1].v);
+	VMOVE(lmax, cmax[1].v);
+	refs = tie_kdtree_build(tie, &kids[1], depth+1, lmin, lmax);
     }
+    bu_task_wait(task);
 
     /* Assign the splitting dimension to the node */
     /* If we've come this far then YES, this node DOES have child nodes, MARK it as so. */
     node->b = TIE_SET_HAS_CHILDREN(node->b) + split;
+
+    return refs + job.refs;
 }
 
 /*************************************************************
@@ -752,12 +1057,15 @@ TIE_VAL(tie_kdtree_prep)(struct tie_s *tie)
 
     /* Compute Max Depth to allow the KD-Tree to grow to */
     tie->max_depth = (int)(TIE_KDTREE_DEPTH_K1 * (log(tie->tri_num) / log(2)) + TIE_KDTREE_DEPTH_K2);
+    if (tie->kdmethod == TIE_KDTREE_SAH || tie->kdmethod == TIE_KDTREE_SAH_CLIP)
+	tie->max_depth += TIE_KDTREE_DEPTH_SAH;
+    if (tie->max_depth > TIE_KDTREE_DEPTH_MAX)
+	tie->max_depth = TIE_KDTREE_DEPTH_MAX;
 
-    /* Build the KDTREE */
-    if (!already_built)
-	tie_kdtree_build(tie, tie->kdtree, 0, tie->min, tie->max);
-
+    /* Build the KDTREE, counting the triangle references in its leaves */
     tie->stat = 0;
+    if (!already_built)
+	tie->stat = (int)tie_kdtree_build(tie, tie->kdtree, 0, tie->min, tie->max);
 }
 
 /*
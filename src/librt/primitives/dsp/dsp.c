@@ -3095,7 +3095,7 @@ rt_dsp_free(register struct soltab *stp)
 int
 rt_dsp_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct bg_tess_tol *ttol, const struct bn_tol *UNUSED(tol), const struct bview *UNUSED(info))
 {
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     struct rt_dsp_internal *dsp_ip =
 	(struct rt_dsp_internal *)ip->idb_ptr;
     point_t m_pt;
@@ -3945,13 +3945,13 @@ rt_dsp_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
     }
 
     /* Mark edges as real */
-    (void)nmg_mark_edges_real(&s->l.magic, &RTG.rtg_vlfree);
+    (void)nmg_mark_edges_real(&s->l.magic, rt_vlfree());
 
     /* Compute "geometry" for region and shell */
     nmg_region_a(*r, tol);
 
     /* sanity check */
-    nmg_make_faces_within_tol(s, &RTG.rtg_vlfree, tol);
+    nmg_make_faces_within_tol(s, rt_vlfree(), tol);
 
     return 0;
 }
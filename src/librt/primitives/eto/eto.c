@@ -381,8 +381,7 @@ rt_eto_shot(struct soltab *stp, struct xray *rp, struct application *ap, struct
     vect_t pprime;		/* P' */
     vect_t work;		/* temporary vector */
     bn_poly_t C;		/* The final equation */
-    bn_complex_t val[4];	/* The complex roots */
-    double k[4];		/* The real roots */
+    fastf_t k[BN_MAX_POLY_DEGREE];	/* The real roots */
     int i;
     int j;
     vect_t cor_pprime;	/* new ray origin */
@@ -484,37 +483,22 @@ rt_eto_shot(struct soltab *stp, struct xray *rp, struct application *ap, struct
     C.cf[0] = term;					/* t^4 */
     /* NOTE: End of ERIM based code */
 
-    /* It is known that the equation is 4th order.  Therefore, if the
-     * root finder returns other than 4 roots, error.
+    /* Only real roots indicate an intersection in real space.  If the
+     * imaginary part of a root is zero or sufficiently close, then its
+     * real part is one value of 't' for the intersections.
      */
-    if ((i = rt_poly_roots(&C, val, stp->st_dp->d_namep)) != 4) {
-	if (i > 0) {
-	    bu_log("eto:  rt_poly_roots() 4!=%d\n", i);
-	    bn_pr_roots(stp->st_name, val, i);
-	} else if (i < 0) {
-	    static int reported = 0;
-	    bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
-	    if (!reported) {
-		VPRINT("while shooting from:\t", rp->r_pt);
-		VPRINT("while shooting at:\t", rp->r_dir);
-		bu_log("Additional elliptical torus convergence failure details will be suppressed.\n");
-		reported = 1;
-	    }
+    if ((i = rt_poly_real_roots(&C, k, 0.0001, stp->st_dp->d_namep)) < 0) {
+	static int reported = 0;
+	bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
+	if (!reported) {
+	    VPRINT("while shooting from:\t", rp->r_pt);
+	    VPRINT("while shooting at:\t", rp->r_dir);
+	    bu_log("Additional elliptical torus convergence failure details will be suppressed.\n");
+	    reported = 1;
 	}
 	return 0;		/* MISS */
     }
 
-    /* Only real roots indicate an intersection in real space.
-     *
-     * Look at each root returned; if the imaginary part is zero or
-     * sufficiently close, then use the real part as one value of 't'
-     * for the intersections
-     */
-    for (j = 0, i = 0; j < 4; j++) {
-	if (NEAR_ZERO(val[j].im, 0.0001))
-	    k[i++] = val[j].re;
-    }
-
     /* reverse above translation by adding distance to all 'k' values. */
     for (j = 0; j < i; ++j)
 	k[j] -= cor_proj;
@@ -526,7 +510,8 @@ rt_eto_shot(struct soltab *stp, struct xray *rp, struct application *ap, struct
 
 	default:
 	    bu_log("rt_eto_shot: reduced 4 to %d roots\n", i);
-	    bn_pr_roots(stp->st_name, val, 4);
+	    for (j = 0; j < i; j++)
+		bu_log("\tk[%d] = %g\n", j, k[j]);
 	    return 0;		/* No hit */
 
 	case 2: {
@@ -918,7 +903,7 @@ rt_eto_adaptive_plot(struct bu_list *vhead, struct rt_db_internal *ip, const str
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
 
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     eto = (struct rt_eto_internal *)ip->idb_ptr;
     if (!eto_is_valid(eto)) {
 	return -1;
@@ -1062,7 +1047,7 @@ rt_eto_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct bg_te
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
 
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     tip = (struct rt_eto_internal *)ip->idb_ptr;
     if (!eto_is_valid(tip)) {
 	return -1;
@@ -1398,7 +1398,7 @@ rt_extrude_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct b
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     extrude_ip = (struct rt_extrude_internal *)ip->idb_ptr;
     RT_EXTRUDE_CK_MAGIC(extrude_ip);
 
@@ -2086,7 +2086,7 @@ rt_extrude_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip
     struct bv_vlist *vlp;
 
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     extrude_ip = (struct rt_extrude_internal *)ip->idb_ptr;
     RT_EXTRUDE_CK_MAGIC(extrude_ip);
 
@@ -2216,8 +2216,8 @@ rt_extrude_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip
     }
 
     BU_LIST_INIT(&vhead);
-    if (!BU_LIST_IS_INITIALIZED(&RTG.rtg_vlfree)) {
-	BU_LIST_INIT(&RTG.rtg_vlfree);
+    if (!BU_LIST_IS_INITIALIZED(rt_vlfree())) {
+	BU_LIST_INIT(rt_vlfree());
     }
     for (i = 0; outer_loop && i<(size_t)BU_PTBL_LEN(outer_loop); i++) {
 	void *seg;
@@ -2255,11 +2255,11 @@ rt_extrude_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip
 	    }
 	}
     }
-    BV_FREE_VLIST(&RTG.rtg_vlfree, &vhead);
+    BV_FREE_VLIST(rt_vlfree(), &vhead);
 
     /* make sure face normal is in correct direction */
     bu_free((char *)verts, "verts");
-    if (nmg_calc_face_plane(fu, pl, &RTG.rtg_vlfree)) {
+    if (nmg_calc_face_plane(fu, pl, rt_vlfree())) {
 	bu_log("Failed to calculate face plane for extrusion\n");
 	return -1;
     }
@@ -2347,7 +2347,7 @@ rt_extrude_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip
     }
 
     /* extrude this face */
-    if (nmg_extrude_face(fu, extrude_ip->h, &RTG.rtg_vlfree, tol)) {
+    if (nmg_extrude_face(fu, extrude_ip->h, rt_vlfree(), tol)) {
 	bu_log("Failed to extrude face sketch\n");
 	return -1;
     }
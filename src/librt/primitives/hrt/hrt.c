@@ -428,10 +428,8 @@ rt_hrt_shot(struct soltab *stp, register struct xray *rp, struct application *ap
     bn_poly_t  Acube, S;    /* The sextic equation (of power 6) and A^3 */
     bn_poly_t Zcube, A;     /* Z^3 and  X^2 + 9/4 * Y^2 + Z^2 - 1 */
     bn_poly_t X2_Y2, Z3_X2_Y2;  /* X^2 + 9/80*Y^2 and Z^3*(X^2 + 9/80*Y^2) */
-    bn_complex_t complex[6];    /* The complex roots */
-    double real[6];             /* The real roots */
+    fastf_t real[BN_MAX_POLY_DEGREE];   /* The real roots */
     int i;
-    int j;
 
     /* Translate the ray point */
     (trans)[X] = (rp->r_pt)[X] - (hrt->hrt_V)[X];
@@ -522,36 +520,24 @@ rt_hrt_shot(struct soltab *stp, register struct xray *rp, struct application *ap
     S.cf[5] = Acube.cf[5] - Z3_X2_Y2.cf[4];
     S.cf[6] = Acube.cf[6] - Z3_X2_Y2.cf[5];
 
-    /* It is known that the equation is sextic (of order 6). Therefore, if the
-     * root finder returns other than 6 roots, return an error.
+    /* The equation is sextic (of order 6).  Only real roots indicate
+     * an intersection in real space, so only those (imaginary part
+     * within the distance tolerance) are returned, each one value of
+     * 't' for the intersections.  A negative count means the solver
+     * failed to converge.
      */
-    if ((i = rt_poly_roots(&S, complex, stp->st_dp->d_namep)) != 6) {
-        if (i > 0) {
-            bu_log("hrt:  rt_poly_roots() 6!=%d\n", i);
-            bn_pr_roots(stp->st_name, complex, i);
-        } else if (i < 0) {
-            static int reported = 0;
-            bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
-            if (!reported) {
-                VPRINT("while shooting from:\t", rp->r_pt);
-                VPRINT("while shooting at:\t", rp->r_dir);
-                bu_log("Additional heart convergence failure details will be suppressed.\n");
-                reported = 1;
-            }
+    if ((i = rt_poly_real_roots(&S, real, ap->a_rt_i->rti_tol.dist, stp->st_dp->d_namep)) < 0) {
+        static int reported = 0;
+        bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
+        if (!reported) {
+            VPRINT("while shooting from:\t", rp->r_pt);
+            VPRINT("while shooting at:\t", rp->r_dir);
+            bu_log("Additional heart convergence failure details will be suppressed.\n");
+            reported = 1;
         }
         return 0;               /* MISS */
     }
 
-    /* Only real roots indicate an intersection in real space.
-     *
-     * Look at each root returned; if the imaginary part is zero or
-     * sufficiently close, then use the real part as one value of 't'
-     * for the intersections
-     */
-    for (j = 0, i = 0; j < 6; j++) {
-        if (NEAR_ZERO(complex[j].im, ap->a_rt_i->rti_tol.dist))
-            real[i++] = complex[j].re;
-    }
     /* Here, 'i' is number of points found */
     switch (i) {
         case 0:
@@ -559,7 +545,6 @@ rt_hrt_shot(struct soltab *stp, register struct xray *rp, struct application *ap
 
         default:
             bu_log("rt_hrt_shot: reduced 6 to %d roots\n", i);
-            bn_pr_roots(stp->st_name, complex, 6);
             return 0;           /* No hit */
 
         case 2:
@@ -672,14 +657,16 @@ rt_hrt_vshot(struct soltab **stp, struct xray **rp, struct seg *segp, int n, str
     bn_poly_t A, Acube, Zcube;
     bn_poly_t X2_Y2, Z3_X2_Y2;
     bn_poly_t *S;
-    bn_complex_t (*complex)[6];
-    int num_roots, num_zero;
+    fastf_t (*real)[BN_MAX_POLY_DEGREE];
+    int *num_roots;
+    int j, num_zero;
     register int i;
     fastf_t *cor_proj;
 
     /* Allocate space for polynomials and roots */
     S = (bn_poly_t *)bu_malloc(n * sizeof(bn_poly_t) * 6, "hrt bn_complex_t");
-    complex = (bn_complex_t (*)[6])bu_malloc(n * sizeof(bn_complex_t) * 6, "hrt bn_complex_t");
+    real = (fastf_t (*)[BN_MAX_POLY_DEGREE])bu_malloc(n * sizeof(fastf_t) * BN_MAX_POLY_DEGREE, "hrt real roots");
+    num_roots = (int *)bu_malloc(n * sizeof(int), "hrt num_roots");
     cor_proj = (fastf_t *)bu_malloc(n * sizeof(fastf_t), "hrt_proj");
 
     /* Initialize seg_stp to assume hit (zero will then flag a miss) */
@@ -786,24 +773,20 @@ rt_hrt_vshot(struct soltab **stp, struct xray **rp, struct seg *segp, int n, str
 
     }
     for (i = 0; i < n; i++) {
-	continue;		/* Skip this iteration */
+	if (segp[i].seg_stp == 0)
+	    continue;		/* Skip this iteration */
     /*
-     * It is known that the equation is sextic (of order 6).
-     * Therefore, if the root finder returns other than six roots, Error
+     * The equation is sextic (of order 6).  Only its real roots are
+     * returned; a negative count means the solver failed to converge.
      */
-    if ((num_roots = rt_poly_roots(&(S[i]), &(complex[i][0]), (*stp)->st_dp->d_namep)) != 6) {
-	if (num_roots > 0) {
-	    bu_log("hrt: rt_poly_roots() 6 != %d\n", num_roots);
-	    bn_pr_roots("hrt", complex[i], num_roots);
-	} else if (num_roots < 0) {
-	    static int reported = 0;
-	    bu_log("The root solver failed to converge on a solution for %s\n", stp[i]->st_dp->d_namep);
-	    if (!reported) {
-		VPRINT("while shooting from: \t", rp[i]->r_pt);
-		VPRINT("while shooting at:\t", rp[i]->r_dir);
-		bu_log("Additional heart convergence failure details will be suppressed.\n");
-		reported = 1;
-	    }
+    if ((num_roots[i] = rt_poly_real_roots(&(S[i]), real[i], ap->a_rt_i->rti_tol.dist, (*stp)->st_dp->d_namep)) < 0) {
+	static int reported = 0;
+	bu_log("The root solver failed to converge on a solution for %s\n", stp[i]->st_dp->d_namep);
+	if (!reported) {
+	    VPRINT("while shooting from: \t", rp[i]->r_pt);
+	    VPRINT("while shooting at:\t", rp[i]->r_dir);
+	    bu_log("Additional heart convergence failure details will be suppressed.\n");
+	    reported = 1;
 	}
 	RT_HRT_SEG_MISS(segp[i]);
     }
@@ -815,31 +798,15 @@ rt_hrt_vshot(struct soltab **stp, struct xray **rp, struct seg *segp, int n, str
 
     /* Only real roots indicate an intersection in real space.
      *
-     * Look at each root returned; if the imaginary part is zero or
-     * sufficiently close, then use the real part as one value of 't'
-     * for the intersections
+     * Each real root returned is one value of 't' for the
+     * intersections.
      *
      * Reverse translation by adding distance to all 'real' values
      * Reuse S to hold 'real' values
      */
     num_zero = 0;
-    if (NEAR_ZERO(complex[i][0].im, ap->a_rt_i->rti_tol.dist)) {
-	S[i].cf[num_zero++] = complex[i][0].re - cor_proj[i];
-    }
-    if (NEAR_ZERO(complex[i][1].im, ap->a_rt_i->rti_tol.dist)) {
-	S[i].cf[num_zero++] = complex[i][1].re - cor_proj[i];
-    }
-    if (NEAR_ZERO(complex[i][2].im, ap->a_rt_i->rti_tol.dist)) {
-	S[i].cf[num_zero++] = complex[i][2].re - cor_proj[i];
-    }
-    if (NEAR_ZERO(complex[i][3].im, ap->a_rt_i->rti_tol.dist)) {
-	S[i].cf[num_zero++] = complex[i][3].re - cor_proj[i];
-    }
-    if (NEAR_ZERO(complex[i][4].im, ap->a_rt_i->rti_tol.dist)) {
-	S[i].cf[num_zero++] = complex[i][4].re - cor_proj[i];
-    }
-    if (NEAR_ZERO(complex[i][5].im, ap->a_rt_i->rti_tol.dist)) {
-	S[i].cf[num_zero++] = complex[i][5].re - cor_proj[i];
+    for (j = 0; j < num_roots[i]; j++) {
+	S[i].cf[num_zero++] = real[i][j] - cor_proj[i];
     }
     S[i].dgr = num_zero;
 
@@ -933,7 +900,8 @@ rt_hrt_vshot(struct soltab **stp, struct xray **rp, struct seg *segp, int n, str
 
     /* Free tmp space used */
     bu_free((char *)S, "hrt S");
-    bu_free((char *)complex, "hrt complex");
+    bu_free((char *)real, "hrt real roots");
+    bu_free((char *)num_roots, "hrt num_roots");
     bu_free((char *)cor_proj, "hrt_cor_proj");
 
 }
@@ -1048,7 +1016,7 @@ rt_hrt_24pts(fastf_t *ov, fastf_t *V, fastf_t *A, fastf_t *B)
 int
 rt_hrt_plot(struct bu_list *vhead, struct rt_db_internal *ip,const struct bg_tess_tol *ttol, const struct bn_tol *UNUSED(tol), const struct bview *UNUSED(info))
 {
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     fastf_t c, dtol, mag_h, ntol = M_PI, r1, r2, **ellipses, theta_prev, theta_new;
     int *pts_dbl;
     int nseg; /* The number of line segments in a particular ellipse */
@@ -187,6 +187,7 @@ int
 rt_metaball_prep(struct soltab *stp, struct rt_db_internal *ip, struct rt_i *rtip)
 {
     struct rt_metaball_internal *mb, *nmb;
+    struct metaball_specific *ms;
     struct wdb_metaball_pnt *mbpt, *nmbpt;
     fastf_t minfstr = +INFINITY;
 
@@ -196,7 +197,8 @@ rt_metaball_prep(struct soltab *stp, struct rt_db_internal *ip, struct rt_i *rti
     RT_METABALL_CK_MAGIC(mb);
 
     /* generate a copy of the metaball */
-    BU_ALLOC(nmb, struct rt_metaball_internal);
+    BU_ALLOC(ms, struct metaball_specific);
+    nmb = &ms->mb;
     nmb->magic = RT_METABALL_INTERNAL_MAGIC;
     BU_LIST_INIT(&nmb->metaball_ctrl_head);
     nmb->threshold = mb->threshold;
@@ -228,7 +230,11 @@ rt_metaball_prep(struct soltab *stp, struct rt_db_internal *ip, struct rt_i *rti
     /* generate a bounding box around the sphere...
      * XXX this can be optimized greatly to reduce the BSP presence... */
     if (rt_metaball_bbox(ip, &(stp->st_min), &(stp->st_max), &rtip->rti_tol)) return 1;
-    stp->st_specific = (void *)nmb;
+
+    /* index the control points so shots don't sum them all */
+    ms->index = rt_metaball_index_create(nmb);
+
+    stp->st_specific = (void *)ms;
     return 0;
 }
 
@@ -240,7 +246,7 @@ rt_metaball_print(register const struct soltab *stp)
     struct rt_metaball_internal *mb;
     struct wdb_metaball_pnt *mbpt;
 
-    mb = (struct rt_metaball_internal *)stp->st_specific;
+    mb = &((struct metaball_specific *)stp->st_specific)->mb;
     RT_METABALL_CK_MAGIC(mb);
     for (BU_LIST_FOR(mbpt, wdb_metaball_pnt, &mb->metaball_ctrl_head)) ++metaball_count;
     bu_log("Metaball with %d points and a threshold of %g (%s rendering)\n", metaball_count, mb->threshold, rt_metaball_lookup_type_name(mb->method));
@@ -361,10 +367,51 @@ rt_metaball_find_intersection(point_t *intersect, const struct rt_metaball_inter
 }
 
 
+/* rt_metaball_point_value() compared with the threshold, using the
+ * control point index if there is one */
+static int
+metaball_cmp(const struct metaball_specific *ms, const point_t *p)
+{
+    fastf_t v;
+
+    if (ms->index)
+	return rt_metaball_index_classify(ms->index, *p, 0.0, ms->mb.threshold, 0);
+
+    v = rt_metaball_point_value(p, &ms->mb);
+    return (v > ms->mb.threshold) ? 1 : ((v < ms->mb.threshold) ? -1 : 0);
+}
+
+
+/* rt_metaball_find_intersection() by way of the index */
+static void
+metaball_bisect(point_t *intersect, const struct metaball_specific *ms, const point_t *a, const point_t *b, fastf_t step, const fastf_t finalstep)
+{
+    point_t mid;
+    const point_t *midp = (const point_t *)&mid;
+
+    VADD2(mid, *a, *b);
+    VSCALE(mid, mid, 0.5);
+
+    if (finalstep > step) {
+	VMOVE(*intersect, mid);
+	return;
+    }
+
+    metaball_bisect(intersect, ms, midp, ((metaball_cmp(ms, a) >= 0) == (metaball_cmp(ms, midp) >= 0)) ? b : a, step/2.0, finalstep);
+}
+
+
+/* Limit on the index nodes opened deciding whether a stretch of ray can
+ * be stepped over.  Failing to decide only costs a normal step.
+ */
+#define METABALL_LEAP_OPEN 64
+
+
 int
 rt_metaball_shot(struct soltab *stp, register struct xray *rp, struct application *ap, struct seg *seghead)
 {
-    struct rt_metaball_internal *mb = (struct rt_metaball_internal *)stp->st_specific;
+    struct metaball_specific *ms = (struct metaball_specific *)stp->st_specific;
+    struct rt_metaball_internal *mb = &ms->mb;
     struct seg *segp = NULL;
     int retval = 0;
     fastf_t step, distleft;
@@ -386,7 +433,7 @@ rt_metaball_shot(struct soltab *stp, register struct xray *rp, struct applicatio
     VSCALE(inc, rp->r_dir, step); /* assume it's normalized and we want to creep at step */
 
     /* walk back out of the solid */
-    while (rt_metaball_point_value(cp, mb) >= mb->threshold) {
+    while (metaball_cmp(ms, cp) >= 0) {
 #if SHOOTALGO == 2
 	fhin = -1;
 #endif
@@ -447,18 +494,36 @@ rt_metaball_shot(struct soltab *stp, register struct xray *rp, struct applicatio
     {
 	int mb_stat = 0, segsleft = abs(ap->a_onehit);
 	point_t lastpoint;
+	fastf_t leap = 2.0 * step;
 
 	while (distleft >= 0.0 || mb_stat == 1) {
+	    if (ms->index) {
+		/* Leap over as much of the ray as the index can show is
+		 * entirely outside the surface (or, once in, entirely
+		 * inside it), growing the leap while that works.
+		 */
+		int want = (mb_stat == 1) ? 1 : -1;
+		while (leap > step && rt_metaball_index_classify(ms->index, p, leap, mb->threshold, METABALL_LEAP_OPEN) != want)
+		    leap *= 0.5;
+		if (leap > step) {
+		    VJOIN1(p, p, leap, rp->r_dir);
+		    distleft -= leap;
+		    leap = FMIN(2.0 * leap, stp->st_aradius);
+		    continue;
+		}
+		leap = 2.0 * step;
+	    }
+
 	    /* advance to the next point */
 	    distleft -= step;
 	    VMOVE(lastpoint, p);
 	    VADD2(p, p, inc);
 	    if (mb_stat == 1) {
-		if (rt_metaball_point_value(cp, mb) < mb->threshold) {
+		if (metaball_cmp(ms, cp) < 0) {
 		    point_t intersect, delta;
 		    const point_t *pA = (const point_t *)&lastpoint;
 		    const point_t *pB = (const point_t *)&p;
-		    rt_metaball_find_intersection(&intersect, mb, pA, pB, step, mb->finalstep);
+		    metaball_bisect(&intersect, ms, pA, pB, step, mb->finalstep);
 		    VMOVE(segp->seg_out.hit_point, intersect);
 		    --segsleft;
 		    ++retval;
@@ -470,11 +535,11 @@ rt_metaball_shot(struct soltab *stp, register struct xray *rp, struct applicatio
 			return retval;
 		}
 	    } else {
-		if (rt_metaball_point_value(cp, mb) > mb->threshold) {
+		if (metaball_cmp(ms, cp) > 0) {
 		    point_t intersect, delta;
 		    const point_t *pA = (const point_t *)&lastpoint;
 		    const point_t *pB = (const point_t *)&p;
-		    rt_metaball_find_intersection(&intersect, mb, pA, pB, step, mb->finalstep);
+		    metaball_bisect(&intersect, ms, pA, pB, step, mb->finalstep);
 		    RT_GET_SEG(segp, ap->a_resource);
 		    segp->seg_stp = stp;
 		    --segsleft;
@@ -542,7 +607,7 @@ void
 rt_metaball_norm(register struct hit *hitp, struct soltab *stp, register struct xray *rp)
 {
     if (rp) RT_CK_RAY(rp);	/* unused. */
-    rt_metaball_norm_internal(&(hitp->hit_normal), &(hitp->hit_point), (struct rt_metaball_internal *)(stp->st_specific));
+    rt_metaball_norm_internal(&(hitp->hit_normal), &(hitp->hit_point), &((struct metaball_specific *)stp->st_specific)->mb);
     return;
 }
 
@@ -553,7 +618,7 @@ rt_metaball_norm(register struct hit *hitp, struct soltab *stp, register struct
 void
 rt_metaball_curve(struct curvature *cvp, struct hit *hitp, struct soltab *stp)
 {
-    struct rt_metaball_internal *metaball = (struct rt_metaball_internal *)stp->st_specific;
+    struct metaball_specific *metaball = (struct metaball_specific *)stp->st_specific;
 
     if (!metaball || !cvp) return;
     if (hitp) RT_CK_HIT(hitp);
@@ -573,7 +638,7 @@ rt_metaball_curve(struct curvature *cvp, struct hit *hitp, struct soltab *stp)
 void
 rt_metaball_uv(struct application *ap, struct soltab *stp, struct hit *hitp, struct uvcoord *uvp)
 {
-    struct rt_metaball_internal *metaball = (struct rt_metaball_internal *)stp->st_specific;
+    struct metaball_specific *metaball = (struct metaball_specific *)stp->st_specific;
     vect_t work, pprime;
     fastf_t r;
 
@@ -611,9 +676,15 @@ rt_metaball_uv(struct application *ap, struct soltab *stp, struct hit *hitp, str
 void
 rt_metaball_free(register struct soltab *stp)
 {
-    struct rt_metaball_internal *metaball = (struct rt_metaball_internal *)stp->st_specific;
+    struct metaball_specific *ms = (struct metaball_specific *)stp->st_specific;
+    struct wdb_metaball_pnt *mbpt;
 
-    bu_free((char *)metaball, "rt_metaball_internal");
+    while (BU_LIST_WHILE(mbpt, wdb_metaball_pnt, &ms->mb.metaball_ctrl_head)) {
+	BU_LIST_DEQUEUE(&(mbpt->l));
+	bu_free(mbpt, "wdb_metaball_pnt");
+    }
+    rt_metaball_index_destroy(ms->index);
+    bu_free((char *)ms, "metaball_specific");
 }
 
 
@@ -652,7 +723,7 @@ rt_metaball_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     mb = (struct rt_metaball_internal *)ip->idb_ptr;
     RT_METABALL_CK_MAGIC(mb);
     rad = rt_metaball_get_bounding_sphere(&bsc, mb->threshold, mb);
@@ -26,6 +26,27 @@ fastf_t rt_metaball_get_bounding_sphere(point_t *center, fastf_t threshold, stru
 int rt_metaball_find_intersection(point_t *intersect, const struct rt_metaball_internal *mb, const point_t *a, const point_t *b, fastf_t step, const fastf_t finalstep);
 void rt_metaball_norm_internal(vect_t *n, point_t *p, struct rt_metaball_internal *mb);
 
+/* spatial index over the control points, see metaball_index.c */
+struct metaball_index;
+
+/* NULL if the method isn't indexed or there are no points */
+struct metaball_index *rt_metaball_index_create(const struct rt_metaball_internal *mb);
+void rt_metaball_index_destroy(struct metaball_index *mbi);
+
+/* Classify the field over the ball of the given radius around p (just
+ * p if radius is zero) against threshold: 1 if it is above threshold
+ * throughout, -1 if below throughout, and 0 if neither (or, for a
+ * single point, exactly at the threshold).  If max_open is nonzero,
+ * give up and return 0 after opening that many index nodes.
+ */
+int rt_metaball_index_classify(const struct metaball_index *mbi, const point_t p, fastf_t radius, fastf_t threshold, size_t max_open);
+
+/* stp->st_specific for a prepped metaball */
+struct metaball_specific {
+    struct rt_metaball_internal mb;
+    struct metaball_index *index;
+};
+
 #endif /* LIBRT_PRIMITIVES_METABALL_METABALL_H */
 
 /*
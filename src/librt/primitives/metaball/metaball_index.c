@@ -0,0 +1,429 @@
+/*                  M E T A B A L L _ I N D E X . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @addtogroup primitives */
+/** @{ */
+/** @file primitives/metaball/metaball_index.c
+ *
+ * Bounding volume hierarchy over the control points of a metaball,
+ * used to decide which side of the threshold the field is on without
+ * summing every point.
+ *
+ * Neither the isopotential nor the blob field ever falls to zero, so
+ * there is no radius beyond which a control point can be ignored.
+ * Instead each node of the hierarchy keeps enough about its points to
+ * bound their total contribution given the nearest and furthest they
+ * can be from the query, and classification refines the nearest nodes
+ * first until those bounds settle the answer.  Distant clusters are
+ * rarely opened, and the answer is the same one the full sum gives.
+ *
+ * The same bounds hold over a ball around the query point, which lets
+ * the shot routine step over space the surface provably can't be in.
+ *
+ */
+/** @} */
+
+#include "common.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "vmath.h"
+#include "bu/malloc.h"
+#include "rt/geom.h"
+
+#include "metaball.h"
+
+/* maximum number of control points in a leaf */
+#define MBI_LEAF_SIZE 8
+
+/* classification stack depth, ample for any balanced tree */
+#define MBI_STACK_SIZE 256
+
+struct mbi_node {
+    point_t min;
+    point_t max;
+    size_t first;		/* first point under this node */
+    size_t cnt;			/* number of points under this node */
+    size_t right;		/* right child, left child is the next node */
+    fastf_t pos;		/* iso: sum of the positive strengths, blob: sum of exp(goo) */
+    fastf_t neg;		/* iso: sum of the negative strengths */
+    fastf_t kmin, kmax;		/* blob: range of the falloff rates */
+};
+
+struct metaball_index {
+    int method;
+    size_t npts;
+    point_t *coord;
+    fastf_t *s;			/* iso: |f|*f, blob: goo */
+    fastf_t *k;			/* blob: goo/f^2 */
+    size_t nnodes;
+    struct mbi_node *nodes;
+};
+
+struct mbi_sort {
+    fastf_t key;
+    size_t idx;
+};
+
+
+static int
+mbi_sort_cmp(const void *a, const void *b)
+{
+    fastf_t ka = ((const struct mbi_sort *)a)->key;
+    fastf_t kb = ((const struct mbi_sort *)b)->key;
+    return (ka < kb) ? -1 : (ka > kb);
+}
+
+
+/* bounds of the contribution of one control point anywhere between
+ * distances a and b of it */
+static void
+mbi_point_bounds(const struct metaball_index *mbi, size_t i, fastf_t a, fastf_t b, fastf_t *lo, fastf_t *hi)
+{
+    fastf_t s = mbi->s[i];
+
+    if (mbi->method == METABALL_ISOPOTENTIAL) {
+	fastf_t fa = (a > 0.0) ? s / (a*a) : ((s > 0.0) ? INFINITY : -INFINITY);
+	fastf_t fb = s / (b*b);
+	if (s > 0.0) {
+	    *lo = fb;
+	    *hi = fa;
+	} else if (s < 0.0) {
+	    *lo = fa;
+	    *hi = fb;
+	} else {
+	    *lo = *hi = 0.0;
+	}
+    } else {
+	fastf_t k = mbi->k[i];
+	fastf_t fa = exp(s - k*a*a);
+	fastf_t fb = exp(s - k*b*b);
+	*lo = FMIN(fa, fb);
+	*hi = FMAX(fa, fb);
+    }
+}
+
+
+/* bounds of the total contribution of a node's control points
+ * anywhere between distances a and b of the node's box */
+static void
+mbi_node_bounds(const struct metaball_index *mbi, const struct mbi_node *n, fastf_t a, fastf_t b, fastf_t *lo, fastf_t *hi)
+{
+    if (mbi->method == METABALL_ISOPOTENTIAL) {
+	*lo = *hi = 0.0;
+	if (n->pos > 0.0) {
+	    *lo += n->pos / (b*b);
+	    *hi += (a > 0.0) ? n->pos / (a*a) : INFINITY;
+	}
+	if (n->neg < 0.0) {
+	    *lo += (a > 0.0) ? n->neg / (a*a) : -INFINITY;
+	    *hi += n->neg / (b*b);
+	}
+    } else {
+	/* exp(-k*d^2) is extreme at the corners of the k, d^2 range */
+	fastf_t p1 = n->kmin*a*a, p2 = n->kmin*b*b, p3 = n->kmax*a*a, p4 = n->kmax*b*b;
+	fastf_t pmin = FMIN(FMIN(p1, p2), FMIN(p3, p4));
+	fastf_t pmax = FMAX(FMAX(p1, p2), FMAX(p3, p4));
+	*lo = n->pos * exp(-pmax);
+	*hi = n->pos * exp(-pmin);
+    }
+}
+
+
+/* nearest and furthest distances from p to a box, widened by radius */
+static void
+mbi_box_range(const struct mbi_node *n, const point_t p, fastf_t radius, fastf_t *a, fastf_t *b)
+{
+    fastf_t near2 = 0.0, far2 = 0.0;
+    int i;
+
+    for (i = 0; i < 3; i++) {
+	fastf_t d1 = n->min[i] - p[i];
+	fastf_t d2 = p[i] - n->max[i];
+	fastf_t dn = FMAX(d1, d2);
+	fastf_t df = FMAX(fabs(d1), fabs(d2));
+	if (dn > 0.0)
+	    near2 += dn*dn;
+	far2 += df*df;
+    }
+    *a = sqrt(near2) - radius;
+    if (*a < 0.0)
+	*a = 0.0;
+    *b = sqrt(far2) + radius;
+}
+
+
+static size_t
+mbi_build(struct metaball_index *mbi, struct mbi_sort *srt, point_t *coord, fastf_t *s, fastf_t *k, size_t first, size_t cnt)
+{
+    size_t n = mbi->nnodes++;
+    struct mbi_node *node = &mbi->nodes[n];
+    size_t i;
+
+    VSETALL(node->min, INFINITY);
+    VSETALL(node->max, -INFINITY);
+    node->pos = node->neg = 0.0;
+    node->kmin = INFINITY;
+    node->kmax = -INFINITY;
+    for (i = first; i < first + cnt; i++) {
+	VMINMAX(node->min, node->max, mbi->coord[i]);
+	if (mbi->method == METABALL_ISOPOTENTIAL) {
+	    if (mbi->s[i] > 0.0)
+		node->pos += mbi->s[i];
+	    else
+		node->neg += mbi->s[i];
+	} else {
+	    node->pos += exp(mbi->s[i]);
+	    V_MIN(node->kmin, mbi->k[i]);
+	    V_MAX(node->kmax, mbi->k[i]);
+	}
+    }
+    node->first = first;
+    node->cnt = cnt;
+    node->right = 0;
+
+    if (cnt > MBI_LEAF_SIZE) {
+	vect_t ext;
+	int axis;
+	size_t half = cnt / 2;
+
+	/* median split along the longest axis */
+	VSUB2(ext, node->max, node->min);
+	axis = (ext[X] > ext[Y]) ? ((ext[X] > ext[Z]) ? X : Z) : ((ext[Y] > ext[Z]) ? Y : Z);
+	for (i = 0; i < cnt; i++) {
+	    srt[i].key = mbi->coord[first + i][axis];
+	    srt[i].idx = first + i;
+	}
+	qsort(srt, cnt, sizeof(struct mbi_sort), mbi_sort_cmp);
+	for (i = 0; i < cnt; i++) {
+	    VMOVE(coord[i], mbi->coord[srt[i].idx]);
+	    s[i] = mbi->s[srt[i].idx];
+	    if (k)
+		k[i] = mbi->k[srt[i].idx];
+	}
+	for (i = 0; i < cnt; i++) {
+	    VMOVE(mbi->coord[first + i], coord[i]);
+	    mbi->s[first + i] = s[i];
+	    if (k)
+		mbi->k[first + i] = k[i];
+	}
+
+	(void)mbi_build(mbi, srt, coord, s, k, first, half);
+	/* mbi->nodes is not reallocated during the build */
+	mbi->nodes[n].right = mbi_build(mbi, srt, coord, s, k, first + half, cnt - half);
+    }
+
+    return n;
+}
+
+
+struct metaball_index *
+rt_metaball_index_create(const struct rt_metaball_internal *mb)
+{
+    struct metaball_index *mbi;
+    struct wdb_metaball_pnt *mbpt;
+    struct mbi_sort *srt;
+    point_t *coord;
+    fastf_t *s, *k = NULL;
+    size_t i = 0;
+
+    RT_METABALL_CK_MAGIC(mb);
+
+    if (mb->method != METABALL_ISOPOTENTIAL && mb->method != METABALL_BLOB)
+	return NULL;
+
+    BU_ALLOC(mbi, struct metaball_index);
+    mbi->method = mb->method;
+    mbi->npts = 0;
+    for (BU_LIST_FOR(mbpt, wdb_metaball_pnt, &mb->metaball_ctrl_head))
+	mbi->npts++;
+    if (!mbi->npts) {
+	bu_free(mbi, "metaball index");
+	return NULL;
+    }
+
+    mbi->coord = (point_t *)bu_calloc(mbi->npts, sizeof(point_t), "metaball index coord");
+    mbi->s = (fastf_t *)bu_calloc(mbi->npts, sizeof(fastf_t), "metaball index s");
+    mbi->k = NULL;
+    if (mbi->method == METABALL_BLOB)
+	mbi->k = (fastf_t *)bu_calloc(mbi->npts, sizeof(fastf_t), "metaball index k");
+
+    for (BU_LIST_FOR(mbpt, wdb_metaball_pnt, &mb->metaball_ctrl_head)) {
+	VMOVE(mbi->coord[i], mbpt->coord);
+	if (mbi->method == METABALL_ISOPOTENTIAL) {
+	    mbi->s[i] = fabs(mbpt->fldstr) * mbpt->fldstr;
+	} else {
+	    mbi->s[i] = mbpt->sweat;
+	    mbi->k[i] = mbpt->sweat / (mbpt->fldstr * mbpt->fldstr);
+	}
+	i++;
+    }
+
+    /* with leaves of at least half the maximum size there are fewer
+     * nodes than points */
+    mbi->nnodes = 0;
+    mbi->nodes = (struct mbi_node *)bu_calloc(mbi->npts + 1, sizeof(struct mbi_node), "metaball index nodes");
+
+    srt = (struct mbi_sort *)bu_calloc(mbi->npts, sizeof(struct mbi_sort), "metaball index sort");
+    coord = (point_t *)bu_calloc(mbi->npts, sizeof(point_t), "metaball index sort coord");
+    s = (fastf_t *)bu_calloc(mbi->npts, sizeof(fastf_t), "metaball index sort s");
+    if (mbi->k)
+	k = (fastf_t *)bu_calloc(mbi->npts, sizeof(fastf_t), "metaball index sort k");
+    (void)mbi_build(mbi, srt, coord, s, k, 0, mbi->npts);
+    bu_free(srt, "metaball index sort");
+    bu_free(coord, "metaball index sort coord");
+    bu_free(s, "metaball index sort s");
+    if (k)
+	bu_free(k, "metaball index sort k");
+
+    return mbi;
+}
+
+
+void
+rt_metaball_index_destroy(struct metaball_index *mbi)
+{
+    if (!mbi)
+	return;
+    bu_free(mbi->coord, "metaball index coord");
+    bu_free(mbi->s, "metaball index s");
+    if (mbi->k)
+	bu_free(mbi->k, "metaball index k");
+    bu_free(mbi->nodes, "metaball index nodes");
+    bu_free(mbi, "metaball index");
+}
+
+
+int
+rt_metaball_index_classify(const struct metaball_index *mbi, const point_t p, fastf_t radius, fastf_t threshold, size_t max_open)
+{
+    struct {
+	size_t n;
+	fastf_t lo, hi;
+    } stack[MBI_STACK_SIZE];
+    int sp = 0;
+    size_t opened = 0;
+
+    /* contributions settled so far (exact unless radius is nonzero) */
+    fastf_t done_lo = 0.0, done_hi = 0.0;
+
+    /* bounds still pending on the stack, with infinite bounds counted
+     * separately so the running sums stay finite */
+    fastf_t pend_lo = 0.0, pend_hi = 0.0;
+    int inf_lo = 0, inf_hi = 0;
+
+    /* magnitude of everything summed, for the rounding slack */
+    fastf_t mag = 0.0;
+
+#define MBI_PUSH(_n) { \
+	fastf_t _a, _b; \
+	stack[sp].n = (_n); \
+	mbi_box_range(&mbi->nodes[_n], p, radius, &_a, &_b); \
+	mbi_node_bounds(mbi, &mbi->nodes[_n], _a, _b, &stack[sp].lo, &stack[sp].hi); \
+	if (isinf(stack[sp].lo)) inf_lo++; else { pend_lo += stack[sp].lo; mag += fabs(stack[sp].lo); } \
+	if (isinf(stack[sp].hi)) inf_hi++; else { pend_hi += stack[sp].hi; mag += fabs(stack[sp].hi); } \
+	sp++; }
+
+    MBI_PUSH(0);
+
+    while (sp) {
+	fastf_t slack = 4.0 * DBL_EPSILON * mag;
+	size_t n, l, r, i;
+
+	if (!inf_lo && done_lo + pend_lo - slack > threshold)
+	    return 1;
+	if (!inf_hi && done_hi + pend_hi + slack < threshold)
+	    return -1;
+	if (max_open && opened >= max_open)
+	    return 0;
+
+	/* open the most recently pushed (and so nearest) node */
+	sp--;
+	n = stack[sp].n;
+	if (isinf(stack[sp].lo)) inf_lo--; else pend_lo -= stack[sp].lo;
+	if (isinf(stack[sp].hi)) inf_hi--; else pend_hi -= stack[sp].hi;
+	opened++;
+
+	if (mbi->nodes[n].cnt <= MBI_LEAF_SIZE || sp + 2 > MBI_STACK_SIZE) {
+	    const struct mbi_node *node = &mbi->nodes[n];
+	    for (i = node->first; i < node->first + node->cnt; i++) {
+		fastf_t lo, hi;
+		if (ZERO(radius)) {
+		    vect_t v;
+		    VSUB2(v, mbi->coord[i], p);
+		    if (mbi->method == METABALL_ISOPOTENTIAL)
+			lo = hi = mbi->s[i] / MAGSQ(v);
+		    else
+			lo = hi = exp(mbi->s[i] - mbi->k[i] * MAGSQ(v));
+		} else {
+		    vect_t v;
+		    fastf_t d, a;
+		    VSUB2(v, mbi->coord[i], p);
+		    d = MAGNITUDE(v);
+		    a = (d > radius) ? d - radius : 0.0;
+		    mbi_point_bounds(mbi, i, a, d + radius, &lo, &hi);
+		}
+		done_lo += lo;
+		done_hi += hi;
+		mag += fabs(lo) + fabs(hi);
+	    }
+	    continue;
+	}
+
+	/* push the further child first, so the nearer is opened next */
+	l = n + 1;
+	r = mbi->nodes[n].right;
+	{
+	    point_t cl, cr;
+	    vect_t vl, vr;
+	    VADD2SCALE(cl, mbi->nodes[l].min, mbi->nodes[l].max, 0.5);
+	    VADD2SCALE(cr, mbi->nodes[r].min, mbi->nodes[r].max, 0.5);
+	    VSUB2(vl, cl, p);
+	    VSUB2(vr, cr, p);
+	    if (MAGSQ(vl) < MAGSQ(vr)) {
+		MBI_PUSH(r);
+		MBI_PUSH(l);
+	    } else {
+		MBI_PUSH(l);
+		MBI_PUSH(r);
+	    }
+	}
+    }
+#undef MBI_PUSH
+
+    /* everything is summed */
+    if (done_lo > threshold)
+	return 1;
+    if (done_hi < threshold)
+	return -1;
+    return 0;
+}
+
+
+/*
+ * Local Variables:
+ * mode: C
+ * tab-width: 8
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
@@ -162,10 +162,10 @@ rt_metaball_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *i
 		}
 	    }
 
-    nmg_mark_edges_real(&s->l.magic, &RTG.rtg_vlfree);
+    nmg_mark_edges_real(&s->l.magic, rt_vlfree());
     nmg_region_a(*r, tol);
 
-    nmg_model_fuse(m, &RTG.rtg_vlfree, tol);
+    nmg_model_fuse(m, rt_vlfree(), tol);
 
     rt_get_timer(&times, NULL);
     bu_log("metaball tessellate (%d triangles): %s\n", numtri, bu_vls_addr(&times));
@@ -121,6 +121,8 @@ int
 rt_nmg_prep(struct soltab *stp, struct rt_db_internal *ip, struct rt_i *rtip)
 {
     struct model *m;
+    struct nmgregion *r;
+    struct shell *s;
     struct nmg_specific *nmg_s;
     vect_t work;
 
@@ -146,6 +148,12 @@ rt_nmg_prep(struct soltab *stp, struct rt_db_internal *ip, struct rt_i *rtip)
      */
     nmg_s->manifolds = nmg_manifolds(m);
 
+    /* build the shell face hierarchies now, shots only read them */
+    for (BU_LIST_FOR(r, nmgregion, &m->r_hd)) {
+	for (BU_LIST_FOR(s, shell, &r->s_hd))
+	    nmg_shell_bvh(s);
+    }
+
     return 0;
 }
 
@@ -1382,10 +1390,10 @@ rt_nmg_shot(struct soltab *stp, struct xray *rp, struct application *ap, struct
     rd.magic = NMG_RAY_DATA_MAGIC;
 
     /* intersect the ray with the geometry (sets surfno) */
-    nmg_isect_ray_model((struct nmg_ray_data *)&rd,&RTG.rtg_vlfree);
+    nmg_isect_ray_model((struct nmg_ray_data *)&rd,rt_vlfree());
 
     /* build the sebgent lists */
-    status = nmg_ray_segs(&rd,&RTG.rtg_vlfree);
+    status = nmg_ray_segs(&rd,rt_vlfree());
 
     /* free the hitmiss table */
     bu_free((char *)rd.hitmiss, "free nmg geom hit list");
@@ -1469,7 +1477,7 @@ rt_nmg_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct bg_te
     m = (struct model *)ip->idb_ptr;
     NMG_CK_MODEL(m);
 
-    nmg_m_to_vlist(vhead, m, 0, &RTG.rtg_vlfree);
+    nmg_m_to_vlist(vhead, m, 0, rt_vlfree());
 
     return 0;
 }
@@ -1741,7 +1749,7 @@ rt_nmg_get(struct bu_vls *logstr, const struct rt_db_internal *intern, const cha
     if (attr == (char *)NULL) {
 	bu_vls_strcpy(logstr, "nmg");
 	bu_ptbl_init(&verts, 256, "nmg verts");
-	nmg_vertex_tabulate(&verts, &m->magic, &RTG.rtg_vlfree);
+	nmg_vertex_tabulate(&verts, &m->magic, rt_vlfree());
 
 	/* first list all the vertices */
 	bu_vls_strcat(logstr, " V {");
@@ -1807,7 +1815,7 @@ rt_nmg_get(struct bu_vls *logstr, const struct rt_db_internal *intern, const cha
 	/* list of vertices */
 
 	bu_ptbl_init(&verts, 256, "nmg verts");
-	nmg_vertex_tabulate(&verts, &m->magic, &RTG.rtg_vlfree);
+	nmg_vertex_tabulate(&verts, &m->magic, rt_vlfree());
 	for (i=0; i<BU_PTBL_LEN(&verts); i++) {
 	    v = (struct vertex *) BU_PTBL_GET(&verts, i);
 	    NMG_CK_VERTEX(v);
@@ -1963,7 +1971,7 @@ rt_nmg_adjust(struct bu_vls *logstr, struct rt_db_internal *intern, int argc, co
 	for (BU_LIST_FOR (fu, faceuse, &s->fu_hd)) {
 	    if (fu->orientation != OT_SAME)
 		continue;
-	    nmg_calc_face_g(fu,&RTG.rtg_vlfree);
+	    nmg_calc_face_g(fu,rt_vlfree());
 	}
     }
 
@@ -2023,7 +2031,7 @@ rt_nmg_faces_area(struct poly_face* faces, struct shell* s)
     size_t *npts;
     point_t **tmp_pts;
     plane_t *eqs;
-    nmg_face_tabulate(&nmg_faces, &s->l.magic, &RTG.rtg_vlfree);
+    nmg_face_tabulate(&nmg_faces, &s->l.magic, rt_vlfree());
     num_faces = BU_PTBL_LEN(&nmg_faces);
     tmp_pts = (point_t **)bu_calloc(num_faces, sizeof(point_t *), "rt_nmg_faces_area: tmp_pts");
     npts = (size_t *)bu_calloc(num_faces, sizeof(size_t), "rt_nmg_faces_area: npts");
@@ -2066,7 +2074,7 @@ rt_nmg_surf_area(fastf_t *area, const struct rt_db_internal *ip)
 	    struct poly_face *faces;
 
 	    /*get faces of this shell*/
-	    nmg_face_tabulate(&nmg_faces, &s->l.magic, &RTG.rtg_vlfree);
+	    nmg_face_tabulate(&nmg_faces, &s->l.magic, rt_vlfree());
 	    num_faces = BU_PTBL_LEN(&nmg_faces);
 	    faces = (struct poly_face *)bu_calloc(num_faces, sizeof(struct poly_face), "rt_nmg_surf_area: faces");
 
@@ -2108,7 +2116,7 @@ rt_nmg_centroid(point_t *cent, const struct rt_db_internal *ip)
     s = BU_LIST_FIRST(shell, &r->s_hd);
 
     /*get faces*/
-    nmg_face_tabulate(&nmg_faces, &s->l.magic, &RTG.rtg_vlfree);
+    nmg_face_tabulate(&nmg_faces, &s->l.magic, rt_vlfree());
     num_faces = BU_PTBL_LEN(&nmg_faces);
 
     /* If we have no faces, there's nothing to do */
@@ -2173,7 +2181,7 @@ rt_nmg_volume(fastf_t *volume, const struct rt_db_internal *ip)
 	    struct poly_face *faces;
 
 	    /*get faces of this shell*/
-	    nmg_face_tabulate(&nmg_faces, &s->l.magic, &RTG.rtg_vlfree);
+	    nmg_face_tabulate(&nmg_faces, &s->l.magic, rt_vlfree());
 	    num_faces = BU_PTBL_LEN(&nmg_faces);
 	    faces = (struct poly_face *)bu_calloc(num_faces, sizeof(struct poly_face), "rt_nmg_volume: faces");
 
@@ -2765,7 +2773,7 @@ nmg_to_arb(const struct model *m, struct rt_arb_internal *arb_int)
     if (BU_LIST_NEXT_NOT_HEAD(&s->l, &r->s_hd))
 	return 0;
 
-    switch (Shell_is_arb(s, &tab, &RTG.rtg_vlfree)) {
+    switch (Shell_is_arb(s, &tab, rt_vlfree())) {
 	case 0:
 	    ret_val = 0;
 	    break;
@@ -89,7 +89,7 @@ rt_nmg_mirror(struct rt_db_internal *ip, register const plane_t plane)
     mirmat[3 + Z*4] += mirror_pt[Z] * mirror_dir[Z];
 
     /* move every vertex */
-    nmg_vertex_tabulate(&table, &nmg->magic, &RTG.rtg_vlfree);
+    nmg_vertex_tabulate(&table, &nmg->magic, rt_vlfree());
     for (i=0; i<BU_PTBL_LEN(&table); i++) {
 	point_t pt;
 
@@ -102,7 +102,7 @@ rt_nmg_mirror(struct rt_db_internal *ip, register const plane_t plane)
 
     bu_ptbl_reset(&table);
 
-    nmg_face_tabulate(&table, &nmg->magic, &RTG.rtg_vlfree);
+    nmg_face_tabulate(&table, &nmg->magic, rt_vlfree());
     for (i=0; i<BU_PTBL_LEN(&table); i++) {
 	struct face *f;
 
@@ -143,7 +143,7 @@ rt_nmg_mirror(struct rt_db_internal *ip, register const plane_t plane)
 	    return 2;
 	}
 
-	if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+	if (nmg_calc_face_g(fu,rt_vlfree())) {
 	    bu_log("ERROR: Unable to calculate NMG faces for mirroring\n");
 	    bu_ptbl_free(&table);
 	    return 3;
@@ -105,6 +105,33 @@ struct bend_pipe {
 };
 
 
+/* Node of the bounding volume hierarchy over a pipe's elements.  The
+ * hierarchy splits the element sequence in half at each level rather
+ * than sorting spatially - consecutive elements of a pipe are already
+ * neighbors - so the leaves cover ascending runs of elements and a
+ * depth first walk visits them in pipe order.  Nodes are stored depth
+ * first, with skip giving the index of the next node outside this
+ * one's subtree.
+ */
+struct pipe_bvh_node {
+    point_t min;
+    point_t max;
+    size_t first;		/* first element index, leaves only */
+    size_t cnt;			/* number of elements, zero for interior nodes */
+    size_t skip;
+};
+
+
+/* stp->st_specific for a prepped pipe */
+struct pipe_specific {
+    struct bu_list head;		/* list of id_pipe elements */
+    size_t nsegs;
+    struct id_pipe **segs;		/* the elements in list order */
+    size_t nnodes;
+    struct pipe_bvh_node *nodes;
+};
+
+
 /* two orthogonal unit vectors that define an orientation */
 struct pipe_orientation {
     vect_t v1;
@@ -156,6 +183,8 @@ struct pipe_bend {
 
 #define RT_PIPE_MAXHITS 128
 
+#define PIPE_BVH_LEAF_SIZE 4	/* maximum number of elements in a BVH leaf */
+
 static fastf_t
 pipe_seg_bend_angle(const struct pipe_segment *seg)
 {
@@ -648,15 +677,103 @@ pipe_elements_free(struct bu_list *head)
 	while (BU_LIST_WHILE(p, id_pipe, head)) {
 	    BU_LIST_DEQUEUE(&(p->l));
 	    if (p->pipe_is_bend) {
-		BU_PUT(p, struct lin_pipe);
-	    } else {
 		BU_PUT(p, struct bend_pipe);
+	    } else {
+		BU_PUT(p, struct lin_pipe);
 	    }
 	}
     }
 }
 
 
+static void
+pipe_element_bounds(const struct id_pipe *p, point_t min, point_t max)
+{
+    if (p->pipe_is_bend) {
+	const struct bend_pipe *bp = (const struct bend_pipe *)p;
+	fastf_t r = sqrt(bp->bend_bound_radius_sq);
+	VSETALL(min, -r);
+	VSETALL(max, r);
+	VADD2(min, min, bp->bend_bound_center);
+	VADD2(max, max, bp->bend_bound_center);
+    } else {
+	const struct lin_pipe *lp = (const struct lin_pipe *)p;
+	VMOVE(min, lp->pipe_min);
+	VMOVE(max, lp->pipe_max);
+    }
+}
+
+
+static size_t
+pipe_bvh_build(struct pipe_specific *ps, size_t first, size_t cnt)
+{
+    size_t n = ps->nnodes++;
+    struct pipe_bvh_node *node = &ps->nodes[n];
+    size_t i;
+
+    VSETALL(node->min, INFINITY);
+    VSETALL(node->max, -INFINITY);
+
+    if (cnt <= PIPE_BVH_LEAF_SIZE) {
+	for (i = first; i < first + cnt; i++) {
+	    point_t emin, emax;
+	    pipe_element_bounds(ps->segs[i], emin, emax);
+	    VMIN(node->min, emin);
+	    VMAX(node->max, emax);
+	}
+	node->first = first;
+	node->cnt = cnt;
+    } else {
+	size_t l = pipe_bvh_build(ps, first, cnt / 2);
+	size_t r = pipe_bvh_build(ps, first + cnt / 2, cnt - cnt / 2);
+	/* ps->nodes is not reallocated during the build */
+	VMOVE(node->min, ps->nodes[l].min);
+	VMOVE(node->max, ps->nodes[l].max);
+	VMIN(node->min, ps->nodes[r].min);
+	VMAX(node->max, ps->nodes[r].max);
+	node->first = first;
+	node->cnt = 0;
+    }
+    node->skip = ps->nnodes;
+
+    return n;
+}
+
+
+/**
+ * Index the pipe elements and build the hierarchy rt_pipe_shot() walks
+ * to find the elements a ray can hit, so long pipes don't cost every
+ * ray a test against every element.
+ */
+static void
+pipe_bvh_create(struct pipe_specific *ps)
+{
+    struct id_pipe *p;
+    size_t i = 0;
+
+    ps->nsegs = 0;
+    for (BU_LIST_FOR(p, id_pipe, &ps->head)) {
+	ps->nsegs++;
+    }
+
+    ps->nnodes = 0;
+    ps->segs = NULL;
+    ps->nodes = NULL;
+    if (!ps->nsegs) {
+	return;
+    }
+
+    ps->segs = (struct id_pipe **)bu_calloc(ps->nsegs, sizeof(struct id_pipe *), "pipe segs");
+    for (BU_LIST_FOR(p, id_pipe, &ps->head)) {
+	ps->segs[i++] = p;
+    }
+
+    /* a binary tree over nsegs leaves at most would have 2*nsegs-1 nodes */
+    ps->nodes = (struct pipe_bvh_node *)bu_calloc(2 * ps->nsegs, sizeof(struct pipe_bvh_node), "pipe bvh");
+    (void)pipe_bvh_build(ps, 0, ps->nsegs);
+}
+
+
 /**
  * Calculate a bounding RPP for a pipe
  */
@@ -682,25 +799,26 @@ rt_pipe_bbox(
  * !0 if there is an error in the description
  *
  * Implicit return -
- * A struct bu_list is created, and its address is stored in
- * stp->st_specific for use by pipe_shot().
+ * A struct pipe_specific is created, and its address is stored in
+ * stp->st_specific for use by rt_pipe_shot().
  */
 int
 rt_pipe_prep(struct soltab *stp, struct rt_db_internal *ip, struct rt_i *rtip)
 {
-    struct bu_list *head;
+    struct pipe_specific *ps;
     fastf_t dx, dy, dz, f;
 
     if (rtip) {
 	RT_CK_RTI(rtip);
     }
 
-    BU_GET(head, struct bu_list);
-    BU_LIST_INIT(head);
+    BU_GET(ps, struct pipe_specific);
+    BU_LIST_INIT(&ps->head);
 
-    pipe_elements_calculate(head, ip, &(stp->st_min), &(stp->st_max));
+    pipe_elements_calculate(&ps->head, ip, &(stp->st_min), &(stp->st_max));
+    pipe_bvh_create(ps);
 
-    stp->st_specific = (void *)head;
+    stp->st_specific = (void *)ps;
 
     VSET(stp->st_center,
 	 (stp->st_max[X] + stp->st_min[X]) / 2,
@@ -727,9 +845,9 @@ rt_pipe_prep(struct soltab *stp, struct rt_db_internal *ip, struct rt_i *rtip)
 void
 rt_pipe_print(const struct soltab *stp)
 {
-    struct bu_list *head = (struct bu_list *)stp->st_specific;
+    struct pipe_specific *ps = (struct pipe_specific *)stp->st_specific;
 
-    if (!head) {
+    if (!ps) {
 	return;
     }
 }
@@ -897,7 +1015,7 @@ bend_pipe_shot(
     vect_t pprime;		/* P' */
     vect_t work;		/* temporary vector */
     bn_poly_t C;		/* The final equation */
-    bn_complex_t val[4];	/* The complex roots */
+    fastf_t val[BN_MAX_POLY_DEGREE];	/* The real roots */
     int j;
 
     int root_count = 0;
@@ -999,62 +1117,55 @@ bend_pipe_shot(
     C.cf[3] = Asqr.cf[3] - X2_Y2.cf[1] * 4.0;
     C.cf[4] = Asqr.cf[4] - X2_Y2.cf[2] * 4.0;
 
-    /* It is known that the equation is 4th order.  Therefore, if the
-     * root finder returns other than 4 roots, error.
+    /* The equation is 4th order; only the real roots (imaginary
+     * part within 0.0001) are returned.  A negative count means the
+     * solver failed to converge.
      */
-    if ((root_count = rt_poly_roots(&C, val, stp->st_dp->d_namep)) != 4) {
-	if (root_count > 0) {
-	    bu_log("pipe:  rt_poly_roots() 4!=%d\n", root_count);
-	    bn_pr_roots(stp->st_name, val, root_count);
-	} else if (root_count < 0) {
-	    static int reported = 0;
-	    bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
-	    if (!reported) {
-		VPRINT("while shooting from:\t", rp->r_pt);
-		VPRINT("while shooting at:\t", rp->r_dir);
-		bu_log("Additional pipe convergence failure details will be suppressed.\n");
-		reported = 1;
-	    }
+    if ((root_count = rt_poly_real_roots(&C, val, 0.0001, stp->st_dp->d_namep)) < 0) {
+	static int reported = 0;
+	bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
+	if (!reported) {
+	    VPRINT("while shooting from:\t", rp->r_pt);
+	    VPRINT("while shooting at:\t", rp->r_dir);
+	    bu_log("Additional pipe convergence failure details will be suppressed.\n");
+	    reported = 1;
 	}
 	goto check_discont_radii;	/* MISSED */
     }
 
     /* Only real roots indicate an intersection in real space.
      *
-     * Look at each root returned; if the imaginary part is zero or
-     * sufficiently close, then use the real part as one value of 't'
-     * for the intersections
+     * Each real root returned is one value of 't' for the
+     * intersections
      */
-    for (j = 0 ; j < 4; j++) {
-	if (NEAR_ZERO(val[j].im, 0.0001)) {
-	    struct hit *hitp;
-	    fastf_t normalized_dist;
-	    fastf_t distance;
-	    point_t hit_pt;
-	    vect_t to_hit;
-	    fastf_t angle;
-
-	    normalized_dist = val[j].re - cor_proj;
-	    distance = normalized_dist * bp->bend_radius;
-
-	    /* check if this hit is within bend angle */
-	    VJOIN1(hit_pt, rp->r_pt, distance, rp->r_dir);
-	    VSUB2(to_hit, hit_pt, bp->bend_V);
-	    angle = atan2(VDOT(to_hit, bp->bend_rb), VDOT(to_hit, bp->bend_ra));
-	    if (angle < 0.0) {
-		angle += M_2PI;
-	    }
-	    if (angle <= bp->bend_angle) {
-		hitp = &hits[*hit_count];
-		hitp->hit_magic = RT_HIT_MAGIC;
-		hitp->hit_dist = distance;
-		VJOIN1(hitp->hit_vpriv, pprime, normalized_dist, dprime);
-		hitp->hit_surfno = seg_no * 10 + PIPE_BEND_OUTER_BODY;
+    for (j = 0; j < root_count; j++) {
+	struct hit *hitp;
+	fastf_t normalized_dist;
+	fastf_t distance;
+	point_t hit_pt;
+	vect_t to_hit;
+	fastf_t angle;
 
-		if ((*hit_count)++ >= RT_PIPE_MAXHITS) {
-		    bu_log("Too many hits (%d) on primitive (%s)\n", *hit_count, stp->st_dp->d_namep);
-		    return;
-		}
+	normalized_dist = val[j] - cor_proj;
+	distance = normalized_dist * bp->bend_radius;
+
+	/* check if this hit is within bend angle */
+	VJOIN1(hit_pt, rp->r_pt, distance, rp->r_dir);
+	VSUB2(to_hit, hit_pt, bp->bend_V);
+	angle = atan2(VDOT(to_hit, bp->bend_rb), VDOT(to_hit, bp->bend_ra));
+	if (angle < 0.0) {
+	    angle += M_2PI;
+	}
+	if (angle <= bp->bend_angle) {
+	    hitp = &hits[*hit_count];
+	    hitp->hit_magic = RT_HIT_MAGIC;
+	    hitp->hit_dist = distance;
+	    VJOIN1(hitp->hit_vpriv, pprime, normalized_dist, dprime);
+	    hitp->hit_surfno = seg_no * 10 + PIPE_BEND_OUTER_BODY;
+
+	    if ((*hit_count)++ >= RT_PIPE_MAXHITS) {
+		bu_log("Too many hits (%d) on primitive (%s)\n", *hit_count, stp->st_dp->d_namep);
+		return;
 	    }
 	}
     }
@@ -1091,62 +1202,55 @@ bend_pipe_shot(
     C.cf[3] = Asqr.cf[3] - X2_Y2.cf[1] * 4.0;
     C.cf[4] = Asqr.cf[4] - X2_Y2.cf[2] * 4.0;
 
-    /* It is known that the equation is 4th order.  Therefore,
-     * if the root finder returns other than 4 roots, error.
+    /* The equation is 4th order; only the real roots (imaginary
+     * part within 0.0001) are returned.  A negative count means the
+     * solver failed to converge.
      */
-    if ((root_count = rt_poly_roots(&C, val, stp->st_dp->d_namep)) != 4) {
-	if (root_count > 0) {
-	    bu_log("tor:  rt_poly_roots() 4!=%d\n", root_count);
-	    bn_pr_roots(stp->st_name, val, root_count);
-	} else if (root_count < 0) {
-	    static int reported = 0;
-	    bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
-	    if (!reported) {
-		VPRINT("while shooting from:\t", rp->r_pt);
-		VPRINT("while shooting at:\t", rp->r_dir);
-		bu_log("Additional pipe convergence failure details will be suppressed.\n");
-		reported = 1;
-	    }
+    if ((root_count = rt_poly_real_roots(&C, val, 0.0001, stp->st_dp->d_namep)) < 0) {
+	static int reported = 0;
+	bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
+	if (!reported) {
+	    VPRINT("while shooting from:\t", rp->r_pt);
+	    VPRINT("while shooting at:\t", rp->r_dir);
+	    bu_log("Additional pipe convergence failure details will be suppressed.\n");
+	    reported = 1;
 	}
 	goto check_discont_radii;	/* MISSED */
     }
 
     /* Only real roots indicate an intersection in real space.
      *
-     * Look at each root returned; if the imaginary part is zero or
-     * sufficiently close, then use the real part as one value of 't'
-     * for the intersections
+     * Each real root returned is one value of 't' for the
+     * intersections
      */
-    for (j = 0; j < 4; j++) {
-	if (NEAR_ZERO(val[j].im, 0.0001)) {
-	    struct hit *hitp;
-	    fastf_t normalized_dist;
-	    fastf_t distance;
-	    point_t hit_pt;
-	    vect_t to_hit;
-	    fastf_t angle;
-
-	    normalized_dist = val[j].re - cor_proj;
-	    distance = normalized_dist * bp->bend_radius;
-
-	    /* check if this hit is within bend angle */
-	    VJOIN1(hit_pt, rp->r_pt, distance, rp->r_dir);
-	    VSUB2(to_hit, hit_pt, bp->bend_V);
-	    angle = atan2(VDOT(to_hit, bp->bend_rb), VDOT(to_hit, bp->bend_ra));
-	    if (angle < 0.0) {
-		angle += M_2PI;
-	    }
-	    if (angle <= bp->bend_angle) {
-		hitp = &hits[*hit_count];
-		hitp->hit_magic = RT_HIT_MAGIC;
-		hitp->hit_dist = distance;
-		VJOIN1(hitp->hit_vpriv, pprime, normalized_dist, dprime);
-		hitp->hit_surfno = seg_no * 10 + PIPE_BEND_INNER_BODY;
+    for (j = 0; j < root_count; j++) {
+	struct hit *hitp;
+	fastf_t normalized_dist;
+	fastf_t distance;
+	point_t hit_pt;
+	vect_t to_hit;
+	fastf_t angle;
 
-		if ((*hit_count)++ >= RT_PIPE_MAXHITS) {
-		    bu_log("Too many hits (%d) on primitive (%s)\n", *hit_count, stp->st_dp->d_namep);
-		    return;
-		}
+	normalized_dist = val[j] - cor_proj;
+	distance = normalized_dist * bp->bend_radius;
+
+	/* check if this hit is within bend angle */
+	VJOIN1(hit_pt, rp->r_pt, distance, rp->r_dir);
+	VSUB2(to_hit, hit_pt, bp->bend_V);
+	angle = atan2(VDOT(to_hit, bp->bend_rb), VDOT(to_hit, bp->bend_ra));
+	if (angle < 0.0) {
+	    angle += M_2PI;
+	}
+	if (angle <= bp->bend_angle) {
+	    hitp = &hits[*hit_count];
+	    hitp->hit_magic = RT_HIT_MAGIC;
+	    hitp->hit_dist = distance;
+	    VJOIN1(hitp->hit_vpriv, pprime, normalized_dist, dprime);
+	    hitp->hit_surfno = seg_no * 10 + PIPE_BEND_INNER_BODY;
+
+	    if ((*hit_count)++ >= RT_PIPE_MAXHITS) {
+		bu_log("Too many hits (%d) on primitive (%s)\n", *hit_count, stp->st_dp->d_namep);
+		return;
 	    }
 	}
     }
@@ -1588,7 +1692,7 @@ rt_pipe_elim_dups(
 void
 rt_pipe_norm(struct hit *hitp, struct soltab *stp, struct xray *rp)
 {
-    struct bu_list *head = (struct bu_list *)stp->st_specific;
+    struct pipe_specific *ps = (struct pipe_specific *)stp->st_specific;
     struct id_pipe *pipe_id;
     struct lin_pipe *pipe_lin;
     struct bend_pipe *pipe_bend;
@@ -1596,14 +1700,10 @@ rt_pipe_norm(struct hit *hitp, struct soltab *stp, struct xray *rp)
     vect_t work;
     vect_t work1;
     int segno;
-    int i;
 
     segno = hitp->hit_surfno / 10;
 
-    pipe_id = BU_LIST_FIRST(id_pipe, head);
-    for (i = 1; i < segno; i++) {
-	pipe_id = BU_LIST_NEXT(id_pipe, &pipe_id->l);
-    }
+    pipe_id = ps->segs[segno - 1];
 
     pipe_lin = (struct lin_pipe *)pipe_id;
     pipe_bend = (struct bend_pipe *)pipe_id;
@@ -1682,38 +1782,55 @@ rt_pipe_shot(
     struct application *ap,
     struct seg *seghead)
 {
-    struct bu_list *head = (struct bu_list *)stp->st_specific;
-    struct id_pipe *pipe_id;
+    struct pipe_specific *ps = (struct pipe_specific *)stp->st_specific;
     struct seg *segp;
     struct hit hits[RT_PIPE_MAXHITS];
     int total_hits = 0;
-    int seg_no;
+    size_t n, j;
     int i;
 
-    pipe_start_shot(stp, rp, BU_LIST_FIRST(id_pipe, head), hits, &total_hits, 1);
-    seg_no = 0;
-    for (BU_LIST_FOR(pipe_id, id_pipe, head)) {
-	seg_no++;
+    if (!ps->nsegs) {
+	return 0;
     }
-    pipe_end_shot(stp, rp, BU_LIST_LAST(id_pipe, head), hits, &total_hits, seg_no);
 
-    seg_no = 0;
-    for (BU_LIST_FOR(pipe_id, id_pipe, head)) {
-	seg_no++;
+    pipe_start_shot(stp, rp, ps->segs[0], hits, &total_hits, 1);
+    pipe_end_shot(stp, rp, ps->segs[ps->nsegs - 1], hits, &total_hits, (int)ps->nsegs);
 
-	if (!pipe_id->pipe_is_bend) {
-	    struct lin_pipe *lin = (struct lin_pipe *)pipe_id;
-	    if (!rt_in_rpp(rp, ap->a_inv_dir, lin->pipe_min, lin->pipe_max)) {
-		continue;
-	    }
-	    linear_pipe_shot(stp, rp, lin, hits, &total_hits, seg_no);
-	} else {
-	    struct bend_pipe *bend = (struct bend_pipe *)pipe_id;
-	    if (!rt_in_sph(rp, bend->bend_bound_center, bend->bend_bound_radius_sq)) {
-		continue;
+    /* Walk the hierarchy for the elements near the ray.  They come out
+     * in pipe order, just as if we had gone down the list.
+     */
+    n = 0;
+    while (n < ps->nnodes) {
+	const struct pipe_bvh_node *node = &ps->nodes[n];
+
+	if (!rt_in_rpp(rp, ap->a_inv_dir, node->min, node->max)) {
+	    n = node->skip;
+	    continue;
+	}
+	if (!node->cnt) {
+	    n++;
+	    continue;
+	}
+
+	for (j = node->first; j < node->first + node->cnt; j++) {
+	    struct id_pipe *pipe_id = ps->segs[j];
+	    int seg_no = (int)j + 1;
+
+	    if (!pipe_id->pipe_is_bend) {
+		struct lin_pipe *lin = (struct lin_pipe *)pipe_id;
+		if (!rt_in_rpp(rp, ap->a_inv_dir, lin->pipe_min, lin->pipe_max)) {
+		    continue;
+		}
+		linear_pipe_shot(stp, rp, lin, hits, &total_hits, seg_no);
+	    } else {
+		struct bend_pipe *bend = (struct bend_pipe *)pipe_id;
+		if (!rt_in_sph(rp, bend->bend_bound_center, bend->bend_bound_radius_sq)) {
+		    continue;
+		}
+		bend_pipe_shot(stp, rp, bend, hits, &total_hits, seg_no);
 	    }
-	    bend_pipe_shot(stp, rp, bend, hits, &total_hits, seg_no);
 	}
+	n = node->skip;
     }
     if (!total_hits) {
 	return 0;
@@ -1808,8 +1925,16 @@ void
 rt_pipe_free(struct soltab *stp)
 {
     if (stp != NULL) {
-	pipe_elements_free((struct bu_list *)stp->st_specific);
-	BU_PUT(stp->st_specific, struct bu_list);
+	struct pipe_specific *ps = (struct pipe_specific *)stp->st_specific;
+	pipe_elements_free(&ps->head);
+	if (ps->segs) {
+	    bu_free(ps->segs, "pipe segs");
+	}
+	if (ps->nodes) {
+	    bu_free(ps->nodes, "pipe bvh");
+	}
+	BU_PUT(ps, struct pipe_specific);
+	stp->st_specific = NULL;
     }
 }
 
@@ -2315,7 +2440,7 @@ rt_pipe_adaptive_plot(struct bu_list *vhead, struct rt_db_internal *ip, const st
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     pipeobj = (struct rt_pipe_internal *)ip->idb_ptr;
     RT_PIPE_CK_MAGIC(pipeobj);
 
@@ -2363,7 +2488,7 @@ rt_pipe_plot(
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     pip = (struct rt_pipe_internal *)ip->idb_ptr;
     RT_PIPE_CK_MAGIC(pip);
 
@@ -2499,7 +2624,7 @@ tesselate_pipe_start(
 	nmg_vertex_gv(vu->v_p, pipe_pnt->pp_coord);
     }
 
-    if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+    if (nmg_calc_face_g(fu,rt_vlfree())) {
 	bu_bomb("tesselate_pipe_start: nmg_calc_face_g failed\n");
     }
 
@@ -2593,7 +2718,7 @@ tesselate_pipe_linear(
 
 	    if (fu_prev) {
 		nmg_vertex_gv(new_outer_loop[i], pt);
-		if (nmg_calc_face_g(fu_prev,&RTG.rtg_vlfree)) {
+		if (nmg_calc_face_g(fu_prev,rt_vlfree())) {
 		    bu_log("tesselate_pipe_linear: nmg_calc_face_g failed\n");
 		    nmg_kfu(fu_prev);
 		} else {
@@ -2655,7 +2780,7 @@ tesselate_pipe_linear(
 		nmg_vertex_gv(new_outer_loop[i], pt);
 	    }
 
-	    if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+	    if (nmg_calc_face_g(fu,rt_vlfree())) {
 		bu_log("tesselate_pipe_linear: nmg_calc_face_g failed\n");
 		nmg_kfu(fu);
 	    } else {
@@ -2708,7 +2833,7 @@ tesselate_pipe_linear(
 		continue;
 	    }
 	    if (i == arc_segs - 1) {
-		if (nmg_calc_face_g(fu_prev,&RTG.rtg_vlfree)) {
+		if (nmg_calc_face_g(fu_prev,rt_vlfree())) {
 		    bu_log("tesselate_pipe_linear: nmg_calc_face_g failed\n");
 		    nmg_kfu(fu_prev);
 		}
@@ -2747,7 +2872,7 @@ tesselate_pipe_linear(
 		VUNITIZE(norms[j]);
 	    }
 
-	    if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+	    if (nmg_calc_face_g(fu,rt_vlfree())) {
 		bu_log("tesselate_pipe_linear: nmg_calc_face_g failed\n");
 		nmg_kfu(fu);
 	    } else {
@@ -2839,7 +2964,7 @@ tesselate_pipe_linear(
 	    if (!new_outer_loop[j]->vg_p) {
 		nmg_vertex_gv(new_outer_loop[j], pt_next);
 	    }
-	    if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+	    if (nmg_calc_face_g(fu,rt_vlfree())) {
 		bu_log("tesselate_pipe_linear: nmg_calc_face_g failed\n");
 		nmg_kfu(fu);
 	    } else {
@@ -2913,7 +3038,7 @@ tesselate_pipe_linear(
 
 	    if (fu_prev) {
 		nmg_vertex_gv(new_inner_loop[i], pt);
-		if (nmg_calc_face_g(fu_prev,&RTG.rtg_vlfree)) {
+		if (nmg_calc_face_g(fu_prev,rt_vlfree())) {
 		    bu_log("tesselate_pipe_linear: nmg_calc_face_g failed\n");
 		    nmg_kfu(fu_prev);
 		} else {
@@ -2975,7 +3100,7 @@ tesselate_pipe_linear(
 		nmg_vertex_gv(new_inner_loop[i], pt);
 	    }
 
-	    if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+	    if (nmg_calc_face_g(fu,rt_vlfree())) {
 		bu_log("tesselate_pipe_linear: nmg_calc_face_g failed\n");
 		nmg_kfu(fu);
 	    } else {
@@ -3033,7 +3158,7 @@ tesselate_pipe_linear(
 		continue;
 	    }
 	    if (i == arc_segs - 1) {
-		if (nmg_calc_face_g(fu_prev,&RTG.rtg_vlfree)) {
+		if (nmg_calc_face_g(fu_prev,rt_vlfree())) {
 		    bu_log("tesselate_pipe_linear: nmg_calc_face_g failed\n");
 		    nmg_kfu(fu_prev);
 		}
@@ -3075,7 +3200,7 @@ tesselate_pipe_linear(
 		VREVERSE(norms[j], norms[j]);
 	    }
 
-	    if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+	    if (nmg_calc_face_g(fu,rt_vlfree())) {
 		bu_log("tesselate_pipe_linear: nmg_calc_face_g failed\n");
 		nmg_kfu(fu);
 	    } else {
@@ -3167,7 +3292,7 @@ tesselate_pipe_linear(
 	    if (!new_inner_loop[j]->vg_p) {
 		nmg_vertex_gv(new_inner_loop[j], pt_next);
 	    }
-	    if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+	    if (nmg_calc_face_g(fu,rt_vlfree())) {
 		bu_log("tesselate_pipe_linear: nmg_calc_face_g failed\n");
 		nmg_kfu(fu);
 	    } else {
@@ -3360,7 +3485,7 @@ tesselate_pipe_bend(
 		if (!new_outer_loop[i]->vg_p) {
 		    nmg_vertex_gv(new_outer_loop[i], pt);
 		}
-		if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+		if (nmg_calc_face_g(fu,rt_vlfree())) {
 		    bu_log("tesselate_pipe_bend: nmg_calc_face_g failed\n");
 		    nmg_kfu(fu);
 		} else {
@@ -3429,7 +3554,7 @@ tesselate_pipe_bend(
 		if (!(*verts[2])->vg_p) {
 		    nmg_vertex_gv(*verts[2], pt);
 		}
-		if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+		if (nmg_calc_face_g(fu,rt_vlfree())) {
 		    bu_log("tesselate_pipe_bend: nmg_calc_face_g failed\n");
 		    nmg_kfu(fu);
 		} else {
@@ -3539,7 +3664,7 @@ tesselate_pipe_bend(
 	    if (!new_inner_loop[i]->vg_p) {
 		nmg_vertex_gv(new_inner_loop[i], pt);
 	    }
-	    if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+	    if (nmg_calc_face_g(fu,rt_vlfree())) {
 		bu_log("tesselate_pipe_bend: nmg_calc_face_g failed\n");
 		nmg_kfu(fu);
 	    } else {
@@ -3599,7 +3724,7 @@ tesselate_pipe_bend(
 	    if (!(*verts[2])->vg_p) {
 		nmg_vertex_gv(*verts[2], pt);
 	    }
-	    if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+	    if (nmg_calc_face_g(fu,rt_vlfree())) {
 		bu_log("tesselate_pipe_bend: nmg_calc_face_g failed\n");
 		nmg_kfu(fu);
 	    } else {
@@ -3681,7 +3806,7 @@ tesselate_pipe_end(
 	return;
     }
     fu = fu->fumate_p;
-    if (nmg_calc_face_g(fu,&RTG.rtg_vlfree)) {
+    if (nmg_calc_face_g(fu,rt_vlfree())) {
 	bu_log("tesselate_pipe_end: nmg_calc_face_g failed\n");
 	nmg_kfu(fu);
 	return;
@@ -3917,7 +4042,7 @@ rt_pipe_tess(
     bu_free((char *)inner_loop, "rt_pipe_tess: inner_loop");
 
     nmg_rebound(m, tol);
-    nmg_edge_fuse(&s->l.magic, &RTG.rtg_vlfree, tol);
+    nmg_edge_fuse(&s->l.magic, rt_vlfree(), tol);
 
     return 0;
 }
@@ -841,7 +841,7 @@ rt_revolve_shot(struct soltab *stp, struct xray *rp, struct application *ap, str
 		    bn_poly_t sum;		/* f(y) + g(y)/(2cx) */
 		    bn_poly_t sum_sq;		/* {f(y) + g(y)/(2cx)}^2 */
 		    bn_poly_t answer;		/* {f(y) + g(y)/(2cx)}^2 - g(y) */
-		    bn_complex_t roots[4];
+		    fastf_t roots[BN_MAX_POLY_DEGREE];
 		    int rootcnt;
 
 		    fastf_t cx, cy, crsq = 0;	/* carc's (x, y) coords and radius^2 */
@@ -920,23 +920,19 @@ rt_revolve_shot(struct soltab *stp, struct xray *rp, struct application *ap, str
 		    bn_poly_mul(&sum_sq, &sum, &sum);
 		    bn_poly_sub(&answer, &sum_sq, &hypXsq);
 
-		    /* It is known that the equation is 4th order.  Therefore, if the
-		     * root finder returns other than 4 roots, error.
+		    /* The equation is 4th order; only its real roots are
+		     * returned.  A negative count means the solver failed to
+		     * converge.
 		     */
-		    rootcnt = rt_poly_roots(&answer, roots, stp->st_dp->d_namep);
-		    if (rootcnt != 4) {
-			if (rootcnt > 0) {
-			    bu_log("tor:  rt_poly_roots() 4!=%d\n", rootcnt);
-			    bn_pr_roots(stp->st_name, roots, rootcnt);
-			} else if (rootcnt < 0) {
-			    static int reported=0;
-			    bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
-			    if (!reported) {
-				VPRINT("while shooting from:\t", rp->r_pt);
-				VPRINT("while shooting at:\t", rp->r_dir);
-				bu_log("Additional torus convergence failure details will be suppressed.\n");
-				reported=1;
-			    }
+		    rootcnt = rt_poly_real_roots(&answer, roots, 0.0001, stp->st_dp->d_namep);
+		    if (rootcnt < 0) {
+			static int reported=0;
+			bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
+			if (!reported) {
+			    VPRINT("while shooting from:\t", rp->r_pt);
+			    VPRINT("while shooting at:\t", rp->r_dir);
+			    bu_log("Additional torus convergence failure details will be suppressed.\n");
+			    reported=1;
 			}
 		    }
 
@@ -1220,7 +1216,7 @@ rt_revolve_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct b
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     rip = (struct rt_revolve_internal *)ip->idb_ptr;
     RT_REVOLVE_CK_MAGIC(rip);
 
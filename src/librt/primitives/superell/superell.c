@@ -438,9 +438,8 @@ rt_superell_shot(struct soltab *stp, struct xray *rp, struct application *ap, st
     vect_t newShotPoint; /* P' */
     vect_t newShotDir; /* D' */
     vect_t normalizedShotPoint; /* P' with normalized dist from superell */
-    bn_complex_t complexRoot[4]; /* roots returned from poly solver */
-    double realRoot[4];  /* real ray distance values */
-    int i, j;
+    fastf_t realRoot[BN_MAX_POLY_DEGREE];  /* real ray distance values */
+    int i;
     struct seg *segp;
 
     /* translate ray point */
@@ -481,34 +480,23 @@ rt_superell_shot(struct soltab *stp, struct xray *rp, struct application *ap, st
     /* (X^2 / A) + (Y^2 / B) + (Z^2 / C) */
     equation.cf[2] = newShotDir[X] * newShotDir[X] * superell->superell_invmsAu + newShotDir[Y] * newShotDir[Y] * superell->superell_invmsBu + newShotDir[Z] * newShotDir[Z] * superell->superell_invmsCu;
 
-    if ((i = rt_poly_roots(&equation, complexRoot, stp->st_dp->d_namep)) != 2) {
-	if (i > 0) {
-	    bu_log("rt_superell_shot():  poly roots %d != 2\n", i);
-	    bn_pr_roots(stp->st_name, complexRoot, i);
-	} else if (i < 0) {
-	    static int reported=0;
-	    bu_log("rt_superell_shot():  The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
-	    if (!reported) {
-		VPRINT("while shooting from:\t", rp->r_pt);
-		VPRINT("while shooting at:\t", rp->r_dir);
-		bu_log("rt_superell_shot():  Additional superellipsoid convergence failure details will be suppressed.\n");
-		reported=1;
-	    }
+    /* Only real roots indicate an intersection in real space, so
+     * only those (imaginary part within 0.001) are returned, each one
+     * value of 't' for the intersections.
+     */
+    if ((i = rt_poly_real_roots(&equation, realRoot, 0.001, stp->st_dp->d_namep)) < 0) {
+	static int reported=0;
+	bu_log("rt_superell_shot():  The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
+	if (!reported) {
+	    VPRINT("while shooting from:\t", rp->r_pt);
+	    VPRINT("while shooting at:\t", rp->r_dir);
+	    bu_log("rt_superell_shot():  Additional superellipsoid convergence failure details will be suppressed.\n");
+	    reported=1;
 	}
 	return 0; /* MISS */
     }
 
     /* XXX BEGIN CUT */
-    /* Only real roots indicate an intersection in real space.
-     *
-     * Look at each root returned; if the imaginary part is zero
-     * or sufficiently close, then use the real part as one value
-     * of 't' for the intersections
-     */
-    for (j=0, i=0; j < 2; j++) {
-	if (NEAR_ZERO(complexRoot[j].im, 0.001))
-	    realRoot[i++] = complexRoot[j].re;
-    }
 
     /* reverse above translation by adding distance to all 'k' values. */
     /* for (j = 0; j < i; ++j)
@@ -522,7 +510,6 @@ rt_superell_shot(struct soltab *stp, struct xray *rp, struct application *ap, st
 
 	default:
 	    bu_log("rt_superell_shot():  reduced 4 to %d roots\n", i);
-	    bn_pr_roots(stp->st_name, complexRoot, 4);
 	    return 0;		/* No hit */
 
 	case 2:
@@ -716,7 +703,7 @@ rt_superell_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     eip = (struct rt_superell_internal *)ip->idb_ptr;
     RT_SUPERELL_CK_MAGIC(eip);
 
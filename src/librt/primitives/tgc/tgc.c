@@ -718,7 +718,7 @@ rt_tgc_shot(struct soltab *stp, register struct xray *rp, struct application *ap
 	}
     } else {
 	bn_poly_t Q, Qsqr;
-	bn_complex_t val[MAX_TGC_HITS-2]; /* roots of final equation */
+	fastf_t val[BN_MAX_POLY_DEGREE]; /* real roots of final equation */
 	register int l;
 	register int nroots;
 
@@ -762,28 +762,20 @@ rt_tgc_shot(struct soltab *stp, register struct xray *rp, struct application *ap
 
 	/* main 'sides' of a TGC (i.e., the cylindrical surface) is a
 	 * quartic equation, so we expect to find 0 to 4 roots.
-	 */
-	nroots = rt_poly_roots(&C, val, stp->st_dp->d_namep);
-
-	/* Retain real roots, ignore the rest.
 	 *
-	 * If the imaginary part is zero or sufficiently close, then
-	 * we pretend it's real since it could be a root solver or
-	 * floating point artifact.  we use rt_poly_root's internal
-	 * tolerance of 1e-5.
+	 * Retain real roots, ignore the rest.  If the imaginary part
+	 * is zero or sufficiently close, then we pretend it's real
+	 * since it could be a root solver or floating point artifact.
+	 * we use the solver's RT_ROOT_TOL.
 	 */
-	for (l=0, npts=0; l < nroots; l++) {
-	    if (NEAR_ZERO(val[l].im, RT_ROOT_TOL)) {
-		hit_type[npts] = TGC_NORM_BODY;
-		k[npts++] = val[l].re;
-	    }
+	nroots = rt_poly_real_roots(&C, val, RT_ROOT_TOL, stp->st_dp->d_namep);
+	for (l=0, npts=0; l < nroots && npts < MAX_TGC_HITS-2; l++) {
+	    hit_type[npts] = TGC_NORM_BODY;
+	    k[npts++] = val[l];
 	}
 
 	/* sane roots? */
-	if (npts > MAX_TGC_HITS-2) {
-	    /* shouldn't be possible, but ensure no overflow */
-	    npts = MAX_TGC_HITS-2;
-	} else if (npts < 0) {
+	if (nroots < 0) {
 	    static size_t reported = 0;
 
 	    if (reported < 10) {
@@ -1183,28 +1175,22 @@ rt_tgc_vshot(struct soltab **stp, register struct xray **rp, struct seg *segp, i
 		npts = 2;
 	    }
 	} else {
-	    bn_complex_t val[4];	/* roots of final equation */
+	    fastf_t val[BN_MAX_POLY_DEGREE];	/* real roots of final equation */
 	    register int l;
 	    register int nroots;
 
-	    /* The equation is 4th order, so we expect 0 to 4 roots */
-	    nroots = rt_poly_roots(&C[ix], val, (*stp)->st_dp->d_namep);
-
-	    /* Only real roots indicate an intersection in real space.
+	    /* The equation is 4th order, so we expect 0 to 4 roots.
 	     *
-	     * Look at each root returned; if the imaginary part is zero
-	     * or sufficiently close, then use the real part as one value
-	     * of 't' for the intersections
+	     * Only real roots indicate an intersection in real space.
+	     * If the imaginary part of a root is zero or sufficiently
+	     * close, then its real part is one value of 't' for the
+	     * intersections.
 	     */
-	    for (l=0, npts=0; l < nroots; l++) {
-		if (NEAR_ZERO(val[l].im, 0.0001))
-		    k[npts++] = val[l].re;
-	    }
+	    nroots = rt_poly_real_roots(&C[ix], val, 0.0001, (*stp)->st_dp->d_namep);
+	    for (l=0, npts=0; l < nroots && npts < 4; l++)
+		k[npts++] = val[l];
 	    /* Here, 'npts' is number of points being returned */
-	    if (npts != 0 && npts != 2 && npts != 4 && npts > 0) {
-		bu_log("tgc:  reduced %d to %d roots\n", nroots, npts);
-		bn_pr_roots("tgc", val, nroots);
-	    } else if (nroots < 0) {
+	    if (nroots < 0) {
 		static size_t reported = 0;
 
 		if (reported < 10) {
@@ -2388,7 +2374,7 @@ rt_tgc_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
 	fu = (struct faceuse *)BU_PTBL_GET(&faces, i);
 	NMG_CK_FACEUSE(fu);
 
-	if (nmg_calc_face_g(fu, &RTG.rtg_vlfree)) {
+	if (nmg_calc_face_g(fu, rt_vlfree())) {
 	    bu_log("rt_tess_tgc: failed to calculate plane equation\n");
 	    nmg_pr_fu_briefly(fu, "");
 	    return -1;
@@ -2505,7 +2491,7 @@ rt_tgc_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
     nmg_region_a(*r, tol);
 
     /* glue faces together */
-    nmg_gluefaces((struct faceuse **)BU_PTBL_BASEADDR(&faces), BU_PTBL_LEN(&faces), &RTG.rtg_vlfree, tol);
+    nmg_gluefaces((struct faceuse **)BU_PTBL_BASEADDR(&faces), BU_PTBL_LEN(&faces), rt_vlfree(), tol);
     bu_ptbl_free(&faces);
 
     return 0;
@@ -3084,7 +3070,7 @@ rt_tgc_adaptive_plot(struct bu_list *vhead, struct rt_db_internal *ip, const str
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     tip = (struct rt_tgc_internal *)ip->idb_ptr;
     RT_TGC_CK_MAGIC(tip);
 
@@ -3188,7 +3174,7 @@ rt_tgc_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct bg_te
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     tip = (struct rt_tgc_internal *)ip->idb_ptr;
     RT_TGC_CK_MAGIC(tip);
 
@@ -410,8 +410,7 @@ rt_tor_shot(struct soltab *stp, register struct xray *rp, struct application *ap
     vect_t pprime;		/* P' */
     vect_t work;		/* temporary vector */
     bn_poly_t C;		/* The final equation */
-    bn_complex_t val[4];		/* The complex roots */
-    double k[4];		/* The real roots */
+    fastf_t k[BN_MAX_POLY_DEGREE];	/* The real roots */
     register int i;
     int j;
     bn_poly_t A, Asqr;
@@ -484,37 +483,22 @@ rt_tor_shot(struct soltab *stp, register struct xray *rp, struct application *ap
     C.cf[3] = Asqr.cf[3] - X2_Y2.cf[1] * 4.0;
     C.cf[4] = Asqr.cf[4] - X2_Y2.cf[2] * 4.0;
 
-    /* It is known that the equation is 4th order.  Therefore, if the
-     * root finder returns other than 4 roots, error.
+    /* Only real roots indicate an intersection in real space.  If the
+     * imaginary part of a root is zero or sufficiently close, then its
+     * real part is one value of 't' for the intersections.
      */
-    if ((i = rt_poly_roots(&C, val, stp->st_dp->d_namep)) != 4) {
-	if (i > 0) {
-	    bu_log("tor:  rt_poly_roots() 4!=%d\n", i);
-	    bn_pr_roots(stp->st_name, val, i);
-	} else if (i < 0) {
-	    static int reported=0;
-	    bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
-	    if (!reported) {
-		VPRINT("while shooting from:\t", rp->r_pt);
-		VPRINT("while shooting at:\t", rp->r_dir);
-		bu_log("Additional torus convergence failure details will be suppressed.\n");
-		reported=1;
-	    }
+    if ((i = rt_poly_real_roots(&C, k, ap->a_rt_i->rti_tol.dist, stp->st_dp->d_namep)) < 0) {
+	static int reported=0;
+	bu_log("The root solver failed to converge on a solution for %s\n", stp->st_dp->d_namep);
+	if (!reported) {
+	    VPRINT("while shooting from:\t", rp->r_pt);
+	    VPRINT("while shooting at:\t", rp->r_dir);
+	    bu_log("Additional torus convergence failure details will be suppressed.\n");
+	    reported=1;
 	}
 	return 0;		/* MISS */
     }
 
-    /* Only real roots indicate an intersection in real space.
-     *
-     * Look at each root returned; if the imaginary part is zero or
-     * sufficiently close, then use the real part as one value of 't'
-     * for the intersections
-     */
-    for (j=0, i=0; j < 4; j++) {
-	if (NEAR_ZERO(val[j].im, ap->a_rt_i->rti_tol.dist))
-	    k[i++] = val[j].re;
-    }
-
     /* reverse above translation by adding distance to all 'k' values.
      */
     for (j = 0; j < i; ++j)
@@ -527,7 +511,8 @@ rt_tor_shot(struct soltab *stp, register struct xray *rp, struct application *ap
 
 	default:
 	    bu_log("rt_tor_shot: reduced 4 to %d roots\n", i);
-	    bn_pr_roots(stp->st_name, val, 4);
+	    for (j = 0; j < i; j++)
+		bu_log("\tk[%d] = %g\n", j, k[j]);
 	    return 0;		/* No hit */
 
 	case 2:
@@ -618,8 +603,8 @@ rt_tor_vshot(struct soltab **stp, struct xray **rp, struct seg *segp, int n, str
     vect_t pprime;		/* P' */
     vect_t work;		/* temporary vector */
     bn_poly_t *C;		/* The final equation */
-    bn_complex_t (*val)[4];	/* The complex roots */
-    int num_roots;
+    fastf_t *roots;		/* The real roots */
+    int *num_roots;
     int num_zero;
     bn_poly_t A, Asqr;
     bn_poly_t X2_Y2;		/* X**2 + Y**2 */
@@ -631,8 +616,9 @@ rt_tor_vshot(struct soltab **stp, struct xray **rp, struct seg *segp, int n, str
 
     /* Allocate space for polys and roots */
     C = (bn_poly_t *)bu_malloc(n * sizeof(bn_poly_t), "tor bn_poly_t");
-    val = (bn_complex_t (*)[4])bu_malloc(n * sizeof(bn_complex_t) * 4,
-					 "tor bn_complex_t");
+    roots = (fastf_t *)bu_malloc(n * sizeof(fastf_t) * BN_MAX_POLY_DEGREE,
+				 "tor roots");
+    num_roots = (int *)bu_malloc(n * sizeof(int), "tor num_roots");
     cor_proj = (fastf_t *)bu_malloc(n * sizeof(fastf_t), "tor proj");
 
     /* Initialize seg_stp to assume hit (zero will then flag miss) */
@@ -640,7 +626,10 @@ rt_tor_vshot(struct soltab **stp, struct xray **rp, struct seg *segp, int n, str
 
     /* for each ray/torus pair */
     for (i = 0; i < n; i++) {
-	if (segp[i].seg_stp == 0) continue;	/* Skip */
+	if (segp[i].seg_stp == 0) {
+	    C[i].dgr = 0;	/* Skip */
+	    continue;
+	}
 	tor = (struct tor_specific *)stp[i]->st_specific;
 
 	/* Convert vector into the space of the unit torus */
@@ -724,57 +713,38 @@ rt_tor_vshot(struct soltab **stp, struct xray **rp, struct seg *segp, int n, str
 	C[i].cf[4] = Asqr.cf[4] - X2_Y2.cf[2];
     }
 
-    /* Unfortunately finding the 4th order roots are too ugly to
-     * expand the root solving manually.
+    /* Only real roots indicate an intersection in real space; solve
+     * for those of every ray/torus pair in one pass.
      */
+    rt_poly_real_roots_n(num_roots, roots, C, n, ap->a_rt_i->rti_tol.dist, (*stp)->st_dp->d_namep);
+
+    /* for each ray/torus pair */
     for (i = 0; i < n; i++) {
-	if (segp[i].seg_stp == 0) continue;	/* Skip */
+	fastf_t *k = &roots[i*BN_MAX_POLY_DEGREE];
+	int j;
 
-	/* It is known that the equation is 4th order.  Therefore, if
-	 * the root finder returns other than 4 roots, error.
-	 */
-	if ((num_roots = rt_poly_roots(&(C[i]), &(val[i][0]), (*stp)->st_dp->d_namep)) != 4) {
-	    if (num_roots > 0) {
-		bu_log("tor:  rt_poly_roots() 4!=%d\n", num_roots);
-		bn_pr_roots("tor", val[i], num_roots);
-	    } else if (num_roots < 0) {
-		static int reported=0;
-		bu_log("The root solver failed to converge on a solution for %s\n", stp[i]->st_dp->d_namep);
-		if (!reported) {
-		    VPRINT("while shooting from:\t", rp[i]->r_pt);
-		    VPRINT("while shooting at:\t", rp[i]->r_dir);
-		    bu_log("Additional torus convergence failure details will be suppressed.\n");
-		    reported=1;
-		}
+	if (segp[i].seg_stp == 0) continue; /* Skip */
+
+	if (num_roots[i] < 0) {
+	    static int reported=0;
+	    bu_log("The root solver failed to converge on a solution for %s\n", stp[i]->st_dp->d_namep);
+	    if (!reported) {
+		VPRINT("while shooting from:\t", rp[i]->r_pt);
+		VPRINT("while shooting at:\t", rp[i]->r_dir);
+		bu_log("Additional torus convergence failure details will be suppressed.\n");
+		reported=1;
 	    }
+	    C[i].dgr = 0;
 	    RT_TOR_SEG_MISS(segp[i]);		/* MISS */
+	    continue;
 	}
-    }
 
-    /* for each ray/torus pair */
-    for (i = 0; i < n; i++) {
-	if (segp[i].seg_stp == 0) continue; /* Skip */
-
-	/* Only real roots indicate an intersection in real space.
-	 *
-	 * Look at each root returned; if the imaginary part is zero
-	 * or sufficiently close, then use the real part as one value
-	 * of 't' for the intersections
+	/* Reverse translation by adding distance to all 'k' values.
+	 * Reuse C to hold k values.
 	 */
-	/* Also reverse translation by adding distance to all 'k' values. */
-	/* Reuse C to hold k values */
-	num_zero = 0;
-	if (NEAR_ZERO(val[i][0].im, ap->a_rt_i->rti_tol.dist))
-	    C[i].cf[num_zero++] = val[i][0].re - cor_proj[i];
-	if (NEAR_ZERO(val[i][1].im, ap->a_rt_i->rti_tol.dist)) {
-	    C[i].cf[num_zero++] = val[i][1].re - cor_proj[i];
-	}
-	if (NEAR_ZERO(val[i][2].im, ap->a_rt_i->rti_tol.dist)) {
-	    C[i].cf[num_zero++] = val[i][2].re - cor_proj[i];
-	}
-	if (NEAR_ZERO(val[i][3].im, ap->a_rt_i->rti_tol.dist)) {
-	    C[i].cf[num_zero++] = val[i][3].re - cor_proj[i];
-	}
+	num_zero = num_roots[i];
+	for (j = 0; j < num_zero; j++)
+	    C[i].cf[j] = k[j] - cor_proj[i];
 	C[i].dgr   = num_zero;
 
 	/* Here, 'i' is number of points found */
@@ -846,7 +816,8 @@ rt_tor_vshot(struct soltab **stp, struct xray **rp, struct seg *segp, int n, str
 
     /* Free tmp space used */
     bu_free((char *)C, "tor C");
-    bu_free((char *)val, "tor val");
+    bu_free((char *)roots, "tor roots");
+    bu_free((char *)num_roots, "tor num_roots");
     bu_free((char *)cor_proj, "tor cor_proj");
 }
 
@@ -1071,7 +1042,7 @@ rt_tor_adaptive_plot(struct bu_list *vhead, struct rt_db_internal *ip, const str
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     tor = (struct rt_tor_internal *)ip->idb_ptr;
     RT_TOR_CK_MAGIC(tor);
 
@@ -1176,7 +1147,7 @@ rt_tor_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct bg_te
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     tip = (struct rt_tor_internal *)ip->idb_ptr;
     RT_TOR_CK_MAGIC(tip);
 
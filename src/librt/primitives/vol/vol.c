@@ -1145,7 +1145,7 @@ rt_vol_plot(struct bu_list *vhead, struct rt_db_internal *ip, const struct bg_te
 
     BU_CK_LIST_HEAD(vhead);
     RT_CK_DB_INTERNAL(ip);
-    struct bu_list *vlfree = &RTG.rtg_vlfree;
+    struct bu_list *vlfree = rt_vlfree();
     vip = (struct rt_vol_internal *)ip->idb_ptr;
     RT_VOL_CK_MAGIC(vip);
 
@@ -1473,10 +1473,10 @@ rt_vol_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
     nmg_region_a(r_tmp, tol);
 
     /* fuse model */
-    nmg_model_fuse(m_tmp, &RTG.rtg_vlfree, tol);
+    nmg_model_fuse(m_tmp, rt_vlfree(), tol);
 
     /* simplify shell */
-    nmg_shell_coplanar_face_merge(s, tol, 1, &RTG.rtg_vlfree);
+    nmg_shell_coplanar_face_merge(s, tol, 1, rt_vlfree());
 
     /* kill snakes */
     for (BU_LIST_FOR(fu, faceuse, &s->fu_hd)) {
@@ -1488,12 +1488,12 @@ rt_vol_tess(struct nmgregion **r, struct model *m, struct rt_db_internal *ip, co
 	    continue;
 
 	for (BU_LIST_FOR(lu, loopuse, &fu->lu_hd))
-	    (void)nmg_kill_snakes(lu,&RTG.rtg_vlfree);
+	    (void)nmg_kill_snakes(lu,rt_vlfree());
     }
 
-    (void)nmg_unbreak_region_edges((uint32_t *)(&s->l),&RTG.rtg_vlfree);
+    (void)nmg_unbreak_region_edges((uint32_t *)(&s->l),rt_vlfree());
 
-    (void)nmg_mark_edges_real((uint32_t *)&s->l,&RTG.rtg_vlfree);
+    (void)nmg_mark_edges_real((uint32_t *)&s->l,rt_vlfree());
 
     nmg_merge_models(m, m_tmp);
     *r = r_tmp;
@@ -352,6 +352,286 @@ rt_poly_roots(bn_poly_t *eqn,	/* equation to be solved */
 }
 
 
+/**
+ * Relative residual accepted by rt_poly_isroot().  Evaluating p(x) in
+ * double precision is good to a few ulps of the summed term magnitude
+ * (about 1e-15 for these degrees), so 1e-9 leaves room for the closed
+ * form's rounding while still failing a root that is off in its fifth
+ * or sixth digit, which RT_ROOT_TOL would have let through.
+ */
+#define RT_ROOT_RELTOL 1.0e-9
+
+
+/**
+ * Check x is a real root of the (monic) polynomial eqn.  The absolute
+ * test rt_poly_checkroots() uses is tried first, so any root the
+ * general solver would accept is accepted here too; RT_ROOT_TOL is
+ * that loose because it is shared with the imaginary part test and
+ * the shot routines' unit-scaled coefficients.  Failing that, |p(x)|
+ * is compared against the magnitude of the terms summed to form it,
+ * so large coefficients (e.g. from distant or large primitives) don't
+ * fail roots that are as good as the arithmetic allows.
+ */
+static int
+rt_poly_isroot(const bn_poly_t *eqn, fastf_t x)
+{
+    fastf_t p = eqn->cf[0];
+    fastf_t mag, xabs;
+    size_t n;
+
+    for (n = 1; n <= eqn->dgr; n++)
+	p = p*x + eqn->cf[n];
+    if (fabs(p) <= RT_ROOT_TOL)
+	return 1;
+
+    xabs = fabs(x);
+    mag = fabs(eqn->cf[0]);
+    for (n = 1; n <= eqn->dgr; n++)
+	mag = mag*xabs + fabs(eqn->cf[n]);
+    return (fabs(p) <= RT_ROOT_RELTOL * mag);
+}
+
+
+/**
+ * Newton steps in real arithmetic to tighten a real root found in
+ * closed form that didn't pass rt_poly_isroot() as given.  A step is
+ * only kept if it reduces |p(x)|, so this can never make a root worse.
+ */
+static fastf_t
+rt_poly_polish(const bn_poly_t *eqn, fastf_t x)
+{
+    int i;
+    size_t n;
+
+    for (i = 0; i < 3; i++) {
+	fastf_t p = eqn->cf[0], dp = 0.0, xn, pn;
+	for (n = 1; n <= eqn->dgr; n++) {
+	    dp = dp*x + p;
+	    p = p*x + eqn->cf[n];
+	}
+	if (ZERO(p) || ZERO(dp))
+	    break;
+	xn = x - p/dp;
+	pn = eqn->cf[0];
+	for (n = 1; n <= eqn->dgr; n++)
+	    pn = pn*xn + eqn->cf[n];
+	if (fabs(pn) >= fabs(p))
+	    break;
+	x = xn;
+    }
+    return x;
+}
+
+
+/**
+ * Largest real root of the monic cubic eqn, by the same reduction
+ * bn_poly_cubic_roots() uses but without working out the other two.
+ * Returns 0 if the coefficients are out of range.
+ */
+static int
+rt_poly_cubic_maxroot(const bn_poly_t *eqn, fastf_t *root)
+{
+    fastf_t a, b, c1, c1_3rd, delta;
+
+    c1 = eqn->cf[1];
+    if (fabs(c1) > SQRT_MAX_FASTF) return 0;
+
+    c1_3rd = c1 / 3.0;
+    a = eqn->cf[2] - c1*c1_3rd;
+    if (fabs(a) > SQRT_MAX_FASTF) return 0;
+    b = (2.0*c1*c1*c1 - 9.0*c1*eqn->cf[2] + 27.0*eqn->cf[3]) / 27.0;
+    if (fabs(b) > SQRT_MAX_FASTF) return 0;
+
+    if ((delta = a*a) > SQRT_MAX_FASTF) return 0;
+    delta = b*b*0.25 + delta*a / 27.0;
+
+    if (delta > 0.0) {
+	/* one real root */
+	fastf_t r_delta = sqrt(delta);
+	*root = cbrt(-0.5*b + r_delta) + cbrt(-0.5*b - r_delta);
+    } else if (ZERO(delta)) {
+	fastf_t r = cbrt(-0.5*b);
+	*root = (r > 0.0) ? 2.0*r : -r;
+    } else if (a >= 0.0) {
+	*root = 0.0;
+    } else {
+	/* three real roots, 2*fact*cos(phi) is the largest */
+	fastf_t fact, f;
+	a /= -3.0;
+	fact = sqrt(a);
+	f = b * (-0.5) / (a*fact);
+	if (f >= 1.0)
+	    *root = 2.0*fact;
+	else if (f <= -1.0)
+	    *root = fact;
+	else
+	    *root = 2.0*fact*cos(acos(f) / 3.0);
+    }
+    *root -= c1_3rd;
+
+    return 1;
+}
+
+
+/**
+ * Real roots of the real quadratic x**2 + b*x + c, counting a complex
+ * pair within imag_tol of the real axis as a double root.
+ */
+static int
+rt_poly_quadratic_real(fastf_t b, fastf_t c, fastf_t roots[], fastf_t imag_tol)
+{
+    fastf_t discrim = b*b - 4.0*c;
+
+    if (discrim > 0.0) {
+	fastf_t rad = sqrt(discrim);
+	fastf_t t = (b > 0.0) ? -0.5*(b + rad) : -0.5*(b - rad);
+	if (ZERO(t)) {
+	    roots[0] = 0.5*rad;
+	    roots[1] = -0.5*rad;
+	} else {
+	    roots[0] = t;
+	    roots[1] = c / t;
+	}
+	return 2;
+    }
+    /* imaginary part is sqrt(-discrim)/2 */
+    if (-discrim <= 4.0*imag_tol*imag_tol) {
+	roots[0] = roots[1] = -0.5*b;
+	return 2;
+    }
+    return 0;
+}
+
+
+/**
+ * Real roots of the monic quartic eqn, factored into two quadratics
+ * by way of the resolvent cubic as in bn_poly_quartic_roots().  Only
+ * the one root of the resolvent that is needed is computed, and the
+ * complex roots are never formed.  The factorization is checked
+ * against the coefficients, so roots of the factors are roots of
+ * eqn.  Returns -1 if the factorization fails.
+ */
+static int
+rt_poly_quartic_real(const bn_poly_t *eqn, fastf_t roots[], fastf_t imag_tol)
+{
+    bn_poly_t cube;
+    fastf_t U, p, q, q1, q2, b1, b2;
+    int n;
+
+    /* something considerably larger than squared floating point fuss */
+    const fastf_t small = 1.0e-8;
+
+    cube.dgr = 3;
+    cube.cf[0] = 1.0;
+    cube.cf[1] = -eqn->cf[2];
+    cube.cf[2] = eqn->cf[3]*eqn->cf[1] - 4*eqn->cf[4];
+    cube.cf[3] = -eqn->cf[3]*eqn->cf[3]
+	- eqn->cf[4]*eqn->cf[1]*eqn->cf[1]
+	+ 4*eqn->cf[4]*eqn->cf[2];
+
+    if (!rt_poly_cubic_maxroot(&cube, &U))
+	return -1;
+
+    p = eqn->cf[1]*eqn->cf[1]*0.25 + U - eqn->cf[2];
+    U *= 0.5;
+    q = U*U - eqn->cf[4];
+    if (p < 0) {
+	if (p < -small)
+	    return -1;
+	p = 0;
+    } else {
+	p = sqrt(p);
+    }
+    if (q < 0) {
+	if (q < -small)
+	    return -1;
+	q = 0;
+    } else {
+	q = sqrt(q);
+    }
+
+    b1 = eqn->cf[1]*0.5;
+    b2 = b1 + p;
+    b1 -= p;
+    q1 = U - q;
+    q2 = U + q;
+
+    if (!NEAR_ZERO(b1*q2 + b2*q1 - eqn->cf[3], small)) {
+	if (!NEAR_ZERO(b1*q1 + b2*q2 - eqn->cf[3], small))
+	    return -1;
+	q = q1;
+	q1 = q2;
+	q2 = q;
+    }
+
+    n = rt_poly_quadratic_real(b1, q1, roots, imag_tol);
+    n += rt_poly_quadratic_real(b2, q2, &roots[n], imag_tol);
+    return n;
+}
+
+
+int
+rt_poly_real_roots(const bn_poly_t *eqn, fastf_t roots[], fastf_t imag_tol, const char *name)
+{
+    bn_poly_t P = *eqn;
+    bn_complex_t cx[BN_MAX_POLY_DEGREE];
+    int found = 0;
+    int i = 0;
+    int n, dgr;
+
+    if (P.dgr <= 0)
+	return 0;
+
+    /* Quartics with a well defined leading term go straight to the
+     * closed form solution.  Every real root is verified, and polished
+     * if it doesn't pass as given, before we trust the answer.
+     */
+    if (P.dgr == 4 && !ZERO(P.cf[0])) {
+	bn_poly_scale(&P, 1.0 / P.cf[0]);
+	found = rt_poly_quartic_real(&P, roots, imag_tol);
+	for (i = 0; i < found; i++) {
+	    if (!rt_poly_isroot(&P, roots[i])) {
+		roots[i] = rt_poly_polish(&P, roots[i]);
+		if (!rt_poly_isroot(&P, roots[i]))
+		    break;
+	    }
+	}
+	if (found >= 0 && i == found)
+	    return found;
+
+	/* Start over on the general solver */
+	P = *eqn;
+	found = 0;
+    }
+
+    /* rt_poly_roots drops leading zero coefficients, so a full
+     * answer has as many roots as the remaining degree.  Fewer means
+     * it gave up part way.
+     */
+    dgr = (int)P.dgr;
+    for (i = 0; i < (int)P.dgr && ZERO(P.cf[i]); i++)
+	dgr--;
+    n = rt_poly_roots(&P, cx, name);
+    if (n != dgr)
+	return -1;
+    for (i = 0; i < n; i++) {
+	if (NEAR_ZERO(cx[i].im, imag_tol))
+	    roots[found++] = cx[i].re;
+    }
+    return found;
+}
+
+
+void
+rt_poly_real_roots_n(int nroots[], fastf_t roots[], const bn_poly_t eqns[], size_t n, fastf_t imag_tol, const char *name)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+	nroots[i] = rt_poly_real_roots(&eqns[i], &roots[i*BN_MAX_POLY_DEGREE], imag_tol, name);
+}
+
+
 /*
  * Local Variables:
  * mode: C
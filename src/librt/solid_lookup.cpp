@@ -0,0 +1,442 @@
+/*                S O L I D _ L O O K U P . C P P
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @addtogroup ray */
+/** @{ */
+/** @file librt/solid_lookup.cpp
+ *
+ * Concurrent lookup of the soltabs already made by a tree walk, so
+ * that rt_gettrees() can find the existing soltab for a leaf without
+ * serializing the walking threads.
+ *
+ * Soltabs are keyed on their directory and the cell of a grid their
+ * translation falls in.  The grid cells are twice the distance
+ * tolerance, so any translation bn_mat_is_equal() would accept is in
+ * the same cell or, near a cell wall, the neighboring one; lookups
+ * probe those few cells.  Rotations are only compared once the keys
+ * match.
+ *
+ * Reads never lock: entries are pushed onto the head of their bucket
+ * chain and never removed while the table lives.  Adding takes one of
+ * many striped locks to look again before publishing, so the same
+ * exact placement is never made twice.  Placements that are merely
+ * within tolerance and fall in different cells may both be added by
+ * racing threads; that just costs some sharing.
+ *
+ * A single object may be placed millions of times, so the table
+ * doubles when it gets crowded.  Growing takes all the striped locks
+ * and links copies of the entries into new buckets, leaving the old
+ * buckets as they were for any reader still walking them; those are
+ * freed with the table.  A reader that misses an entry added after
+ * the growth finds it when it goes to add it.
+ *
+ * Uses found through the table are counted in the entry and folded
+ * into st_uses when the table is destroyed, after the walk.
+ *
+ * The directory locks replace the four RT_SEM_TREE semaphores for the
+ * rti_solidheads[] lists and d_use_hd lists, which are still kept for
+ * everyone else who looks at them.
+ */
+
+#include "common.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+#include "vmath.h"
+#include "bn/mat.h"
+#include "raytrace.h"
+
+#include "./librt_private.h"
+
+
+/* Striped locks for insertion, and for the directory lists */
+#define SOLID_LOOKUP_LOCKS 1024
+#define SOLID_DIR_LOCKS 256
+
+/* Starting bucket count limits; the table grows past the maximum */
+#define SOLID_LOOKUP_MIN (1 << 10)
+#define SOLID_LOOKUP_START_MAX (1 << 20)
+
+/* Cell indices are clamped to fit an int64_t */
+#define SOLID_CELL_MAX 4.0e18
+
+
+struct solid_entry {
+    struct solid_entry *next;	/* immutable once published */
+    const struct directory *dp;
+    int64_t cell[3];
+    struct soltab *stp;
+    struct solid_entry *orig;	/* entry counting uses, self if not a copy */
+    std::atomic<long> uses;	/* extra uses found through the table */
+};
+
+
+struct solid_buckets {
+    size_t mask;
+    std::atomic<struct solid_entry *> *heads;
+    struct solid_buckets *prev;	/* smaller buckets from before growing */
+};
+
+
+struct rt_solid_lookup {
+    struct rt_i *rtip;
+    double cellsize;
+    std::atomic<struct solid_buckets *> buckets;
+    std::atomic<size_t> count;
+    std::mutex locks[SOLID_LOOKUP_LOCKS];
+};
+
+
+static std::mutex solid_dir_locks[SOLID_DIR_LOCKS];
+
+
+void
+_rt_solid_dir_lock(int hash)
+{
+    solid_dir_locks[(unsigned int)hash % SOLID_DIR_LOCKS].lock();
+}
+
+
+void
+_rt_solid_dir_unlock(int hash)
+{
+    solid_dir_locks[(unsigned int)hash % SOLID_DIR_LOCKS].unlock();
+}
+
+
+static int64_t
+solid_cell(const struct rt_solid_lookup *tbl, double t)
+{
+    double c = floor(t / tbl->cellsize);
+
+    if (c > SOLID_CELL_MAX)
+	c = SOLID_CELL_MAX;
+    if (c < -SOLID_CELL_MAX)
+	c = -SOLID_CELL_MAX;
+    return (int64_t)c;
+}
+
+
+/* Hash of a key; the low bits pick the bucket and the striped lock */
+static size_t
+solid_hash(const struct directory *dp, const int64_t cell[3])
+{
+    uint64_t h = (uint64_t)(uintptr_t)dp;
+
+    for (int i = 0; i < 3; i++) {
+	h ^= (uint64_t)cell[i] + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+
+    return (size_t)h;
+}
+
+
+static int
+solid_mat_match(const matp_t mat, const struct soltab *stp, const struct bn_tol *tol)
+{
+    if (!stp->st_matp || !mat)
+	return (!stp->st_matp && !mat);
+
+    return bn_mat_is_equal(mat, stp->st_matp, tol);
+}
+
+
+/* Entry for dp placed by mat with key hash h in the given cell, if
+ * there is one */
+static struct solid_entry *
+solid_scan(const struct rt_solid_lookup *tbl, const struct solid_buckets *sb, const matp_t mat, const struct directory *dp, const int64_t cell[3], size_t h)
+{
+    struct solid_entry *e = sb->heads[h & sb->mask].load(std::memory_order_acquire);
+
+    for (; e; e = e->next) {
+	if (e->dp != dp || e->cell[X] != cell[X] || e->cell[Y] != cell[Y] || e->cell[Z] != cell[Z])
+	    continue;
+	if (solid_mat_match(mat, e->stp, &tbl->rtip->rti_tol))
+	    return e;
+    }
+
+    return NULL;
+}
+
+
+static void
+solid_key(const struct rt_solid_lookup *tbl, const matp_t mat, int64_t cell[3])
+{
+    if (!mat) {
+	cell[X] = cell[Y] = cell[Z] = 0;
+	return;
+    }
+    cell[X] = solid_cell(tbl, mat[MDX]);
+    cell[Y] = solid_cell(tbl, mat[MDY]);
+    cell[Z] = solid_cell(tbl, mat[MDZ]);
+}
+
+
+static struct soltab *
+solid_use(struct solid_entry *e)
+{
+    struct soltab *stp = e->stp;
+
+    /* Only count uses of non-dead solids */
+    if (!(stp->st_aradius <= -1))
+	e->orig->uses.fetch_add(1, std::memory_order_relaxed);
+
+    if (RT_G_DEBUG & RT_DEBUG_SOLIDS) {
+	bu_log(stp->st_matp ?
+	       "%s re-referenced %ld\n" :
+	       "%s re-referenced %ld (identity mat)\n",
+	       e->dp->d_namep, stp->st_uses + e->orig->uses.load(std::memory_order_relaxed));
+    }
+
+    return stp;
+}
+
+
+/* Push an entry for stp onto its bucket.  Caller holds the striped
+ * lock of the key, or has the table to itself. */
+static struct solid_entry *
+solid_publish(struct solid_buckets *sb, struct soltab *stp, const int64_t cell[3], size_t h, struct solid_entry *orig)
+{
+    struct solid_entry *e = new struct solid_entry;
+    std::atomic<struct solid_entry *> *head = &sb->heads[h & sb->mask];
+
+    e->dp = stp->st_dp;
+    VMOVE(e->cell, cell);
+    e->stp = stp;
+    e->orig = (orig) ? orig : e;
+    e->uses.store(0, std::memory_order_relaxed);
+    e->next = head->load(std::memory_order_relaxed);
+    head->store(e, std::memory_order_release);
+
+    return e;
+}
+
+
+static struct solid_buckets *
+solid_buckets_create(size_t nb, struct solid_buckets *prev)
+{
+    struct solid_buckets *sb = new struct solid_buckets;
+
+    sb->mask = nb - 1;
+    sb->heads = new std::atomic<struct solid_entry *>[nb];
+    for (size_t i = 0; i < nb; i++)
+	sb->heads[i].store(NULL, std::memory_order_relaxed);
+    sb->prev = prev;
+
+    return sb;
+}
+
+
+/* Double the buckets if they are still crowded once nobody is adding */
+static void
+solid_grow(struct rt_solid_lookup *tbl)
+{
+    struct solid_buckets *sb, *nsb;
+
+    for (int i = 0; i < SOLID_LOOKUP_LOCKS; i++)
+	tbl->locks[i].lock();
+
+    sb = tbl->buckets.load(std::memory_order_relaxed);
+    if (tbl->count.load(std::memory_order_relaxed) > 2 * (sb->mask + 1)) {
+	nsb = solid_buckets_create(2 * (sb->mask + 1), sb);
+	for (size_t i = 0; i <= sb->mask; i++) {
+	    struct solid_entry *e = sb->heads[i].load(std::memory_order_relaxed);
+	    for (; e; e = e->next)
+		solid_publish(nsb, e->stp, e->cell, solid_hash(e->dp, e->cell), e->orig);
+	}
+	tbl->buckets.store(nsb, std::memory_order_release);
+    }
+
+    for (int i = SOLID_LOOKUP_LOCKS - 1; i >= 0; i--)
+	tbl->locks[i].unlock();
+}
+
+
+struct rt_solid_lookup *
+_rt_solid_lookup_create(struct rt_i *rtip)
+{
+    struct rt_solid_lookup *tbl;
+    struct solid_buckets *sb;
+    const struct directory *dp;
+    struct soltab *stp;
+    size_t want, nb;
+
+    RT_CK_RTI(rtip);
+
+    /* Start with room for the objects that may be placed, plus what
+     * is there already */
+    want = rtip->nsolids;
+    FOR_ALL_DIRECTORY_START(dp, rtip->rti_dbip) {
+	want++;
+    } FOR_ALL_DIRECTORY_END;
+    for (nb = SOLID_LOOKUP_MIN; nb < want && nb < SOLID_LOOKUP_START_MAX; nb <<= 1)
+	;
+
+    tbl = new struct rt_solid_lookup;
+    tbl->rtip = rtip;
+    tbl->cellsize = 2.0 * FMAX(rtip->rti_tol.dist, SMALL_FASTF);
+    tbl->count.store(0, std::memory_order_relaxed);
+    sb = solid_buckets_create(nb, NULL);
+    tbl->buckets.store(sb, std::memory_order_relaxed);
+
+    /* Solids from earlier rt_gettrees() calls can be shared too */
+    RT_VISIT_ALL_SOLTABS_START(stp, rtip) {
+	int64_t cell[3];
+	if (stp->st_aradius <= -1)
+	    continue;
+	solid_key(tbl, stp->st_matp, cell);
+	(void)solid_publish(sb, stp, cell, solid_hash(stp->st_dp, cell), NULL);
+	tbl->count.fetch_add(1, std::memory_order_relaxed);
+    } RT_VISIT_ALL_SOLTABS_END;
+
+    return tbl;
+}
+
+
+void
+_rt_solid_lookup_destroy(struct rt_solid_lookup *tbl)
+{
+    struct solid_buckets *sb;
+
+    if (!tbl)
+	return;
+
+    sb = tbl->buckets.load(std::memory_order_relaxed);
+    while (sb) {
+	struct solid_buckets *prev = sb->prev;
+	for (size_t i = 0; i <= sb->mask; i++) {
+	    struct solid_entry *e = sb->heads[i].load(std::memory_order_relaxed);
+	    while (e) {
+		struct solid_entry *next = e->next;
+		if (e->orig == e)
+		    e->stp->st_uses += e->uses.load(std::memory_order_relaxed);
+		delete e;
+		e = next;
+	    }
+	}
+	delete[] sb->heads;
+	delete sb;
+	sb = prev;
+    }
+    delete tbl;
+}
+
+
+struct soltab *
+_rt_solid_lookup_find(struct rt_solid_lookup *tbl, const matp_t mat, struct directory *dp)
+{
+    struct solid_buckets *sb = tbl->buckets.load(std::memory_order_acquire);
+    int64_t cell[3], alt[3];
+    int nprobe = 1;
+
+    RT_CK_DIR(dp);
+
+    solid_key(tbl, mat, cell);
+    VMOVE(alt, cell);
+
+    /* Within tolerance of a cell wall, the match may be next door */
+    if (mat) {
+	double tdist = tbl->rtip->rti_tol.dist;
+	for (int i = 0; i < 3; i++) {
+	    double lo = mat[MDX + 4*i] - (double)cell[i] * tbl->cellsize;
+	    if (lo < tdist) {
+		alt[i] = cell[i] - 1;
+	    } else if (tbl->cellsize - lo < tdist) {
+		alt[i] = cell[i] + 1;
+	    }
+	    if (alt[i] != cell[i])
+		nprobe <<= 1;
+	}
+    }
+
+    for (int p = 0; p < 8; p++) {
+	int64_t probe[3];
+	struct solid_entry *e;
+	int skip = 0;
+
+	for (int i = 0; i < 3; i++) {
+	    probe[i] = (p & (1 << i)) ? alt[i] : cell[i];
+	    if ((p & (1 << i)) && alt[i] == cell[i])
+		skip = 1;
+	}
+	if (skip)
+	    continue;
+
+	e = solid_scan(tbl, sb, mat, dp, probe, solid_hash(dp, probe));
+	if (e)
+	    return solid_use(e);
+
+	if (--nprobe == 0)
+	    break;
+    }
+
+    return RT_SOLTAB_NULL;
+}
+
+
+struct soltab *
+_rt_solid_lookup_add(struct rt_solid_lookup *tbl, struct soltab *stp)
+{
+    struct solid_buckets *sb;
+    struct solid_entry *e;
+    int64_t cell[3];
+    size_t h;
+
+    RT_CK_SOLTAB(stp);
+
+    solid_key(tbl, stp->st_matp, cell);
+    h = solid_hash(stp->st_dp, cell);
+
+    {
+	std::lock_guard<std::mutex> guard(tbl->locks[h % SOLID_LOOKUP_LOCKS]);
+
+	/* Someone may have added this same placement since the lookup,
+	 * possibly to buckets grown since then */
+	sb = tbl->buckets.load(std::memory_order_acquire);
+	e = solid_scan(tbl, sb, stp->st_matp, stp->st_dp, cell, h);
+	if (e)
+	    return solid_use(e);
+
+	(void)solid_publish(sb, stp, cell, h, NULL);
+    }
+
+    if (tbl->count.fetch_add(1, std::memory_order_relaxed) + 1 > 2 * (sb->mask + 1))
+	solid_grow(tbl);
+
+    return stp;
+}
+
+
+/** @} */
+
+
+// Local Variables:
+// tab-width: 8
+// mode: C++
+// c-basic-offset: 4
+// indent-tabs-mode: t
+// c-file-style: "stroustrup"
+// End:
+// ex: shiftwidth=4 tabstop=8
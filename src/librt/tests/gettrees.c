@@ -0,0 +1,170 @@
+/*                      G E T T R E E S . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file gettrees.c
+ *
+ * Time rt_gettrees() on a model of many placements of a group of
+ * solids, with every placement used by two regions, on increasing
+ * numbers of CPUs.  Every run has to make one soltab per placement
+ * of each solid and share it between the two regions.
+ *
+ * Usage: rt_gettrees [placements [max_cpus]]
+ *
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+
+#include "vmath.h"
+#include "bu/app.h"
+#include "bu/log.h"
+#include "bu/parallel.h"
+#include "bu/time.h"
+#include "bu/vls.h"
+#include "bn/mat.h"
+#include "raytrace.h"
+#include "wdb.h"
+
+#define NSOLIDS 32
+
+
+static void
+gt_mk_model(struct rt_wdb *wdbp, int nplace)
+{
+    struct wmember parts, all;
+    int i;
+
+    BU_LIST_INIT(&parts.l);
+    for (i = 0; i < NSOLIDS; i++) {
+	struct bu_vls sname = BU_VLS_INIT_ZERO;
+	point_t center;
+
+	VSET(center, (i % 4) * 3.0, (i / 4) * 3.0, 0.0);
+	bu_vls_sprintf(&sname, "s%d.s", i);
+	if (mk_sph(wdbp, bu_vls_cstr(&sname), center, 1.0))
+	    bu_exit(1, "unable to make %s\n", bu_vls_cstr(&sname));
+	(void)mk_addmember(bu_vls_cstr(&sname), &parts.l, NULL, WMOP_UNION);
+	bu_vls_free(&sname);
+    }
+    if (mk_lcomb(wdbp, "parts", &parts, 0, NULL, NULL, NULL, 0))
+	bu_exit(1, "unable to make parts\n");
+
+    BU_LIST_INIT(&all.l);
+    for (i = 0; i < nplace; i++) {
+	struct bu_vls rname = BU_VLS_INIT_ZERO;
+	const char *which[2] = {"a", "b"};
+	mat_t mat;
+	int k;
+
+	bn_mat_angles(mat, 0.0, 0.0, 7.0 * i);
+	MAT_DELTAS(mat, (i % 100) * 20.0, (i / 100) * 40.0, 0.0);
+
+	for (k = 0; k < 2; k++) {
+	    struct wmember reg;
+	    BU_LIST_INIT(&reg.l);
+	    (void)mk_addmember("parts", &reg.l, mat, WMOP_UNION);
+	    bu_vls_sprintf(&rname, "%s%d.r", which[k], i);
+	    if (mk_lcomb(wdbp, bu_vls_cstr(&rname), &reg, 1, NULL, NULL, NULL, 0))
+		bu_exit(1, "unable to make %s\n", bu_vls_cstr(&rname));
+	    (void)mk_addmember(bu_vls_cstr(&rname), &all.l, NULL, WMOP_UNION);
+	}
+	bu_vls_free(&rname);
+    }
+    if (mk_lcomb(wdbp, "all", &all, 0, NULL, NULL, NULL, 0))
+	bu_exit(1, "unable to make group\n");
+}
+
+
+int
+main(int argc, const char **argv)
+{
+    struct db_i *dbip;
+    struct rt_wdb *wdbp;
+    const char *top = "all";
+    size_t maxcpu = bu_avail_cpus();
+    size_t ncpu;
+    int nplace = 500;
+    double t1 = 0.0;
+    int bad = 0;
+
+    bu_setprogname(argv[0]);
+
+    if (argc > 1)
+	nplace = atoi(argv[1]);
+    if (argc > 2)
+	maxcpu = (size_t)atoi(argv[2]);
+    if (nplace < 1 || maxcpu < 1)
+	bu_exit(1, "Usage: %s [placements [max_cpus]]\n", argv[0]);
+    if (maxcpu > MAX_PSW)
+	maxcpu = MAX_PSW;
+
+    dbip = db_create_inmem();
+    if (dbip == DBI_NULL)
+	bu_exit(1, "unable to create in-memory database\n");
+    wdbp = wdb_dbopen(dbip, RT_WDB_TYPE_DB_INMEM);
+    gt_mk_model(wdbp, nplace);
+
+    for (ncpu = 1; ; ncpu = (ncpu * 2 > maxcpu) ? maxcpu : ncpu * 2) {
+	struct rt_i *rtip = rt_new_rti(dbip);
+	struct soltab *stp;
+	size_t nuses = 0;
+	int64_t start;
+	double elapsed;
+
+	start = bu_gettime();
+	if (rt_gettrees(rtip, 1, &top, (int)ncpu) < 0)
+	    bu_exit(1, "unable to load placements\n");
+	elapsed = (double)(bu_gettime() - start) / 1.0e6;
+	if (ncpu == 1)
+	    t1 = elapsed;
+
+	RT_VISIT_ALL_SOLTABS_START(stp, rtip) {
+	    nuses += stp->st_uses;
+	} RT_VISIT_ALL_SOLTABS_END;
+
+	bu_log("%3zu cpus: %d regions, %zu solids in %.3fs, %.2fx\n",
+	       ncpu, (int)rtip->nregions, rtip->nsolids, elapsed,
+	       (elapsed > 0.0) ? t1 / elapsed : 0.0);
+
+	if (rtip->nsolids != (size_t)NSOLIDS * nplace || nuses != (size_t)2 * NSOLIDS * nplace) {
+	    bu_log("%zu cpus: %zu solids with %zu uses, expected %d with %d [FAIL]\n",
+		   ncpu, rtip->nsolids, nuses, NSOLIDS * nplace, 2 * NSOLIDS * nplace);
+	    bad++;
+	}
+
+	rt_free_rti(rtip);
+	if (ncpu == maxcpu)
+	    break;
+    }
+
+    wdb_close(wdbp);
+
+    return (bad) ? 1 : 0;
+}
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
@@ -0,0 +1,269 @@
+/*                      I N S T A N C E . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file instance.c
+ *
+ * Place one BoT many times under different rigid matrices, and check
+ * that shooting the placements prepped as object-space instances
+ * gives the same partitions, normals and regions as prepping each
+ * placement in model space.
+ *
+ * Usage: rt_instance [placements]
+ *
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "vmath.h"
+#include "bu/app.h"
+#include "bu/log.h"
+#include "bu/malloc.h"
+#include "bu/str.h"
+#include "bu/vls.h"
+#include "bn/mat.h"
+#include "raytrace.h"
+#include "wdb.h"
+
+#define BOX_SIZE 10.0
+#define PLACE_STEP 40.0
+#define RAYS_PER_PLACEMENT 25
+#define MAX_PARTS 4
+
+struct inst_result {
+    int cnt;
+    fastf_t in[MAX_PARTS];
+    fastf_t out[MAX_PARTS];
+    vect_t inormal[MAX_PARTS];
+    const char *region[MAX_PARTS];
+};
+
+
+static int
+inst_hit(struct application *ap, struct partition *PartHeadp, struct seg *UNUSED(segs))
+{
+    struct inst_result *r = (struct inst_result *)ap->a_uptr;
+    struct partition *pp;
+
+    for (pp = PartHeadp->pt_forw; pp != PartHeadp && r->cnt < MAX_PARTS; pp = pp->pt_forw) {
+	r->in[r->cnt] = pp->pt_inhit->hit_dist;
+	r->out[r->cnt] = pp->pt_outhit->hit_dist;
+	RT_HIT_NORMAL(r->inormal[r->cnt], pp->pt_inhit, pp->pt_inseg->seg_stp, &ap->a_ray, pp->pt_inflip);
+	r->region[r->cnt] = pp->pt_regionp->reg_name;
+	r->cnt++;
+    }
+    return 1;
+}
+
+
+static int
+inst_miss(struct application *UNUSED(ap))
+{
+    return 0;
+}
+
+
+/* A closed box from 12 outward facing triangles */
+static void
+inst_mk_box(struct rt_wdb *wdbp)
+{
+    fastf_t verts[8*3];
+    int faces[] = {
+	0, 2, 1,  0, 3, 2,	/* -Z */
+	4, 5, 6,  4, 6, 7,	/* +Z */
+	0, 1, 5,  0, 5, 4,	/* -Y */
+	3, 7, 6,  3, 6, 2,	/* +Y */
+	0, 4, 7,  0, 7, 3,	/* -X */
+	1, 2, 6,  1, 6, 5	/* +X */
+    };
+    int i;
+
+    for (i = 0; i < 8; i++) {
+	verts[i*3+X] = ((i & 1) ^ ((i >> 1) & 1)) ? BOX_SIZE : 0.0;
+	verts[i*3+Y] = (i & 2) ? BOX_SIZE : 0.0;
+	verts[i*3+Z] = (i & 4) ? BOX_SIZE : 0.0;
+    }
+    if (mk_bot(wdbp, "box.s", RT_BOT_SOLID, RT_BOT_CCW, 0, 8, 12, verts, faces, NULL, NULL))
+	bu_exit(1, "unable to make box\n");
+}
+
+
+/* Region i holds the box rotated about all three axes and moved along X */
+static void
+inst_placement(mat_t mat, int i)
+{
+    bn_mat_angles(mat, 17.0 * i, 31.0 * i, 53.0 * i);
+    MAT_DELTAS(mat, i * PLACE_STEP, 0.0, 0.0);
+}
+
+
+static void
+inst_shoot(struct rt_i *rtip, int nplace, struct inst_result *results)
+{
+    struct application ap;
+    int i, j;
+
+    RT_APPLICATION_INIT(&ap);
+    ap.a_rt_i = rtip;
+    ap.a_hit = inst_hit;
+    ap.a_miss = inst_miss;
+    ap.a_onehit = 0;
+    ap.a_resource = &rt_uniresource;
+
+    for (i = 0; i < nplace; i++) {
+	mat_t mat;
+	point_t center, local;
+
+	inst_placement(mat, i);
+	VSETALL(local, BOX_SIZE / 2);
+	MAT4X3PNT(center, mat, local);
+
+	for (j = 0; j < RAYS_PER_PLACEMENT; j++) {
+	    struct inst_result *r = &results[i * RAYS_PER_PLACEMENT + j];
+	    fastf_t u = (j % 5 - 2) * BOX_SIZE / 6.0;
+	    fastf_t v = (j / 5 - 2) * BOX_SIZE / 6.0;
+
+	    VSET(ap.a_ray.r_dir, 0.3 * (j % 3 - 1), 0.2 * (j % 4 - 1.5), -1.0);
+	    VUNITIZE(ap.a_ray.r_dir);
+	    VSET(ap.a_ray.r_pt, center[X] + u, center[Y] + v, center[Z]);
+	    VJOIN1(ap.a_ray.r_pt, ap.a_ray.r_pt, -100.0, ap.a_ray.r_dir);
+
+	    memset(r, 0, sizeof(struct inst_result));
+	    ap.a_uptr = (void *)r;
+	    (void)rt_shootray(&ap);
+	}
+    }
+}
+
+
+static struct rt_i *
+inst_load(struct db_i *dbip, int dont_instance)
+{
+    struct rt_i *rtip = rt_new_rti(dbip);
+
+    rtip->rti_dont_instance = dont_instance;
+    if (rt_gettree(rtip, "all") < 0)
+	bu_exit(1, "unable to load placements\n");
+    rt_prep(rtip);
+
+    return rtip;
+}
+
+
+int
+main(int argc, const char **argv)
+{
+    struct db_i *dbip;
+    struct rt_wdb *wdbp;
+    struct rt_i *rtip;
+    struct wmember all;
+    struct inst_result *inst, *world;
+    int i, nplace = 20, nhits = 0, bad = 0;
+
+    bu_setprogname(argv[0]);
+
+    if (argc > 1)
+	nplace = atoi(argv[1]);
+    if (nplace < 1)
+	bu_exit(1, "Usage: %s [placements]\n", argv[0]);
+
+    dbip = db_create_inmem();
+    if (dbip == DBI_NULL)
+	bu_exit(1, "unable to create in-memory database\n");
+    wdbp = wdb_dbopen(dbip, RT_WDB_TYPE_DB_INMEM);
+
+    inst_mk_box(wdbp);
+    BU_LIST_INIT(&all.l);
+    for (i = 0; i < nplace; i++) {
+	struct bu_vls rname = BU_VLS_INIT_ZERO;
+	struct wmember reg;
+	mat_t mat;
+
+	inst_placement(mat, i);
+	BU_LIST_INIT(&reg.l);
+	(void)mk_addmember("box.s", &reg.l, mat, WMOP_UNION);
+	bu_vls_sprintf(&rname, "box%d.r", i);
+	if (mk_lcomb(wdbp, bu_vls_cstr(&rname), &reg, 1, NULL, NULL, NULL, 0))
+	    bu_exit(1, "unable to make %s\n", bu_vls_cstr(&rname));
+	(void)mk_addmember(bu_vls_cstr(&rname), &all.l, NULL, WMOP_UNION);
+	bu_vls_free(&rname);
+    }
+    if (mk_lcomb(wdbp, "all", &all, 0, NULL, NULL, NULL, 0))
+	bu_exit(1, "unable to make group\n");
+
+    inst = (struct inst_result *)bu_calloc(nplace * RAYS_PER_PLACEMENT, sizeof(struct inst_result), "inst");
+    world = (struct inst_result *)bu_calloc(nplace * RAYS_PER_PLACEMENT, sizeof(struct inst_result), "world");
+
+    /* each run keeps its rt_i until the results are compared, since
+     * the region names belong to it */
+    rtip = inst_load(dbip, 0);
+    inst_shoot(rtip, nplace, inst);
+    {
+	struct rt_i *wrtip = inst_load(dbip, 1);
+	inst_shoot(wrtip, nplace, world);
+
+	for (i = 0; i < nplace * RAYS_PER_PLACEMENT; i++) {
+	    int k;
+	    if (inst[i].cnt != world[i].cnt) {
+		bu_log("ray %d: %d partitions instanced, %d in model space\n", i, inst[i].cnt, world[i].cnt);
+		bad++;
+		continue;
+	    }
+	    nhits += inst[i].cnt;
+	    for (k = 0; k < inst[i].cnt; k++) {
+		if (!NEAR_EQUAL(inst[i].in[k], world[i].in[k], 1.0e-6)
+		    || !NEAR_EQUAL(inst[i].out[k], world[i].out[k], 1.0e-6)
+		    || !VNEAR_EQUAL(inst[i].inormal[k], world[i].inormal[k], 1.0e-6)
+		    || !BU_STR_EQUAL(inst[i].region[k], world[i].region[k]))
+		{
+		    bu_log("ray %d partition %d: instanced %s in %g out %g N (%g %g %g), model space %s in %g out %g N (%g %g %g)\n",
+			   i, k,
+			   inst[i].region[k], inst[i].in[k], inst[i].out[k], V3ARGS(inst[i].inormal[k]),
+			   world[i].region[k], world[i].in[k], world[i].out[k], V3ARGS(world[i].inormal[k]));
+		    bad++;
+		}
+	    }
+	}
+	rt_free_rti(wrtip);
+    }
+    rt_free_rti(rtip);
+
+    bu_log("%d placements, %d partitions compared, %d mismatches\n", nplace, nhits, bad);
+
+    bu_free(inst, "inst");
+    bu_free(world, "world");
+    wdb_close(wdbp);
+
+    if (!nhits)
+	bu_exit(1, "no ray hit a placement\n");
+
+    return (bad) ? 1 : 0;
+}
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
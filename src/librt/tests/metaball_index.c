@@ -0,0 +1,207 @@
+/*                 M E T A B A L L _ I N D E X . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file metaball_index.c
+ *
+ * Shoot down onto square grids of metaball control points of
+ * increasing size, checking every hit lands on the threshold surface
+ * of the full field sum and that each control point is hit, and
+ * reporting the time per ray.
+ *
+ * Usage: rt_metaball_index [max_points]
+ *
+ */
+
+#include "common.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vmath.h"
+#include "bu/app.h"
+#include "bu/log.h"
+#include "bu/malloc.h"
+#include "bu/time.h"
+#include "raytrace.h"
+#include "wdb.h"
+
+#define MB_SPACING 4.0
+#define MB_FLDSTR 1.5
+#define MB_SWEAT 2.0
+#define MB_THRESHOLD 1.0
+#define RAY_HEIGHT 100.0
+#define MAX_RAYS 2000
+
+struct mb_hit {
+    int cnt;
+    fastf_t in;
+    fastf_t out;
+};
+
+
+static int
+mb_hit(struct application *ap, struct partition *PartHeadp, struct seg *UNUSED(segs))
+{
+    struct mb_hit *h = (struct mb_hit *)ap->a_uptr;
+    struct partition *pp;
+
+    for (pp = PartHeadp->pt_forw; pp != PartHeadp; pp = pp->pt_forw) {
+	if (!h->cnt)
+	    h->in = pp->pt_inhit->hit_dist;
+	h->out = pp->pt_outhit->hit_dist;
+	h->cnt++;
+    }
+    return 1;
+}
+
+
+static int
+mb_miss(struct application *UNUSED(ap))
+{
+    return 0;
+}
+
+
+/* field value at dist along the ray, relative to the threshold */
+static fastf_t
+surface_error(const struct rt_metaball_internal *mb, const struct xray *rp, fastf_t dist)
+{
+    point_t p;
+
+    VJOIN1(p, rp->r_pt, dist, rp->r_dir);
+    return fabs(rt_metaball_point_value((const point_t *)&p, mb) - MB_THRESHOLD);
+}
+
+
+/* Shoot down onto the points of an n x n blob grid and half way
+ * between them, returning the number of bad rays */
+static int
+metaball_test(size_t n)
+{
+    struct db_i *dbip;
+    struct rt_wdb *wdbp;
+    struct rt_i *rtip;
+    struct directory *dp;
+    struct rt_db_internal intern;
+    struct rt_metaball_internal *mb;
+    struct application ap;
+    struct mb_hit h;
+    fastf_t (*pts)[5];
+    const fastf_t **verts;
+    size_t i, npts = n * n, stride, nrays = 0;
+    int bad = 0;
+    int64_t t0, elapsed;
+
+    dbip = db_create_inmem();
+    if (dbip == DBI_NULL)
+	bu_exit(1, "unable to create in-memory database\n");
+    wdbp = wdb_dbopen(dbip, RT_WDB_TYPE_DB_INMEM);
+
+    pts = (fastf_t (*)[5])bu_calloc(npts, sizeof(fastf_t[5]), "pts");
+    verts = (const fastf_t **)bu_calloc(npts, sizeof(fastf_t *), "verts");
+    for (i = 0; i < npts; i++) {
+	VSET(pts[i], (i % n) * MB_SPACING, (i / n) * MB_SPACING, 0.0);
+	pts[i][3] = MB_FLDSTR;
+	pts[i][4] = MB_SWEAT;
+	verts[i] = pts[i];
+    }
+    if (mk_metaball(wdbp, "mb.s", npts, METABALL_BLOB, MB_THRESHOLD, verts))
+	bu_exit(1, "unable to make metaball\n");
+    bu_free(pts, "pts");
+    bu_free(verts, "verts");
+
+    dp = db_lookup(dbip, "mb.s", LOOKUP_QUIET);
+    if (dp == RT_DIR_NULL || rt_db_get_internal(&intern, dp, dbip, NULL, &rt_uniresource) < 0)
+	bu_exit(1, "unable to read back metaball\n");
+    mb = (struct rt_metaball_internal *)intern.idb_ptr;
+
+    rtip = rt_new_rti(dbip);
+    if (rt_gettree(rtip, "mb.s") < 0)
+	bu_exit(1, "unable to load metaball\n");
+    rt_prep(rtip);
+
+    RT_APPLICATION_INIT(&ap);
+    ap.a_rt_i = rtip;
+    ap.a_hit = mb_hit;
+    ap.a_miss = mb_miss;
+    ap.a_onehit = 0;
+    ap.a_resource = &rt_uniresource;
+    ap.a_uptr = (void *)&h;
+    VSET(ap.a_ray.r_dir, 0.0, 0.0, -1.0);
+
+    stride = (npts > MAX_RAYS) ? npts / MAX_RAYS : 1;
+    t0 = bu_gettime();
+    for (i = 0; i < npts; i += stride) {
+	int k;
+	for (k = 0; k < 2; k++) {
+	    /* through the control point, then between it and the next */
+	    VSET(ap.a_ray.r_pt, (i % n + 0.5 * k) * MB_SPACING, (i / n + 0.5 * k) * MB_SPACING, RAY_HEIGHT);
+	    h.cnt = 0;
+	    (void)rt_shootray(&ap);
+	    nrays++;
+	    if ((k == 0 && h.cnt < 1)
+		|| (h.cnt && (surface_error(mb, &ap.a_ray, h.in) > 1.0e-3
+			      || surface_error(mb, &ap.a_ray, h.out) > 1.0e-3)))
+	    {
+		bu_log("%zu points, ray %zu/%d: %d partitions, in %g out %g\n", npts, i, k, h.cnt, h.in, h.out);
+		bad++;
+	    }
+	}
+    }
+    elapsed = bu_gettime() - t0;
+
+    bu_log("%6zu points: %zu rays, %.2f us/ray\n", npts, nrays, (double)elapsed / nrays);
+
+    rt_db_free_internal(&intern);
+    rt_free_rti(rtip);
+    wdb_close(wdbp);
+
+    return bad;
+}
+
+
+int
+main(int argc, const char **argv)
+{
+    size_t n, max_pts = 2500;
+    int bad = 0;
+
+    bu_setprogname(argv[0]);
+
+    if (argc > 1)
+	max_pts = (size_t)atol(argv[1]);
+    if (max_pts < 4)
+	bu_exit(1, "Usage: %s [max_points]\n", argv[0]);
+
+    for (n = 2; n * n <= max_pts; n *= 5)
+	bad += metaball_test(n);
+
+    return (bad) ? 1 : 0;
+}
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
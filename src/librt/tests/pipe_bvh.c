@@ -0,0 +1,177 @@
+/*                      P I P E _ B V H . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file pipe_bvh.c
+ *
+ * Shoot long zig-zag pipes of increasing point counts, checking each
+ * ray finds the straight section under it and reporting the time per
+ * ray, which should grow with the log of the number of pipe points
+ * rather than linearly.
+ *
+ * Usage: rt_pipe_bvh [max_points]
+ *
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "vmath.h"
+#include "bu/app.h"
+#include "bu/log.h"
+#include "bu/time.h"
+#include "raytrace.h"
+#include "wdb.h"
+
+#define PIPE_OD 2.0
+#define PIPE_STEP 10.0
+#define RAY_HEIGHT 100.0
+#define MAX_RAYS 2000
+
+struct pipe_hit {
+    int cnt;
+    fastf_t in;
+    fastf_t out;
+};
+
+
+static int
+pipe_hit(struct application *ap, struct partition *PartHeadp, struct seg *UNUSED(segs))
+{
+    struct pipe_hit *h = (struct pipe_hit *)ap->a_uptr;
+    struct partition *pp;
+
+    for (pp = PartHeadp->pt_forw; pp != PartHeadp; pp = pp->pt_forw) {
+	if (!h->cnt) {
+	    h->in = pp->pt_inhit->hit_dist;
+	}
+	h->out = pp->pt_outhit->hit_dist;
+	h->cnt++;
+    }
+    return 1;
+}
+
+
+static int
+pipe_miss(struct application *UNUSED(ap))
+{
+    return 0;
+}
+
+
+/* Shoot down onto the middle of the straight sections of an npts point
+ * zig-zag pipe, returning the number of bad rays */
+static int
+pipe_test(size_t npts)
+{
+    struct db_i *dbip;
+    struct rt_wdb *wdbp;
+    struct rt_i *rtip;
+    struct bu_list head;
+    struct application ap;
+    struct pipe_hit h;
+    size_t i, stride, nrays = 0;
+    int bad = 0;
+    int64_t t0, elapsed;
+
+    dbip = db_create_inmem();
+    if (dbip == DBI_NULL)
+	bu_exit(1, "unable to create in-memory database\n");
+    wdbp = wdb_dbopen(dbip, RT_WDB_TYPE_DB_INMEM);
+
+    /* 90 degree zig-zag in the XY plane */
+    mk_pipe_init(&head);
+    for (i = 0; i < npts; i++) {
+	point_t pt;
+	VSET(pt, i * PIPE_STEP, (i % 2) * PIPE_STEP, 0.0);
+	mk_add_pipe_pnt(&head, pt, PIPE_OD, 0.0, 3.0);
+    }
+    if (mk_pipe(wdbp, "pipe.s", &head))
+	bu_exit(1, "unable to make pipe\n");
+    mk_pipe_free(&head);
+
+    rtip = rt_new_rti(dbip);
+    if (rt_gettree(rtip, "pipe.s") < 0)
+	bu_exit(1, "unable to load pipe\n");
+    rt_prep(rtip);
+
+    RT_APPLICATION_INIT(&ap);
+    ap.a_rt_i = rtip;
+    ap.a_hit = pipe_hit;
+    ap.a_miss = pipe_miss;
+    ap.a_onehit = 0;
+    ap.a_resource = &rt_uniresource;
+    ap.a_uptr = (void *)&h;
+    VSET(ap.a_ray.r_dir, 0.0, 0.0, -1.0);
+
+    stride = (npts - 1 > MAX_RAYS) ? (npts - 1) / MAX_RAYS : 1;
+    t0 = bu_gettime();
+    for (i = 0; i + 1 < npts; i += stride) {
+	VSET(ap.a_ray.r_pt, (i + 0.5) * PIPE_STEP, 0.5 * PIPE_STEP, RAY_HEIGHT);
+	h.cnt = 0;
+	(void)rt_shootray(&ap);
+	nrays++;
+	if (h.cnt != 1
+	    || !NEAR_EQUAL(h.in, RAY_HEIGHT - PIPE_OD/2, 1.0e-6)
+	    || !NEAR_EQUAL(h.out, RAY_HEIGHT + PIPE_OD/2, 1.0e-6))
+	{
+	    bu_log("%zu points, section %zu: %d partitions, in %g out %g\n", npts, i, h.cnt, h.in, h.out);
+	    bad++;
+	}
+    }
+    elapsed = bu_gettime() - t0;
+
+    bu_log("%6zu points: %zu rays, %.2f us/ray\n", npts, nrays, (double)elapsed / nrays);
+
+    rt_free_rti(rtip);
+    wdb_close(wdbp);
+
+    return bad;
+}
+
+
+int
+main(int argc, const char **argv)
+{
+    size_t npts, max_pts = 10000;
+    int bad = 0;
+
+    bu_setprogname(argv[0]);
+
+    if (argc > 1)
+	max_pts = (size_t)atol(argv[1]);
+    if (max_pts < 10)
+	bu_exit(1, "Usage: %s [max_points]\n", argv[0]);
+
+    for (npts = 10; npts <= max_pts; npts *= 10)
+	bad += pipe_test(npts);
+
+    return (bad) ? 1 : 0;
+}
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
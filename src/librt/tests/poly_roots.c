@@ -0,0 +1,191 @@
+/*                    P O L Y _ R O O T S . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file poly_roots.c
+ *
+ * Check rt_poly_real_roots against the real roots reported by
+ * rt_poly_roots for the quartics generated by random rays against
+ * unit tori, and report how long each takes.
+ *
+ * Usage: rt_poly_roots [nrays]
+ *
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "bu.h"
+#include "vmath.h"
+#include "raytrace.h"
+
+#define IMAG_TOL 0.0005
+
+static unsigned long rseed = 1;
+
+static fastf_t
+rnd(void)
+{
+    /* simple LCG so the test is repeatable on every platform */
+    rseed = (rseed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+    return (fastf_t)rseed / (fastf_t)0x7fffffffUL;
+}
+
+/* The quartic for a ray against the unit torus with tube radius alpha,
+ * set up the same way rt_tor_shot does it. */
+static void
+tor_eqn(bn_poly_t *C, fastf_t alpha)
+{
+    vect_t d, p, cp;
+    fastf_t proj;
+    bn_poly_t A, X2_Y2;
+
+    VSET(d, rnd() - 0.5, rnd() - 0.5, rnd() - 0.5);
+    VUNITIZE(d);
+    VSET(p, 6.0*rnd() - 3.0, 6.0*rnd() - 3.0, 2.0*rnd() - 1.0);
+    proj = VDOT(p, d);
+    VJOIN1(cp, p, -proj, d);
+
+    X2_Y2.dgr = 2;
+    X2_Y2.cf[0] = d[X]*d[X] + d[Y]*d[Y];
+    X2_Y2.cf[1] = 2.0 * (d[X]*cp[X] + d[Y]*cp[Y]);
+    X2_Y2.cf[2] = cp[X]*cp[X] + cp[Y]*cp[Y];
+
+    A.dgr = 2;
+    A.cf[0] = X2_Y2.cf[0] + d[Z]*d[Z];
+    A.cf[1] = X2_Y2.cf[1] + 2.0*d[Z]*cp[Z];
+    A.cf[2] = X2_Y2.cf[2] + cp[Z]*cp[Z] + 1.0 - alpha*alpha;
+
+    C->dgr = 4;
+    C->cf[0] = A.cf[0]*A.cf[0];
+    C->cf[1] = 2.0*A.cf[0]*A.cf[1];
+    C->cf[2] = 2.0*A.cf[0]*A.cf[2] + A.cf[1]*A.cf[1] - 4.0*X2_Y2.cf[0];
+    C->cf[3] = 2.0*A.cf[1]*A.cf[2] - 4.0*X2_Y2.cf[1];
+    C->cf[4] = A.cf[2]*A.cf[2] - 4.0*X2_Y2.cf[2];
+}
+
+static int
+cmp_roots(const void *a, const void *b)
+{
+    fastf_t x = *(const fastf_t *)a, y = *(const fastf_t *)b;
+    return (x < y) ? -1 : (x > y);
+}
+
+int
+main(int argc, const char **argv)
+{
+    size_t nrays = 100000;
+    size_t i, hits = 0, count_mismatch = 0, root_mismatch = 0;
+    bn_poly_t *eqns;
+    int *ref_n, *real_n;
+    fastf_t *ref, *real;
+    int64_t t0, t_ref, t_real;
+
+    bu_setprogname(argv[0]);
+
+    if (argc > 1)
+	nrays = (size_t)atol(argv[1]);
+    if (!nrays)
+	bu_exit(1, "Usage: %s [nrays]\n", argv[0]);
+
+    eqns = (bn_poly_t *)bu_calloc(nrays, sizeof(bn_poly_t), "eqns");
+    ref_n = (int *)bu_calloc(nrays, sizeof(int), "ref_n");
+    real_n = (int *)bu_calloc(nrays, sizeof(int), "real_n");
+    ref = (fastf_t *)bu_calloc(nrays * BN_MAX_POLY_DEGREE, sizeof(fastf_t), "ref");
+    real = (fastf_t *)bu_calloc(nrays * BN_MAX_POLY_DEGREE, sizeof(fastf_t), "real");
+
+    for (i = 0; i < nrays; i++)
+	tor_eqn(&eqns[i], 0.1 + 0.8*rnd());
+
+    /* the general solver, keeping the real roots */
+    t0 = bu_gettime();
+    for (i = 0; i < nrays; i++) {
+	bn_poly_t C = eqns[i];
+	bn_complex_t val[BN_MAX_POLY_DEGREE];
+	int j, n = rt_poly_roots(&C, val, "poly_roots");
+	ref_n[i] = 0;
+	if (n != 4) {
+	    ref_n[i] = -1;
+	    continue;
+	}
+	for (j = 0; j < n; j++) {
+	    if (NEAR_ZERO(val[j].im, IMAG_TOL))
+		ref[i*BN_MAX_POLY_DEGREE + ref_n[i]++] = val[j].re;
+	}
+    }
+    t_ref = bu_gettime() - t0;
+
+    t0 = bu_gettime();
+    rt_poly_real_roots_n(real_n, real, eqns, nrays, IMAG_TOL, "poly_roots");
+    t_real = bu_gettime() - t0;
+
+    for (i = 0; i < nrays; i++) {
+	fastf_t *r1 = &ref[i*BN_MAX_POLY_DEGREE];
+	fastf_t *r2 = &real[i*BN_MAX_POLY_DEGREE];
+	int j;
+
+	if (ref_n[i] < 0)
+	    continue;
+	if (ref_n[i] != real_n[i]) {
+	    count_mismatch++;
+	    continue;
+	}
+	if (ref_n[i])
+	    hits++;
+	qsort(r1, ref_n[i], sizeof(fastf_t), cmp_roots);
+	qsort(r2, real_n[i], sizeof(fastf_t), cmp_roots);
+	for (j = 0; j < ref_n[i]; j++) {
+	    if (fabs(r1[j] - r2[j]) > 1.0e-6 * (1.0 + fabs(r1[j]))) {
+		root_mismatch++;
+		break;
+	    }
+	}
+    }
+
+    bu_log("%zu rays, %zu hits: rt_poly_roots %.3fs, rt_poly_real_roots %.3fs, %zu root count and %zu root value mismatches\n",
+	   nrays, hits, t_ref / 1.0e6, t_real / 1.0e6, count_mismatch, root_mismatch);
+
+    bu_free(eqns, "eqns");
+    bu_free(ref_n, "ref_n");
+    bu_free(real_n, "real_n");
+    bu_free(ref, "ref");
+    bu_free(real, "real");
+
+    /* The two solvers do not always agree on the root count.  For a
+     * grazing ray the quartic has a nearly double root, which
+     * rt_poly_roots returns as a complex pair whose imaginary part sits
+     * close to IMAG_TOL, and the two solvers can land on either side
+     * of it.  Allow up to one ray in 1000 to disagree, on the count or
+     * on the roots; anything more means the new path is wrong. */
+    if (!hits || count_mismatch + root_mismatch > nrays / 1000)
+	return 1;
+
+    return 0;
+}
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
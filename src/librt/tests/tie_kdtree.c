@@ -0,0 +1,239 @@
+/*                   T I E _ K D T R E E . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file tie_kdtree.c
+ *
+ * Build TIE kd-trees over a scattering of tessellated spheres with
+ * each of the kd-tree methods, report the build time and how many
+ * rays per second each tree shoots, and check that every tree gives
+ * the same first hits as the midpoint split one.
+ *
+ * Usage: rt_tie_kdtree [triangles [rays]]
+ *
+ */
+
+#include "common.h"
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "vmath.h"
+#include "bu/app.h"
+#include "bu/log.h"
+#include "bu/malloc.h"
+#include "bu/time.h"
+#include "rt/tie.h"
+
+struct tk_method {
+    unsigned int kdmethod;
+    const char *name;
+};
+
+static const struct tk_method tk_methods[] = {
+    {TIE_KDTREE_FAST, "fast"},
+    {TIE_KDTREE_SAH, "sah"},
+    {TIE_KDTREE_SAH_CLIP, "sah_clip"}
+};
+#define TK_NMETHODS (sizeof(tk_methods) / sizeof(tk_methods[0]))
+
+#define TK_NSPHERES 50
+
+
+/* Repeatable numbers in [0, 1) */
+static double
+tk_rand(unsigned long *seed)
+{
+    *seed = *seed * 6364136223846793005UL + 1442695040888963407UL;
+    return (double)((*seed >> 11) & 0xFFFFFFFFFFFFFUL) / (double)0x10000000000000UL;
+}
+
+
+/* Fill verts with ntri triangles tessellating TK_NSPHERES spheres of
+ * very different sizes, scattered so there is plenty of empty space */
+static void
+tk_mk_triangles(TIE_3 *verts, unsigned int ntri)
+{
+    unsigned long seed = 1;
+    unsigned int per = ntri / TK_NSPHERES;
+    unsigned int nlat = (unsigned int)sqrt(per / 4.0) + 2;
+    unsigned int nlon = nlat * 2;
+    unsigned int s, i, j, k, t = 0;
+
+    for (s = 0; s < TK_NSPHERES; s++) {
+	fastf_t rad = 2.0 + 38.0 * tk_rand(&seed) * tk_rand(&seed);
+	point_t c;
+	unsigned int last = (s == TK_NSPHERES - 1) ? ntri : t + per;
+
+	VSET(c, 400.0 * tk_rand(&seed) - 200.0, 400.0 * tk_rand(&seed) - 200.0, 400.0 * tk_rand(&seed) - 200.0);
+	for (i = 0; i < nlat && t < last; i++) {
+	    for (j = 0; j < nlon && t < last; j++) {
+		fastf_t th[2], ph[2];
+		TIE_3 p[4];
+
+		th[0] = M_PI * i / nlat;
+		th[1] = M_PI * (i + 1) / nlat;
+		ph[0] = M_2PI * j / nlon;
+		ph[1] = M_2PI * (j + 1) / nlon;
+		for (k = 0; k < 4; k++) {
+		    fastf_t a = th[k / 2], b = ph[k % 2];
+		    VSET(p[k].v, c[X] + rad * sin(a) * cos(b), c[Y] + rad * sin(a) * sin(b), c[Z] + rad * cos(a));
+		}
+		if (i > 0) {
+		    verts[3*t] = p[0];
+		    verts[3*t + 1] = p[1];
+		    verts[3*t + 2] = p[3];
+		    t++;
+		}
+		if (i < nlat - 1 && t < last) {
+		    verts[3*t] = p[0];
+		    verts[3*t + 1] = p[3];
+		    verts[3*t + 2] = p[2];
+		    t++;
+		}
+	    }
+	}
+
+	/* pad out with slivers if the tessellation came up short */
+	for (; t < last; t++) {
+	    VSET(verts[3*t].v, c[X], c[Y], c[Z] + rad);
+	    VSET(verts[3*t + 1].v, c[X] + 0.1 * (t % 7 + 1), c[Y], c[Z] + rad);
+	    VSET(verts[3*t + 2].v, c[X], c[Y] + 0.1, c[Z] + rad + 0.1);
+	}
+    }
+}
+
+
+static void *
+tk_hit(struct tie_ray_s *UNUSED(ray), struct tie_id_s *UNUSED(id), struct tie_tri_s *tri, void *UNUSED(ptr))
+{
+    /* stop at the first hit */
+    return tri;
+}
+
+
+/* Shoot nrays rays from around the model at its middle, filling dist
+ * with the first hit distances (-1 for a miss) */
+static void
+tk_shoot(struct tie_s *tie, unsigned int nrays, fastf_t *dist)
+{
+    unsigned long seed = 7;
+    unsigned int i;
+
+    for (i = 0; i < nrays; i++) {
+	struct tie_ray_s ray;
+	struct tie_id_s id;
+	fastf_t a = M_2PI * tk_rand(&seed);
+	fastf_t b = acos(2.0 * tk_rand(&seed) - 1.0);
+	point_t target;
+
+	VSET(ray.pos, 500.0 * sin(b) * cos(a), 500.0 * sin(b) * sin(a), 500.0 * cos(b));
+	VSET(target, 400.0 * tk_rand(&seed) - 200.0, 400.0 * tk_rand(&seed) - 200.0, 400.0 * tk_rand(&seed) - 200.0);
+	VSUB2(ray.dir, target, ray.pos);
+	VUNITIZE(ray.dir);
+	ray.depth = 0;
+
+	if (TIE_WORK(tie, &ray, &id, tk_hit, NULL))
+	    dist[i] = id.dist;
+	else
+	    dist[i] = -1.0;
+    }
+}
+
+
+int
+main(int argc, const char **argv)
+{
+    unsigned int ntri = 200000;
+    unsigned int nrays = 200000;
+    unsigned int i, m;
+    TIE_3 *verts;
+    TIE_3 **tlist;
+    fastf_t *dist[TK_NMETHODS];
+    int bad = 0;
+
+    bu_setprogname(argv[0]);
+
+    if (argc > 1)
+	ntri = (unsigned int)atoi(argv[1]);
+    if (argc > 2)
+	nrays = (unsigned int)atoi(argv[2]);
+    if (ntri < 16 || nrays < 1)
+	bu_exit(1, "Usage: %s [triangles [rays]]\n", argv[0]);
+
+    verts = (TIE_3 *)bu_malloc(sizeof(TIE_3) * 3 * ntri, "verts");
+    tlist = (TIE_3 **)bu_malloc(sizeof(TIE_3 *) * 3 * ntri, "tlist");
+    tk_mk_triangles(verts, ntri);
+    for (i = 0; i < 3 * ntri; i++)
+	tlist[i] = &verts[i];
+
+    for (m = 0; m < TK_NMETHODS; m++) {
+	struct tie_s tie;
+	int64_t start;
+	double build, shoot;
+
+	TIE_INIT(&tie, ntri, tk_methods[m].kdmethod);
+	TIE_PUSH(&tie, tlist, ntri, NULL, 0);
+
+	start = bu_gettime();
+	TIE_PREP(&tie);
+	build = (double)(bu_gettime() - start) / 1.0e6;
+
+	dist[m] = (fastf_t *)bu_malloc(sizeof(fastf_t) * nrays, "dist");
+	start = bu_gettime();
+	tk_shoot(&tie, nrays, dist[m]);
+	shoot = (double)(bu_gettime() - start) / 1.0e6;
+
+	bu_log("%-8s: %u triangles, %d in leaves, built in %.3fs, %.0f rays/sec\n",
+	       tk_methods[m].name, tie.tri_num, tie.stat, build,
+	       (shoot > 0.0) ? nrays / shoot : 0.0);
+
+	TIE_FREE(&tie);
+    }
+
+    for (m = 1; m < TK_NMETHODS; m++) {
+	unsigned int mismatch = 0;
+
+	for (i = 0; i < nrays; i++) {
+	    if ((dist[0][i] < 0.0) != (dist[m][i] < 0.0) || fabs(dist[0][i] - dist[m][i]) > 1.0e-6)
+		mismatch++;
+	}
+	if (mismatch) {
+	    bu_log("%s: %u of %u rays hit differently than %s [FAIL]\n",
+		   tk_methods[m].name, mismatch, nrays, tk_methods[0].name);
+	    bad++;
+	}
+    }
+
+    for (m = 0; m < TK_NMETHODS; m++)
+	bu_free(dist[m], "dist");
+    bu_free(tlist, "tlist");
+    bu_free(verts, "verts");
+
+    return (bad) ? 1 : 0;
+}
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
@@ -0,0 +1,332 @@
+/*                     W A L K _ T R E E . C
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file walk_tree.c
+ *
+ * Walk a deep hierarchy of assemblies with db_walk_tree() on one cpu
+ * and on several, and check that both walks find the same regions
+ * with the same matrices, that each thread ends its regions in the
+ * order the serial walk does, that the region start function is never
+ * entered by two threads at once, and report how long each walk took.
+ *
+ * Usage: rt_walk_tree [depth [max_cpus]]
+ *
+ */
+
+#include "common.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "vmath.h"
+#include "bu/app.h"
+#include "bu/log.h"
+#include "bu/parallel.h"
+#include "bu/snooze.h"
+#include "bu/sort.h"
+#include "bu/str.h"
+#include "bu/time.h"
+#include "bu/vls.h"
+#include "bn/mat.h"
+#include "raytrace.h"
+#include "wdb.h"
+
+/* members per assembly */
+#define WT_FANOUT 3
+
+/* A region ended by a walk */
+struct wt_region {
+    char *name;			/* "path x y z" */
+    int cpu;			/* bu_parallel_id() that ended it */
+    long seq;			/* index in the serial walk */
+    int seen;			/* matched by the parallel walk */
+};
+
+struct wt_walk {
+    int starts;			/* region start calls */
+    int inside;			/* threads in the region start function */
+    int overlapped;		/* times two threads were in it at once */
+    struct bu_ptbl found;	/* wt_region's, in region end order */
+};
+
+
+static int
+wt_region_start(struct db_tree_state *UNUSED(tsp), const struct db_full_path *UNUSED(pathp), const struct rt_comb_internal *UNUSED(combp), void *client_data)
+{
+    struct wt_walk *w = (struct wt_walk *)client_data;
+
+    /* Serializing the calls is db_walk_tree()'s job, the semaphore
+     * only keeps the count honest.  Stay inside for a moment so a
+     * second thread let in has time to show up.
+     */
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    if (w->inside++)
+	w->overlapped++;
+    w->starts++;
+    bu_semaphore_release(BU_SEM_GENERAL);
+
+    bu_snooze(100);
+
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    w->inside--;
+    bu_semaphore_release(BU_SEM_GENERAL);
+
+    return 0;
+}
+
+
+static union tree *
+wt_region_end(struct db_tree_state *tsp, const struct db_full_path *pathp, union tree *curtree, void *client_data)
+{
+    struct wt_walk *w = (struct wt_walk *)client_data;
+    struct wt_region *reg;
+    struct bu_vls str = BU_VLS_INIT_ZERO;
+    char *sofar = db_path_to_string(pathp);
+
+    bu_vls_sprintf(&str, "%s %.3f %.3f %.3f", sofar, tsp->ts_mat[MDX], tsp->ts_mat[MDY], tsp->ts_mat[MDZ]);
+    bu_free(sofar, "path string");
+
+    BU_GET(reg, struct wt_region);
+    reg->name = bu_vls_strdup(&str);
+    reg->cpu = bu_parallel_id();
+    bu_vls_free(&str);
+
+    bu_semaphore_acquire(BU_SEM_GENERAL);
+    reg->seq = (long)BU_PTBL_LEN(&w->found);
+    bu_ptbl_ins(&w->found, (long *)reg);
+    bu_semaphore_release(BU_SEM_GENERAL);
+
+    return curtree;
+}
+
+
+static union tree *
+wt_leaf(struct db_tree_state *UNUSED(tsp), const struct db_full_path *UNUSED(pathp), struct rt_db_internal *UNUSED(ip), void *UNUSED(client_data))
+{
+    union tree *curtree;
+
+    BU_GET(curtree, union tree);
+    RT_TREE_INIT(curtree);
+    curtree->tr_op = OP_NOP;
+    return curtree;
+}
+
+
+static int
+wt_cmp(const void *a, const void *b, void *UNUSED(arg))
+{
+    return bu_strcmp((*(struct wt_region * const *)a)->name, (*(struct wt_region * const *)b)->name);
+}
+
+
+static int
+wt_bcmp(const void *a, const void *b)
+{
+    return wt_cmp(a, b, NULL);
+}
+
+
+/* Make assembly "name", with regions depth levels down */
+static void
+wt_mk_assembly(struct rt_wdb *wdbp, const char *name, int depth)
+{
+    struct wmember head;
+    int i;
+
+    BU_LIST_INIT(&head.l);
+    for (i = 0; i < WT_FANOUT; i++) {
+	struct bu_vls mname = BU_VLS_INIT_ZERO;
+	mat_t mat;
+
+	MAT_IDN(mat);
+	MAT_DELTAS(mat, (i + 1) * 10.0, depth * 5.0, i * 2.0);
+
+	if (depth > 1) {
+	    bu_vls_sprintf(&mname, "%s_%d", name, i);
+	    wt_mk_assembly(wdbp, bu_vls_cstr(&mname), depth - 1);
+	} else {
+	    bu_vls_sprintf(&mname, "reg%d.r", i);
+	}
+	(void)mk_addmember(bu_vls_cstr(&mname), &head.l, mat, WMOP_UNION);
+	bu_vls_free(&mname);
+    }
+    if (mk_lcomb(wdbp, name, &head, 0, NULL, NULL, NULL, 0))
+	bu_exit(1, "unable to make %s\n", name);
+}
+
+
+static double
+wt_walk(struct db_i *dbip, int ncpu, struct wt_walk *w)
+{
+    const char *top = "top";
+    int64_t start;
+
+    memset(w, 0, sizeof(struct wt_walk));
+    bu_ptbl_init(&w->found, 1024, "found");
+
+    start = bu_gettime();
+    if (db_walk_tree(dbip, 1, &top, ncpu, &rt_initial_tree_state, wt_region_start, wt_region_end, wt_leaf, (void *)w) < 0)
+	bu_exit(1, "unable to walk top\n");
+
+    return (double)(bu_gettime() - start) / 1.0e6;
+}
+
+
+static void
+wt_free(struct wt_walk *w)
+{
+    size_t i;
+    for (i = 0; i < BU_PTBL_LEN(&w->found); i++) {
+	struct wt_region *reg = (struct wt_region *)BU_PTBL_GET(&w->found, i);
+	bu_free(reg->name, "region string");
+	BU_PUT(reg, struct wt_region);
+    }
+    bu_ptbl_free(&w->found);
+}
+
+
+int
+main(int argc, const char **argv)
+{
+    struct db_i *dbip;
+    struct rt_wdb *wdbp;
+    struct wt_walk serial, par;
+    size_t maxcpu = bu_avail_cpus();
+    size_t expected = 1;
+    int depth = 7;
+    int i, bad = 0;
+    double t1, tn;
+
+    bu_setprogname(argv[0]);
+
+    if (argc > 1)
+	depth = atoi(argv[1]);
+    if (argc > 2)
+	maxcpu = (size_t)atoi(argv[2]);
+    if (depth < 1 || maxcpu < 1)
+	bu_exit(1, "Usage: %s [depth [max_cpus]]\n", argv[0]);
+    if (maxcpu < 2)
+	maxcpu = 2;
+    if (maxcpu > MAX_PSW)
+	maxcpu = MAX_PSW;
+
+    dbip = db_create_inmem();
+    if (dbip == DBI_NULL)
+	bu_exit(1, "unable to create in-memory database\n");
+    wdbp = wdb_dbopen(dbip, RT_WDB_TYPE_DB_INMEM);
+
+    for (i = 0; i < WT_FANOUT; i++) {
+	struct bu_vls name = BU_VLS_INIT_ZERO;
+	struct wmember reg;
+	point_t center;
+
+	VSET(center, 0.0, 0.0, i * 3.0);
+	bu_vls_sprintf(&name, "sph%d.s", i);
+	if (mk_sph(wdbp, bu_vls_cstr(&name), center, 1.0))
+	    bu_exit(1, "unable to make %s\n", bu_vls_cstr(&name));
+	BU_LIST_INIT(&reg.l);
+	(void)mk_addmember(bu_vls_cstr(&name), &reg.l, NULL, WMOP_UNION);
+	bu_vls_sprintf(&name, "reg%d.r", i);
+	if (mk_lcomb(wdbp, bu_vls_cstr(&name), &reg, 1, NULL, NULL, NULL, 0))
+	    bu_exit(1, "unable to make %s\n", bu_vls_cstr(&name));
+	bu_vls_free(&name);
+    }
+    wt_mk_assembly(wdbp, "top", depth);
+    for (i = 0; i < depth; i++)
+	expected *= WT_FANOUT;
+
+    t1 = wt_walk(dbip, 1, &serial);
+    tn = wt_walk(dbip, (int)maxcpu, &par);
+    bu_log("depth %d: %zu regions, %.3fs on 1 cpu, %.3fs on %zu cpus\n",
+	   depth, BU_PTBL_LEN(&serial.found), t1, tn, maxcpu);
+
+    if (BU_PTBL_LEN(&serial.found) != expected) {
+	bu_log("1 cpu found %zu regions, expected %zu [FAIL]\n", BU_PTBL_LEN(&serial.found), expected);
+	bad++;
+    }
+    if (BU_PTBL_LEN(&par.found) != BU_PTBL_LEN(&serial.found) || par.starts != serial.starts) {
+	bu_log("%zu cpus found %zu regions from %d starts, 1 cpu %zu from %d [FAIL]\n",
+	       maxcpu, BU_PTBL_LEN(&par.found), par.starts, BU_PTBL_LEN(&serial.found), serial.starts);
+	bad++;
+    } else {
+	/* Which thread ends which batch of regions is up to the
+	 * scheduler, but each thread claims its batches in tree order
+	 * and works through them in order, so the regions any one
+	 * thread ends must come in the same order as on 1 cpu.
+	 */
+	long last[MAX_PSW + 1];
+	size_t j, n = BU_PTBL_LEN(&serial.found);
+	struct wt_region **byname = (struct wt_region **)bu_calloc(n, sizeof(struct wt_region *), "byname");
+
+	memcpy(byname, BU_PTBL_BASEADDR(&serial.found), n * sizeof(struct wt_region *));
+	bu_sort(byname, n, sizeof(struct wt_region *), wt_cmp, NULL);
+	for (j = 0; j <= MAX_PSW; j++)
+	    last[j] = -1;
+
+	for (j = 0; j < n; j++) {
+	    struct wt_region *preg = (struct wt_region *)BU_PTBL_GET(&par.found, j);
+	    struct wt_region **match = (struct wt_region **)bsearch(&preg, byname, n, sizeof(struct wt_region *), wt_bcmp);
+
+	    if (!match) {
+		bu_log("'%s' found on %zu cpus but not on 1 cpu [FAIL]\n", preg->name, maxcpu);
+		bad++;
+		break;
+	    }
+	    if ((*match)->seen) {
+		bu_log("'%s' ended twice on %zu cpus [FAIL]\n", preg->name, maxcpu);
+		bad++;
+		break;
+	    }
+	    (*match)->seen = 1;
+	    if (preg->cpu < 0 || preg->cpu > MAX_PSW) {
+		bu_log("'%s' ended on cpu %d, out of range [FAIL]\n", preg->name, preg->cpu);
+		bad++;
+		break;
+	    }
+	    if ((*match)->seq <= last[preg->cpu]) {
+		bu_log("cpu %d ended '%s' (region %ld on 1 cpu) after region %ld [FAIL]\n",
+		       preg->cpu, preg->name, (*match)->seq, last[preg->cpu]);
+		bad++;
+		break;
+	    }
+	    last[preg->cpu] = (*match)->seq;
+	}
+	bu_free(byname, "byname");
+    }
+    if (par.overlapped) {
+	bu_log("region start function entered concurrently %d times [FAIL]\n", par.overlapped);
+	bad++;
+    }
+
+    wt_free(&serial);
+    wt_free(&par);
+    wdb_close(wdbp);
+
+    return (bad) ? 1 : 0;
+}
+
+/*
+ * Local Variables:
+ * tab-width: 8
+ * mode: C
+ * indent-tabs-mode: t
+ * c-file-style: "stroustrup"
+ * End:
+ * ex: shiftwidth=4 tabstop=8
+ */
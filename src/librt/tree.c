@@ -33,37 +33,12 @@
 #include "raytrace.h"
 
 #include "./cache.h"
+#include "./librt_private.h"
 
 
-#define ACQUIRE_SEMAPHORE_TREE(_hash) switch ((_hash)&03) {	\
-	case 0:							\
-	    bu_semaphore_acquire(RT_SEM_TREE0);			\
-	    break;						\
-	case 1:							\
-	    bu_semaphore_acquire(RT_SEM_TREE1);			\
-	    break;						\
-	case 2:							\
-	    bu_semaphore_acquire(RT_SEM_TREE2);			\
-	    break;						\
-	default:						\
-	    bu_semaphore_acquire(RT_SEM_TREE3);			\
-	    break;						\
-    }
-
-#define RELEASE_SEMAPHORE_TREE(_hash) switch ((_hash)&03) {	\
-	case 0:							\
-	    bu_semaphore_release(RT_SEM_TREE0);			\
-	    break;						\
-	case 1:							\
-	    bu_semaphore_release(RT_SEM_TREE1);			\
-	    break;						\
-	case 2:							\
-	    bu_semaphore_release(RT_SEM_TREE2);			\
-	    break;						\
-	default:						\
-	    bu_semaphore_release(RT_SEM_TREE3);			\
-	    break;						\
-    }
+/* The directory lists are guarded by many striped locks (solid_lookup.cpp) */
+#define ACQUIRE_SEMAPHORE_TREE(_hash) _rt_solid_dir_lock(_hash)
+#define RELEASE_SEMAPHORE_TREE(_hash) _rt_solid_dir_unlock(_hash)
 
 
 static void
@@ -127,6 +102,7 @@ struct gettree_data
 {
     struct bu_hash_tbl *tbl;
     struct rt_cache *cache;
+    struct rt_solid_lookup *lookup;	/* NULL when not instancing */
 };
 
 
@@ -262,139 +238,55 @@ _rt_gettree_region_end(struct db_tree_state *tsp, const struct db_full_path *pat
  * "mat" will be a null pointer when an identity matrix is signified.
  * This greatly speeds the comparison process.
  *
- * The two cases can be distinguished by the fact that stp->st_id will
- * be 0 for a new soltab structure, and non-zero for an existing one.
+ * "created" is set when a new soltab was made, which the caller has
+ * to prep.  Other threads may find it before its st_id is filled in,
+ * and any references they take to it are dropped again by
+ * _rt_tree_kill_dead_solid_refs() if the prep fails.
  *
  * This routine will run in parallel.
  *
- * In order to avoid a race between searching the soltab list and
- * adding new solids to it, the new solid to be added *must* be
- * enrolled in the list before exiting the critical section.
- *
- * To limit the size of the list to be searched, there are many lists.
- * The selection of which list is determined by the hash value
- * computed from the solid's name.  This is the same optimization used
- * in searching the directory lists.
- *
- * This subroutine is the critical bottleneck in parallel tree walking.
- *
- * It is safe, and much faster, to use several different critical
- * sections when searching different lists.
- *
- * There are only 4 dedicated semaphores defined, TREE0 through TREE3.
- * This unfortunately limits the code to having only 4 CPUs doing list
- * searching at any one time.  Hopefully, this is enough parallelism
- * to keep the rest of the CPUs doing I/O and actual solid prepping.
- *
- * Since the algorithm has been reduced from an O((nsolid/128)**2)
- * search on the entire rti_solidheads[hash] list to an O(ninstance)
- * search on the dp->d_use_head list for this one solid, the critical
- * section should be relatively short-lived.  Having the 3-way split
- * should provide ample opportunity for parallelism through here,
- * while still ensuring that the necessary variables are protected.
- *
- * There are two critical variables which *both* need to be protected:
- * the specific rti_solidhead[hash] list head, and the specific
- * dp->d_use_hd list head.  Fortunately, since the selection of
- * critical section is based upon db_dirhash(dp->d_namep), any other
- * processor that wants to search this same 'dp' will get the same
- * hash as the current thread, and will thus wait for the appropriate
- * semaphore to be released.  Similarly, any other thread that wants
- * to search the same rti_solidhead[hash] list as the current thread
- * will be using the same hash, and will thus wait for the proper
- * semaphore.
+ * This is the hot spot of parallel tree walking, so the search is a
+ * lookup in a table keyed on the directory and the placement (see
+ * solid_lookup.cpp) that takes no lock at all.  A solid that is not
+ * found is made outside of any lock and then added to the table,
+ * which takes one of many striped locks to check again that no other
+ * thread added the same placement meanwhile.  Only then is it linked
+ * into the rti_solidheads[hash] and dp->d_use_hd lists, under one of
+ * many striped directory locks.
  */
 static struct soltab *
-_rt_find_identical_solid(const matp_t mat, struct directory *dp, struct rt_i *rtip)
+_rt_find_identical_solid(const matp_t mat, struct directory *dp, struct rt_i *rtip, struct rt_solid_lookup *lookup, int *created)
 {
     struct soltab *stp = RT_SOLTAB_NULL;
+    struct soltab *found;
     int hash;
 
     RT_CK_DIR(dp);
     RT_CK_RTI(rtip);
 
-    hash = db_dirhash(dp->d_namep);
-
-    /* Enter the appropriate dual critical-section */
-    ACQUIRE_SEMAPHORE_TREE(hash);
-
-    /*
-     * If solid has not been referenced yet, the search can be
-     * skipped.  If solid is being referenced a _lot_, it certainly
-     * isn't all going to be in the same place, so don't bother
-     * searching.  Consider the case of a million instances of the
-     * same tree submodel solid.
-     */
-    if (dp->d_uses > 0 && dp->d_uses < 100 &&
-	rtip->rti_dont_instance == 0
-	) {
-	struct bu_list *mid;
-
-	/* Search dp->d_use_hd list for other instances */
-	for (BU_LIST_FOR(mid, bu_list, &dp->d_use_hd)) {
-
-	    stp = BU_LIST_MAIN_PTR(soltab, mid, l2);
-	    RT_CK_SOLTAB(stp);
-
-	    if (stp->st_matp == (matp_t)0) {
-		if (mat == (matp_t)0) {
-		    /* Both have identity matrix */
-		    goto more_checks;
-		}
-		continue;
-	    }
-	    if (mat == (matp_t)0) continue;	/* doesn't match */
-
-	    if (!bn_mat_is_equal(mat, stp->st_matp, &rtip->rti_tol))
-		continue;
-
-	more_checks:
-	    /* Don't instance this solid from some other model
-	     * instance.  As this is nearly always equal, check it
-	     * last
-	     */
-	    if (stp->st_rtip != rtip) continue;
-
-	    /*
-	     * stp now points to re-referenced solid.  stp->st_id is
-	     * non-zero, indicating pre-existing solid.
-	     */
-	    RT_CK_SOLTAB(stp);		/* sanity */
+    *created = 0;
 
-	    /* Only increment use counter for non-dead solids. */
-	    if (!(stp->st_aradius <= -1))
-		stp->st_uses++;
+    if (lookup) {
+	stp = _rt_solid_lookup_find(lookup, mat, dp);
+	if (stp) {
 	    /* dp->d_uses is NOT incremented, because number of
 	     * soltab's using it has not gone up.
 	     */
-	    if (RT_G_DEBUG & RT_DEBUG_SOLIDS) {
-		bu_log(mat ?
-		       "%s re-referenced %ld\n" :
-		       "%s re-referenced %ld (identity mat)\n",
-		       dp->d_namep, stp->st_uses);
-	    }
-
-	    /* Leave the appropriate dual critical-section */
-	    RELEASE_SEMAPHORE_TREE(hash);
 	    return stp;
 	}
     }
 
     /*
-     * Create and link a new solid into the list.
-     *
-     * Ensure the search keys "dp", "st_mat" and "st_rtip" are stored
-     * now, while still inside the critical section, because they are
-     * searched on, above.
+     * Make a new solid.  The search keys "dp", "st_mat" and
+     * "st_rtip" have to be in place before it is added to the table.
      */
     BU_ALLOC(stp, struct soltab);
     stp->l.magic = RT_SOLTAB_MAGIC;
     stp->l2.magic = RT_SOLTAB2_MAGIC;
     stp->st_rtip = rtip;
     stp->st_dp = dp;
-    dp->d_uses++;
     stp->st_uses = 1;
-    /* stp->st_id is intentionally left zero here, as a flag */
+    /* stp->st_id is intentionally left zero here, until prep */
 
     if (mat) {
 	stp->st_matp = (matp_t)bu_malloc(sizeof(mat_t), "st_matp");
@@ -403,17 +295,30 @@ _rt_find_identical_solid(const matp_t mat, struct directory *dp, struct rt_i *rt
 	stp->st_matp = (matp_t)0;
     }
 
-    /* Add to the appropriate soltab list head */
-    /* PARALLEL NOTE:  Uses critical section on rt_solidheads element */
-    BU_LIST_INSERT(&(rtip->rti_solidheads[hash]), &(stp->l));
+    /* Init tables of regions using this solid.  Usually small. */
+    bu_ptbl_init(&stp->st_regions, 7, "st_regions ptbl");
 
-    /* Also add to the directory structure list head */
-    /* PARALLEL NOTE:  Uses critical section on this 'dp' */
-    BU_LIST_INSERT(&dp->d_use_hd, &(stp->l2));
+    if (lookup) {
+	found = _rt_solid_lookup_add(lookup, stp);
+	if (found != stp) {
+	    /* Lost the race to another thread making the same solid */
+	    bu_ptbl_free(&stp->st_regions);
+	    if (stp->st_matp)
+		bu_free(stp->st_matp, "st_matp");
+	    bu_free(stp, "struct soltab");
+	    return found;
+	}
+    }
+    *created = 1;
 
-    /*
-     * Leave the 4-way critical-section protecting dp and [hash]
+    /* Add to the appropriate soltab list head and to the directory
+     * structure list head.
      */
+    hash = db_dirhash(dp->d_namep);
+    ACQUIRE_SEMAPHORE_TREE(hash);
+    dp->d_uses++;
+    BU_LIST_INSERT(&(rtip->rti_solidheads[hash]), &(stp->l));
+    BU_LIST_INSERT(&dp->d_use_hd, &(stp->l2));
     RELEASE_SEMAPHORE_TREE(hash);
 
     /* Enter an exclusive critical section to protect nsolids.
@@ -423,14 +328,6 @@ _rt_find_identical_solid(const matp_t mat, struct directory *dp, struct rt_i *rt
     stp->st_bit = rtip->nsolids++;
     bu_semaphore_release(BU_SEM_GENERAL);
 
-    /*
-     * Fill in the last little bit of the structure in full parallel
-     * mode, outside of any critical section.
-     */
-
-    /* Init tables of regions using this solid.  Usually small. */
-    bu_ptbl_init(&stp->st_regions, 7, "st_regions ptbl");
-
     return stp;
 }
 
@@ -447,6 +344,7 @@ _rt_gettree_leaf(struct db_tree_state *tsp, const struct db_full_path *pathp, st
     matp_t mat;
     union tree *curtree;
     struct rt_i *rtip;
+    int created;
     int ret;
     int i;
 
@@ -487,8 +385,8 @@ _rt_gettree_leaf(struct db_tree_state *tsp, const struct db_full_path *pathp, st
      * become a dead solid, so by testing against -1 (instead of <= 0,
      * like before, oops), it isn't a problem.
      */
-    stp = _rt_find_identical_solid(mat, dp, rtip);
-    if (stp->st_id != 0) {
+    stp = _rt_find_identical_solid(mat, dp, rtip, data->lookup, &created);
+    if (!created) {
 	/* stp is an instance of a pre-existing solid */
 	if (stp->st_aradius <= -1) {
 	    /* It's dead, Jim.  st_uses was not incremented. */
@@ -514,8 +412,18 @@ _rt_gettree_leaf(struct db_tree_state *tsp, const struct db_full_path *pathp, st
      * If prep wants to keep the internal structure, that is OK, as
      * long as idb_ptr is set to null.  Note that the prep routine may
      * have changed st_id.
+     *
+     * Rigid placements of primitives with large preps share one prep
+     * done in object space (see instance.c).
      */
-    if (rtip->rti_dbip->dbi_version > 4) {
+    if (_rt_instance_ok(rtip, ip->idb_type, mat)) {
+	int hash = db_dirhash(dp->d_namep);
+	int creator;
+	ACQUIRE_SEMAPHORE_TREE(hash);
+	creator = _rt_instance_attach(stp);
+	RELEASE_SEMAPHORE_TREE(hash);
+	ret = _rt_instance_prep(stp, creator, data->cache, tsp->ts_resp);
+    } else if (rtip->rti_dbip->dbi_version > 4) {
 	ret = rt_cache_prep(data->cache, stp, ip);
     } else {
 	ret = rt_obj_prep(stp, ip, stp->st_rtip);
@@ -527,6 +435,7 @@ _rt_gettree_leaf(struct db_tree_state *tsp, const struct db_full_path *pathp, st
 	/* Too late to delete soltab entry; mark it as "dead" */
 	hash = db_dirhash(dp->d_namep);
 	ACQUIRE_SEMAPHORE_TREE(hash);
+	_rt_instance_detach(stp);
 	stp->st_aradius = -1;
 	stp->st_uses--;
 	RELEASE_SEMAPHORE_TREE(hash);
@@ -773,6 +682,9 @@ rt_gettrees_and_attrs(struct rt_i *rtip, const char **attrs, int argc, const cha
 	if (rtip->rti_dbip->dbi_version > 4) {
 	    data.cache = rt_cache_open();
 	}
+	data.lookup = NULL;
+	if (!rtip->rti_dont_instance)
+	    data.lookup = _rt_solid_lookup_create(rtip);
 
 	if (UNLIKELY(rtip->rti_dbip->dbi_use_comb_instance_ids)) {
 	    struct bu_ptbl pos_paths = BU_PTBL_INIT_ZERO;
@@ -811,6 +723,7 @@ rt_gettrees_and_attrs(struct rt_i *rtip, const char **attrs, int argc, const cha
 	if (rtip->rti_dbip->dbi_version > 4) {
 	    rt_cache_close(data.cache);
 	}
+	_rt_solid_lookup_destroy(data.lookup);
     }
 
     /* DEBUG:  Ensure that all region trees are valid */
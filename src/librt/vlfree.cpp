@@ -0,0 +1,57 @@
+/*                      V L F R E E . C P P
+ * BRL-CAD
+ *
+ * Copyright (c) 2024 United States Government as represented by
+ * the U.S. Army Research Laboratory.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * version 2.1 as published by the Free Software Foundation.
+ *
+ * This library is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this file; see the file named COPYING for more
+ * information.
+ */
+/** @file librt/vlfree.cpp
+ *
+ * Per-thread selection of the bv_vlist freelist used by the plotting
+ * routines.
+ *
+ */
+
+#include "common.h"
+
+#include "raytrace.h"
+
+/* NULL means the shared RTG.rtg_vlfree */
+static thread_local struct bu_list *thread_vlfree = NULL;
+
+
+struct bu_list *
+rt_vlfree(void)
+{
+    return (thread_vlfree) ? thread_vlfree : &RTG.rtg_vlfree;
+}
+
+
+struct bu_list *
+rt_vlfree_set(struct bu_list *vlfree)
+{
+    struct bu_list *prev = thread_vlfree;
+    thread_vlfree = vlfree;
+    return prev;
+}
+
+// Local Variables:
+// tab-width: 8
+// mode: C++
+// c-basic-offset: 4
+// indent-tabs-mode: t
+// c-file-style: "stroustrup"
+// End:
+// ex: shiftwidth=4 tabstop=8
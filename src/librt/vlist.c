@@ -39,26 +39,26 @@
 struct bv_vlblock *
 rt_vlblock_init(void)
 {
-    return bv_vlblock_init(&RTG.rtg_vlfree, 32);
+    return bv_vlblock_init(rt_vlfree(), 32);
 }
 
 void
 rt_vlist_copy(struct bu_list *dest, const struct bu_list *src)
 {
-    bv_vlist_copy(&RTG.rtg_vlfree, dest, src);
+    bv_vlist_copy(rt_vlfree(), dest, src);
 }
 
 
 void
 rt_vlist_cleanup(void)
 {
-    bv_vlist_cleanup(&RTG.rtg_vlfree);
+    bv_vlist_cleanup(rt_vlfree());
 }
 
 void
 rt_vlist_import(struct bu_list *hp, struct bu_vls *namevls, const unsigned char *buf)
 {
-    bv_vlist_import(&RTG.rtg_vlfree, hp, namevls, buf);
+    bv_vlist_import(rt_vlfree(), hp, namevls, buf);
 }
 
 #define TBAD	0 /* no such command */
@@ -105,6 +105,7 @@ extern struct icv_image *bif;
 
 /***** variables shared with worker() ******/
 extern unsigned char *scanbuf;		/* pixels for REMRT */
+extern double hyper_adapt;		/* adaptive hypersampling threshold, 0 for off */
 extern fastf_t aspect;			/* view aspect ratio X/Y */
 extern fastf_t cell_height;		/* model space grid cell height */
 extern fastf_t cell_width;		/* model space grid cell width */
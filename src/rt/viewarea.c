@@ -33,6 +33,7 @@
 #include <math.h>
 #include <string.h>
 
+#include "bu/hash.h"
 #include "bu/parallel.h"
 #include "bu/units.h"
 #include "vmath.h"
@@ -50,10 +51,10 @@ extern double units;
 extern int default_units;
 extern int model_units;
 
-static size_t hit_count=0;
 static fastf_t cell_area=0.0;
 
-/* holds total exposed values */
+/* holds total exposed values, summed from the thread tallies */
+static size_t hit_count=0;
 static size_t exposed_hit_sum=0;
 static fastf_t exposed_hit_x_sum=0.0;
 static fastf_t exposed_hit_y_sum=0.0;
@@ -72,24 +73,13 @@ struct bu_structparse view_parse[] = {
 
 const char title[] = "RT Area";
 
-struct point_list {
-    struct point_list * next;
-    point_t pt_cell;
-};
-
-
 struct area {
     struct bu_list l;			/* magic # and doubly linked list */
     struct area * assembly;		/* pointer to a bu_list of assemblies */
     size_t hits;			/* presented hits count */
     size_t exposures;			/* exposed hits count */
-    size_t seen;			/* book-keeping for exposure */
     size_t depth;			/* assembly depth */
     const char * name;			/* assembly name */
-    struct point_list * hit_points;	/* list of points that define the presented area */
-    struct point_list * exp_points;	/* list of points that define the exposed area */
-    size_t num_hit_points;              /* number of points present in hit_points */
-    size_t num_exp_points;		/* number of points present in exp_points */
     fastf_t group_exposed_hit_x_sum;	/* running x total of exposed hit points on group */
     fastf_t group_exposed_hit_y_sum;	/* running y total of exposed hit points on group */
     fastf_t group_exposed_hit_z_sum;	/* running z total of exposed hit points on group */
@@ -111,37 +101,112 @@ typedef enum area_type {
 } area_type_t;
 
 
-/*
- * This function receives a pointer to a point_list
- * structure, the number of points to calculate, and
- * the point address of where to record the information.
+/* a parent assembly of a region, and how far above the region it is */
+struct area_parent {
+    size_t assembly;			/* index into area_assemblies[] */
+    size_t depth;
+};
+
+
+/* Everything one thread has seen, indexed by region bit number or
+ * assembly index.  Each thread counts into its own, and the tallies
+ * are summed once all rays are done.  A region or assembly has been
+ * seen by the current ray when its seen entry equals the ray serial.
  */
-int
-area_center(struct point_list * ptlist, size_t number, point_t *center)
+struct area_tally {
+    size_t serial;			/* current ray */
+    size_t hit_count;			/* rays that hit anything */
+    size_t exposed_hit_sum;
+    point_t exposed_hit_pt;
+    size_t *reg_seen;
+    size_t *reg_hits;
+    size_t *reg_exposures;
+    point_t *reg_hit_pt;		/* only when computing centers */
+    point_t *reg_exp_pt;
+    size_t *asm_seen;
+    size_t *asm_hits;
+    size_t *asm_exposures;
+    size_t *asm_depth;
+    point_t *asm_hit_pt;		/* only when computing centers */
+    point_t *asm_exp_pt;
+};
+
+
+/* set up by view_2init() */
+static size_t area_nregions = 0;
+static size_t area_nassemblies = 0;
+static struct area **area_assemblies = NULL;	/* assembly records, by index */
+static size_t *area_parent_start = NULL;	/* by region bit, into area_parents[] */
+static struct area_parent *area_parents = NULL;
+static struct area_tally *area_tallies[MAX_PSW];
+
+
+static struct area *
+area_create(struct area *assembly, const char *name)
 {
-    struct point_list *point_it;
-    point_t temp_point;
+    struct area *cell;
+
+    BU_ALLOC(cell, struct area);
+    BU_LIST_INIT(&(cell->l));
+    cell->assembly = assembly;
+    cell->hits = 0;
+    cell->exposures = 0;
+    cell->depth = 0;
+    cell->name = name;
+    cell->group_exposed_hit_x_sum = 0.0;
+    cell->group_exposed_hit_y_sum = 0.0;
+    cell->group_exposed_hit_z_sum = 0.0;
+    cell->group_presented_hit_x_sum = 0.0;
+    cell->group_presented_hit_y_sum = 0.0;
+    cell->group_presented_hit_z_sum = 0.0;
+
+    return cell;
+}
 
-    if (!ptlist || number == 0) {
-	return 0;
-    }
-    temp_point[X] = 0;
-    temp_point[Y] = 0;
-    temp_point[Z] = 0;
-
-    point_it = ptlist;
-    while (point_it) {
-	temp_point[X] += point_it->pt_cell[X];
-	temp_point[Y] += point_it->pt_cell[Y];
-	temp_point[Z] += point_it->pt_cell[Z];
-	point_it = point_it->next;
+
+static struct area_tally *
+area_tally_create(void)
+{
+    struct area_tally *t;
+    size_t nr = area_nregions ? area_nregions : 1;
+    size_t na = area_nassemblies ? area_nassemblies : 1;
+
+    BU_ALLOC(t, struct area_tally);
+    t->reg_seen = (size_t *)bu_calloc(nr, sizeof(size_t), "area_tally reg_seen");
+    t->reg_hits = (size_t *)bu_calloc(nr, sizeof(size_t), "area_tally reg_hits");
+    t->reg_exposures = (size_t *)bu_calloc(nr, sizeof(size_t), "area_tally reg_exposures");
+    t->asm_seen = (size_t *)bu_calloc(na, sizeof(size_t), "area_tally asm_seen");
+    t->asm_hits = (size_t *)bu_calloc(na, sizeof(size_t), "area_tally asm_hits");
+    t->asm_exposures = (size_t *)bu_calloc(na, sizeof(size_t), "area_tally asm_exposures");
+    t->asm_depth = (size_t *)bu_calloc(na, sizeof(size_t), "area_tally asm_depth");
+    if (rtarea_compute_centers) {
+	t->reg_hit_pt = (point_t *)bu_calloc(nr, sizeof(point_t), "area_tally reg_hit_pt");
+	t->reg_exp_pt = (point_t *)bu_calloc(nr, sizeof(point_t), "area_tally reg_exp_pt");
+	t->asm_hit_pt = (point_t *)bu_calloc(na, sizeof(point_t), "area_tally asm_hit_pt");
+	t->asm_exp_pt = (point_t *)bu_calloc(na, sizeof(point_t), "area_tally asm_exp_pt");
     }
 
-    (*center)[X] = temp_point[X] / number;
-    (*center)[Y] = temp_point[Y] / number;
-    (*center)[Z] = temp_point[Z] / number;
+    return t;
+}
+
 
-    return 1;
+static void
+area_tally_free(struct area_tally *t)
+{
+    bu_free(t->reg_seen, "area_tally reg_seen");
+    bu_free(t->reg_hits, "area_tally reg_hits");
+    bu_free(t->reg_exposures, "area_tally reg_exposures");
+    bu_free(t->asm_seen, "area_tally asm_seen");
+    bu_free(t->asm_hits, "area_tally asm_hits");
+    bu_free(t->asm_exposures, "area_tally asm_exposures");
+    bu_free(t->asm_depth, "area_tally asm_depth");
+    if (t->reg_hit_pt) {
+	bu_free(t->reg_hit_pt, "area_tally reg_hit_pt");
+	bu_free(t->reg_exp_pt, "area_tally reg_exp_pt");
+	bu_free(t->asm_hit_pt, "area_tally asm_hit_pt");
+	bu_free(t->asm_exp_pt, "area_tally asm_exp_pt");
+    }
+    bu_free(t, "area_tally");
 }
 
 
@@ -155,188 +220,43 @@ view_pixel(struct application *UNUSED(ap))
 }
 
 
-/* keeps track of how many times we encounter an assembly by
- * maintaining a simple linked list of them using the same structure
- * used for regions.
+/* Count a hit by the current ray on region 'bit' and, once per ray,
+ * on each of its parent assemblies.  All hits are presented hits, the
+ * first along the ray is exposed as well.
  */
 static void
-increment_assembly_counter(register struct area *cell, const char *path, area_type_t type, point_t *hit_point)
+tally_hit(struct area_tally *t, size_t bit, area_type_t type, const point_t hit_point)
 {
-    size_t l = 0;
-    char *buffer = (char *) NULL;
-    size_t depth = 0;
-    int parent_found = 0;
-    register struct area *assembly_head_ptr;
-    register struct area *area_record_ptr = (struct area *) NULL;
-
-    if (!cell) {
-	bu_log("ERROR: Function 'increment_assembly_counter' received a NULL pointer to an 'area' structure. Function aborted.\n");
-	return;
-    }
-    if (!path) {
-	bu_log("ERROR: Function 'increment_assembly_counter' received a NULL pointer to a region path. Function aborted.\n");
-	return;
-    }
-
-    assembly_head_ptr = cell->assembly;
+    size_t i;
 
-    l = strlen(path);
-    buffer = (char *)bu_calloc((unsigned int)l+1, sizeof(char), "increment_assembly_counter buffer allocation");
-    bu_strlcpy(buffer, path, l+1);
-
-    /* trim off the region name */
-    while (l > 0) {
-	if (buffer[l-1] == '/') {
-	    break;
-	}
-	l--;
+    t->reg_seen[bit] = t->serial;
+    t->reg_hits[bit]++;
+    if (type == EXPOSED_AREA)
+	t->reg_exposures[bit]++;
+    if (rtarea_compute_centers) {
+	VADD2(t->reg_hit_pt[bit], t->reg_hit_pt[bit], hit_point);
+	if (type == EXPOSED_AREA)
+	    VADD2(t->reg_exp_pt[bit], t->reg_exp_pt[bit], hit_point);
     }
-    buffer[l-1] = '\0';
-
-    /* traverse region path name, character-by-character to
-     * extract and process each parent name of the current region.
-     */
-    while (l > 0) {
-	/* when the current character in the path name is forward-slash, this
-	 * indicates the characters to the right of the forward-slash are the next
-	 * parent in the path, use this name. when done find next name up the
-	 * path until the path is empty.
-	 */
-	if (buffer[l-1] == '/') {
-	    parent_found=0;
-
-	    /* traverse the assembly linked-list */
-	    for (BU_LIST_FOR(area_record_ptr, area, &(assembly_head_ptr->l))) {
-		/* if the 'name' of the current parent/group of the
-		 * current region matches the current 'name' in the area
-		 * structure, then within the current linked-list area
-		 * structure, increment number of exposures & hits and
-		 * increment seen, then exit for-loop.
-		 */
-		if ((BU_STR_EQUAL(area_record_ptr->name, &buffer[l]))) {
-		    if (type == EXPOSED_AREA) {
-			if (!area_record_ptr->seen) {
-			    area_record_ptr->exposures++;
-			    area_record_ptr->seen++;
-			    area_record_ptr->hits++;
-
-			    /* total x, y, z for exposed & presented hits */
-			    if (rtarea_compute_centers) {
-				area_record_ptr->group_exposed_hit_x_sum += (fastf_t)((*hit_point)[X]);
-				area_record_ptr->group_exposed_hit_y_sum += (fastf_t)((*hit_point)[Y]);
-				area_record_ptr->group_exposed_hit_z_sum += (fastf_t)((*hit_point)[Z]);
-				area_record_ptr->group_presented_hit_x_sum += (fastf_t)((*hit_point)[X]);
-				area_record_ptr->group_presented_hit_y_sum += (fastf_t)((*hit_point)[Y]);
-				area_record_ptr->group_presented_hit_z_sum += (fastf_t)((*hit_point)[Z]);
-			    }
-
-			    if (depth > area_record_ptr->depth) {
-				area_record_ptr->depth = depth;
-			    }
-			}
-		    }
-		    if (type == PRESENTED_AREA) {
-			if (!area_record_ptr->seen) {
-			    area_record_ptr->hits++;
-			    area_record_ptr->seen++;
-
-			    /* total x, y, z for presented hits */
-			    if (rtarea_compute_centers) {
-				area_record_ptr->group_presented_hit_x_sum += (fastf_t)((*hit_point)[X]);
-				area_record_ptr->group_presented_hit_y_sum += (fastf_t)((*hit_point)[Y]);
-				area_record_ptr->group_presented_hit_z_sum += (fastf_t)((*hit_point)[Z]);
-			    }
-
-			    if (depth > area_record_ptr->depth) {
-				area_record_ptr->depth = depth;
-			    }
-			}
-		    }
-		    parent_found=1;
-		    break;
-		}
-	    }
-
-	    /* if a parent of the current region does not already exist in the
-	     * assembly linked-list then create, populate, insert new area record
-	     * into the assembly linked-list.
-	     */
-	    if (!parent_found) {
-		char *name;
-		size_t len;
-
-		/* create new area record */
-		BU_ALLOC(area_record_ptr, struct area);
-
-		/* initialize new parent-area record (i.e. assembly-area record) */
-		area_record_ptr->assembly = (struct area *) NULL;
-		area_record_ptr->hits = 0;
-		area_record_ptr->exposures = 0;
-		area_record_ptr->seen = 0;
-		area_record_ptr->depth = 0;
-		area_record_ptr->name = (char *) NULL;
-		area_record_ptr->hit_points = (struct point_list *) NULL;
-		area_record_ptr->exp_points = (struct point_list *) NULL;
-		area_record_ptr->num_hit_points = 0;
-		area_record_ptr->num_exp_points = 0;
-		area_record_ptr->group_exposed_hit_x_sum = 0.0;
-		area_record_ptr->group_exposed_hit_y_sum = 0.0;
-		area_record_ptr->group_exposed_hit_z_sum = 0.0;
-		area_record_ptr->group_presented_hit_x_sum = 0.0;
-		area_record_ptr->group_presented_hit_y_sum = 0.0;
-		area_record_ptr->group_presented_hit_z_sum = 0.0;
-
-		/* allocate string to contain the object/parent/group name, copy the
-		 * name to the new string, assign the string to the parent-area record.
-		 */
-		len = strlen(&buffer[l])+1;
-		name = (char *)bu_malloc(len, "increment_assembly_counter assembly name allocation");
-		bu_strlcpy(name, &buffer[l], len);
-
-		/* populate parent-area record */
-		area_record_ptr->name = name;
-
-		if (type == EXPOSED_AREA) {
-		    area_record_ptr->exposures++;
-		    area_record_ptr->hits++;
-		    /* total x, y, z for exposed & presented hits */
-		    if (rtarea_compute_centers) {
-			area_record_ptr->group_exposed_hit_x_sum += (fastf_t)((*hit_point)[X]);
-			area_record_ptr->group_exposed_hit_y_sum += (fastf_t)((*hit_point)[Y]);
-			area_record_ptr->group_exposed_hit_z_sum += (fastf_t)((*hit_point)[Z]);
-			area_record_ptr->group_presented_hit_x_sum += (fastf_t)((*hit_point)[X]);
-			area_record_ptr->group_presented_hit_y_sum += (fastf_t)((*hit_point)[Y]);
-			area_record_ptr->group_presented_hit_z_sum += (fastf_t)((*hit_point)[Z]);
-		    }
-		}
-		if (type == PRESENTED_AREA) {
-		    area_record_ptr->hits++;
-		    /* total x, y, z for presented hits */
-		    if (rtarea_compute_centers) {
-			area_record_ptr->group_presented_hit_x_sum += (fastf_t)((*hit_point)[X]);
-			area_record_ptr->group_presented_hit_y_sum += (fastf_t)((*hit_point)[Y]);
-			area_record_ptr->group_presented_hit_z_sum += (fastf_t)((*hit_point)[Z]);
-		    }
-		}
 
-		/* always mark the current parent as seen since this is a new
-		 * parent-area record and it is being processed now.
-		 */
-		area_record_ptr->seen++;
+    for (i = area_parent_start[bit]; i < area_parent_start[bit+1]; i++) {
+	size_t a = area_parents[i].assembly;
 
-		if (depth > area_record_ptr->depth) {
-		    area_record_ptr->depth = depth;
-		}
-		/* attach new area record to assembly linked-list */
-		BU_LIST_PUSH(&(assembly_head_ptr->l), &(area_record_ptr->l));
-	    }
-	    buffer[l-1] = '\0';
-	    depth++;
+	if (t->asm_seen[a] == t->serial)
+	    continue;
+	t->asm_seen[a] = t->serial;
+
+	t->asm_hits[a]++;
+	if (type == EXPOSED_AREA)
+	    t->asm_exposures[a]++;
+	if (rtarea_compute_centers) {
+	    VADD2(t->asm_hit_pt[a], t->asm_hit_pt[a], hit_point);
+	    if (type == EXPOSED_AREA)
+		VADD2(t->asm_exp_pt[a], t->asm_exp_pt[a], hit_point);
 	}
-	l--;
+	if (area_parents[i].depth > t->asm_depth[a])
+	    t->asm_depth[a] = area_parents[i].depth;
     }
-    bu_free(buffer, "increment_assembly_counter buffer free");
-    return;
 }
 
 
@@ -355,179 +275,49 @@ raymiss(struct application *UNUSED(ap))
 int
 rayhit(struct application *ap, struct partition *PartHeadp, struct seg *UNUSED(segHeadp))
 {
-    struct point_list * temp_point_list;           /* to contain exposed points */
-    struct point_list * temp_presented_point_list; /* to contain presented points */
-    register struct region *rp;
-    struct rt_i *rtip = ap->a_rt_i;
     register struct partition *pp = PartHeadp->pt_forw;
-    register struct area *cell;
-    struct area *cellp;
+    struct area_tally *t;
+    int cpu = ap->a_resource->re_cpu;
 
     if (pp == PartHeadp)
 	return 0;		/* nothing was actually hit?? */
 
-    /* ugh, horrible block */
-    bu_semaphore_acquire(RT_SEM_RESULTS);
+    /* each thread only ever touches its own tally */
+    t = area_tallies[cpu];
+    if (!t)
+	t = area_tallies[cpu] = area_tally_create();
 
-    hit_count++;
+    t->hit_count++;
 
-    /* traverse all regions in the model, clear seen in the 'area' record
-     * associated with each region.
-     */
-    for (BU_LIST_FOR(rp, region, &(rtip->HeadRegion))) {
-	cell = (struct area *)rp->reg_udata;
-	cell->seen = 0;
-    }
+    /* a new ray, so nothing has been seen yet */
+    t->serial++;
 
-    /* clear seen for all 'area' records associated with groups */
-    rp = BU_LIST_FIRST(region, &(rtip->HeadRegion));
-    cell = (struct area *)rp->reg_udata;
-    for (BU_LIST_FOR(cellp, area, &(cell->assembly->l))) {
-	cellp->seen = 0;
-    }
-
-    /* get the exposed areas (i.e. first hits), traverse linked-list of
-     * partition records.
-     */
+    /* get the exposed area (i.e. the first non-air hit) */
     for (BU_LIST_FOR(pp, partition, (struct bu_list *)PartHeadp)) {
 	struct region *reg = pp->pt_regionp;
 
-	/* obtain the pointer to the area record associated with the current
-	 * region being processed.
-	 */
-	cell = (struct area *)reg->reg_udata;
-
-	/* ignore air. if the current region is of type 'air' skip this region
-	 * and continue with the next region hit by the ray.
-	 */
+	/* ignore air */
 	if (reg->reg_aircode) {
 	    continue;
 	}
 
-	/* only process this hit if the region has not already been hit by this
-	 * ray. this allows only exposed regions to be processed. (i.e. 1st hit)
-	 */
-	if (!cell->seen) {  /* for exposed areas */
-	    if (rtarea_compute_centers) {
-
-		/* create a new 'exposed' point_list record */
-		BU_ALLOC(temp_point_list, struct point_list);
-
-		/* create a new 'presented' point_list record */
-		BU_ALLOC(temp_presented_point_list, struct point_list);
-
-		/* initialize new 'exposed' point_list record */
-		temp_point_list->next = (struct point_list *) NULL;
-		(temp_point_list->pt_cell)[X] = 0.0;
-		(temp_point_list->pt_cell)[Y] = 0.0;
-		(temp_point_list->pt_cell)[Z] = 0.0;
-
-		/* initialize new 'presented' point_list record */
-		temp_presented_point_list->next = (struct point_list *) NULL;
-		(temp_presented_point_list->pt_cell)[X] = 0.0;
-		(temp_presented_point_list->pt_cell)[Y] = 0.0;
-		(temp_presented_point_list->pt_cell)[Z] = 0.0;
-
-		/* compute hit_point and store in pt_inhit record within the
-		 * current partition record
-		 */
-		VJOIN1(pp->pt_inhit->hit_point, ap->a_ray.r_pt, pp->pt_inhit->hit_dist, ap->a_ray.r_dir);
-
-		/* place hit_point in new 'exposed' point_list record */
-		(temp_point_list->pt_cell)[X] = (pp->pt_inhit->hit_point)[X];
-		(temp_point_list->pt_cell)[Y] = (pp->pt_inhit->hit_point)[Y];
-		(temp_point_list->pt_cell)[Z] = (pp->pt_inhit->hit_point)[Z];
-
-		/* place hit_point in new 'presented' point_list record */
-		(temp_presented_point_list->pt_cell)[X] = (pp->pt_inhit->hit_point)[X];
-		(temp_presented_point_list->pt_cell)[Y] = (pp->pt_inhit->hit_point)[Y];
-		(temp_presented_point_list->pt_cell)[Z] = (pp->pt_inhit->hit_point)[Z];
-
-		/* for computing exposed area center, count hits and sum x, y, z
-		 * values of hits on exposed regions
-		 */
-		exposed_hit_sum++;
-		exposed_hit_x_sum = exposed_hit_x_sum + (fastf_t)((pp->pt_inhit->hit_point)[X]);
-		exposed_hit_y_sum = exposed_hit_y_sum + (fastf_t)((pp->pt_inhit->hit_point)[Y]);
-		exposed_hit_z_sum = exposed_hit_z_sum + (fastf_t)((pp->pt_inhit->hit_point)[Z]);
-
-		/* if current area record contains no point_list linked-list then
-		 * place the new and first point_list record in the area record.
-		 * if the current area record already has a point_list record
-		 * linked-list, then add the new point_list record to the head of
-		 * the linked-list.
-		 */
-		if (!cell->exp_points) {
-		    cell->exp_points = temp_point_list;
-		} else {
-		    temp_point_list->next = cell->exp_points;
-		    cell->exp_points = temp_point_list;
-		}
+	if (rtarea_compute_centers) {
+	    VJOIN1(pp->pt_inhit->hit_point, ap->a_ray.r_pt, pp->pt_inhit->hit_dist, ap->a_ray.r_dir);
 
-		/* if current area record contains no 'presented' point_list linked-list
-		 * then place the new and first point_list record in the area record.
-		 * if the current area record already has a point_list record
-		 * linked-list, then add the new point_list record to the head of
-		 * the linked-list.
-		 */
-		if (!cell->hit_points) {
-		    cell->hit_points = temp_presented_point_list;
-		} else {
-		    temp_presented_point_list->next = cell->hit_points;
-		    cell->hit_points = temp_presented_point_list;
-		}
-
-		/* for the current area record, increment num_exp_points which
-		 * maintains a count of the number of records within the point_list
-		 * linked-list and also the total of exposed hits on the current
-		 * region.
-		 */
-		cell->num_exp_points++;
-
-		/* for the current area record, increment num_hit_points which
-		 * maintains a count of the number of records within the
-		 * 'presented' point_list linked-list and also the total of
-		 * presented hits on the current region.
-		 */
-		cell->num_hit_points++;
-	    }
-
-	    /* for the current area structure, increment exposures and seen */
-	    cell->exposures++;
-	    cell->seen++;
-
-	    /* increment 'presented hits' for current region since all hits on a
-	     * region are 'presented hits' even those that are a first-hit on a ray.
-	     */
-	    cell->hits++;
-
-	    /* if the current area record does not contain the region name that
-	     * it represents then extract the region name from the object path
-	     * then assign the name within the area record.
-	     */
-	    if (!cell->name) {
-		size_t l = strlen(reg->reg_name);
-		while (l > 0) {
-		    if (reg->reg_name[l-1] == '/') {
-			break;
-		    }
-		    l--;
-		}
-		cell->name = &reg->reg_name[l];
-	    }
-
-	    /* record the parent assemblies */
-	    increment_assembly_counter(cell, reg->reg_name, EXPOSED_AREA, &(pp->pt_inhit->hit_point));
+	    /* for computing exposed area center */
+	    t->exposed_hit_sum++;
+	    VADD2(t->exposed_hit_pt, t->exposed_hit_pt, pp->pt_inhit->hit_point);
 	}
 
+	tally_hit(t, (size_t)reg->reg_bit, EXPOSED_AREA, pp->pt_inhit->hit_point);
+
 	/* halt after first non-air */
 	break;
-    } /* end of for-loop to 'get the exposed areas (i.e. first hits)' */
+    }
 
     /* get the presented areas */
     for (BU_LIST_FOR(pp, partition, (struct bu_list *)PartHeadp)) {
 	struct region *reg = pp->pt_regionp;
-	cell = (struct area *)reg->reg_udata;
 
 	/* ignore air */
 	if (reg->reg_aircode) {
@@ -535,63 +325,16 @@ rayhit(struct application *ap, struct partition *PartHeadp, struct seg *UNUSED(s
 	}
 
 	/* makes sure that a region already processed is not processed again */
-	if (!cell->seen) {
-
-	    /* marks the current region being processed as 'seen'='yes' so that
-	     * additional hits of this region by this ray are not processed.
-	     */
-	    cell->seen++;
-
-	    /* increments the presented hits on the current region because all
-	     * hits on a region are considered part of presented area of that region.
-	     *
-	     * do not increment exposed hits here because all exposed hit on all
-	     * regions have already been processed in the previous loop used to
-	     * process the first hit of the current ray.
-	     */
-	    cell->hits++;
-
-	    /* enable/disable center point processing */
-	    if (rtarea_compute_centers) {
-		cell->num_hit_points++;
-
-		/* allocate memory for point_list structure */
-		BU_ALLOC(temp_point_list, struct point_list);
-
-		/* compute hit point */
-		VJOIN1(pp->pt_inhit->hit_point, ap->a_ray.r_pt, pp->pt_inhit->hit_dist, ap->a_ray.r_dir);
-
-		/* record the points in the area */
-		(temp_point_list->pt_cell)[X] = (pp->pt_inhit->hit_point)[X];
-		(temp_point_list->pt_cell)[Y] = (pp->pt_inhit->hit_point)[Y];
-		(temp_point_list->pt_cell)[Z] = (pp->pt_inhit->hit_point)[Z];
-		temp_point_list->next = (struct point_list *) NULL;
-
-		if (!cell->hit_points) {
-		    cell->hit_points = temp_point_list;
-		} else {
-		    temp_point_list->next = cell->hit_points;
-		    cell->hit_points = temp_point_list;
-		}
-	    }
-
-	    if (!cell->name) {
-		/* get the region name */
-		size_t l = strlen(reg->reg_name);
-		while (l > 0) {
-		    if (reg->reg_name[l-1] == '/') {
-			break;
-		    }
-		    l--;
-		}
-		cell->name = &reg->reg_name[l];
-	    }
+	if (t->reg_seen[reg->reg_bit] == t->serial) {
+	    continue;
+	}
 
-	    /* record the parent assemblies */
-	    increment_assembly_counter(cell, reg->reg_name, PRESENTED_AREA, &(pp->pt_inhit->hit_point));
+	if (rtarea_compute_centers) {
+	    VJOIN1(pp->pt_inhit->hit_point, ap->a_ray.r_pt, pp->pt_inhit->hit_dist, ap->a_ray.r_dir);
 	}
+
+	tally_hit(t, (size_t)reg->reg_bit, PRESENTED_AREA, pp->pt_inhit->hit_point);
     }
-    bu_semaphore_release(RT_SEM_RESULTS);
 
     return 0;
 }
@@ -711,12 +454,11 @@ print_region_area_list(size_t *count, struct rt_i *rtip, area_type_t type)
 		   bu_units_string(factor)
 		);
 	    if (rtarea_compute_centers) {
-		point_t temp;
-		if (area_center((cell->hit_points), (cell->num_hit_points), &temp)) {
+		if (cell->hits) {
 		    bu_log("\tcenter at (%.4lf, %.4lf, %.4lf) %s",
-			   temp[X]/units,
-			   temp[Y]/units,
-			   temp[Z]/units,
+			   cell->group_presented_hit_x_sum / (fastf_t)cell->hits / units,
+			   cell->group_presented_hit_y_sum / (fastf_t)cell->hits / units,
+			   cell->group_presented_hit_z_sum / (fastf_t)cell->hits / units,
 			   bu_units_string(units)
 			);
 		}
@@ -732,12 +474,11 @@ print_region_area_list(size_t *count, struct rt_i *rtip, area_type_t type)
 		   bu_units_string(factor)
 		);
 	    if (rtarea_compute_centers) {
-		point_t temp;
-		if (area_center((cell->exp_points), (cell->num_exp_points), &temp)) {
+		if (cell->exposures) {
 		    bu_log("\tcenter at (%.4lf, %.4lf, %.4lf) %s",
-			   temp[X]/units,
-			   temp[Y]/units,
-			   temp[Z]/units,
+			   cell->group_exposed_hit_x_sum / (fastf_t)cell->exposures / units,
+			   cell->group_exposed_hit_y_sum / (fastf_t)cell->exposures / units,
+			   cell->group_exposed_hit_z_sum / (fastf_t)cell->exposures / units,
 			   bu_units_string(units)
 			);
 		}
@@ -918,6 +659,57 @@ view_end(struct application *ap)
 
     double factor = 1.0; /* show local database units in parens by default */
 
+    size_t i;
+
+    /* sum up what each thread saw */
+    for (i = 0; i < MAX_PSW; i++) {
+	struct area_tally *t = area_tallies[i];
+	size_t j;
+
+	if (!t)
+	    continue;
+
+	hit_count += t->hit_count;
+	exposed_hit_sum += t->exposed_hit_sum;
+	exposed_hit_x_sum += t->exposed_hit_pt[X];
+	exposed_hit_y_sum += t->exposed_hit_pt[Y];
+	exposed_hit_z_sum += t->exposed_hit_pt[Z];
+
+	for (BU_LIST_FOR(rp, region, &(rtip->HeadRegion))) {
+	    j = (size_t)rp->reg_bit;
+	    cell = (struct area *)rp->reg_udata;
+	    cell->hits += t->reg_hits[j];
+	    cell->exposures += t->reg_exposures[j];
+	    if (rtarea_compute_centers) {
+		cell->group_presented_hit_x_sum += t->reg_hit_pt[j][X];
+		cell->group_presented_hit_y_sum += t->reg_hit_pt[j][Y];
+		cell->group_presented_hit_z_sum += t->reg_hit_pt[j][Z];
+		cell->group_exposed_hit_x_sum += t->reg_exp_pt[j][X];
+		cell->group_exposed_hit_y_sum += t->reg_exp_pt[j][Y];
+		cell->group_exposed_hit_z_sum += t->reg_exp_pt[j][Z];
+	    }
+	}
+
+	for (j = 0; j < area_nassemblies; j++) {
+	    cell = area_assemblies[j];
+	    cell->hits += t->asm_hits[j];
+	    cell->exposures += t->asm_exposures[j];
+	    if (t->asm_depth[j] > cell->depth)
+		cell->depth = t->asm_depth[j];
+	    if (rtarea_compute_centers) {
+		cell->group_presented_hit_x_sum += t->asm_hit_pt[j][X];
+		cell->group_presented_hit_y_sum += t->asm_hit_pt[j][Y];
+		cell->group_presented_hit_z_sum += t->asm_hit_pt[j][Z];
+		cell->group_exposed_hit_x_sum += t->asm_exp_pt[j][X];
+		cell->group_exposed_hit_y_sum += t->asm_exp_pt[j][Y];
+		cell->group_exposed_hit_z_sum += t->asm_exp_pt[j][Z];
+	    }
+	}
+
+	area_tally_free(t);
+	area_tallies[i] = NULL;
+    }
+
     /* if not specified by user use local database units for summary units */
     if (model_units) {
 	units = rtip->rti_dbip->dbi_local2base;
@@ -996,35 +788,14 @@ view_end(struct application *ap)
 	   "********************************************************************\n"
 	   "\n");
 
-    /* free the assembly areas */
-    cell = (struct area *)rp->reg_udata;
+    /* free the assembly areas, all regions share the one list */
+    rp = BU_LIST_FIRST(region, &(rtip->HeadRegion));
+    cell = BU_LIST_IS_HEAD(rp, &(rtip->HeadRegion)) ? NULL : (struct area *)rp->reg_udata;
     if (cell) {
 	while (BU_LIST_WHILE(cellp, area, &(cell->assembly->l))) {
 	    if (cellp->name) {
 		bu_free((char *)cellp->name, "view_end assembly name free");
 	    }
-	    if (rtarea_compute_centers) {
-		if (cellp->exp_points) {
-		    struct point_list * point, * next_point;
-		    point = cellp->exp_points;
-		    while (point) {
-			/*next_point = BU_LIST_NEXT(point_list, &(point->l));*/
-			next_point = point->next;
-			bu_free(point, "exposed point_list free");
-			point = next_point;
-		    }
-		}
-		if (cellp->hit_points) {
-		    struct point_list * point, * next_point;
-		    point = cellp->hit_points;
-		    while (point) {
-			/*next_point = BU_LIST_NEXT(point_list, &(point->l));*/
-			next_point = point->next;
-			bu_free(point, "presented point_list free");
-			point = next_point;
-		    }
-		}
-	    }
 	    BU_LIST_DEQUEUE(&(cellp->l));
 	    bu_free(cellp, "free assembly-area entry");
 	}
@@ -1035,33 +806,20 @@ view_end(struct application *ap)
     for (BU_LIST_FOR(rp, region, &(rtip->HeadRegion))) {
 	cell = (struct area *)rp->reg_udata;
 	if (cell) {
-	    if (rtarea_compute_centers) {
-		if (cell->exp_points) {
-		    struct point_list * point, * next_point;
-		    point = cell->exp_points;
-		    while (point) {
-			/*next_point = BU_LIST_NEXT(point_list, &(point->l));*/
-			next_point = point->next;
-			bu_free(point, "exposed point_list free");
-			point = next_point;
-		    }
-		}
-		if (cell->hit_points) {
-		    struct point_list * point, * next_point;
-		    point = cell->hit_points;
-		    while (point) {
-			/*next_point = BU_LIST_NEXT(point_list, &(point->l));*/
-			next_point = point->next;
-			bu_free(point, "presented point_list free");
-			point = next_point;
-		    }
-		}
-	    }
 	    bu_free(cell, "view_end area free");
-	    cell = (void *)NULL;
+	    rp->reg_udata = NULL;
 	}
     }
 
+    bu_free(area_assemblies, "view_end assembly table free");
+    bu_free(area_parent_start, "view_end parent start free");
+    bu_free(area_parents, "view_end parents free");
+    area_assemblies = NULL;
+    area_parent_start = NULL;
+    area_parents = NULL;
+    area_nassemblies = 0;
+    area_nregions = 0;
+
     /* flush for good measure */
     fflush(stdout); fflush(stderr);
     return;
@@ -1077,6 +835,9 @@ view_2init(struct application *ap, char *UNUSED(framename))
 {
     register struct region *rp;
     register struct rt_i *rtip = ap->a_rt_i;
+    bu_hash_tbl *names;
+    size_t nparents = 0, max_parents = 0, max_assemblies = 0;
+    size_t i;
 
     /* initial empty parent assembly */
     struct area *assembly;
@@ -1084,67 +845,111 @@ view_2init(struct application *ap, char *UNUSED(framename))
     /* cell_width, cell_height, and hypersample are global variables */
     cell_area = cell_width * cell_height / (hypersample + 1);
 
-    /* create first parent-area record */
-    BU_ALLOC(assembly, struct area);
-
-    /* initialize linked-list pointers for first parent-area record */
-    BU_LIST_INIT(&(assembly->l));
-
-    /* initialize first parent-area record */
-    assembly->assembly = (struct area *) NULL;
-    assembly->hits = 0;
-    assembly->exposures = 0;
-    assembly->seen = 0;
-    assembly->depth = 0;
-    assembly->name = (char *) NULL;
-    assembly->hit_points = (struct point_list *) NULL;
-    assembly->exp_points = (struct point_list *) NULL;
-    assembly->num_hit_points = 0;
-    assembly->num_exp_points = 0;
-    assembly->group_exposed_hit_x_sum = 0.0;
-    assembly->group_exposed_hit_y_sum = 0.0;
-    assembly->group_exposed_hit_z_sum = 0.0;
-    assembly->group_presented_hit_x_sum = 0.0;
-    assembly->group_presented_hit_y_sum = 0.0;
-    assembly->group_presented_hit_z_sum = 0.0;
-
-    bu_semaphore_acquire(RT_SEM_RESULTS);
-
-    /* traverse the regions linked-list, create and assign an empty area record
-     * to each region record.
+    hit_count = 0;
+    exposed_hit_sum = 0;
+    exposed_hit_x_sum = exposed_hit_y_sum = exposed_hit_z_sum = 0.0;
+
+    /* create first parent-area record, the head of the assembly list */
+    assembly = area_create(NULL, NULL);
+
+    /* Work out the parent assemblies of every region up front, so rays
+     * only have to index into the per-thread tallies.  Assemblies are
+     * known by name alone, wherever they appear in the tree.
      */
+    area_nregions = rtip->nregions;
+    area_parent_start = (size_t *)bu_calloc(area_nregions + 1, sizeof(size_t), "area_parent_start");
+    names = bu_hash_create(1024);
+
     for (BU_LIST_FOR(rp, region, &(rtip->HeadRegion))) {
-	struct area *cell;
-
-	/* create region-area record */
-	BU_ALLOC(cell, struct area);
-
-	/* initialize linked-list pointers for region-area record */
-	BU_LIST_INIT(&(cell->l));
-
-	/* initialize region-area record */
-	cell->assembly = assembly;
-	cell->hits = 0;
-	cell->exposures = 0;
-	cell->seen = 0;
-	cell->depth = 0;
-	cell->name = (char *) NULL;
-	cell->hit_points = (struct point_list *) NULL;
-	cell->exp_points = (struct point_list *) NULL;
-	cell->num_hit_points = 0;
-	cell->num_exp_points = 0;
-	cell->group_exposed_hit_x_sum = 0.0;
-	cell->group_exposed_hit_y_sum = 0.0;
-	cell->group_exposed_hit_z_sum = 0.0;
-	cell->group_presented_hit_x_sum = 0.0;
-	cell->group_presented_hit_y_sum = 0.0;
-	cell->group_presented_hit_z_sum = 0.0;
-
-	/* place new region-area record into current region record */
-	rp->reg_udata = (void *)cell;
+	char *buffer;
+	size_t l, depth = 0;
+
+	/* trim off the region name, then walk up the path */
+	buffer = bu_strdup(rp->reg_name);
+	l = strlen(buffer);
+	while (l > 0) {
+	    if (buffer[l-1] == '/') {
+		break;
+	    }
+	    l--;
+	}
+
+	/* create region-area record, named by the last path element */
+	rp->reg_udata = (void *)area_create(assembly, &rp->reg_name[l]);
+	if (l > 0)
+	    buffer[l-1] = '\0';
+	while (l > 0) {
+	    if (buffer[l-1] == '/') {
+		size_t idx = (size_t)(uintptr_t)bu_hash_get(names, (const uint8_t *)&buffer[l], strlen(&buffer[l]));
+
+		if (!idx) {
+		    struct area *parent = area_create(NULL, bu_strdup(&buffer[l]));
+		    if (area_nassemblies == max_assemblies) {
+			max_assemblies = (max_assemblies) ? max_assemblies * 2 : 64;
+			area_assemblies = (struct area **)bu_realloc(area_assemblies, max_assemblies * sizeof(struct area *), "area_assemblies");
+		    }
+		    area_assemblies[area_nassemblies++] = parent;
+		    idx = area_nassemblies;
+		    bu_hash_set(names, (const uint8_t *)&buffer[l], strlen(&buffer[l]), (void *)(uintptr_t)idx);
+
+		    /* attach new area record to assembly linked-list */
+		    BU_LIST_PUSH(&(assembly->l), &(parent->l));
+		}
+
+		if (nparents == max_parents) {
+		    max_parents = (max_parents) ? max_parents * 2 : 256;
+		    area_parents = (struct area_parent *)bu_realloc(area_parents, max_parents * sizeof(struct area_parent), "area_parents");
+		}
+		area_parents[nparents].assembly = idx - 1;
+		area_parents[nparents].depth = depth;
+		nparents++;
+
+		buffer[l-1] = '\0';
+		depth++;
+	    }
+	    l--;
+	}
+	bu_free(buffer, "view_2init path");
+
+	/* parents are recorded in HeadRegion order, note where each
+	 * region's start (regions are renumbered below) */
+	area_parent_start[rp->reg_bit + 1] = nparents;
     }
+    bu_hash_destroy(names);
 
-    bu_semaphore_release(RT_SEM_RESULTS);
+    /* The entries above were counted into reg_bit+1 as running totals
+     * in list order.  Convert them to per-region counts and re-sum in
+     * reg_bit order, moving the entries to match.
+     */
+    {
+	struct area_parent *sorted;
+	size_t prev = 0, j, *cnt;
+
+	cnt = (size_t *)bu_calloc(area_nregions + 1, sizeof(size_t), "area_parent counts");
+	for (BU_LIST_FOR(rp, region, &(rtip->HeadRegion))) {
+	    size_t end = area_parent_start[rp->reg_bit + 1];
+	    cnt[rp->reg_bit] = end - prev;
+	    prev = end;
+	}
+	area_parent_start[0] = 0;
+	for (i = 0; i < area_nregions; i++)
+	    area_parent_start[i + 1] = area_parent_start[i] + cnt[i];
+
+	sorted = (struct area_parent *)bu_calloc(nparents ? nparents : 1, sizeof(struct area_parent), "area_parents");
+	prev = 0;
+	for (BU_LIST_FOR(rp, region, &(rtip->HeadRegion))) {
+	    for (j = 0; j < cnt[rp->reg_bit]; j++)
+		sorted[area_parent_start[rp->reg_bit] + j] = area_parents[prev + j];
+	    prev += cnt[rp->reg_bit];
+	}
+	bu_free(cnt, "area_parent counts");
+	if (area_parents)
+	    bu_free(area_parents, "area_parents");
+	area_parents = sorted;
+    }
+
+    for (i = 0; i < MAX_PSW; i++)
+	area_tallies[i] = NULL;
 
     return;
 }
@@ -1164,8 +969,6 @@ view_init(struct application *ap, char *UNUSED(file), char *UNUSED(obj), int UNU
 
     output_is_binary = 0;		/* output is printable ascii */
 
-    hit_count = 0;
-
     return 0;		/* No framebuffer needed */
 }
 
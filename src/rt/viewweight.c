@@ -70,13 +70,18 @@ FILE *densityfp;
 
 struct analyze_densities *density = NULL;
 
-struct datapoint {
-    struct datapoint *next;
-    vect_t centroid;
-    fastf_t weight;
+/* What one thread has found in one region.  Each thread sums into
+ * its own array, indexed by region bit number, and the arrays are
+ * added up in view_end().
+ */
+struct region_tally {
     fastf_t volume;
+    fastf_t weight;
+    vect_t moment;	/* weight times centroid */
 };
 
+static struct region_tally *tallies[MAX_PSW];
+
 
 extern int rpt_overlap;     	/* report region verbosely */
 extern fastf_t cell_width;      	/* model space grid cell width */
@@ -336,14 +341,22 @@ hit(struct application *ap, struct partition *PartHeadp, struct seg *UNUSED(segp
 {
     struct partition *pp;
     register struct xray *rp = &ap->a_ray;
-    void *addp;
+    struct region_tally *tally;
+    int cpu = ap->a_resource->re_cpu;
+
+    /* each thread only ever touches its own tally */
+    tally = tallies[cpu];
+    if (!tally) {
+	size_t nregions = ap->a_rt_i->nregions;
+	tally = tallies[cpu] = (struct region_tally *)bu_calloc(nregions ? nregions : 1, sizeof(struct region_tally), "region tally");
+    }
 
     for (pp = PartHeadp->pt_forw; pp != PartHeadp; pp = pp->pt_forw) {
 	register struct region *reg = pp->pt_regionp;
 	register struct hit *ihitp = pp->pt_inhit;
 	register struct hit *ohitp = pp->pt_outhit;
 	register fastf_t depth;
-	register struct datapoint *dp;
+	register struct region_tally *tp;
 	long int material_id = reg->reg_gmater;
 	fastf_t density_factor = analyze_densities_density(density, material_id);
 
@@ -355,14 +368,7 @@ hit(struct application *ap, struct partition *PartHeadp, struct seg *UNUSED(segp
 	VJOIN1(ohitp->hit_point, rp->r_pt, ohitp->hit_dist, rp->r_dir);
 	depth = ohitp->hit_dist - ihitp->hit_dist;
 
-	/* add the datapoint structure in and then calculate it
-	   in parallel, the region structures are a shared resource */
-	BU_ALLOC(dp, struct datapoint);
-	bu_semaphore_acquire(BU_SEM_SYSCALL);
-	addp = reg->reg_udata;
-	reg->reg_udata = (void *)dp;
-	dp->next = (struct datapoint *)addp;
-	bu_semaphore_release(BU_SEM_SYSCALL);
+	tp = &tally[reg->reg_bit];
 
 	/* no density factor means we use a default (zero) */
 	{
@@ -391,12 +397,16 @@ hit(struct application *ap, struct partition *PartHeadp, struct seg *UNUSED(segp
 	    /* convert reg_los percentage to factor */
 	    const fastf_t los_factor = (fastf_t)reg->reg_los * 0.01;
 
-	    dp->volume = partition_volume;
-	    VBLEND2(dp->centroid, 0.5, ihitp->hit_point, 0.5, ohitp->hit_point);
+	    tp->volume += partition_volume;
 
 	    if (density_factor >= 0) {
 		/* Compute mass in terms of grams */
-		dp->weight = partition_volume * los_factor * density_factor;
+		const fastf_t weight = partition_volume * los_factor * density_factor;
+		point_t centroid;
+
+		VBLEND2(centroid, 0.5, ihitp->hit_point, 0.5, ohitp->hit_point);
+		tp->weight += weight;
+		VJOIN1(tp->moment, tp->moment, weight, centroid);
 	    }
 	}
     }
@@ -446,11 +456,10 @@ view_init(struct application *ap, char *UNUSED(file), char *UNUSED(obj), int min
 void
 view_2init(struct application *ap, char *UNUSED(framename))
 {
-    register struct region *rp;
-    register struct rt_i *rtip = ap->a_rt_i;
+    int i;
 
-    for (BU_LIST_FOR(rp, region, &(rtip->HeadRegion))) {
-	rp->reg_udata = (void *)NULL;
+    for (i = 0; i < MAX_PSW; i++) {
+	tallies[i] = NULL;
     }
 }
 
@@ -491,7 +500,6 @@ region_ID_cmp(const void *p1, const void *p2, void *UNUSED(arg))
 void
 view_end(struct application *ap)
 {
-    register struct datapoint *dp;
     register struct region *rp;
     register fastf_t total_weight = 0;
     fastf_t sum_x = 0, sum_y = 0, sum_z = 0;
@@ -513,6 +521,10 @@ view_end(struct application *ap)
     int nregions = 0;
     int ridx; /* for region array */
 
+    /* per-region totals, by region bit number */
+    struct region_tally *reg_tally;
+    size_t i;
+
     /* default units */
     bu_strlcpy(units, "grams", sizeof(units));
     bu_strlcpy(unit2, bu_units_string(dbp->dbi_local2base), sizeof(unit2));
@@ -549,6 +561,35 @@ view_end(struct application *ap)
 	       dbp->dbi_base2local, units, unit2);
     }
 
+    /* add up what each thread found, in cpu order so a given
+     * assignment of work always produces the same sums
+     */
+    reg_tally = (struct region_tally *)bu_calloc(rtip->nregions ? rtip->nregions : 1, sizeof(struct region_tally), "reg_tally");
+    for (i = 0; i < MAX_PSW; i++) {
+	size_t j;
+
+	if (!tallies[i])
+	    continue;
+
+	for (j = 0; j < rtip->nregions; j++) {
+	    reg_tally[j].volume += tallies[i][j].volume;
+	    reg_tally[j].weight += tallies[i][j].weight;
+	    VADD2(reg_tally[j].moment, reg_tally[j].moment, tallies[i][j].moment);
+	}
+	bu_free(tallies[i], "region tally");
+	tallies[i] = NULL;
+    }
+
+    for (BU_LIST_FOR(rp, region, &(rtip->HeadRegion))) {
+	const struct region_tally *tp = &reg_tally[rp->reg_bit];
+
+	sum_x += tp->moment[X];
+	sum_y += tp->moment[Y];
+	sum_z += tp->moment[Z];
+	volume += tp->volume;
+	total_weight += tp->weight * conversion;
+    }
+
     if (noverlaps)
 	bu_log("%d overlap%c detected.\n\n", noverlaps,
 	       noverlaps==1 ? '\0' : 's');
@@ -582,32 +623,11 @@ view_end(struct application *ap)
 	   IDs used and count regions for later use; also do bookkeeping
 	   chores */
 	for (BU_LIST_FOR(rp, region, &(rtip->HeadRegion))) {
-	    register fastf_t weight = 0;
-	    register fastf_t *ptr;
-
 	    ++nregions; /* this is needed to create the region array */
 
 	    /* keep track of the highest region ID */
 	    if (max_item < rp->reg_regionid)
 		max_item = rp->reg_regionid;
-
-	    for (dp = (struct datapoint *)rp->reg_udata;
-		 dp != (struct datapoint *)NULL; dp = dp->next) {
-		sum_x += dp->weight * dp->centroid[X];
-		sum_y += dp->weight * dp->centroid[Y];
-		sum_z += dp->weight * dp->centroid[Z];
-		weight += dp->weight;
-		volume += dp->volume;
-	    }
-
-	    weight *= conversion;
-	    total_weight += weight;
-
-	    BU_ALLOC(ptr, fastf_t);
-	    *ptr = weight;
-	    /* FIXME: shouldn't the existing reg_udata be bu_free'd first (see previous loop) */
-	    /* FIXME: isn't the region list a "shared resource"? if so, can we use reg_udata so cavalierly? */
-	    rp->reg_udata = (void *)ptr;
 	}
 
 	/* make room for a zero ID number and an "end ID " so we can
@@ -628,11 +648,10 @@ view_end(struct application *ap)
 
 	    id = rp->reg_regionid;
 
-	    /* FIXME: shouldn't we bu_free reg_udata after using here? */
 	    if (item_wt[id] < 0)
-		item_wt[id] = *(fastf_t *)rp->reg_udata;
+		item_wt[id] = reg_tally[rp->reg_bit].weight * conversion;
 	    else
-		item_wt[id] += *(fastf_t *)rp->reg_udata;
+		item_wt[id] += reg_tally[rp->reg_bit].weight * conversion;
 	}
 
 	/* sort the region array by ID, then by name */
@@ -656,7 +675,7 @@ view_end(struct application *ap)
 		if (r->reg_regionid == id) {
 		    char *cname = analyze_densities_name(density, r->reg_gmater);
 		    fastf_t cdensity = analyze_densities_density(density, r->reg_gmater);
-		    fastf_t weight = *(fastf_t *)r->reg_udata;
+		    fastf_t weight = reg_tally[r->reg_bit].weight * conversion;
 		    fprintf(outfp, "%8.3f %5d  %3d %-15.15s %7.4f %s\n",
 			    weight,
 			    r->reg_gmater, r->reg_los,
@@ -716,10 +735,11 @@ view_end(struct application *ap)
 
 	/* now finished with heap variables */
 	bu_free(item_wt, "item_wt");
-	/* FIXME: shouldn't we bu_free reg_udata before freeing the region array? */
 	bu_free(rp_array, "rp_array");
     }
 
+    bu_free(reg_tally, "reg_tally");
+
     volume *= (dbp->dbi_base2local*dbp->dbi_base2local*dbp->dbi_base2local);
     sum_x *= (conversion / total_weight) * dbp->dbi_base2local;
     sum_y *= (conversion / total_weight) * dbp->dbi_base2local;
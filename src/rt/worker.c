@@ -79,6 +79,36 @@ int last_pixel = 0;			/* last pixel number */
 
 int stop_worker = 0;
 
+/**
+ * Adaptive hypersampling threshold, set with -c "set hyperAdapt=#".
+ * When non-zero and hypersampling, each pixel first gets one ray
+ * through its middle, and only pixels whose color, region or depth
+ * differs from a neighbor's by more than this get all hypersample+1
+ * rays.  Colors are compared per channel in 0..1, depths relative to
+ * the larger of the two.
+ */
+double hyper_adapt = 0.0;
+
+/* base sample of one pixel, for adaptive hypersampling */
+struct adapt_sample {
+    int state;		/* ADAPT_* */
+    float color[3];
+    float dist;		/* hit distance */
+    const void *uptr;	/* region shaded */
+};
+#define ADAPT_NONE 0	/* not shot */
+#define ADAPT_MISS 1
+#define ADAPT_HIT 2
+
+#define ADAPT_BAND 64	/* scanlines sampled and then refined at a time */
+
+static int first_pixel = 0;		/* first pixel number of this run */
+static int adapt_pass = 0;		/* 1: base samples, 2: refine */
+static struct adapt_sample *adapt_buf = NULL;
+static int adapt_first = 0;		/* pixel number of adapt_buf[0] */
+static int adapt_last = -1;
+static int adapt_nrefined[MAX_PSW];	/* pixels hypersampled by each cpu */
+
 /**
  * For certain hypersample values there is a particular advantage to
  * subdividing the pixel and shooting a ray in each sub-pixel.  This
@@ -148,6 +178,60 @@ jitter_start_pnt(vect_t point, struct application *a, int samplenum, int pat_num
 }
 
 
+/**
+ * Does neighboring pixel number pixelnum look different enough from s
+ * that the pixel s was taken from is on an edge?
+ */
+static int
+adapt_differs(const struct adapt_sample *s, int pixelnum)
+{
+    const struct adapt_sample *n;
+    int i;
+
+    if (pixelnum < adapt_first || pixelnum > adapt_last)
+	return 0;
+    n = &adapt_buf[pixelnum - adapt_first];
+    if (n->state == ADAPT_NONE)
+	return 0;
+
+    if (n->state != s->state || n->uptr != s->uptr)
+	return 1;
+    for (i = 0; i < 3; i++) {
+	if (fabs(n->color[i] - s->color[i]) > hyper_adapt)
+	    return 1;
+    }
+    if (s->state == ADAPT_HIT &&
+	fabs(n->dist - s->dist) > hyper_adapt * FMAX(fabs(n->dist), fabs(s->dist)))
+	return 1;
+
+    return 0;
+}
+
+
+/**
+ * Compare the base sample of a pixel with those of the four pixels
+ * around it.
+ */
+static int
+adapt_edge(int x, int y, int pixelnum)
+{
+    const struct adapt_sample *s = &adapt_buf[pixelnum - adapt_first];
+
+    if (s->state == ADAPT_NONE)
+	return 1;
+    if (x > 0 && adapt_differs(s, pixelnum - 1))
+	return 1;
+    if ((size_t)x < width - 1 && adapt_differs(s, pixelnum + 1))
+	return 1;
+    if (y > 0 && adapt_differs(s, pixelnum - (int)width))
+	return 1;
+    if ((size_t)y < height - 1 && adapt_differs(s, pixelnum + (int)width))
+	return 1;
+
+    return 0;
+}
+
+
 void
 do_pixel(int cpu, int pat_num, int pixelnum)
 {
@@ -216,6 +300,25 @@ do_pixel(int cpu, int pat_num, int pixelnum)
 	}
     }
 
+    if (adapt_pass == 2) {
+	const struct adapt_sample *s = &adapt_buf[pixelnum - adapt_first];
+
+	if (!adapt_edge(a.a_x, a.a_y, pixelnum)) {
+	    /* nothing changes around here, the base sample will do */
+	    VMOVE(a.a_color, s->color);
+	    a.a_user = (s->state == ADAPT_HIT);
+	    a.a_uptr = (void *)s->uptr;
+	    a.a_dist = s->dist;
+
+	    view_pixel(&a);
+	    if ((size_t)a.a_x == width-1) {
+		view_eol(&a);		/* End of scan line */
+	    }
+	    return;
+	}
+	adapt_nrefined[cpu]++;
+    }
+
     /* Check the pixel map to determine if this image should be
      * rendered or not.
      */
@@ -251,14 +354,17 @@ do_pixel(int cpu, int pat_num, int pixelnum)
      * XXX - If you edit the unrolled or non-unrolled section, be sure
      * to edit the other section.
      */
-    if (hypersample == 0) {
+    if (hypersample == 0 || adapt_pass == 1) {
 	/* not hypersampling, so just do it */
 
 	/****************/
 	/* BEGIN UNROLL */
 	/****************/
 
-	if (jitter & JITTER_CELL) {
+	if (adapt_pass == 1) {
+	    /* base sample from the middle of the cell */
+	    VJOIN2(point, viewbase_model, a.a_x + 0.5, dx_model, a.a_y + 0.5, dy_model);
+	} else if (jitter & JITTER_CELL) {
 	    jitter_start_pnt(point, &a, samplenum, pat_num);
 	}
 
@@ -429,6 +535,16 @@ do_pixel(int cpu, int pat_num, int pixelnum)
 
     /* bu_log("2: [%d, %d] : [%.2f, %.2f, %.2f]\n", pixelnum%width, pixelnum/width, a.a_color[0], a.a_color[1], a.a_color[2]); */
 
+    if (adapt_pass == 1) {
+	/* keep the base sample for the refine pass to look at */
+	struct adapt_sample *s = &adapt_buf[pixelnum - adapt_first];
+	VMOVE(s->color, a.a_color);
+	s->state = (a.a_user) ? ADAPT_HIT : ADAPT_MISS;
+	s->dist = a.a_dist;
+	s->uptr = a.a_uptr;
+	return;
+    }
+
     /* Add get_pixel_timer here to get total time taken to get pixel, when asked */
     if (lightmodel == 8) {
 	fastf_t pixelTime;
@@ -562,7 +678,7 @@ pat_found:
 	    bu_semaphore_release(RT_SEM_WORKER);
 
 	    if (top_down) {
-		from = last_pixel - pixel_start;
+		from = last_pixel - (pixel_start - first_pixel);
 		to = from - per_processor_chunk;
 	    } else {
 		from = pixel_start;
@@ -571,7 +687,7 @@ pat_found:
 
 	    /* bu_log("SPAN[%d -> %d] for %d pixels\n", pixel_start, pixel_start+per_processor_chunk, per_processor_chunk); */
 	    for (pixelnum = from; pixelnum != to; (from < to) ? pixelnum++ : pixelnum--) {
-		if (pixelnum > last_pixel || pixelnum < 0)
+		if (pixelnum > last_pixel || pixelnum < first_pixel)
 		    return;
 
 		/* bu_log("    PIXEL[%d]\n", pixelnum); */
@@ -583,11 +699,12 @@ pat_found:
 
 
 /**
- * Compute a run of pixels, in parallel if the hardware permits it.
+ * Run the workers over pixels a through b.
  */
-void
-do_run(int a, int b)
+static void
+run_workers(int a, int b)
 {
+    first_pixel = a;
     cur_pixel = a;
     last_pixel = b;
 
@@ -603,6 +720,67 @@ do_run(int a, int b)
 	 */
 	bu_parallel(worker, (size_t)npsw, NULL);
     }
+}
+
+
+/**
+ * Adaptive hypersampling.  The run is done a band of scanlines at a
+ * time: one ray for each pixel in the band and the scanline on either
+ * side of it, then the band again, hypersampling just the pixels that
+ * differ from a neighbor.
+ */
+static void
+run_adaptive(int a, int b)
+{
+    int band = ADAPT_BAND * (int)width;
+    int nbands = (b - a) / band + 1;
+    int nrefined = 0;
+    int i;
+
+    adapt_buf = (struct adapt_sample *)bu_malloc(sizeof(struct adapt_sample) * (band + 2 * width), "adapt_buf");
+    memset(adapt_nrefined, 0, sizeof(adapt_nrefined));
+
+    for (i = 0; i < nbands && !stop_worker; i++) {
+	/* top down renders want the top band first */
+	int k = (top_down) ? nbands - 1 - i : i;
+	int start = a + k * band;
+	int end = (start + band - 1 < b) ? start + band - 1 : b;
+
+	adapt_first = (start - (int)width >= a) ? start - (int)width : a;
+	adapt_last = (end + (int)width <= b) ? end + (int)width : b;
+	memset(adapt_buf, 0, sizeof(struct adapt_sample) * (adapt_last - adapt_first + 1));
+
+	adapt_pass = 1;
+	run_workers(adapt_first, adapt_last);
+	adapt_pass = 2;
+	run_workers(start, end);
+    }
+    adapt_pass = 0;
+
+    for (i = 0; i < MAX_PSW; i++)
+	nrefined += adapt_nrefined[i];
+    if (rt_verbosity & VERBOSE_STATS)
+	bu_log("Adaptive hypersampling: %d of %d pixels hypersampled\n", nrefined, b - a + 1);
+
+    bu_free(adapt_buf, "adapt_buf");
+    adapt_buf = NULL;
+}
+
+
+/**
+ * Compute a run of pixels, in parallel if the hardware permits it.
+ */
+void
+do_run(int a, int b)
+{
+    /* Adaptive hypersampling needs every pixel of the run in order,
+     * once, and shot the usual way */
+    if (hyper_adapt > 0.0 && hypersample > 0 && !incr_mode && !random_mode &&
+	!fullfloat_mode && !pixmap && lightmodel != 8) {
+	run_adaptive(a, b);
+    } else {
+	run_workers(a, b);
+    }
 
     /* Tally up the statistics */
     size_t cpu;
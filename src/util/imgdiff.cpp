@@ -80,6 +80,8 @@ main(int ac, const char **av)
     size_t width2 = 0;
     size_t height2 = 0;
     int approx_diff = 0;
+    int stream_diff = 0;
+    int threshold = 0;
     uint32_t pret = 0;
     const char *in_fmt = NULL;
     const char *out_fmt = NULL;
@@ -112,6 +114,8 @@ main(int ac, const char **av)
 	{"",  "format-img2",      "format",     &image_mime,  (void *)&in_type_2,     "File format of second input file.",        },
 	{"",  "output-format",    "format",     &image_mime,  (void *)&out_type,      "File format of output file."               },
 	{"A", "approximate",      "",           NULL,         (void *)&approx_diff ,  "Calculate approximate difference metric."  },
+	{"S", "stream",           "",           NULL,         (void *)&stream_diff ,  "Compare PIX inputs without loading them; output is a PIX heatmap."  },
+	{"t", "threshold",        "#",          &bu_opt_int,  (void *)&threshold,     "Stop after more than # pixels are off by many."  },
 	BU_OPT_DESC_NULL
     };
 
@@ -124,6 +128,12 @@ main(int ac, const char **av)
 	goto cleanup;
     }
 
+    if (threshold < 0) {
+	bu_log("Error - threshold must not be negative: %d\n", threshold);
+	ret = 1;
+	goto cleanup;
+    }
+
     /* First, see if help was requested or needed */
     if (uac < 2 || uac > 3 || need_help) {
 	/* Print help */
@@ -208,6 +218,40 @@ main(int ac, const char **av)
 	}
     }
 
+    if (stream_diff && !approx_diff) {
+	if (in_type_1 != BU_MIME_IMAGE_PIX || in_type_2 != BU_MIME_IMAGE_PIX) {
+	    bu_exit(1, "streaming comparison requires PIX inputs");
+	}
+	if (width1 != width2 && width2) {
+	    bu_exit(1, "streaming comparison requires images of the same width");
+	}
+	struct icv_diff_stats stats;
+	FILE *f1 = fopen(img_path_1, "rb");
+	FILE *f2 = fopen(img_path_2, "rb");
+	FILE *heat = (out_path) ? fopen(out_path, "wb") : NULL;
+	if (!f1 || !f2 || (out_path && !heat)) {
+	    bu_exit(1, "Unable to open image files");
+	}
+	ret = icv_diff_stream(&stats, f1, f2, width1, (size_t)threshold, heat, 0);
+	fclose(f1);
+	fclose(f2);
+	if (heat)
+	    fclose(heat);
+
+	/* an error is neither a match nor a difference */
+	if (ret < 0) {
+	    bu_log("Error - streaming comparison failed\n");
+	    ret = 2;
+	    goto cleanup;
+	}
+
+	bu_log("%zu matching, %zu off by 1, %zu off by many, %zu missing, max delta %d\n", stats.matching, stats.off_by_1, stats.off_by_many, stats.missing, stats.max_delta);
+	if (ret == 2)
+	    bu_log("Stopped early: more than %d pixels off by many\n", threshold);
+	ret = (ret) ? 1 : 0;
+	goto cleanup;
+    }
+
     img1 = icv_read(img_path_1, in_type_1, width1, height1);
     img2 = icv_read(img_path_2, in_type_2, width2, height2);
 